@@ -2,15 +2,26 @@
 // Licensed under the BSD 3-Clause License.
 
 #include "BehaviacAgent.h"
+#include "BehaviacSharedBlackboard.h"
+#include "BehaviacAgentSubsystem.h"
+#include "GameFramework/Actor.h"
 #include "BehaviorTree/BehaviacBehaviorTree.h"
 #include "BehaviorTree/BehaviacBehaviorTask.h"
 #include "BehaviorTree/BehaviacBehaviorNode.h"
+#include "Engine/World.h"
+#include "Serialization/ArchiveCountMem.h"
 
 UBehaviacAgentComponent::UBehaviacAgentComponent()
 	: bAutoTick(true)
 	, DefaultBehaviorTree(nullptr)
 	, CurrentTreeTask(nullptr)
 	, CurrentTreeAsset(nullptr)
+	, GlobalBlackboard(nullptr)
+	, TeamBlackboard(nullptr)
+	, SquadBlackboard(nullptr)
+	, UtilityInputsSharedVersion(0)
+	, CachedNumTasks(0)
+	, CachedTaskBytes(0)
 {
 	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.bStartWithTickEnabled = true;
@@ -20,6 +31,14 @@ void UBehaviacAgentComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	if (UWorld* World = GetWorld())
+	{
+		if (UBehaviacAgentSubsystem* AgentSubsystem = World->GetSubsystem<UBehaviacAgentSubsystem>())
+		{
+			AgentSubsystem->RegisterAgent(this);
+		}
+	}
+
 	if (DefaultBehaviorTree)
 	{
 		LoadBehaviorTree(DefaultBehaviorTree);
@@ -39,6 +58,15 @@ void UBehaviacAgentComponent::TickComponent(float DeltaTime, ELevelTick TickType
 void UBehaviacAgentComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	StopBehaviorTree();
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UBehaviacAgentSubsystem* AgentSubsystem = World->GetSubsystem<UBehaviacAgentSubsystem>())
+		{
+			AgentSubsystem->UnregisterAgent(this);
+		}
+	}
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -76,10 +104,56 @@ bool UBehaviacAgentComponent::LoadBehaviorTree(UBehaviacBehaviorTree* TreeAsset)
 	BEHAVIAC_VLOG(TEXT("[Behaviac] After Init: CurrentTreeTask->HasChildTask=%d"), 
 		CurrentTreeTask->HasChildTask());
 
+	// The task graph is fixed once built, so measure it here rather than on every stat refresh
+	MeasureTaskGraph();
+
 	UE_LOG(LogBehaviac, Log, TEXT("[Behaviac] Loaded behavior tree: %s"), *TreeAsset->GetName());
 	return true;
 }
 
+bool UBehaviacAgentComponent::RebindBehaviorTree(UBehaviacBehaviorTree* TreeAsset)
+{
+	if (!TreeAsset || !TreeAsset->GetRootNode())
+	{
+		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Cannot rebind to a null behavior tree"));
+		return false;
+	}
+
+	if (!CurrentTreeTask || CurrentTreeAsset != TreeAsset)
+	{
+		return LoadBehaviorTree(TreeAsset);
+	}
+
+	const FBehaviacRebindResult Result = CurrentTreeTask->RebindTree(TreeAsset->GetRootNode(), this);
+	MeasureTaskGraph();
+
+	BEHAVIAC_VLOG(TEXT("[Behaviac] Rebound %s on %s: %d tasks kept, %d rebuilt"),
+		*TreeAsset->GetName(), *GetNameSafe(GetOwner()), Result.NumKept, Result.NumCreated);
+	return true;
+}
+
+bool UBehaviacAgentComponent::NeedsRebind() const
+{
+	return CurrentTreeTask && CurrentTreeAsset && CurrentTreeTask->GetNode() != CurrentTreeAsset->GetRootNode();
+}
+
+void UBehaviacAgentComponent::MeasureTaskGraph()
+{
+	CachedNumTasks = 0;
+	CachedTaskBytes = 0;
+	if (!CurrentTreeTask)
+	{
+		return;
+	}
+
+	CurrentTreeTask->Traverse(false, [this](UBehaviacBehaviorTask* Task)
+	{
+		CachedNumTasks++;
+		CachedTaskBytes += FArchiveCountMem(Task).GetMax();
+		return true;
+	});
+}
+
 bool UBehaviacAgentComponent::LoadBehaviorTreeByPath(const FString& RelativePath)
 {
 	// Try to find the asset
@@ -103,6 +177,7 @@ EBehaviacStatus UBehaviacAgentComponent::TickBehaviorTree()
 		return EBehaviacStatus::Invalid;
 	}
 
+	SCOPE_CYCLE_COUNTER(STAT_BehaviacTickTree);
 	EBehaviacStatus Result = CurrentTreeTask->Tick(this);
 	return Result;
 }
@@ -115,6 +190,9 @@ void UBehaviacAgentComponent::StopBehaviorTree()
 		CurrentTreeTask = nullptr;
 	}
 
+	CachedNumTasks = 0;
+	CachedTaskBytes = 0;
+
 	CurrentTreeAsset = nullptr;
 }
 
@@ -137,45 +215,118 @@ EBehaviacStatus UBehaviacAgentComponent::GetBehaviorTreeStatus() const
 
 // --- Property System ---
 
+/** Split a property name into its scope and the key within that scope */
+static EBehaviacBlackboardScope ParsePropertyScope(const FString& PropertyName, FString& OutKey)
+{
+	if (PropertyName.StartsWith(TEXT("Self.")))
+	{
+		OutKey = PropertyName.Mid(5);
+		return EBehaviacBlackboardScope::Agent;
+	}
+	if (PropertyName.StartsWith(TEXT("Team.")))
+	{
+		OutKey = PropertyName.Mid(5);
+		return EBehaviacBlackboardScope::Team;
+	}
+	if (PropertyName.StartsWith(TEXT("Squad.")))
+	{
+		OutKey = PropertyName.Mid(6);
+		return EBehaviacBlackboardScope::Squad;
+	}
+	if (PropertyName.StartsWith(TEXT("Global.")))
+	{
+		OutKey = PropertyName.Mid(7);
+		return EBehaviacBlackboardScope::Global;
+	}
+
+	OutKey = PropertyName;
+	return EBehaviacBlackboardScope::Agent;
+}
+
+bool UBehaviacAgentComponent::IsPropertyReference(const FString& Operand)
+{
+	return Operand.StartsWith(TEXT("Self."))
+		|| Operand.StartsWith(TEXT("Team."))
+		|| Operand.StartsWith(TEXT("Squad."))
+		|| Operand.StartsWith(TEXT("Global."));
+}
+
+void UBehaviacAgentComponent::SetSharedBlackboard(EBehaviacBlackboardScope Scope, UBehaviacSharedBlackboard* Blackboard)
+{
+	switch (Scope)
+	{
+	case EBehaviacBlackboardScope::Global:	GlobalBlackboard = Blackboard; break;
+	case EBehaviacBlackboardScope::Team:	TeamBlackboard = Blackboard; break;
+	case EBehaviacBlackboardScope::Squad:	SquadBlackboard = Blackboard; break;
+	default: break;
+	}
+	InvalidateUtilityInputs();
+}
+
+UBehaviacSharedBlackboard* UBehaviacAgentComponent::GetSharedBlackboard(EBehaviacBlackboardScope Scope) const
+{
+	switch (Scope)
+	{
+	case EBehaviacBlackboardScope::Global:	return GlobalBlackboard;
+	case EBehaviacBlackboardScope::Team:	return TeamBlackboard;
+	case EBehaviacBlackboardScope::Squad:	return SquadBlackboard;
+	default: return nullptr;
+	}
+}
+
 void UBehaviacAgentComponent::SetPropertyValue(const FString& PropertyName, const FString& Value)
 {
-	FScopeLock Lock(&PropertyLock);
+	FString Key;
+	const EBehaviacBlackboardScope Scope = ParsePropertyScope(PropertyName, Key);
 
-	// Strip "Self." prefix if present
-	FString CleanName = PropertyName;
-	if (CleanName.StartsWith(TEXT("Self.")))
+	if (Scope != EBehaviacBlackboardScope::Agent)
 	{
-		CleanName = CleanName.Mid(5);
+		if (UBehaviacSharedBlackboard* Shared = GetSharedBlackboard(Scope))
+		{
+			Shared->SetValue(Key, Value);
+		}
+		else
+		{
+			UE_LOG(LogBehaviac, Verbose, TEXT("[Behaviac] No shared blackboard bound for property: %s"), *PropertyName);
+		}
+		return;
 	}
 
-	Properties.Add(CleanName, Value);
+	FScopeLock Lock(&PropertyLock);
+	Properties.Add(Key, Value);
+	InvalidateUtilityInputs();
 }
 
 FString UBehaviacAgentComponent::GetPropertyValue(const FString& PropertyName) const
 {
-	FScopeLock Lock(&PropertyLock);
+	FString Key;
+	const EBehaviacBlackboardScope Scope = ParsePropertyScope(PropertyName, Key);
 
-	FString CleanName = PropertyName;
-	if (CleanName.StartsWith(TEXT("Self.")))
+	if (Scope != EBehaviacBlackboardScope::Agent)
 	{
-		CleanName = CleanName.Mid(5);
+		const UBehaviacSharedBlackboard* Shared = GetSharedBlackboard(Scope);
+		const FString* Found = Shared ? Shared->FindValue(Key) : nullptr;
+		return Found ? *Found : FString();
 	}
 
-	const FString* Found = Properties.Find(CleanName);
+	FScopeLock Lock(&PropertyLock);
+	const FString* Found = Properties.Find(Key);
 	return Found ? *Found : FString();
 }
 
 bool UBehaviacAgentComponent::HasProperty(const FString& PropertyName) const
 {
-	FScopeLock Lock(&PropertyLock);
+	FString Key;
+	const EBehaviacBlackboardScope Scope = ParsePropertyScope(PropertyName, Key);
 
-	FString CleanName = PropertyName;
-	if (CleanName.StartsWith(TEXT("Self.")))
+	if (Scope != EBehaviacBlackboardScope::Agent)
 	{
-		CleanName = CleanName.Mid(5);
+		const UBehaviacSharedBlackboard* Shared = GetSharedBlackboard(Scope);
+		return Shared && Shared->HasValue(Key);
 	}
 
-	return Properties.Contains(CleanName);
+	FScopeLock Lock(&PropertyLock);
+	return Properties.Contains(Key);
 }
 
 void UBehaviacAgentComponent::SetIntProperty(const FString& PropertyName, int32 Value)
@@ -209,6 +360,247 @@ bool UBehaviacAgentComponent::GetBoolProperty(const FString& PropertyName) const
 	return Val.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Val == TEXT("1");
 }
 
+// --- Collection Properties ---
+
+/** Collections live in agent scope; a "Self." prefix is accepted and stripped. */
+static FString GetCollectionKey(const FString& PropertyName)
+{
+	return PropertyName.StartsWith(TEXT("Self.")) ? PropertyName.Mid(5) : PropertyName;
+}
+
+/** Find or create a collection and reset it to the requested element type. */
+static FBehaviacCollection& ResetCollection(TMap<FString, FBehaviacCollection>& Collections, const FString& Key, EBehaviacCollectionType Type, bool bIsSet)
+{
+	FBehaviacCollection& Collection = Collections.FindOrAdd(Key);
+	if (Collection.Type != Type)
+	{
+		Collection.Actors.Empty();
+		Collection.Vectors.Empty();
+		Collection.Floats.Empty();
+	}
+	Collection.Type = Type;
+	Collection.bIsSet = bIsSet;
+	++Collection.Version;
+	return Collection;
+}
+
+void UBehaviacAgentComponent::SetActorArrayProperty(const FString& PropertyName, const TArray<AActor*>& Values)
+{
+	FBehaviacCollection& Collection = ResetCollection(Collections, GetCollectionKey(PropertyName), EBehaviacCollectionType::Actor, false);
+	InvalidateUtilityInputs();
+	Collection.Actors.Reset(Values.Num());
+	for (AActor* Actor : Values)
+	{
+		Collection.Actors.Add(Actor);
+	}
+}
+
+void UBehaviacAgentComponent::SetVectorArrayProperty(const FString& PropertyName, const TArray<FVector>& Values)
+{
+	FBehaviacCollection& Collection = ResetCollection(Collections, GetCollectionKey(PropertyName), EBehaviacCollectionType::Vector, false);
+	InvalidateUtilityInputs();
+	Collection.Vectors = Values;
+}
+
+void UBehaviacAgentComponent::SetFloatArrayProperty(const FString& PropertyName, const TArray<float>& Values)
+{
+	FBehaviacCollection& Collection = ResetCollection(Collections, GetCollectionKey(PropertyName), EBehaviacCollectionType::Float, false);
+	InvalidateUtilityInputs();
+	Collection.Floats = Values;
+}
+
+bool UBehaviacAgentComponent::AddActorToSet(const FString& PropertyName, AActor* Actor)
+{
+	if (!Actor)
+	{
+		return false;
+	}
+
+	const FString Key = GetCollectionKey(PropertyName);
+	FBehaviacCollection* Collection = Collections.Find(Key);
+	if (!Collection || Collection->Type != EBehaviacCollectionType::Actor)
+	{
+		Collection = &ResetCollection(Collections, Key, EBehaviacCollectionType::Actor, true);
+	}
+
+	const TWeakObjectPtr<AActor> Weak(Actor);
+	if (Collection->Actors.Contains(Weak))
+	{
+		return false;
+	}
+
+	Collection->Actors.Add(Weak);
+	++Collection->Version;
+	InvalidateUtilityInputs();
+	return true;
+}
+
+bool UBehaviacAgentComponent::RemoveActorFromSet(const FString& PropertyName, AActor* Actor)
+{
+	FBehaviacCollection* Collection = Collections.Find(GetCollectionKey(PropertyName));
+	if (!Collection || Collection->Type != EBehaviacCollectionType::Actor)
+	{
+		return false;
+	}
+
+	if (Collection->Actors.Remove(TWeakObjectPtr<AActor>(Actor)) == 0)
+	{
+		return false;
+	}
+
+	++Collection->Version;
+	InvalidateUtilityInputs();
+	return true;
+}
+
+void UBehaviacAgentComponent::ClearCollectionProperty(const FString& PropertyName)
+{
+	Collections.Remove(GetCollectionKey(PropertyName));
+	InvalidateUtilityInputs();
+}
+
+int32 UBehaviacAgentComponent::GetCollectionNum(const FString& PropertyName) const
+{
+	const FBehaviacCollection* Collection = FindCollection(PropertyName);
+	return Collection ? Collection->Num() : 0;
+}
+
+const FBehaviacCollection* UBehaviacAgentComponent::FindCollection(const FString& PropertyName) const
+{
+	return Collections.Find(GetCollectionKey(PropertyName));
+}
+
+bool UBehaviacAgentComponent::BindCollectionSlot(const FString& SlotName, const FString& CollectionName, int32 Index)
+{
+	const FString Key = GetCollectionKey(CollectionName);
+	const FBehaviacCollection* Collection = Collections.Find(Key);
+	if (!Collection || Index < 0 || Index >= Collection->Num())
+	{
+		UnbindCollectionSlot(SlotName);
+		return false;
+	}
+
+	// Rebinding an existing slot only moves the index; the names are not reallocated.
+	FBehaviacCollectionCursor& Cursor = CollectionSlots.FindOrAdd(GetCollectionKey(SlotName));
+	if (Cursor.CollectionName != Key)
+	{
+		Cursor.CollectionName = Key;
+	}
+	Cursor.Index = Index;
+	Cursor.Version = Collection->Version;
+	return true;
+}
+
+void UBehaviacAgentComponent::UnbindCollectionSlot(const FString& SlotName)
+{
+	CollectionSlots.Remove(GetCollectionKey(SlotName));
+}
+
+/** Resolve a slot to its collection, or nullptr if unbound or the collection changed since binding. */
+static const FBehaviacCollection* ResolveSlot(const TMap<FString, FBehaviacCollection>& Collections,
+	const TMap<FString, FBehaviacCollectionCursor>& Slots, const FString& SlotName, int32& OutIndex)
+{
+	const FBehaviacCollectionCursor* Cursor = Slots.Find(GetCollectionKey(SlotName));
+	if (!Cursor)
+	{
+		return nullptr;
+	}
+
+	const FBehaviacCollection* Collection = Collections.Find(Cursor->CollectionName);
+	if (!Collection || Collection->Version != Cursor->Version)
+	{
+		return nullptr;
+	}
+
+	OutIndex = Cursor->Index;
+	return Collection;
+}
+
+bool UBehaviacAgentComponent::IsCollectionSlotValid(const FString& SlotName) const
+{
+	int32 Index = INDEX_NONE;
+	return ResolveSlot(Collections, CollectionSlots, SlotName, Index) != nullptr;
+}
+
+AActor* UBehaviacAgentComponent::GetSlotActor(const FString& SlotName) const
+{
+	int32 Index = INDEX_NONE;
+	const FBehaviacCollection* Collection = ResolveSlot(Collections, CollectionSlots, SlotName, Index);
+	return Collection && Collection->Actors.IsValidIndex(Index) ? Collection->Actors[Index].Get() : nullptr;
+}
+
+FVector UBehaviacAgentComponent::GetSlotVector(const FString& SlotName) const
+{
+	int32 Index = INDEX_NONE;
+	const FBehaviacCollection* Collection = ResolveSlot(Collections, CollectionSlots, SlotName, Index);
+	return Collection && Collection->Vectors.IsValidIndex(Index) ? Collection->Vectors[Index] : FVector::ZeroVector;
+}
+
+float UBehaviacAgentComponent::GetSlotFloat(const FString& SlotName) const
+{
+	int32 Index = INDEX_NONE;
+	const FBehaviacCollection* Collection = ResolveSlot(Collections, CollectionSlots, SlotName, Index);
+	return Collection && Collection->Floats.IsValidIndex(Index) ? Collection->Floats[Index] : 0.0f;
+}
+
+float UBehaviacAgentComponent::GetUtilityInput(FName InputName)
+{
+	// Shared boards are written by other agents, so compare their versions instead of hooking every write
+	uint32 SharedVersion = 0;
+	for (const UBehaviacSharedBlackboard* Shared : { GlobalBlackboard, TeamBlackboard, SquadBlackboard })
+	{
+		SharedVersion += Shared ? static_cast<uint32>(Shared->GetVersion()) : 0;
+	}
+	if (SharedVersion != UtilityInputsSharedVersion)
+	{
+		InvalidateUtilityInputs();
+		UtilityInputsSharedVersion = SharedVersion;
+	}
+
+	if (const float* Cached = UtilityInputs.Find(InputName))
+	{
+		return *Cached;
+	}
+
+	const FString InputProperty = InputName.ToString();
+	const FBehaviacCollection* Collection = FindCollection(InputProperty);
+	const float Value = Collection ? static_cast<float>(Collection->Num()) : GetFloatProperty(InputProperty);
+	UtilityInputs.Add(InputName, Value);
+	return Value;
+}
+
+// --- Memory Accounting ---
+
+void UBehaviacAgentComponent::GetMemoryUsage(FBehaviacMemoryUsage& OutUsage) const
+{
+	OutUsage.NumTasks += CachedNumTasks;
+	OutUsage.TaskBytes += CachedTaskBytes;
+
+	{
+		FScopeLock Lock(&PropertyLock);
+		OutUsage.BlackboardEntries += Properties.Num();
+		OutUsage.BlackboardBytes += Properties.GetAllocatedSize();
+		for (const TPair<FString, FString>& Pair : Properties)
+		{
+			OutUsage.BlackboardBytes += Pair.Key.GetAllocatedSize() + Pair.Value.GetAllocatedSize();
+		}
+	}
+
+	OutUsage.BlackboardEntries += Collections.Num();
+	OutUsage.BlackboardBytes += Collections.GetAllocatedSize() + CollectionSlots.GetAllocatedSize();
+	for (const TPair<FString, FBehaviacCollection>& Pair : Collections)
+	{
+		OutUsage.BlackboardBytes += Pair.Key.GetAllocatedSize()
+			+ Pair.Value.Actors.GetAllocatedSize()
+			+ Pair.Value.Vectors.GetAllocatedSize()
+			+ Pair.Value.Floats.GetAllocatedSize();
+	}
+
+	OutUsage.MethodHandlers += MethodHandlers.Num();
+	OutUsage.PendingSignals += ActiveSignals.Num();
+	OutUsage.PendingEvents += PendingEvents.Num();
+}
+
 // --- Method System ---
 
 EBehaviacStatus UBehaviacAgentComponent::ExecuteMethod(const FString& MethodName)
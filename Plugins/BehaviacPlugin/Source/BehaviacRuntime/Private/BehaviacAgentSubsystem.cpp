@@ -0,0 +1,353 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviacAgentSubsystem.h"
+#include "BehaviacAgent.h"
+#include "BehaviacSharedBlackboard.h"
+#include "BehaviorTree/BehaviacBehaviorTree.h"
+#include "BehaviorTree/BehaviacBehaviorTask.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+// Stats are process-wide while subsystems are per world, so each world publishes deltas.
+#define BEHAVIAC_PUBLISH_DWORD_STAT(Stat, NewValue, OldValue) \
+	do \
+	{ \
+		if ((NewValue) >= (OldValue)) { INC_DWORD_STAT_BY(Stat, (NewValue) - (OldValue)); } \
+		else { DEC_DWORD_STAT_BY(Stat, (OldValue) - (NewValue)); } \
+	} while (0)
+
+#define BEHAVIAC_PUBLISH_MEMORY_STAT(Stat, NewValue, OldValue) \
+	do \
+	{ \
+		if ((NewValue) >= (OldValue)) { INC_MEMORY_STAT_BY(Stat, (NewValue) - (OldValue)); } \
+		else { DEC_MEMORY_STAT_BY(Stat, (OldValue) - (NewValue)); } \
+	} while (0)
+
+static TAutoConsoleVariable<int32> CVarBehaviacReloadAgentsPerFrame(
+	TEXT("Behaviac.ReloadAgentsPerFrame"),
+	16,
+	TEXT("Maximum number of agents rebound to a reloaded behavior tree per frame (0 = all at once)."));
+
+void UBehaviacAgentSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	TreeReloadedHandle = UBehaviacBehaviorTree::OnTreeReloaded.AddUObject(this, &UBehaviacAgentSubsystem::HandleTreeReloaded);
+}
+
+void UBehaviacAgentSubsystem::Deinitialize()
+{
+	UBehaviacBehaviorTree::OnTreeReloaded.Remove(TreeReloadedHandle);
+	Agents.Empty();
+	PendingRebinds.Empty();
+	NextPendingRebind = 0;
+	// Publish after emptying so this world's agent count is withdrawn too
+	PublishStats(FBehaviacMemoryUsage(), 0);
+	Super::Deinitialize();
+}
+
+void UBehaviacAgentSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (GetNumPendingRebinds() > 0)
+	{
+		ProcessPendingRebinds(CVarBehaviacReloadAgentsPerFrame.GetValueOnGameThread());
+	}
+
+#if STATS
+	TimeUntilStatRefresh -= DeltaTime;
+	if (TimeUntilStatRefresh > 0.0f || !FThreadStats::IsCollectingData())
+	{
+		return;
+	}
+	TimeUntilStatRefresh = StatRefreshInterval;
+
+	TArray<UBehaviacBehaviorTree*> Trees;
+	GatherLoadedTrees(Trees);
+	PublishStats(GetWorldMemoryUsage(), Trees.Num());
+#endif
+}
+
+TStatId UBehaviacAgentSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBehaviacAgentSubsystem, STATGROUP_Tickables);
+}
+
+void UBehaviacAgentSubsystem::RegisterAgent(UBehaviacAgentComponent* Agent)
+{
+	if (Agent)
+	{
+		Agents.AddUnique(Agent);
+	}
+}
+
+void UBehaviacAgentSubsystem::UnregisterAgent(UBehaviacAgentComponent* Agent)
+{
+	Agents.RemoveSwap(Agent);
+}
+
+void UBehaviacAgentSubsystem::HandleTreeReloaded(UBehaviacBehaviorTree* Tree)
+{
+	for (const TWeakObjectPtr<UBehaviacAgentComponent>& Agent : Agents)
+	{
+		// Entries before NextPendingRebind were already rebound to an older reload
+		if (Agent.IsValid() && Agent->GetCurrentTreeAsset() == Tree)
+		{
+			const int32 Existing = PendingRebinds.Find(Agent);
+			if (Existing == INDEX_NONE || Existing < NextPendingRebind)
+			{
+				PendingRebinds.Add(Agent);
+			}
+		}
+	}
+}
+
+int32 UBehaviacAgentSubsystem::ProcessPendingRebinds(int32 MaxAgents)
+{
+	const int32 NumPending = GetNumPendingRebinds();
+	const int32 End = NextPendingRebind + (MaxAgents > 0 ? FMath::Min(MaxAgents, NumPending) : NumPending);
+
+	int32 NumRebound = 0;
+	for (; NextPendingRebind < End; ++NextPendingRebind)
+	{
+		UBehaviacAgentComponent* Agent = PendingRebinds[NextPendingRebind].Get();
+		// Agents that stopped or switched trees since the reload have nothing to rebind
+		if (Agent && Agent->NeedsRebind() && Agent->RebindBehaviorTree(Agent->GetCurrentTreeAsset()))
+		{
+			NumRebound++;
+		}
+	}
+
+	// Drained by index so a large reload does not shift the queue every frame
+	if (NextPendingRebind >= PendingRebinds.Num())
+	{
+		PendingRebinds.Reset();
+		NextPendingRebind = 0;
+	}
+	return NumRebound;
+}
+
+#if WITH_EDITOR
+int32 UBehaviacAgentSubsystem::ReloadTreesFromSource()
+{
+	TArray<UBehaviacBehaviorTree*> Trees;
+	GatherLoadedTrees(Trees);
+
+	int32 NumReloaded = 0;
+	for (UBehaviacBehaviorTree* Tree : Trees)
+	{
+		if (Tree->ReloadFromSourceFile())
+		{
+			NumReloaded++;
+		}
+	}
+	return NumReloaded;
+}
+#endif
+
+void UBehaviacAgentSubsystem::GatherLoadedTrees(TArray<UBehaviacBehaviorTree*>& OutTrees) const
+{
+	for (const TWeakObjectPtr<UBehaviacAgentComponent>& Agent : Agents)
+	{
+		if (Agent.IsValid() && Agent->GetCurrentTreeAsset())
+		{
+			OutTrees.AddUnique(Agent->GetCurrentTreeAsset());
+		}
+	}
+}
+
+FBehaviacMemoryUsage UBehaviacAgentSubsystem::GetWorldMemoryUsage() const
+{
+	FBehaviacMemoryUsage Usage;
+
+	// Node definitions are shared by every agent running the same tree, so count each asset once
+	TArray<UBehaviacBehaviorTree*> Trees;
+	GatherLoadedTrees(Trees);
+	for (const UBehaviacBehaviorTree* Tree : Trees)
+	{
+		Tree->GetMemoryUsage(Usage);
+	}
+
+	for (const TWeakObjectPtr<UBehaviacAgentComponent>& Agent : Agents)
+	{
+		if (Agent.IsValid())
+		{
+			Agent->GetMemoryUsage(Usage);
+		}
+	}
+
+	// Shared boards are owned by the world, not by any agent
+	if (const UBehaviacBlackboardSubsystem* Blackboards = GetWorld() ? GetWorld()->GetSubsystem<UBehaviacBlackboardSubsystem>() : nullptr)
+	{
+		Blackboards->GetMemoryUsage(Usage);
+	}
+	return Usage;
+}
+
+void UBehaviacAgentSubsystem::PublishStats(const FBehaviacMemoryUsage& Usage, int32 NumTrees)
+{
+	const int32 NumAgents = Agents.Num();
+
+	BEHAVIAC_PUBLISH_DWORD_STAT(STAT_BehaviacAgents, NumAgents, PublishedAgents);
+	BEHAVIAC_PUBLISH_DWORD_STAT(STAT_BehaviacTreeAssets, NumTrees, PublishedTrees);
+	BEHAVIAC_PUBLISH_DWORD_STAT(STAT_BehaviacNodes, Usage.NumNodes, PublishedUsage.NumNodes);
+	BEHAVIAC_PUBLISH_DWORD_STAT(STAT_BehaviacTasks, Usage.NumTasks, PublishedUsage.NumTasks);
+	BEHAVIAC_PUBLISH_DWORD_STAT(STAT_BehaviacBlackboardEntries, Usage.BlackboardEntries, PublishedUsage.BlackboardEntries);
+	BEHAVIAC_PUBLISH_DWORD_STAT(STAT_BehaviacMethodHandlers, Usage.MethodHandlers, PublishedUsage.MethodHandlers);
+	BEHAVIAC_PUBLISH_DWORD_STAT(STAT_BehaviacPendingSignals, Usage.PendingSignals, PublishedUsage.PendingSignals);
+	BEHAVIAC_PUBLISH_DWORD_STAT(STAT_BehaviacPendingEvents, Usage.PendingEvents, PublishedUsage.PendingEvents);
+	BEHAVIAC_PUBLISH_MEMORY_STAT(STAT_BehaviacNodeMemory, Usage.NodeBytes, PublishedUsage.NodeBytes);
+	BEHAVIAC_PUBLISH_MEMORY_STAT(STAT_BehaviacTaskMemory, Usage.TaskBytes, PublishedUsage.TaskBytes);
+	BEHAVIAC_PUBLISH_MEMORY_STAT(STAT_BehaviacBlackboardMemory, Usage.BlackboardBytes, PublishedUsage.BlackboardBytes);
+
+	PublishedUsage = Usage;
+	PublishedAgents = NumAgents;
+	PublishedTrees = NumTrees;
+}
+
+static FString FormatBytes(int64 Bytes)
+{
+	return FString::Printf(TEXT("%.1f KB"), Bytes / 1024.0);
+}
+
+void UBehaviacAgentSubsystem::DumpMemReport(FOutputDevice& Ar) const
+{
+	const UWorld* World = GetWorld();
+	Ar.Logf(TEXT("Behaviac memory report for world %s"), World ? *World->GetName() : TEXT("<none>"));
+
+	// --- Per tree asset ---
+	TArray<UBehaviacBehaviorTree*> Trees;
+	GatherLoadedTrees(Trees);
+
+	Ar.Logf(TEXT("Tree assets: %d"), Trees.Num());
+	for (const UBehaviacBehaviorTree* Tree : Trees)
+	{
+		FBehaviacMemoryUsage TreeUsage;
+		Tree->GetMemoryUsage(TreeUsage);
+
+		int32 NumUsers = 0;
+		FBehaviacMemoryUsage AgentsUsage;
+		for (const TWeakObjectPtr<UBehaviacAgentComponent>& Agent : Agents)
+		{
+			if (Agent.IsValid() && Agent->GetCurrentTreeAsset() == Tree)
+			{
+				NumUsers++;
+				Agent->GetMemoryUsage(AgentsUsage);
+			}
+		}
+
+		Ar.Logf(TEXT("  %-40s Nodes=%5d NodeDefs=%10s Agents=%4d Tasks=%6d TaskState=%10s"),
+			*Tree->GetName(), TreeUsage.NumNodes, *FormatBytes(TreeUsage.NodeBytes),
+			NumUsers, AgentsUsage.NumTasks, *FormatBytes(AgentsUsage.TaskBytes));
+	}
+
+	// --- Per agent ---
+	Ar.Logf(TEXT("Agents: %d"), Agents.Num());
+	int32 NumStale = 0;
+	for (const TWeakObjectPtr<UBehaviacAgentComponent>& Agent : Agents)
+	{
+		if (!Agent.IsValid())
+		{
+			NumStale++;
+			continue;
+		}
+
+		FBehaviacMemoryUsage AgentUsage;
+		Agent->GetMemoryUsage(AgentUsage);
+
+		const AActor* Owner = Agent->GetOwner();
+		const UBehaviacBehaviorTree* Tree = Agent->GetCurrentTreeAsset();
+		Ar.Logf(TEXT("  %-40s Tree=%-24s Tasks=%4d TaskState=%10s BBEntries=%4d Blackboard=%10s Handlers=%3d Signals=%2d Events=%2d"),
+			Owner ? *Owner->GetName() : *Agent->GetName(),
+			Tree ? *Tree->GetName() : TEXT("<none>"),
+			AgentUsage.NumTasks, *FormatBytes(AgentUsage.TaskBytes),
+			AgentUsage.BlackboardEntries, *FormatBytes(AgentUsage.BlackboardBytes),
+			AgentUsage.MethodHandlers, AgentUsage.PendingSignals, AgentUsage.PendingEvents);
+	}
+
+	// --- Shared blackboards ---
+	TArray<TPair<FString, const UBehaviacSharedBlackboard*>> SharedBoards;
+	if (const UBehaviacBlackboardSubsystem* Blackboards = World ? World->GetSubsystem<UBehaviacBlackboardSubsystem>() : nullptr)
+	{
+		Blackboards->GatherBlackboards(SharedBoards);
+	}
+
+	Ar.Logf(TEXT("Shared blackboards: %d"), SharedBoards.Num());
+	for (const TPair<FString, const UBehaviacSharedBlackboard*>& Board : SharedBoards)
+	{
+		FBehaviacMemoryUsage BoardUsage;
+		Board.Value->GetMemoryUsage(BoardUsage);
+		Ar.Logf(TEXT("  %-40s BBEntries=%4d Blackboard=%10s Producers=%3d"),
+			*Board.Key, BoardUsage.BlackboardEntries, *FormatBytes(BoardUsage.BlackboardBytes),
+			Board.Value->GetNumProducers());
+	}
+
+	// --- Leaks: task graphs no longer owned by a running agent ---
+	int32 NumDetachedTrees = 0;
+	for (TObjectIterator<UBehaviacBehaviorTreeTask> It; It; ++It)
+	{
+		const UBehaviacAgentComponent* Owner = It->GetTypedOuter<UBehaviacAgentComponent>();
+		if (Owner && Owner->GetWorld() == World && Owner->GetCurrentTreeTask() != *It)
+		{
+			NumDetachedTrees++;
+		}
+	}
+
+	// --- Totals ---
+	const FBehaviacMemoryUsage Total = GetWorldMemoryUsage();
+	Ar.Logf(TEXT("Totals: Trees=%d Nodes=%d NodeDefs=%s Agents=%d Tasks=%d TaskState=%s BBEntries=%d Blackboard=%s Handlers=%d Signals=%d Events=%d"),
+		Trees.Num(), Total.NumNodes, *FormatBytes(Total.NodeBytes),
+		Agents.Num(), Total.NumTasks, *FormatBytes(Total.TaskBytes),
+		Total.BlackboardEntries, *FormatBytes(Total.BlackboardBytes),
+		Total.MethodHandlers, Total.PendingSignals, Total.PendingEvents);
+
+	if (NumStale > 0 || NumDetachedTrees > 0)
+	{
+		Ar.Logf(TEXT("Warning: %d destroyed agents still registered, %d task graphs not owned by their agent (awaiting GC or leaked)"),
+			NumStale, NumDetachedTrees);
+	}
+}
+
+// ===================================================================
+// Console commands
+// ===================================================================
+
+static void BehaviacMemReport(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	const UBehaviacAgentSubsystem* AgentSubsystem = World ? World->GetSubsystem<UBehaviacAgentSubsystem>() : nullptr;
+	if (!AgentSubsystem)
+	{
+		Ar.Log(TEXT("Behaviac.MemReport: no Behaviac agent subsystem in this world"));
+		return;
+	}
+	AgentSubsystem->DumpMemReport(Ar);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice BehaviacMemReportCommand(
+	TEXT("Behaviac.MemReport"),
+	TEXT("Report Behaviac memory per tree asset and per agent, with totals for the current world."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&BehaviacMemReport));
+
+#if WITH_EDITOR
+static void BehaviacReloadTrees(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UBehaviacAgentSubsystem* AgentSubsystem = World ? World->GetSubsystem<UBehaviacAgentSubsystem>() : nullptr;
+	if (!AgentSubsystem)
+	{
+		Ar.Log(TEXT("Behaviac.ReloadTrees: no Behaviac agent subsystem in this world"));
+		return;
+	}
+
+	const int32 NumReloaded = AgentSubsystem->ReloadTreesFromSource();
+	Ar.Logf(TEXT("Behaviac.ReloadTrees: reloaded %d trees, %d agents queued for rebind"),
+		NumReloaded, AgentSubsystem->GetNumPendingRebinds());
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice BehaviacReloadTreesCommand(
+	TEXT("Behaviac.ReloadTrees"),
+	TEXT("Re-read every behavior tree in use in the current world from its source file and rebind running agents."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&BehaviacReloadTrees));
+#endif
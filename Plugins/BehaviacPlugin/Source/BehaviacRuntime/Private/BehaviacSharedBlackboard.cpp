@@ -0,0 +1,212 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviacSharedBlackboard.h"
+
+// ===================================================================
+// UBehaviacSharedBlackboard
+// ===================================================================
+
+UBehaviacSharedBlackboard::UBehaviacSharedBlackboard()
+	: Version(0)
+{
+}
+
+void UBehaviacSharedBlackboard::SetValue(const FString& Key, const FString& Value)
+{
+	FBehaviacSharedBlackboardEntry* Entry = Entries.Find(Key);
+	if (Entry && Entry->Value == Value)
+	{
+		return;
+	}
+
+	++Version;
+
+	if (!Entry)
+	{
+		Entry = &Entries.Add(Key);
+	}
+
+	Entry->Value = Value;
+	Entry->Version = Version;
+}
+
+FString UBehaviacSharedBlackboard::GetValue(const FString& Key) const
+{
+	const FString* Found = FindValue(Key);
+	return Found ? *Found : FString();
+}
+
+bool UBehaviacSharedBlackboard::HasValue(const FString& Key) const
+{
+	return Entries.Contains(Key);
+}
+
+void UBehaviacSharedBlackboard::ClearValue(const FString& Key)
+{
+	if (Entries.Remove(Key) > 0)
+	{
+		++Version;
+	}
+}
+
+const FString* UBehaviacSharedBlackboard::FindValue(const FString& Key) const
+{
+	const FBehaviacSharedBlackboardEntry* Entry = Entries.Find(Key);
+	return Entry ? &Entry->Value : nullptr;
+}
+
+uint32 UBehaviacSharedBlackboard::GetEntryVersion(const FString& Key) const
+{
+	const FBehaviacSharedBlackboardEntry* Entry = Entries.Find(Key);
+	return Entry ? Entry->Version : 0;
+}
+
+void UBehaviacSharedBlackboard::RegisterProducer(const FString& Key, float Interval, TFunction<FString()> Produce)
+{
+	UnregisterProducer(Key);
+
+	FBehaviacSharedBlackboardProducer& Producer = Producers.AddDefaulted_GetRef();
+	Producer.Key = Key;
+	Producer.Interval = FMath::Max(0.0f, Interval);
+	Producer.TimeUntilUpdate = 0.0f;
+	Producer.Produce = MoveTemp(Produce);
+}
+
+void UBehaviacSharedBlackboard::UnregisterProducer(const FString& Key)
+{
+	Producers.RemoveAll([&Key](const FBehaviacSharedBlackboardProducer& Producer)
+	{
+		return Producer.Key == Key;
+	});
+}
+
+void UBehaviacSharedBlackboard::TickProducers(float DeltaTime)
+{
+	for (FBehaviacSharedBlackboardProducer& Producer : Producers)
+	{
+		Producer.TimeUntilUpdate -= DeltaTime;
+		if (Producer.TimeUntilUpdate > 0.0f)
+		{
+			continue;
+		}
+
+		Producer.TimeUntilUpdate = Producer.Interval;
+		if (Producer.Produce)
+		{
+			SetValue(Producer.Key, Producer.Produce());
+		}
+	}
+}
+
+void UBehaviacSharedBlackboard::GetMemoryUsage(FBehaviacMemoryUsage& OutUsage) const
+{
+	OutUsage.BlackboardEntries += Entries.Num();
+	OutUsage.BlackboardBytes += Entries.GetAllocatedSize() + Producers.GetAllocatedSize();
+	for (const TPair<FString, FBehaviacSharedBlackboardEntry>& Pair : Entries)
+	{
+		OutUsage.BlackboardBytes += Pair.Key.GetAllocatedSize() + Pair.Value.Value.GetAllocatedSize();
+	}
+	for (const FBehaviacSharedBlackboardProducer& Producer : Producers)
+	{
+		OutUsage.BlackboardBytes += Producer.Key.GetAllocatedSize();
+	}
+}
+
+// ===================================================================
+// UBehaviacBlackboardSubsystem
+// ===================================================================
+
+void UBehaviacBlackboardSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (GlobalBlackboard)
+	{
+		GlobalBlackboard->TickProducers(DeltaTime);
+	}
+
+	for (const TPair<uint8, UBehaviacSharedBlackboard*>& Pair : TeamBlackboards)
+	{
+		if (Pair.Value)
+		{
+			Pair.Value->TickProducers(DeltaTime);
+		}
+	}
+
+	for (const TPair<FName, UBehaviacSharedBlackboard*>& Pair : SquadBlackboards)
+	{
+		if (Pair.Value)
+		{
+			Pair.Value->TickProducers(DeltaTime);
+		}
+	}
+}
+
+TStatId UBehaviacBlackboardSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBehaviacBlackboardSubsystem, STATGROUP_Tickables);
+}
+
+UBehaviacSharedBlackboard* UBehaviacBlackboardSubsystem::GetGlobalBlackboard()
+{
+	if (!GlobalBlackboard)
+	{
+		GlobalBlackboard = NewObject<UBehaviacSharedBlackboard>(this);
+	}
+	return GlobalBlackboard;
+}
+
+UBehaviacSharedBlackboard* UBehaviacBlackboardSubsystem::GetTeamBlackboard(uint8 TeamId)
+{
+	UBehaviacSharedBlackboard*& Board = TeamBlackboards.FindOrAdd(TeamId);
+	if (!Board)
+	{
+		Board = NewObject<UBehaviacSharedBlackboard>(this);
+	}
+	return Board;
+}
+
+UBehaviacSharedBlackboard* UBehaviacBlackboardSubsystem::GetSquadBlackboard(FName SquadName)
+{
+	UBehaviacSharedBlackboard*& Board = SquadBlackboards.FindOrAdd(SquadName);
+	if (!Board)
+	{
+		Board = NewObject<UBehaviacSharedBlackboard>(this);
+	}
+	return Board;
+}
+
+void UBehaviacBlackboardSubsystem::GatherBlackboards(TArray<TPair<FString, const UBehaviacSharedBlackboard*>>& OutBoards) const
+{
+	if (GlobalBlackboard)
+	{
+		OutBoards.Emplace(TEXT("Global"), GlobalBlackboard);
+	}
+
+	for (const TPair<uint8, UBehaviacSharedBlackboard*>& Pair : TeamBlackboards)
+	{
+		if (Pair.Value)
+		{
+			OutBoards.Emplace(FString::Printf(TEXT("Team.%d"), Pair.Key), Pair.Value);
+		}
+	}
+
+	for (const TPair<FName, UBehaviacSharedBlackboard*>& Pair : SquadBlackboards)
+	{
+		if (Pair.Value)
+		{
+			OutBoards.Emplace(TEXT("Squad.") + Pair.Key.ToString(), Pair.Value);
+		}
+	}
+}
+
+void UBehaviacBlackboardSubsystem::GetMemoryUsage(FBehaviacMemoryUsage& OutUsage) const
+{
+	TArray<TPair<FString, const UBehaviacSharedBlackboard*>> Boards;
+	GatherBlackboards(Boards);
+	for (const TPair<FString, const UBehaviacSharedBlackboard*>& Board : Boards)
+	{
+		Board.Value->GetMemoryUsage(OutUsage);
+	}
+}
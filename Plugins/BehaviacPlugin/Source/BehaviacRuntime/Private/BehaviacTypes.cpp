@@ -5,6 +5,19 @@
 
 DEFINE_LOG_CATEGORY(LogBehaviac);
 
+DEFINE_STAT(STAT_BehaviacTickTree);
+DEFINE_STAT(STAT_BehaviacAgents);
+DEFINE_STAT(STAT_BehaviacTreeAssets);
+DEFINE_STAT(STAT_BehaviacNodes);
+DEFINE_STAT(STAT_BehaviacTasks);
+DEFINE_STAT(STAT_BehaviacBlackboardEntries);
+DEFINE_STAT(STAT_BehaviacMethodHandlers);
+DEFINE_STAT(STAT_BehaviacPendingSignals);
+DEFINE_STAT(STAT_BehaviacPendingEvents);
+DEFINE_STAT(STAT_BehaviacNodeMemory);
+DEFINE_STAT(STAT_BehaviacTaskMemory);
+DEFINE_STAT(STAT_BehaviacBlackboardMemory);
+
 TAutoConsoleVariable<int32> CVarBehaviacVerboseLogging(
 	TEXT("Behaviac.VerboseLogging"),
 	0,
@@ -108,7 +108,7 @@ EBehaviacStatus UBehaviacAssignmentTask::OnUpdate(UBehaviacAgentComponent* Agent
 	FString Value = AssignNode->PropertyValue;
 
 	// Resolve if it references another property
-	if (Value.StartsWith(TEXT("Self.")))
+	if (UBehaviacAgentComponent::IsPropertyReference(Value))
 	{
 		Value = Agent->GetPropertyValue(Value);
 	}
@@ -166,11 +166,11 @@ EBehaviacStatus UBehaviacComputeTask::OnUpdate(UBehaviacAgentComponent* Agent, E
 	FString LeftStr = ComputeNode->LeftOperand;
 	FString RightStr = ComputeNode->RightOperand;
 
-	if (LeftStr.StartsWith(TEXT("Self.")))
+	if (UBehaviacAgentComponent::IsPropertyReference(LeftStr))
 	{
 		LeftStr = Agent->GetPropertyValue(LeftStr);
 	}
-	if (RightStr.StartsWith(TEXT("Self.")))
+	if (UBehaviacAgentComponent::IsPropertyReference(RightStr))
 	{
 		RightStr = Agent->GetPropertyValue(RightStr);
 	}
@@ -287,6 +287,13 @@ bool UBehaviacWaitTask::OnEnter(UBehaviacAgentComponent* Agent)
 	return true;
 }
 
+void UBehaviacWaitTask::OnRebind(UBehaviacAgentComponent* Agent)
+{
+	// StartTime is kept, so a shortened wait can finish on the next update
+	const UBehaviacWait* WaitNode = Cast<UBehaviacWait>(Node);
+	WaitDuration = WaitNode ? WaitNode->Duration : 1.0f;
+}
+
 EBehaviacStatus UBehaviacWaitTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	double CurrentTime = 0.0;
@@ -345,6 +352,12 @@ bool UBehaviacWaitFramesTask::OnEnter(UBehaviacAgentComponent* Agent)
 	return true;
 }
 
+void UBehaviacWaitFramesTask::OnRebind(UBehaviacAgentComponent* Agent)
+{
+	const UBehaviacWaitFrames* WFNode = Cast<UBehaviacWaitFrames>(Node);
+	TargetFrames = WFNode ? WFNode->FrameCount : 1;
+}
+
 EBehaviacStatus UBehaviacWaitFramesTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	int32 Elapsed = static_cast<int32>(GFrameCounter - StartFrame);
@@ -105,7 +105,7 @@ bool UBehaviacPrecondition::Evaluate(UBehaviacAgentComponent* Agent) const
 	FString RightValue = RightOperand;
 
 	// If right operand references a property, resolve it
-	if (RightOperand.StartsWith(TEXT("Self.")))
+	if (UBehaviacAgentComponent::IsPropertyReference(RightOperand))
 	{
 		RightValue = Agent->GetPropertyValue(RightOperand);
 	}
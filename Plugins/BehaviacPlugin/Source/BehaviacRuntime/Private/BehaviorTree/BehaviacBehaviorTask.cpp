@@ -88,6 +88,98 @@ void UBehaviacBehaviorTask::Traverse(bool bChildFirst, TFunction<bool(UBehaviacB
 	Handler(this);
 }
 
+void UBehaviacBehaviorTask::Abort(UBehaviacAgentComponent* Agent)
+{
+	Traverse(true, [Agent](UBehaviacBehaviorTask* Task)
+	{
+		if (Task->bHasEntered)
+		{
+			Task->OnExit(Agent, EBehaviacStatus::Failure);
+			Task->bHasEntered = false;
+			Task->Status = EBehaviacStatus::Failure;
+		}
+		return true;
+	});
+}
+
+static bool IsSameNodeShape(const UBehaviacBehaviorNode* A, const UBehaviacBehaviorNode* B)
+{
+	if (!A || !B)
+	{
+		return A == B;
+	}
+	return A->GetClass() == B->GetClass() && A->NodeId == B->NodeId;
+}
+
+bool UBehaviacBehaviorTask::CanRebind(const UBehaviacBehaviorNode* InNode) const
+{
+	// Nodes built in code have no ID, so there is nothing stable to match them by
+	if (!Node || !InNode || Node->NodeId == BEHAVIAC_INVALID_NODE_ID || !IsSameNodeShape(Node, InNode))
+	{
+		return false;
+	}
+
+	if (Node->GetChildCount() != InNode->GetChildCount())
+	{
+		return false;
+	}
+
+	for (int32 i = 0; i < InNode->GetChildCount(); i++)
+	{
+		if (!IsSameNodeShape(Node->GetChild(i), InNode->GetChild(i)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void UBehaviacBehaviorTask::Rebind(UBehaviacBehaviorNode* InNode, UBehaviacAgentComponent* Agent, FBehaviacRebindResult& OutResult)
+{
+	Node = InNode;
+	OutResult.NumKept++;
+	OnRebind(Agent);
+}
+
+void UBehaviacBehaviorTask::OnRebind(UBehaviacAgentComponent* Agent)
+{
+}
+
+/** Rebind an existing task to a reloaded node, or create a fresh task when its state cannot carry over. */
+static UBehaviacBehaviorTask* RebindOrCreateTask(UBehaviacBehaviorTask* OldTask, UBehaviacBehaviorNode* NewNode,
+	UBehaviacBehaviorTask* Parent, UBehaviacAgentComponent* Agent, FBehaviacRebindResult& OutResult)
+{
+	if (OldTask && OldTask->CanRebind(NewNode))
+	{
+		OldTask->Rebind(NewNode, Agent, OutResult);
+		return OldTask;
+	}
+
+	// The replaced subtree may be mid-action; let it release what it acquired on enter
+	if (OldTask)
+	{
+		OldTask->Abort(Agent);
+	}
+
+	if (!NewNode)
+	{
+		return nullptr;
+	}
+
+	UBehaviacBehaviorTask* NewTask = NewNode->CreateTask(Parent);
+	if (NewTask)
+	{
+		NewTask->Init(NewNode);
+		NewTask->SetParentTask(Parent);
+		NewTask->Traverse(false, [&OutResult](UBehaviacBehaviorTask*)
+		{
+			OutResult.NumCreated++;
+			return true;
+		});
+	}
+	return NewTask;
+}
+
 bool UBehaviacBehaviorTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	return true;
@@ -205,6 +297,38 @@ void UBehaviacCompositeTask::Reset(UBehaviacAgentComponent* Agent)
 	}
 }
 
+void UBehaviacCompositeTask::Rebind(UBehaviacBehaviorNode* InNode, UBehaviacAgentComponent* Agent, FBehaviacRebindResult& OutResult)
+{
+	Super::Rebind(InNode, Agent, OutResult);
+
+	// Init skips null children, so only pair by index when the layouts line up
+	if (ChildTasks.Num() != InNode->GetChildCount())
+	{
+		for (UBehaviacBehaviorTask* ChildTask : ChildTasks)
+		{
+			if (ChildTask)
+			{
+				ChildTask->Abort(Agent);
+			}
+		}
+		Init(InNode);
+		Traverse(false, [this, &OutResult](UBehaviacBehaviorTask* Task)
+		{
+			if (Task != this)
+			{
+				OutResult.NumCreated++;
+			}
+			return true;
+		});
+		return;
+	}
+
+	for (int32 i = 0; i < ChildTasks.Num(); i++)
+	{
+		ChildTasks[i] = RebindOrCreateTask(ChildTasks[i], InNode->GetChild(i), this, Agent, OutResult);
+	}
+}
+
 void UBehaviacCompositeTask::Traverse(bool bChildFirst, TFunction<bool(UBehaviacBehaviorTask*)> Handler)
 {
 	if (!bChildFirst)
@@ -266,6 +390,12 @@ void UBehaviacSingleChildTask::Reset(UBehaviacAgentComponent* Agent)
 	}
 }
 
+void UBehaviacSingleChildTask::Rebind(UBehaviacBehaviorNode* InNode, UBehaviacAgentComponent* Agent, FBehaviacRebindResult& OutResult)
+{
+	Super::Rebind(InNode, Agent, OutResult);
+	ChildTask = RebindOrCreateTask(ChildTask, InNode->GetChildCount() > 0 ? InNode->GetChild(0) : nullptr, this, Agent, OutResult);
+}
+
 void UBehaviacSingleChildTask::Traverse(bool bChildFirst, TFunction<bool(UBehaviacBehaviorTask*)> Handler)
 {
 	if (!bChildFirst)
@@ -330,6 +460,14 @@ void UBehaviacBehaviorTreeTask::Init(UBehaviacBehaviorNode* InNode)
 	}
 }
 
+FBehaviacRebindResult UBehaviacBehaviorTreeTask::RebindTree(UBehaviacBehaviorNode* NewRootNode, UBehaviacAgentComponent* Agent)
+{
+	FBehaviacRebindResult Result;
+	Node = NewRootNode;
+	ChildTask = RebindOrCreateTask(ChildTask, NewRootNode, this, Agent, Result);
+	return Result;
+}
+
 EBehaviacStatus UBehaviacBehaviorTreeTask::Tick(UBehaviacAgentComponent* Agent)
 {
 	return Execute(Agent, EBehaviacStatus::Invalid);
@@ -10,8 +10,11 @@
 #include "BehaviorTree/Attachments/BehaviacAttachment.h"
 #include "FSM/BehaviacFSM.h"
 #include "Misc/FileHelper.h"
+#include "Serialization/ArchiveCountMem.h"
 #include "XmlFile.h"
 
+FOnBehaviacTreeReloaded UBehaviacBehaviorTree::OnTreeReloaded;
+
 UBehaviacBehaviorTree::UBehaviacBehaviorTree()
 	: RootNode(nullptr)
 	, Version(0)
@@ -31,6 +34,7 @@ static UBehaviacBehaviorNode* CreateNodeByClassName(const FString& ClassName, UO
 	if (ClassName == TEXT("IfElse"))				return NewObject<UBehaviacIfElse>(Outer);
 	if (ClassName == TEXT("SelectorLoop"))		return NewObject<UBehaviacSelectorLoop>(Outer);
 	if (ClassName == TEXT("SelectorProbability")) return NewObject<UBehaviacSelectorProbability>(Outer);
+	if (ClassName == TEXT("SelectorUtility"))	return NewObject<UBehaviacSelectorUtility>(Outer);
 	if (ClassName == TEXT("SelectorStochastic"))	return NewObject<UBehaviacSelectorStochastic>(Outer);
 	if (ClassName == TEXT("SequenceStochastic"))	return NewObject<UBehaviacSequenceStochastic>(Outer);
 	if (ClassName == TEXT("ReferencedBehavior"))	return NewObject<UBehaviacReferenceBehavior>(Outer);
@@ -70,6 +74,7 @@ static UBehaviacBehaviorNode* CreateNodeByClassName(const FString& ClassName, UO
 	if (ClassName == TEXT("DecoratorIterator"))			return NewObject<UBehaviacDecoratorIterator>(Outer);
 	if (ClassName == TEXT("DecoratorLog"))				return NewObject<UBehaviacDecoratorLog>(Outer);
 	if (ClassName == TEXT("DecoratorWeight"))			return NewObject<UBehaviacDecoratorWeight>(Outer);
+	if (ClassName == TEXT("DecoratorUtility"))			return NewObject<UBehaviacDecoratorUtility>(Outer);
 
 	// FSM
 	if (ClassName == TEXT("FSM"))				return NewObject<UBehaviacFSMNode>(Outer);
@@ -244,14 +249,17 @@ bool UBehaviacBehaviorTree::LoadFromXML(const FString& XMLContent)
 		}
 	}
 
+	// Parse into a local so a broken edit during live reload keeps the previous definition
+	UBehaviacBehaviorNode* NewRootNode = nullptr;
+
 	if (FirstNode)
 	{
-		RootNode = ParseNodeFromXML(FirstNode, this);
+		NewRootNode = ParseNodeFromXML(FirstNode, this);
 		
-		if (RootNode)
+		if (NewRootNode)
 		{
 			BEHAVIAC_VLOG(TEXT("[Behaviac] XML parsed! RootNode=%s, ChildCount=%d"), 
-				*RootNode->GetName(), RootNode->GetChildCount());
+				*NewRootNode->GetName(), NewRootNode->GetChildCount());
 		}
 		else
 		{
@@ -263,7 +271,68 @@ bool UBehaviacBehaviorTree::LoadFromXML(const FString& XMLContent)
 		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] No <node> element found in XML!"));
 	}
 
-	return RootNode != nullptr;
+	if (!NewRootNode)
+	{
+		return false;
+	}
+
+	const bool bIsReload = RootNode != nullptr;
+	RootNode = NewRootNode;
+
+	if (bIsReload)
+	{
+		UE_LOG(LogBehaviac, Log, TEXT("[Behaviac] Reloaded behavior tree: %s"), *GetName());
+		OnTreeReloaded.Broadcast(this);
+	}
+
+	return true;
+}
+
+#if WITH_EDITOR
+bool UBehaviacBehaviorTree::ReloadFromSourceFile()
+{
+	FString FileContent;
+	if (SourceFilePath.IsEmpty() || !FFileHelper::LoadFileToString(FileContent, *SourceFilePath))
+	{
+		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Cannot reload %s: failed to read '%s'"), *GetName(), *SourceFilePath);
+		return false;
+	}
+
+	return LoadFromXML(FileContent);
+}
+#endif
+
+static void AccumulateNodeMemory(const UBehaviacBehaviorNode* Node, FBehaviacMemoryUsage& OutUsage)
+{
+	if (!Node)
+	{
+		return;
+	}
+
+	OutUsage.NumNodes++;
+	OutUsage.NodeBytes += FArchiveCountMem(const_cast<UBehaviacBehaviorNode*>(Node)).GetMax();
+
+	for (const TArray<UBehaviacAttachment*>* Attachments : { &Node->Preconditions, &Node->Effectors, &Node->Events })
+	{
+		for (const UBehaviacAttachment* Attachment : *Attachments)
+		{
+			if (Attachment)
+			{
+				OutUsage.NodeBytes += FArchiveCountMem(const_cast<UBehaviacAttachment*>(Attachment)).GetMax();
+			}
+		}
+	}
+
+	for (int32 i = 0; i < Node->GetChildCount(); i++)
+	{
+		AccumulateNodeMemory(Node->GetChild(i), OutUsage);
+	}
+}
+
+void UBehaviacBehaviorTree::GetMemoryUsage(FBehaviacMemoryUsage& OutUsage) const
+{
+	OutUsage.NodeBytes += FArchiveCountMem(const_cast<UBehaviacBehaviorTree*>(this)).GetMax();
+	AccumulateNodeMemory(RootNode, OutUsage);
 }
 
 // ===================================================================
@@ -281,7 +350,9 @@ UBehaviacBehaviorTree* UBehaviacBehaviorTreeLibrary::LoadBehaviorTreeFromFile(UO
 	}
 
 	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+#if WITH_EDITORONLY_DATA
 	Tree->SourceFilePath = FilePath;
+#endif
 	Tree->TreeName = FPaths::GetBaseFilename(FilePath);
 
 	if (Tree->LoadFromXML(FileContent))
@@ -4,6 +4,7 @@
 #include "BehaviorTree/Composites/BehaviacComposites.h"
 #include "BehaviorTree/Decorators/BehaviacDecorators.h"
 #include "BehaviacAgent.h"
+#include "Engine/World.h"
 
 // ===================================================================
 // SELECTOR
@@ -475,6 +476,162 @@ EBehaviacStatus UBehaviacSelectorProbabilityTask::OnUpdate(UBehaviacAgentCompone
 	return EBehaviacStatus::Failure;
 }
 
+// ===================================================================
+// SELECTOR UTILITY
+// ===================================================================
+
+UBehaviacSelectorUtility::UBehaviacSelectorUtility()
+	: RescoreInterval(0.0f), Hysteresis(0.1f)
+{
+}
+
+UBehaviacBehaviorTask* UBehaviacSelectorUtility::CreateTask(UObject* Outer) const
+{
+	return NewObject<UBehaviacSelectorUtilityTask>(Outer);
+}
+
+void UBehaviacSelectorUtility::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
+{
+	Super::LoadFromProperties(Version, InAgentType, Properties);
+
+	for (const FBehaviacProperty& Prop : Properties)
+	{
+		if (Prop.Name == TEXT("RescoreInterval"))
+		{
+			RescoreInterval = FMath::Max(0.0f, FCString::Atof(*Prop.Value));
+		}
+		else if (Prop.Name == TEXT("Hysteresis"))
+		{
+			Hysteresis = FMath::Max(0.0f, FCString::Atof(*Prop.Value));
+		}
+	}
+}
+
+UBehaviacSelectorUtilityTask::UBehaviacSelectorUtilityTask()
+	: LastScoreTime(0.0), bHasScored(false)
+{
+}
+
+void UBehaviacSelectorUtilityTask::Reset(UBehaviacAgentComponent* Agent)
+{
+	Super::Reset(Agent);
+	bHasScored = false;
+}
+
+bool UBehaviacSelectorUtilityTask::OnEnter(UBehaviacAgentComponent* Agent)
+{
+	ActiveChildIndex = INDEX_NONE;
+	bHasScored = false;
+	FailedChildren.Init(false, ChildTasks.Num());
+	return ChildTasks.Num() > 0;
+}
+
+bool UBehaviacSelectorUtilityTask::IsRescoreDue(UBehaviacAgentComponent* Agent) const
+{
+	const UBehaviacSelectorUtility* UtilityNode = Cast<UBehaviacSelectorUtility>(Node);
+	if (!bHasScored || !UtilityNode || UtilityNode->RescoreInterval <= 0.0f)
+	{
+		return true;
+	}
+
+	const UWorld* World = Agent ? Agent->GetWorld() : nullptr;
+	return !World || (World->GetTimeSeconds() - LastScoreTime) >= UtilityNode->RescoreInterval;
+}
+
+void UBehaviacSelectorUtilityTask::ScoreChildren(UBehaviacAgentComponent* Agent)
+{
+	Scores.SetNumUninitialized(ChildTasks.Num());
+
+	for (int32 i = 0; i < ChildTasks.Num(); i++)
+	{
+		const UBehaviacDecoratorUtility* UtilityNode = Node ? Cast<UBehaviacDecoratorUtility>(Node->GetChild(i)) : nullptr;
+		if (!UtilityNode || !Agent)
+		{
+			Scores[i] = 0.0f;
+			continue;
+		}
+
+		// Compensation factor keeps a product of many considerations comparable to a product of few
+		const int32 NumConsiderations = UtilityNode->Considerations.Num();
+		const float Modification = NumConsiderations > 0 ? 1.0f - 1.0f / NumConsiderations : 0.0f;
+
+		float Score = FMath::Max(0.0f, UtilityNode->Weight);
+		for (const FBehaviacConsideration& Consideration : UtilityNode->Considerations)
+		{
+			if (Score <= 0.0f)
+			{
+				break;
+			}
+			const float Raw = Consideration.Evaluate(Agent->GetUtilityInput(FName(*Consideration.InputProperty)));
+			Score *= Raw + (1.0f - Raw) * Modification * Raw;
+		}
+		Scores[i] = Score;
+	}
+
+	const UWorld* World = Agent ? Agent->GetWorld() : nullptr;
+	LastScoreTime = World ? World->GetTimeSeconds() : 0.0;
+	bHasScored = true;
+}
+
+int32 UBehaviacSelectorUtilityTask::PickBestChild() const
+{
+	int32 Best = INDEX_NONE;
+	float BestScore = 0.0f;
+	for (int32 i = 0; i < Scores.Num(); i++)
+	{
+		if (Scores[i] > BestScore && !FailedChildren[i])
+		{
+			Best = i;
+			BestScore = Scores[i];
+		}
+	}
+	return Best;
+}
+
+EBehaviacStatus UBehaviacSelectorUtilityTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+{
+	if (IsRescoreDue(Agent))
+	{
+		ScoreChildren(Agent);
+
+		const int32 Best = PickBestChild();
+		if (Best != INDEX_NONE && Best != ActiveChildIndex)
+		{
+			const UBehaviacSelectorUtility* UtilityNode = Cast<UBehaviacSelectorUtility>(Node);
+			const float Margin = UtilityNode ? UtilityNode->Hysteresis : 0.0f;
+
+			if (!ChildTasks.IsValidIndex(ActiveChildIndex))
+			{
+				ActiveChildIndex = Best;
+			}
+			else if (Scores[Best] > Scores[ActiveChildIndex] + Margin)
+			{
+				BEHAVIAC_VLOG(TEXT("[SelectorUtility] Switching child[%d] (%.3f) → child[%d] (%.3f)"),
+					ActiveChildIndex, Scores[ActiveChildIndex], Best, Scores[Best]);
+				ChildTasks[ActiveChildIndex]->Reset(Agent);
+				ActiveChildIndex = Best;
+				ChildStatus = EBehaviacStatus::Invalid;
+			}
+		}
+	}
+
+	while (ChildTasks.IsValidIndex(ActiveChildIndex))
+	{
+		const EBehaviacStatus Result = ChildTasks[ActiveChildIndex]->Execute(Agent, ChildStatus);
+		if (Result != EBehaviacStatus::Failure)
+		{
+			return Result;
+		}
+
+		// Fall back to the next best child, like a regular selector
+		FailedChildren[ActiveChildIndex] = true;
+		ActiveChildIndex = PickBestChild();
+		ChildStatus = EBehaviacStatus::Invalid;
+	}
+
+	return EBehaviacStatus::Failure;
+}
+
 // ===================================================================
 // SELECTOR STOCHASTIC
 // ===================================================================
@@ -52,11 +52,11 @@ EBehaviacStatus UBehaviacConditionTask::OnUpdate(UBehaviacAgentComponent* Agent,
 	FString RightStr = CondNode->RightOperand;
 
 	// Resolve property references
-	if (LeftStr.StartsWith(TEXT("Self.")))
+	if (UBehaviacAgentComponent::IsPropertyReference(LeftStr))
 	{
 		LeftStr = Agent->GetPropertyValue(LeftStr);
 	}
-	if (RightStr.StartsWith(TEXT("Self.")))
+	if (UBehaviacAgentComponent::IsPropertyReference(RightStr))
 	{
 		RightStr = Agent->GetPropertyValue(RightStr);
 	}
@@ -131,6 +131,13 @@ bool UBehaviacDecoratorLoopTask::OnEnter(UBehaviacAgentComponent* Agent)
 	return true;
 }
 
+void UBehaviacDecoratorLoopTask::OnRebind(UBehaviacAgentComponent* Agent)
+{
+	// Keep the iterations already run, but stop at the reloaded count
+	const UBehaviacDecoratorLoop* LoopNode = Cast<UBehaviacDecoratorLoop>(Node);
+	TargetCount = LoopNode ? LoopNode->LoopCount : -1;
+}
+
 EBehaviacStatus UBehaviacDecoratorLoopTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (!ChildTask)
@@ -553,25 +560,82 @@ void UBehaviacDecoratorIterator::LoadFromProperties(int32 Version, const FString
 		{
 			ArrayProperty = Prop.Value;
 		}
+		else if (Prop.Name == TEXT("Element"))
+		{
+			ElementProperty = Prop.Value;
+		}
 	}
 }
 
 UBehaviacDecoratorIteratorTask::UBehaviacDecoratorIteratorTask()
-	: CurrentIndex(0), ArrayCount(0)
+	: CurrentIndex(0), ArrayCount(0), bNativeCollection(false)
 {
 }
 
 bool UBehaviacDecoratorIteratorTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	CurrentIndex = 0;
-	// Get array count from agent
+	BindCollection(Agent);
+	return ArrayCount > 0;
+}
+
+void UBehaviacDecoratorIteratorTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
+{
+	UnbindElement(Agent);
+	Super::OnExit(Agent, InStatus);
+}
+
+void UBehaviacDecoratorIteratorTask::OnRebind(UBehaviacAgentComponent* Agent)
+{
+	// Only a running iterator holds a slot; an idle one reads the node on its next enter
+	if (!bHasEntered)
+	{
+		return;
+	}
+
+	// Keep the position, but iterate the reloaded collection through the reloaded slot
+	UnbindElement(Agent);
+	BindCollection(Agent);
+}
+
+void UBehaviacDecoratorIteratorTask::BindCollection(UBehaviacAgentComponent* Agent)
+{
+	ArrayCount = 0;
+	bNativeCollection = false;
+
 	const UBehaviacDecoratorIterator* IterNode = Cast<UBehaviacDecoratorIterator>(Node);
-	if (IterNode && Agent)
+	if (!IterNode || !Agent)
 	{
-		FString CountStr = Agent->GetPropertyValue(IterNode->ArrayProperty + TEXT(".Count"));
-		ArrayCount = CountStr.IsNumeric() ? FCString::Atoi(*CountStr) : 0;
+		ArrayProperty.Reset();
+		ElementProperty.Reset();
+		return;
+	}
+	ArrayProperty = IterNode->ArrayProperty;
+	ElementProperty = IterNode->ElementProperty;
+
+	// Native collections bind the element slot in place; no per-element string work
+	if (const FBehaviacCollection* Collection = Agent->FindCollection(ArrayProperty))
+	{
+		bNativeCollection = true;
+		ArrayCount = Collection->Num();
+		if (CurrentIndex < ArrayCount && !ElementProperty.IsEmpty())
+		{
+			Agent->BindCollectionSlot(ElementProperty, ArrayProperty, CurrentIndex);
+		}
+		return;
+	}
+
+	// Legacy: array size published as a "<Name>.Count" string property
+	FString CountStr = Agent->GetPropertyValue(ArrayProperty + TEXT(".Count"));
+	ArrayCount = CountStr.IsNumeric() ? FCString::Atoi(*CountStr) : 0;
+}
+
+void UBehaviacDecoratorIteratorTask::UnbindElement(UBehaviacAgentComponent* Agent)
+{
+	if (bNativeCollection && Agent && !ElementProperty.IsEmpty())
+	{
+		Agent->UnbindCollectionSlot(ElementProperty);
 	}
-	return ArrayCount > 0;
 }
 
 EBehaviacStatus UBehaviacDecoratorIteratorTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
@@ -588,6 +652,16 @@ EBehaviacStatus UBehaviacDecoratorIteratorTask::OnUpdate(UBehaviacAgentComponent
 		return Result;
 	}
 
+	if (bNativeCollection && !ElementProperty.IsEmpty())
+	{
+		// The collection changed under the cursor: stop rather than visit shifted elements
+		if (!Agent->IsCollectionSlotValid(ElementProperty))
+		{
+			return Result;
+		}
+		Agent->BindCollectionSlot(ElementProperty, ArrayProperty, CurrentIndex);
+	}
+
 	ChildTask->Reset(Agent);
 	return EBehaviacStatus::Running;
 }
@@ -662,3 +736,95 @@ EBehaviacStatus UBehaviacDecoratorWeightTask::OnUpdate(UBehaviacAgentComponent*
 	}
 	return EBehaviacStatus::Failure;
 }
+
+// ===================================================================
+// Utility
+// ===================================================================
+
+float FBehaviacConsideration::Evaluate(float RawInput) const
+{
+	const float Range = InputMax - InputMin;
+	const float X = FMath::Clamp(FMath::IsNearlyZero(Range) ? 0.0f : (RawInput - InputMin) / Range, 0.0f, 1.0f);
+
+	float Y = 0.0f;
+	switch (Curve)
+	{
+	case EBehaviacResponseCurve::Linear:
+		Y = Slope * (X - XShift) + YShift;
+		break;
+	case EBehaviacResponseCurve::Polynomial:
+		Y = Slope * FMath::Pow(FMath::Max(X - XShift, 0.0f), Exponent) + YShift;
+		break;
+	case EBehaviacResponseCurve::Logistic:
+		Y = Exponent / (1.0f + FMath::Exp(-Slope * (X - XShift))) + YShift;
+		break;
+	case EBehaviacResponseCurve::Step:
+		Y = X >= XShift ? 1.0f : 0.0f;
+		break;
+	}
+	return FMath::Clamp(Y, 0.0f, 1.0f);
+}
+
+static EBehaviacResponseCurve ParseResponseCurve(const FString& Name)
+{
+	if (Name == TEXT("Polynomial"))	return EBehaviacResponseCurve::Polynomial;
+	if (Name == TEXT("Logistic"))	return EBehaviacResponseCurve::Logistic;
+	if (Name == TEXT("Step"))		return EBehaviacResponseCurve::Step;
+	return EBehaviacResponseCurve::Linear;
+}
+
+UBehaviacDecoratorUtility::UBehaviacDecoratorUtility()
+	: Weight(1.0f)
+{
+}
+
+UBehaviacBehaviorTask* UBehaviacDecoratorUtility::CreateTask(UObject* Outer) const
+{
+	// Pass-through like Weight; the score is read by the parent SelectorUtility
+	return NewObject<UBehaviacDecoratorWeightTask>(Outer);
+}
+
+void UBehaviacDecoratorUtility::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
+{
+	Super::LoadFromProperties(Version, InAgentType, Properties);
+	Weight = 1.0f;
+	Considerations.Reset();
+
+	for (const FBehaviacProperty& Prop : Properties)
+	{
+		if (Prop.Name == TEXT("Weight"))
+		{
+			Weight = FCString::Atof(*Prop.Value);
+		}
+		else if (Prop.Name == TEXT("Considerations"))
+		{
+			TArray<FString> Entries;
+			Prop.Value.ParseIntoArray(Entries, TEXT("|"));
+			for (const FString& Entry : Entries)
+			{
+				TArray<FString> Fields;
+				Entry.ParseIntoArray(Fields, TEXT(","), false);
+				if (Fields.Num() == 0 || Fields[0].TrimStartAndEnd().IsEmpty())
+				{
+					UE_LOG(LogBehaviacDecorator, Warning, TEXT("[Behaviac] Utility: ignoring consideration without input: '%s'"), *Entry);
+					continue;
+				}
+
+				auto FieldOr = [&Fields](int32 Index, float Default)
+				{
+					return Fields.IsValidIndex(Index) && !Fields[Index].IsEmpty() ? FCString::Atof(*Fields[Index]) : Default;
+				};
+
+				FBehaviacConsideration& Consideration = Considerations.AddDefaulted_GetRef();
+				Consideration.InputProperty = Fields[0].TrimStartAndEnd();
+				Consideration.Curve = Fields.IsValidIndex(1) ? ParseResponseCurve(Fields[1].TrimStartAndEnd()) : EBehaviacResponseCurve::Linear;
+				Consideration.InputMin = FieldOr(2, 0.0f);
+				Consideration.InputMax = FieldOr(3, 1.0f);
+				Consideration.Slope = FieldOr(4, 1.0f);
+				Consideration.Exponent = FieldOr(5, 1.0f);
+				Consideration.XShift = FieldOr(6, 0.0f);
+				Consideration.YShift = FieldOr(7, 0.0f);
+			}
+		}
+	}
+}
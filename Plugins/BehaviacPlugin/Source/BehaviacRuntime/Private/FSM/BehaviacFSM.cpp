@@ -36,9 +36,9 @@ bool UBehaviacTransitionCondition::Evaluate(UBehaviacAgentComponent* Agent) cons
 	FString LeftStr = LeftOperand;
 	FString RightStr = RightOperand;
 
-	if (LeftStr.StartsWith(TEXT("Self.")))
+	if (UBehaviacAgentComponent::IsPropertyReference(LeftStr))
 		LeftStr = Agent->GetPropertyValue(LeftStr);
-	if (RightStr.StartsWith(TEXT("Self.")))
+	if (UBehaviacAgentComponent::IsPropertyReference(RightStr))
 		RightStr = Agent->GetPropertyValue(RightStr);
 
 	if (LeftStr.IsNumeric() && RightStr.IsNumeric())
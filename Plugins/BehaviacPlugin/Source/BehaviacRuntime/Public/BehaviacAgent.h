@@ -6,11 +6,13 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "BehaviacTypes.h"
+#include "BehaviacCollection.h"
 #include "BehaviacAgent.generated.h"
 
 class UBehaviacBehaviorTree;
 class UBehaviacBehaviorTreeTask;
 class UBehaviacBehaviorNode;
+class UBehaviacSharedBlackboard;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FBehaviacMethodDelegate, const FString&, MethodName, EBehaviacStatus&, OutResult);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FBehaviacSignalDelegate, const FString&, SignalName);
@@ -24,6 +26,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FBehaviacSignalDelegate, const FStri
  * Features:
  * - Load and execute behavior trees by asset path
  * - Property system (blackboard-like key/value store)
+ * - Shared blackboard scopes (global / team / squad) via property prefixes
+ * - Native actor / vector / float collections with typed iteration slots
  * - Method binding via delegates and Blueprint events
  * - Signal system for WaitForSignal nodes
  * - Multiple behavior tree support (stack)
@@ -48,6 +52,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
 	bool LoadBehaviorTree(UBehaviacBehaviorTree* TreeAsset);
 
+	/**
+	 * Swap to a reloaded definition of the current tree without resetting it.
+	 * Tasks whose node ID, class and child layout are unchanged keep their runtime state;
+	 * other tasks are rebuilt. Falls back to LoadBehaviorTree for a different asset.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
+	bool RebindBehaviorTree(UBehaviacBehaviorTree* TreeAsset);
+
+	/** Whether the running task graph was built from an older definition of its tree */
+	bool NeedsRebind() const;
+
 	/** Load a behavior tree by relative path (for XML/BSON loading) */
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
 	bool LoadBehaviorTreeByPath(const FString& RelativePath);
@@ -68,6 +83,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
 	EBehaviacStatus GetBehaviorTreeStatus() const;
 
+	/** The loaded behavior tree asset, or nullptr */
+	UBehaviacBehaviorTree* GetCurrentTreeAsset() const { return CurrentTreeAsset; }
+
+	/** The runtime task graph of the loaded tree, or nullptr */
+	UBehaviacBehaviorTreeTask* GetCurrentTreeTask() const { return CurrentTreeTask; }
+
+	/** Add this agent's task state, blackboard and bookkeeping usage (node definitions are counted per tree asset) */
+	void GetMemoryUsage(FBehaviacMemoryUsage& OutUsage) const;
+
 	/** Whether automatic ticking is enabled */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Agent")
 	bool bAutoTick;
@@ -114,6 +138,85 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Properties")
 	bool GetBoolProperty(const FString& PropertyName) const;
 
+	/**
+	 * Whether an operand names a blackboard property rather than a literal.
+	 * "Self.X" is private to this agent; "Global.X", "Team.X" and "Squad.X" read the bound shared blackboard.
+	 */
+	static bool IsPropertyReference(const FString& Operand);
+
+	// --- Shared Blackboards ---
+
+	/** Bind a shared blackboard for a scope (Agent scope is ignored) */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Properties")
+	void SetSharedBlackboard(EBehaviacBlackboardScope Scope, UBehaviacSharedBlackboard* Blackboard);
+
+	/** Get the shared blackboard bound for a scope */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Properties")
+	UBehaviacSharedBlackboard* GetSharedBlackboard(EBehaviacBlackboardScope Scope) const;
+
+	// --- Collection Properties ---
+
+	/** Replace an actor array property */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Collections")
+	void SetActorArrayProperty(const FString& PropertyName, const TArray<AActor*>& Values);
+
+	/** Replace a vector array property */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Collections")
+	void SetVectorArrayProperty(const FString& PropertyName, const TArray<FVector>& Values);
+
+	/** Replace a float array property */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Collections")
+	void SetFloatArrayProperty(const FString& PropertyName, const TArray<float>& Values);
+
+	/** Add an actor to a set property, creating the set if needed. Returns false if already present. */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Collections")
+	bool AddActorToSet(const FString& PropertyName, AActor* Actor);
+
+	/** Remove an actor from a set or array property. Returns false if not present. */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Collections")
+	bool RemoveActorFromSet(const FString& PropertyName, AActor* Actor);
+
+	/** Remove a collection property */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Collections")
+	void ClearCollectionProperty(const FString& PropertyName);
+
+	/** Number of elements in a collection property, or 0 if it does not exist */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Collections")
+	int32 GetCollectionNum(const FString& PropertyName) const;
+
+	/** Read a collection by reference. The pointer is valid until the next collection write on this agent. */
+	const FBehaviacCollection* FindCollection(const FString& PropertyName) const;
+
+	/**
+	 * Bind a typed slot to one element of a collection (used by the Iterator decorator).
+	 * Returns false if the collection does not exist or the index is out of range.
+	 */
+	bool BindCollectionSlot(const FString& SlotName, const FString& CollectionName, int32 Index);
+
+	/** Release a typed slot */
+	void UnbindCollectionSlot(const FString& SlotName);
+
+	/** Whether a slot is bound and the collection has not changed since it was bound */
+	bool IsCollectionSlotValid(const FString& SlotName) const;
+
+	/**
+	 * Utility input read by SelectorUtility: a native collection's element count, else the float property.
+	 * Cached by name and shared by every selector on this agent until the blackboard changes.
+	 */
+	float GetUtilityInput(FName InputName);
+
+	/** Actor currently bound to a slot, or nullptr */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Collections")
+	AActor* GetSlotActor(const FString& SlotName) const;
+
+	/** Vector currently bound to a slot, or zero */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Collections")
+	FVector GetSlotVector(const FString& SlotName) const;
+
+	/** Float currently bound to a slot, or zero */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Collections")
+	float GetSlotFloat(const FString& SlotName) const;
+
 	// --- Method System ---
 
 	/** Execute a named method on this agent. Override in Blueprints or bind delegates. */
@@ -186,6 +289,39 @@ protected:
 	UPROPERTY()
 	UBehaviacBehaviorTree* CurrentTreeAsset;
 
+	/** Shared blackboards resolved through the Global./Team./Squad. prefixes */
+	UPROPERTY()
+	UBehaviacSharedBlackboard* GlobalBlackboard;
+
+	UPROPERTY()
+	UBehaviacSharedBlackboard* TeamBlackboard;
+
+	UPROPERTY()
+	UBehaviacSharedBlackboard* SquadBlackboard;
+
+	/** Native collection storage (agent scope only, game thread only) */
+	UPROPERTY()
+	TMap<FString, FBehaviacCollection> Collections;
+
+	/** Typed slots bound to collection elements */
+	TMap<FString, FBehaviacCollectionCursor> CollectionSlots;
+
+	/** Utility inputs read since the last agent-scope write, by input name */
+	TMap<FName, float> UtilityInputs;
+
+	/** Summed shared blackboard versions UtilityInputs were read at */
+	uint32 UtilityInputsSharedVersion;
+
+	/** Drop cached utility inputs; called by every agent-scope property or collection write */
+	void InvalidateUtilityInputs() { UtilityInputs.Reset(); }
+
+	/** Task count and bytes of CurrentTreeTask, measured once when the tree is loaded */
+	int32 CachedNumTasks;
+	int64 CachedTaskBytes;
+
+	/** Measure CurrentTreeTask into CachedNumTasks / CachedTaskBytes */
+	void MeasureTaskGraph();
+
 	/** Registered C++ method handlers */
 	TMap<FString, TFunction<EBehaviacStatus()>> MethodHandlers;
 
@@ -0,0 +1,84 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BehaviacTypes.h"
+#include "BehaviacAgentSubsystem.generated.h"
+
+class UBehaviacAgentComponent;
+class UBehaviacBehaviorTree;
+
+/**
+ * UBehaviacAgentSubsystem: tracks the Behaviac agents that are playing in a world.
+ *
+ * Agents register themselves in BeginPlay and unregister in EndPlay. The subsystem
+ * publishes the world's totals to "stat Behaviac" and backs the Behaviac.MemReport
+ * console command.
+ *
+ * When a tree asset is reloaded, agents running it are queued and rebound a few per
+ * frame (Behaviac.ReloadAgentsPerFrame) so a reload never hitches the game thread.
+ */
+UCLASS()
+class BEHAVIACRUNTIME_API UBehaviacAgentSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterAgent(UBehaviacAgentComponent* Agent);
+	void UnregisterAgent(UBehaviacAgentComponent* Agent);
+
+	/** Registered agents; entries may be stale if an agent was destroyed without EndPlay */
+	const TArray<TWeakObjectPtr<UBehaviacAgentComponent>>& GetAgents() const { return Agents; }
+
+	/** Totals for this world: node definitions of every distinct loaded tree plus every agent's state */
+	FBehaviacMemoryUsage GetWorldMemoryUsage() const;
+
+	/** Write a per-tree and per-agent breakdown to an output device */
+	void DumpMemReport(FOutputDevice& Ar) const;
+
+#if WITH_EDITOR
+	/** Re-read every tree in use in this world from its source file; returns the number reloaded */
+	int32 ReloadTreesFromSource();
+#endif
+
+	/** Rebind up to MaxAgents queued agents to their reloaded trees; returns the number rebound */
+	int32 ProcessPendingRebinds(int32 MaxAgents);
+
+	int32 GetNumPendingRebinds() const { return PendingRebinds.Num() - NextPendingRebind; }
+
+	/** Seconds between "stat Behaviac" refreshes */
+	static constexpr float StatRefreshInterval = 1.0f;
+
+private:
+	/** Distinct tree assets currently loaded by registered agents */
+	void GatherLoadedTrees(TArray<UBehaviacBehaviorTree*>& OutTrees) const;
+
+	/** Replace this world's previous contribution to the stat counters */
+	void PublishStats(const FBehaviacMemoryUsage& Usage, int32 NumTrees);
+
+	/** Queue every agent running the reloaded tree for a rebind */
+	void HandleTreeReloaded(UBehaviacBehaviorTree* Tree);
+
+	TArray<TWeakObjectPtr<UBehaviacAgentComponent>> Agents;
+
+	/** Agents whose tree was reloaded but which still run the old task graph; drained from NextPendingRebind */
+	TArray<TWeakObjectPtr<UBehaviacAgentComponent>> PendingRebinds;
+	int32 NextPendingRebind = 0;
+
+	FDelegateHandle TreeReloadedHandle;
+
+	/** What this world last added to the process-wide stats, so it can be replaced or removed */
+	FBehaviacMemoryUsage PublishedUsage;
+	int32 PublishedAgents = 0;
+	int32 PublishedTrees = 0;
+
+	float TimeUntilStatRefresh = 0.0f;
+};
@@ -0,0 +1,70 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviacCollection.generated.h"
+
+class AActor;
+
+/** Element type stored in a native blackboard collection */
+UENUM(BlueprintType)
+enum class EBehaviacCollectionType : uint8
+{
+	Actor,
+	Vector,
+	Float
+};
+
+/**
+ * A native array (or set) value stored in an agent blackboard.
+ *
+ * Only the array matching Type is used. Sets keep insertion order and reject duplicates.
+ * Version is bumped on every mutation so iteration cursors can detect that
+ * the collection changed underneath them.
+ */
+USTRUCT(BlueprintType)
+struct BEHAVIACRUNTIME_API FBehaviacCollection
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = "Behaviac")
+	EBehaviacCollectionType Type = EBehaviacCollectionType::Actor;
+
+	UPROPERTY(VisibleAnywhere, Category = "Behaviac")
+	bool bIsSet = false;
+
+	UPROPERTY()
+	TArray<TWeakObjectPtr<AActor>> Actors;
+
+	UPROPERTY()
+	TArray<FVector> Vectors;
+
+	UPROPERTY()
+	TArray<float> Floats;
+
+	uint32 Version = 0;
+
+	int32 Num() const
+	{
+		switch (Type)
+		{
+		case EBehaviacCollectionType::Actor:	return Actors.Num();
+		case EBehaviacCollectionType::Vector:	return Vectors.Num();
+		case EBehaviacCollectionType::Float:	return Floats.Num();
+		}
+		return 0;
+	}
+};
+
+/**
+ * A typed slot bound to one element of a collection.
+ * Reads go straight to the collection storage; nothing is copied or formatted.
+ */
+struct FBehaviacCollectionCursor
+{
+	FString CollectionName;
+	int32 Index = INDEX_NONE;
+	uint32 Version = 0;
+};
@@ -0,0 +1,144 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BehaviacTypes.h"
+#include "BehaviacSharedBlackboard.generated.h"
+
+/** One value stored in a shared blackboard, stamped with the board version it was last changed at. */
+struct FBehaviacSharedBlackboardEntry
+{
+	FString Value;
+	uint32 Version = 0;
+};
+
+/** A fact that is recomputed once per interval and published to a shared blackboard. */
+struct FBehaviacSharedBlackboardProducer
+{
+	FString Key;
+	float Interval = 0.0f;
+	float TimeUntilUpdate = 0.0f;
+	TFunction<FString()> Produce;
+};
+
+/**
+ * UBehaviacSharedBlackboard: a key/value store shared by many agents.
+ *
+ * Agents bind one board per shared scope (global, team, squad) and read it
+ * through the "Global.", "Team." and "Squad." property prefixes, so a fact
+ * computed once by a producer is visible to every bound agent.
+ *
+ * Reads are versioned: every write that changes a value bumps the board
+ * version and stamps the entry, so readers can skip work when nothing changed.
+ */
+UCLASS(BlueprintType)
+class BEHAVIACRUNTIME_API UBehaviacSharedBlackboard : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UBehaviacSharedBlackboard();
+
+	/** Set a value. The version is only bumped if the value actually changed. */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|SharedBlackboard")
+	void SetValue(const FString& Key, const FString& Value);
+
+	/** Get a value by copy; empty if the key is not present */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|SharedBlackboard")
+	FString GetValue(const FString& Key) const;
+
+	/** Check if a key exists */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|SharedBlackboard")
+	bool HasValue(const FString& Key) const;
+
+	/** Remove a key */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|SharedBlackboard")
+	void ClearValue(const FString& Key);
+
+	/** Read a value by reference. The pointer is valid until the next write to this board. */
+	const FString* FindValue(const FString& Key) const;
+
+	/** Board-wide version, bumped on every change */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|SharedBlackboard")
+	int32 GetVersion() const { return static_cast<int32>(Version); }
+
+	/** Version at which the given key last changed, or 0 if it does not exist */
+	uint32 GetEntryVersion(const FString& Key) const;
+
+	/** Number of stored entries */
+	int32 GetNumEntries() const { return Entries.Num(); }
+
+	// --- Producers ---
+
+	/**
+	 * Register a producer that recomputes Key every Interval seconds.
+	 * Replaces any existing producer for the same key. The first update runs on the next tick.
+	 */
+	void RegisterProducer(const FString& Key, float Interval, TFunction<FString()> Produce);
+
+	/** Remove the producer for a key (the last published value is kept) */
+	void UnregisterProducer(const FString& Key);
+
+	/** Advance producer timers and publish any values that are due */
+	void TickProducers(float DeltaTime);
+
+	/** Number of registered producers */
+	int32 GetNumProducers() const { return Producers.Num(); }
+
+	/** Accumulate the entries and their memory into OutUsage (blackboard counters only) */
+	void GetMemoryUsage(FBehaviacMemoryUsage& OutUsage) const;
+
+private:
+	TMap<FString, FBehaviacSharedBlackboardEntry> Entries;
+
+	TArray<FBehaviacSharedBlackboardProducer> Producers;
+
+	uint32 Version;
+};
+
+/**
+ * UBehaviacBlackboardSubsystem: owns the shared blackboards of a world and ticks their producers.
+ *
+ * Team boards are keyed by the generic team id, squad boards by name.
+ */
+UCLASS()
+class BEHAVIACRUNTIME_API UBehaviacBlackboardSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** The world-wide blackboard */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|SharedBlackboard")
+	UBehaviacSharedBlackboard* GetGlobalBlackboard();
+
+	/** The blackboard of a team, created on first use */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|SharedBlackboard")
+	UBehaviacSharedBlackboard* GetTeamBlackboard(uint8 TeamId);
+
+	/** The blackboard of a squad, created on first use */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|SharedBlackboard")
+	UBehaviacSharedBlackboard* GetSquadBlackboard(FName SquadName);
+
+	/** Every board created so far, labelled by scope ("Global", "Team.1", "Squad.Top") */
+	void GatherBlackboards(TArray<TPair<FString, const UBehaviacSharedBlackboard*>>& OutBoards) const;
+
+	/** Accumulate the memory of every shared board into OutUsage */
+	void GetMemoryUsage(FBehaviacMemoryUsage& OutUsage) const;
+
+private:
+	UPROPERTY()
+	UBehaviacSharedBlackboard* GlobalBlackboard = nullptr;
+
+	UPROPERTY()
+	TMap<uint8, UBehaviacSharedBlackboard*> TeamBlackboards;
+
+	UPROPERTY()
+	TMap<FName, UBehaviacSharedBlackboard*> SquadBlackboards;
+};
@@ -30,6 +30,54 @@ BEHAVIACRUNTIME_API extern TAutoConsoleVariable<int32> CVarBehaviacVerboseLoggin
 		UE_LOG(LogBehaviac, Log, Format, ##__VA_ARGS__); \
 	}
 
+/**
+ * Stat counters, shown with "stat Behaviac".
+ * Memory and count stats are refreshed about once per second by UBehaviacAgentSubsystem;
+ * use "Behaviac.MemReport" for a per-tree / per-agent breakdown.
+ */
+DECLARE_STATS_GROUP(TEXT("Behaviac"), STATGROUP_Behaviac, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick Behavior Tree"), STAT_BehaviacTickTree, STATGROUP_Behaviac, BEHAVIACRUNTIME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Agents"), STAT_BehaviacAgents, STATGROUP_Behaviac, BEHAVIACRUNTIME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Tree Assets"), STAT_BehaviacTreeAssets, STATGROUP_Behaviac, BEHAVIACRUNTIME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Node Definitions"), STAT_BehaviacNodes, STATGROUP_Behaviac, BEHAVIACRUNTIME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Tasks"), STAT_BehaviacTasks, STATGROUP_Behaviac, BEHAVIACRUNTIME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Blackboard Entries"), STAT_BehaviacBlackboardEntries, STATGROUP_Behaviac, BEHAVIACRUNTIME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Method Handlers"), STAT_BehaviacMethodHandlers, STATGROUP_Behaviac, BEHAVIACRUNTIME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Signals"), STAT_BehaviacPendingSignals, STATGROUP_Behaviac, BEHAVIACRUNTIME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Events"), STAT_BehaviacPendingEvents, STATGROUP_Behaviac, BEHAVIACRUNTIME_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Node Definition Memory"), STAT_BehaviacNodeMemory, STATGROUP_Behaviac, BEHAVIACRUNTIME_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Task State Memory"), STAT_BehaviacTaskMemory, STATGROUP_Behaviac, BEHAVIACRUNTIME_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Blackboard Memory"), STAT_BehaviacBlackboardMemory, STATGROUP_Behaviac, BEHAVIACRUNTIME_API);
+
+/** Memory and bookkeeping counts of a tree asset, an agent, or a whole world. */
+struct FBehaviacMemoryUsage
+{
+	int32 NumNodes = 0;
+	int64 NodeBytes = 0;
+	int32 NumTasks = 0;
+	int64 TaskBytes = 0;
+	int32 BlackboardEntries = 0;
+	int64 BlackboardBytes = 0;
+	int32 MethodHandlers = 0;
+	int32 PendingSignals = 0;
+	int32 PendingEvents = 0;
+
+	FBehaviacMemoryUsage& operator+=(const FBehaviacMemoryUsage& Other)
+	{
+		NumNodes += Other.NumNodes;
+		NodeBytes += Other.NodeBytes;
+		NumTasks += Other.NumTasks;
+		TaskBytes += Other.TaskBytes;
+		BlackboardEntries += Other.BlackboardEntries;
+		BlackboardBytes += Other.BlackboardBytes;
+		MethodHandlers += Other.MethodHandlers;
+		PendingSignals += Other.PendingSignals;
+		PendingEvents += Other.PendingEvents;
+		return *this;
+	}
+};
+
 /** Return values of node execution and valid states for behaviors. */
 UENUM(BlueprintType)
 enum class EBehaviacStatus : uint8
@@ -107,6 +155,20 @@ enum class EBehaviacEffectorPhase : uint8
 	Both,
 };
 
+/** Scope a blackboard property lives in. Shared scopes are resolved through UBehaviacSharedBlackboard. */
+UENUM(BlueprintType)
+enum class EBehaviacBlackboardScope : uint8
+{
+	/** Visible to every agent in the world ("Global.Key") */
+	Global		UMETA(DisplayName = "Global"),
+	/** Visible to every agent on the same team ("Team.Key") */
+	Team		UMETA(DisplayName = "Team"),
+	/** Visible to every agent in the same squad ("Squad.Key") */
+	Squad		UMETA(DisplayName = "Squad"),
+	/** Private to one agent ("Self.Key" or a bare key) */
+	Agent		UMETA(DisplayName = "Agent"),
+};
+
 /** File format for behavior tree data. */
 UENUM(BlueprintType)
 enum class EBehaviacFileFormat : uint8
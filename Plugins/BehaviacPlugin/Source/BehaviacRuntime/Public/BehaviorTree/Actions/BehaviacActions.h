@@ -193,6 +193,7 @@ public:
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+	virtual void OnRebind(UBehaviacAgentComponent* Agent) override;
 
 private:
 	double StartTime;
@@ -228,6 +229,7 @@ public:
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+	virtual void OnRebind(UBehaviacAgentComponent* Agent) override;
 
 private:
 	int32 StartFrame;
@@ -11,6 +11,15 @@
 class UBehaviacBehaviorNode;
 class UBehaviacAgentComponent;
 
+/** Outcome of rebinding a task graph to a reloaded tree. */
+struct FBehaviacRebindResult
+{
+	/** Tasks that kept their runtime state and now point at the new node definitions */
+	int32 NumKept = 0;
+	/** Tasks created fresh because their node was added or changed shape */
+	int32 NumCreated = 0;
+};
+
 /**
  * Base class for behavior task instances (runtime state of a behavior node).
  *
@@ -54,7 +63,28 @@ public:
 	/** Traverse the tree to reset all running/completed tasks */
 	virtual void Traverse(bool bChildFirst, TFunction<bool(UBehaviacBehaviorTask*)> Handler);
 
+	/** Exit every entered task of this subtree with Failure, children first, without applying effectors */
+	void Abort(UBehaviacAgentComponent* Agent);
+
+	// --- Live Reload ---
+
+	/**
+	 * Whether this task's runtime state can carry over to a reloaded node definition:
+	 * same node ID and class, and the same child IDs and classes in the same order.
+	 */
+	bool CanRebind(const UBehaviacBehaviorNode* InNode) const;
+
+	/**
+	 * Point this task at a reloaded node definition, keeping its runtime state.
+	 * Children are rebound pairwise; a child that cannot be rebound is aborted with Agent
+	 * and replaced by a fresh task. Only call this after CanRebind(InNode) returned true.
+	 */
+	virtual void Rebind(UBehaviacBehaviorNode* InNode, UBehaviacAgentComponent* Agent, FBehaviacRebindResult& OutResult);
+
 protected:
+	/** Called by Rebind once Node is the reloaded definition; re-read node settings cached in OnEnter here */
+	virtual void OnRebind(UBehaviacAgentComponent* Agent);
+
 	/** Called when entering this node */
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent);
 
@@ -103,6 +133,7 @@ public:
 	virtual void Init(UBehaviacBehaviorNode* InNode) override;
 	virtual void Reset(UBehaviacAgentComponent* Agent) override;
 	virtual void Traverse(bool bChildFirst, TFunction<bool(UBehaviacBehaviorTask*)> Handler) override;
+	virtual void Rebind(UBehaviacBehaviorNode* InNode, UBehaviacAgentComponent* Agent, FBehaviacRebindResult& OutResult) override;
 
 	/** Get all child tasks */
 	const TArray<UBehaviacBehaviorTask*>& GetChildTasks() const { return ChildTasks; }
@@ -131,6 +162,7 @@ public:
 	virtual void Init(UBehaviacBehaviorNode* InNode) override;
 	virtual void Reset(UBehaviacAgentComponent* Agent) override;
 	virtual void Traverse(bool bChildFirst, TFunction<bool(UBehaviacBehaviorTask*)> Handler) override;
+	virtual void Rebind(UBehaviacBehaviorNode* InNode, UBehaviacAgentComponent* Agent, FBehaviacRebindResult& OutResult) override;
 
 protected:
 	virtual EBehaviacStatus UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
@@ -163,6 +195,13 @@ class BEHAVIACRUNTIME_API UBehaviacBehaviorTreeTask : public UBehaviacSingleChil
 public:
 	/** Override Init to create task from root node itself */
 	virtual void Init(UBehaviacBehaviorNode* InNode) override;
+
+	/**
+	 * Rebind the whole task graph to a reloaded root node. The root task is compared
+	 * against the root node itself; the tree wrapper always keeps its own state.
+	 * Replaced running tasks are exited with Agent; kept tasks re-read their node settings.
+	 */
+	FBehaviacRebindResult RebindTree(UBehaviacBehaviorNode* NewRootNode, UBehaviacAgentComponent* Agent);
 	
 	/** Tick the entire behavior tree */
 	EBehaviacStatus Tick(UBehaviacAgentComponent* Agent);
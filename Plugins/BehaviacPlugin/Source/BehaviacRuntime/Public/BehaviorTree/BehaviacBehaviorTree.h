@@ -10,6 +10,10 @@
 #include "BehaviacBehaviorTree.generated.h"
 
 class UBehaviacBehaviorNode;
+class UBehaviacBehaviorTree;
+
+/** Fired after a tree that already had nodes loads a new definition (reimport or live reload) */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBehaviacTreeReloaded, UBehaviacBehaviorTree*);
 
 /**
  * UBehaviacBehaviorTree: Data asset representing a behavior tree definition.
@@ -33,10 +37,6 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|BehaviorTree")
 	FString TreeName;
 
-	/** Source file path (for imported trees) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|BehaviorTree")
-	FString SourceFilePath;
-
 	/** Version number from the source file */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|BehaviorTree")
 	int32 Version;
@@ -49,10 +49,28 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|BehaviorTree")
 	UBehaviacBehaviorNode* GetRootNode() const { return RootNode; }
 
-	/** Load from XML string */
+	/**
+	 * Load from XML string. If the tree already had a root node, OnTreeReloaded is broadcast;
+	 * running agents keep the old nodes alive until they are rebound.
+	 */
 	bool LoadFromXML(const FString& XMLContent);
 
+#if WITH_EDITOR
+	/** Re-read SourceFilePath and load it. Returns false if the file cannot be read or parsed. */
+	bool ReloadFromSourceFile();
+#endif
+
+	/** Broadcast whenever a loaded tree is replaced by a new definition */
+	static FOnBehaviacTreeReloaded OnTreeReloaded;
+
+	/** Add the node count and node definition bytes (including attachments) of this tree */
+	void GetMemoryUsage(FBehaviacMemoryUsage& OutUsage) const;
+
 #if WITH_EDITORONLY_DATA
+	/** Source file path (for imported trees); cooked builds load the imported nodes only */
+	UPROPERTY(EditAnywhere, Category = "Behaviac|BehaviorTree")
+	FString SourceFilePath;
+
 	/** Description for editor display */
 	UPROPERTY(EditAnywhere, Category = "Behaviac|BehaviorTree")
 	FString Description;
@@ -183,6 +183,70 @@ protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 };
 
+// ===================================================================
+// SELECTOR UTILITY
+// ===================================================================
+
+/**
+ * SelectorUtility: runs the child with the highest utility score.
+ *
+ * Children are scored from their UBehaviacDecoratorUtility considerations; a child
+ * without one scores 0 and is never picked. Raw inputs come from the agent's utility
+ * input cache, so every child and every selector on the agent share one read per input. A running child is only
+ * replaced when another child beats its score by more than Hysteresis. If the
+ * chosen child fails, the next best child runs, like a regular selector.
+ */
+UCLASS(DisplayName = "SelectorUtility")
+class BEHAVIACRUNTIME_API UBehaviacSelectorUtility : public UBehaviacBehaviorNode
+{
+	GENERATED_BODY()
+public:
+	UBehaviacSelectorUtility();
+
+	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
+
+	/** Seconds between re-scoring passes while a child is running (0 = every tick) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Composite")
+	float RescoreInterval;
+
+	/** Score margin a challenger needs over the running child to interrupt it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Composite")
+	float Hysteresis;
+};
+
+UCLASS()
+class BEHAVIACRUNTIME_API UBehaviacSelectorUtilityTask : public UBehaviacCompositeTask
+{
+	GENERATED_BODY()
+public:
+	UBehaviacSelectorUtilityTask();
+
+	virtual void Reset(UBehaviacAgentComponent* Agent) override;
+
+	/** Score of a child from the last scoring pass */
+	float GetChildScore(int32 Index) const { return Scores.IsValidIndex(Index) ? Scores[Index] : 0.0f; }
+
+protected:
+	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
+	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+
+private:
+	bool IsRescoreDue(UBehaviacAgentComponent* Agent) const;
+	void ScoreChildren(UBehaviacAgentComponent* Agent);
+
+	/** Highest scoring child that has not failed this run, or INDEX_NONE */
+	int32 PickBestChild() const;
+
+	TArray<float> Scores;
+
+	/** Children that already failed since the selector was entered */
+	TBitArray<> FailedChildren;
+
+	double LastScoreTime;
+	bool bHasScored;
+};
+
 // ===================================================================
 // SELECTOR STOCHASTIC
 // ===================================================================
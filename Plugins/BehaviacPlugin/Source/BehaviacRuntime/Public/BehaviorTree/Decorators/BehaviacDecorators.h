@@ -143,6 +143,7 @@ public:
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+	virtual void OnRebind(UBehaviacAgentComponent* Agent) override;
 
 private:
 	int32 CurrentCount;
@@ -396,8 +397,13 @@ public:
 	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
+	/** Collection to iterate (native collection, or legacy "<Name>.Count" string property) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Decorator")
 	FString ArrayProperty;
+
+	/** Typed slot bound to the current element of a native collection while the child runs */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Decorator")
+	FString ElementProperty;
 };
 
 UCLASS()
@@ -409,11 +415,24 @@ public:
 
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
+	virtual void OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+	virtual void OnRebind(UBehaviacAgentComponent* Agent) override;
 
 private:
+	/** Read the node's collection into ArrayCount and bind the element slot at CurrentIndex */
+	void BindCollection(UBehaviacAgentComponent* Agent);
+	void UnbindElement(UBehaviacAgentComponent* Agent);
+
 	int32 CurrentIndex;
 	int32 ArrayCount;
+
+	/** True when iterating a native collection through a bound element slot */
+	bool bNativeCollection;
+
+	/** Collection and slot bound at enter, kept so a reload that renames them releases the old slot */
+	FString ArrayProperty;
+	FString ElementProperty;
 };
 
 // ===================================================================
@@ -463,3 +482,81 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorWeightTask : public UBehaviacDecorat
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 };
+
+// ===================================================================
+// DECORATOR: Utility (used with SelectorUtility)
+// ===================================================================
+
+/** Response curve shapes for utility considerations */
+UENUM(BlueprintType)
+enum class EBehaviacResponseCurve : uint8
+{
+	Linear,		// Slope * (x - XShift) + YShift
+	Polynomial,	// Slope * (x - XShift)^Exponent + YShift
+	Logistic,	// Exponent / (1 + e^(-Slope * (x - XShift))) + YShift
+	Step		// 1 when x >= XShift, otherwise 0
+};
+
+/**
+ * One input to a utility score: a blackboard value normalized into [0, 1]
+ * and mapped through a response curve.
+ */
+USTRUCT(BlueprintType)
+struct BEHAVIACRUNTIME_API FBehaviacConsideration
+{
+	GENERATED_BODY()
+
+	/** Float property or native collection (scored by element count) to read */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Utility")
+	FString InputProperty;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Utility")
+	EBehaviacResponseCurve Curve = EBehaviacResponseCurve::Linear;
+
+	/** Input range mapped onto [0, 1] before the curve is applied */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Utility")
+	float InputMin = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Utility")
+	float InputMax = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Utility")
+	float Slope = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Utility")
+	float Exponent = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Utility")
+	float XShift = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Utility")
+	float YShift = 0.0f;
+
+	/** Map a raw input through the normalization and response curve; result is clamped to [0, 1] */
+	float Evaluate(float RawInput) const;
+};
+
+/**
+ * Utility: scores its child for a parent SelectorUtility.
+ * Score = Weight * product of all considerations (with a compensation factor
+ * so children with many considerations are not penalized).
+ *
+ * XML property "Considerations" lists entries separated by '|', each as
+ * "Input,Curve,Min,Max,Slope,Exponent,XShift,YShift".
+ */
+UCLASS(DisplayName = "Utility")
+class BEHAVIACRUNTIME_API UBehaviacDecoratorUtility : public UBehaviacDecorator
+{
+	GENERATED_BODY()
+public:
+	UBehaviacDecoratorUtility();
+
+	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Decorator")
+	float Weight;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Decorator")
+	TArray<FBehaviacConsideration> Considerations;
+};
@@ -160,3 +160,44 @@ bool FBehaviacAgent_MethodHandlerUnknown::RunTest(const FString&)
 		Result, EBehaviacStatus::Invalid);
 	return true;
 }
+
+// ===========================================================================
+// Memory accounting
+// ===========================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacAgent_MemoryUsage,
+	"BehaviacPlugin.Agent.MemoryUsage",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacAgent_MemoryUsage::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = BT_MakeSequence({ BT_MakeNoop(), BT_MakeNoop() });
+
+	FBehaviacMemoryUsage TreeUsage;
+	Tree->GetMemoryUsage(TreeUsage);
+	TestEqual(TEXT("Tree counts every node definition"), TreeUsage.NumNodes, 3);
+	TestTrue(TEXT("Node definitions have a size"), TreeUsage.NodeBytes > 0);
+
+	TestTrue(TEXT("Tree loads"), A->LoadBehaviorTree(Tree));
+	A->SetPropertyValue(TEXT("Target"), TEXT("Hero"));
+	A->SetFloatArrayProperty(TEXT("Ranges"), { 1.0f, 2.0f });
+	A->RegisterMethodHandler(TEXT("Attack"), []() { return EBehaviacStatus::Success; });
+	A->SendSignal(TEXT("Retreat"));
+
+	FBehaviacMemoryUsage AgentUsage;
+	A->GetMemoryUsage(AgentUsage);
+	TestEqual(TEXT("Agent does not count shared node definitions"), AgentUsage.NumNodes, 0);
+	TestTrue(TEXT("Task graph is counted"), AgentUsage.NumTasks >= 3 && AgentUsage.TaskBytes > 0);
+	TestEqual(TEXT("Property and collection entries"), AgentUsage.BlackboardEntries, 2);
+	TestTrue(TEXT("Blackboard has a size"), AgentUsage.BlackboardBytes > 0);
+	TestEqual(TEXT("Handlers"), AgentUsage.MethodHandlers, 1);
+	TestEqual(TEXT("Signals"), AgentUsage.PendingSignals, 1);
+
+	A->StopBehaviorTree();
+	FBehaviacMemoryUsage StoppedUsage;
+	A->GetMemoryUsage(StoppedUsage);
+	TestEqual(TEXT("Stopping releases the task graph from accounting"), StoppedUsage.NumTasks, 0);
+	return true;
+}
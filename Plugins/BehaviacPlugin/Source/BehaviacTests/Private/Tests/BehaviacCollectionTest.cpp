@@ -0,0 +1,137 @@
+// Behaviac UE5 Plugin — Collection Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.Collections
+
+#include "Misc/AutomationTest.h"
+#include "BehaviacTestHelpers.h"
+#include "GameFramework/Actor.h"
+
+/** Iterator over a collection whose child calls the given method once per element. */
+static UBehaviacDecoratorIterator* BT_MakeIterator(const FString& ArrayProperty, const FString& ElementProperty, const FString& MethodName)
+{
+	UBehaviacAction* Body = NewObject<UBehaviacAction>(GetTransientPackage());
+	Body->MethodName = MethodName;
+
+	UBehaviacDecoratorIterator* Iter = BT_WrapDecorator<UBehaviacDecoratorIterator>(Body);
+	Iter->ArrayProperty = ArrayProperty;
+	Iter->ElementProperty = ElementProperty;
+	return Iter;
+}
+
+// ===========================================================================
+// Storage
+// ===========================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacCollections_SetSemantics,
+	"BehaviacPlugin.Collections.SetSemantics",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacCollections_SetSemantics::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	// The CDO stands in for a perceived actor; no world is needed for set bookkeeping
+	AActor* Enemy = GetMutableDefault<AActor>();
+
+	TestTrue(TEXT("First add succeeds"), A->AddActorToSet(TEXT("Self.Enemies"), Enemy));
+	TestFalse(TEXT("Duplicate add is rejected"), A->AddActorToSet(TEXT("Enemies"), Enemy));
+	TestEqual(TEXT("Self. prefix and bare name share storage"), A->GetCollectionNum(TEXT("Enemies")), 1);
+
+	TestTrue(TEXT("Remove succeeds"), A->RemoveActorFromSet(TEXT("Enemies"), Enemy));
+	TestFalse(TEXT("Second remove fails"), A->RemoveActorFromSet(TEXT("Enemies"), Enemy));
+	TestEqual(TEXT("Set is empty"), A->GetCollectionNum(TEXT("Enemies")), 0);
+	TestFalse(TEXT("Collections do not appear as string properties"), A->HasProperty(TEXT("Enemies")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacCollections_SlotInvalidatedByWrite,
+	"BehaviacPlugin.Collections.SlotInvalidatedByWrite",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacCollections_SlotInvalidatedByWrite::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->SetVectorArrayProperty(TEXT("Waypoints"), { FVector(1, 0, 0), FVector(2, 0, 0) });
+
+	TestTrue(TEXT("Bind in range"), A->BindCollectionSlot(TEXT("Waypoint"), TEXT("Waypoints"), 1));
+	TestEqual(TEXT("Slot reads bound element"), A->GetSlotVector(TEXT("Waypoint")), FVector(2, 0, 0));
+	TestFalse(TEXT("Bind out of range fails"), A->BindCollectionSlot(TEXT("Other"), TEXT("Waypoints"), 2));
+
+	A->SetVectorArrayProperty(TEXT("Waypoints"), { FVector(5, 0, 0) });
+	TestFalse(TEXT("Write invalidates the cursor"), A->IsCollectionSlotValid(TEXT("Waypoint")));
+	TestEqual(TEXT("Invalid slot reads zero"), A->GetSlotVector(TEXT("Waypoint")), FVector::ZeroVector);
+	return true;
+}
+
+// ===========================================================================
+// Iterator decorator
+// ===========================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacCollections_IteratorBindsElements,
+	"BehaviacPlugin.Collections.IteratorBindsElements",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacCollections_IteratorBindsElements::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->SetFloatArrayProperty(TEXT("Ranges"), { 1.0f, 2.0f, 3.0f });
+
+	float Sum = 0.0f;
+	A->RegisterMethodHandler(TEXT("Accumulate"), [A, &Sum]() -> EBehaviacStatus
+	{
+		Sum += A->GetSlotFloat(TEXT("Range"));
+		return EBehaviacStatus::Success;
+	});
+
+	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(BT_MakeIterator(TEXT("Self.Ranges"), TEXT("Range"), TEXT("Accumulate")));
+	TestEqual(TEXT("Running until the last element"), BT_TickN(Tree, A, 2), EBehaviacStatus::Running);
+	TestEqual(TEXT("Success after the last element"), BT_TickN(Tree, A, 1), EBehaviacStatus::Success);
+	TestEqual(TEXT("Every element visited once"), Sum, 6.0f);
+	TestFalse(TEXT("Slot released on exit"), A->IsCollectionSlotValid(TEXT("Range")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacCollections_IteratorStopsOnMutation,
+	"BehaviacPlugin.Collections.IteratorStopsOnMutation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacCollections_IteratorStopsOnMutation::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->SetFloatArrayProperty(TEXT("Ranges"), { 1.0f, 2.0f, 3.0f });
+
+	int32 Visits = 0;
+	A->RegisterMethodHandler(TEXT("Mutate"), [A, &Visits]() -> EBehaviacStatus
+	{
+		++Visits;
+		A->SetFloatArrayProperty(TEXT("Ranges"), { 4.0f });
+		return EBehaviacStatus::Success;
+	});
+
+	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(BT_MakeIterator(TEXT("Ranges"), TEXT("Range"), TEXT("Mutate")));
+	TestEqual(TEXT("Iteration ends when the collection changes"), BT_TickN(Tree, A, 1), EBehaviacStatus::Success);
+	TestEqual(TEXT("No stale elements visited"), Visits, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacCollections_IteratorLegacyCount,
+	"BehaviacPlugin.Collections.IteratorLegacyCount",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacCollections_IteratorLegacyCount::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->SetIntProperty(TEXT("Targets.Count"), 2);
+
+	int32 Visits = 0;
+	A->RegisterMethodHandler(TEXT("Visit"), [&Visits]() -> EBehaviacStatus
+	{
+		++Visits;
+		return EBehaviacStatus::Success;
+	});
+
+	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(BT_MakeIterator(TEXT("Targets"), FString(), TEXT("Visit")));
+	TestEqual(TEXT("String count still drives iteration"), BT_TickN(Tree, A, 2), EBehaviacStatus::Success);
+	TestEqual(TEXT("Visited Count times"), Visits, 2);
+	return true;
+}
@@ -5,6 +5,7 @@
 
 #include "Misc/AutomationTest.h"
 #include "BehaviacTestHelpers.h"
+#include "BehaviacSharedBlackboard.h"
 
 // ===========================================================================
 // Helpers local to this file
@@ -407,3 +408,152 @@ bool FBehaviacComposites_SelectorProbability_WeightedSelection::RunTest(const FS
 	TestEqual(TEXT("Weight=1 child always selected (10/10)"), CountB, 10);
 	return true;
 }
+
+// ===========================================================================
+// SELECTOR UTILITY
+// ===========================================================================
+
+/** Utility wrapper scoring a child linearly from one float property in [0, 1]. */
+static UBehaviacDecoratorUtility* MakeUtilityChild(UBehaviacBehaviorNode* Child, const FString& InputProperty)
+{
+	UBehaviacDecoratorUtility* Wrap = NewObject<UBehaviacDecoratorUtility>(GetTransientPackage());
+	FBehaviacConsideration& Consideration = Wrap->Considerations.AddDefaulted_GetRef();
+	Consideration.InputProperty = InputProperty;
+	Wrap->AddChild(Child);
+	return Wrap;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacComposites_Consideration_Curves,
+	"BehaviacPlugin.Composites.SelectorUtility.Curves",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacComposites_Consideration_Curves::RunTest(const FString&)
+{
+	FBehaviacConsideration C;
+	C.InputMin = 0.0f;
+	C.InputMax = 200.0f;
+	TestEqual(TEXT("Linear normalizes the input range"), C.Evaluate(50.0f), 0.25f);
+	TestEqual(TEXT("Input above range is clamped"), C.Evaluate(400.0f), 1.0f);
+
+	C.Slope = -1.0f;
+	C.YShift = 1.0f;
+	TestEqual(TEXT("Inverted linear"), C.Evaluate(50.0f), 0.75f);
+
+	C.Curve = EBehaviacResponseCurve::Step;
+	C.XShift = 0.5f;
+	TestEqual(TEXT("Step below threshold"), C.Evaluate(50.0f), 0.0f);
+	TestEqual(TEXT("Step above threshold"), C.Evaluate(150.0f), 1.0f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacComposites_SelectorUtility_PicksHighest,
+	"BehaviacPlugin.Composites.SelectorUtility.PicksHighest",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacComposites_SelectorUtility_PicksHighest::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->SetFloatProperty(TEXT("Aggression"), 0.2f);
+	A->SetFloatProperty(TEXT("Caution"), 0.9f);
+
+	int32 CountA = 0, CountB = 0;
+	UBehaviacSelectorUtility* SU = NewObject<UBehaviacSelectorUtility>(GetTransientPackage());
+	SU->AddChild(MakeUtilityChild(MakeCountedAction(A, CountA, EBehaviacStatus::Success, TEXT("Attack")), TEXT("Aggression")));
+	SU->AddChild(MakeUtilityChild(MakeCountedAction(A, CountB, EBehaviacStatus::Success, TEXT("Retreat")), TEXT("Caution")));
+	SU->AddChild(BT_MakeNoop()); // no Utility wrapper → scores 0, never picked
+
+	TestEqual(TEXT("SelectorUtility → Success"), BT_ExecOnce(SU, A), EBehaviacStatus::Success);
+	TestEqual(TEXT("Lower score not run"), CountA, 0);
+	TestEqual(TEXT("Highest score run"), CountB, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacComposites_SelectorUtility_Hysteresis,
+	"BehaviacPlugin.Composites.SelectorUtility.Hysteresis",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacComposites_SelectorUtility_Hysteresis::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->SetFloatProperty(TEXT("Push"), 0.6f);
+	A->SetFloatProperty(TEXT("Farm"), 0.5f);
+
+	int32 CountPush = 0, CountFarm = 0;
+	UBehaviacSelectorUtility* SU = NewObject<UBehaviacSelectorUtility>(GetTransientPackage());
+	SU->Hysteresis = 0.1f;
+	SU->AddChild(MakeUtilityChild(MakeCountedAction(A, CountPush, EBehaviacStatus::Running, TEXT("Push")), TEXT("Push")));
+	SU->AddChild(MakeUtilityChild(MakeCountedAction(A, CountFarm, EBehaviacStatus::Running, TEXT("Farm")), TEXT("Farm")));
+
+	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(SU);
+	BT_TickN(Tree, A, 1);
+	TestEqual(TEXT("Best child starts"), CountPush, 1);
+
+	// Challenger is ahead, but not by more than the hysteresis margin
+	A->SetFloatProperty(TEXT("Farm"), 0.65f);
+	BT_TickN(Tree, A, 1);
+	TestEqual(TEXT("Running child kept within margin"), CountPush, 2);
+	TestEqual(TEXT("Challenger not started"), CountFarm, 0);
+
+	A->SetFloatProperty(TEXT("Farm"), 0.9f);
+	BT_TickN(Tree, A, 1);
+	TestEqual(TEXT("Challenger takes over past the margin"), CountFarm, 1);
+	TestEqual(TEXT("Previous child not ticked again"), CountPush, 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacComposites_SelectorUtility_InputCache,
+	"BehaviacPlugin.Composites.SelectorUtility.InputCache",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacComposites_SelectorUtility_InputCache::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	UBehaviacSharedBlackboard* Team = NewObject<UBehaviacSharedBlackboard>(GetTransientPackage());
+	A->SetSharedBlackboard(EBehaviacBlackboardScope::Team, Team);
+
+	A->SetActorArrayProperty(TEXT("Enemies"), { GetMutableDefault<AActor>() });
+	TestEqual(TEXT("Collection input reads its size"), A->GetUtilityInput(TEXT("Enemies")), 1.0f);
+	A->SetActorArrayProperty(TEXT("Enemies"), { GetMutableDefault<AActor>(), GetMutableDefault<AActor>() });
+	TestEqual(TEXT("Collection write refreshes the input"), A->GetUtilityInput(TEXT("Enemies")), 2.0f);
+
+	Team->SetValue(TEXT("Threat"), TEXT("0.25"));
+	TestEqual(TEXT("Shared input is read"), A->GetUtilityInput(TEXT("Team.Threat")), 0.25f);
+	Team->SetValue(TEXT("Threat"), TEXT("0.75"));
+	TestEqual(TEXT("Shared write refreshes the input"), A->GetUtilityInput(TEXT("Team.Threat")), 0.75f);
+
+	// Both selectors share the agent's inputs
+	int32 CountA = 0, CountB = 0;
+	UBehaviacSelectorUtility* SU = NewObject<UBehaviacSelectorUtility>(GetTransientPackage());
+	SU->AddChild(MakeUtilityChild(MakeCountedAction(A, CountA, EBehaviacStatus::Success, TEXT("Hold")), TEXT("Self.Calm")));
+	SU->AddChild(MakeUtilityChild(MakeCountedAction(A, CountB, EBehaviacStatus::Success, TEXT("Defend")), TEXT("Team.Threat")));
+	A->SetFloatProperty(TEXT("Self.Calm"), 0.5f);
+	TestEqual(TEXT("First selector"), BT_ExecOnce(SU, A), EBehaviacStatus::Success);
+	TestEqual(TEXT("Second selector"), BT_ExecOnce(SU, A), EBehaviacStatus::Success);
+	TestEqual(TEXT("Higher shared input wins both times"), CountB, 2);
+
+	Team->SetValue(TEXT("Threat"), TEXT("0.1"));
+	BT_ExecOnce(SU, A);
+	TestEqual(TEXT("Rescored after the shared write"), CountA, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacComposites_SelectorUtility_FallbackOnFailure,
+	"BehaviacPlugin.Composites.SelectorUtility.FallbackOnFailure",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacComposites_SelectorUtility_FallbackOnFailure::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->SetFloatProperty(TEXT("High"), 0.9f);
+	A->SetFloatProperty(TEXT("Low"), 0.3f);
+
+	int32 CountHigh = 0, CountLow = 0;
+	UBehaviacSelectorUtility* SU = NewObject<UBehaviacSelectorUtility>(GetTransientPackage());
+	SU->AddChild(MakeUtilityChild(MakeCountedAction(A, CountLow, EBehaviacStatus::Success, TEXT("LowOp")), TEXT("Low")));
+	SU->AddChild(MakeUtilityChild(MakeCountedAction(A, CountHigh, EBehaviacStatus::Failure, TEXT("HighOp")), TEXT("High")));
+
+	TestEqual(TEXT("Next best child succeeds"), BT_ExecOnce(SU, A), EBehaviacStatus::Success);
+	TestEqual(TEXT("Best child tried first"), CountHigh, 1);
+	TestEqual(TEXT("Fallback ran in the same tick"), CountLow, 1);
+	return true;
+}
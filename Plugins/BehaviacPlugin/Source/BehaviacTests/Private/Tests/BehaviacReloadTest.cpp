@@ -0,0 +1,240 @@
+// Behaviac UE5 Plugin — Live Reload Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.Reload
+
+#include "Misc/AutomationTest.h"
+#include "BehaviacTestHelpers.h"
+
+/** Action with an explicit node ID, as produced by the XML loader. */
+static UBehaviacAction* BT_MakeIdAction(int32 NodeId, const FString& MethodName)
+{
+	UBehaviacAction* Node = NewObject<UBehaviacAction>(GetTransientPackage());
+	Node->NodeId = NodeId;
+	Node->MethodName = MethodName;
+	return Node;
+}
+
+static UBehaviacSequence* BT_MakeIdSequence(int32 NodeId, TArray<UBehaviacBehaviorNode*> Kids)
+{
+	UBehaviacSequence* Seq = BT_MakeSequence(Kids);
+	Seq->NodeId = NodeId;
+	return Seq;
+}
+
+/** Agent whose "Prep" counts calls and succeeds, and whose "Work"/"Work2" stay Running. */
+static UBehaviacAgentComponent* BT_MakeReloadAgent(int32& PrepCalls, int32& Work2Calls)
+{
+	UBehaviacAgentComponent* Agent = BT_MakeAgent();
+	Agent->RegisterMethodHandler(TEXT("Prep"), [&PrepCalls]() -> EBehaviacStatus
+	{
+		++PrepCalls;
+		return EBehaviacStatus::Success;
+	});
+	Agent->RegisterMethodHandler(TEXT("Work"), []() { return EBehaviacStatus::Running; });
+	Agent->RegisterMethodHandler(TEXT("Work2"), [&Work2Calls]() -> EBehaviacStatus
+	{
+		++Work2Calls;
+		return EBehaviacStatus::Running;
+	});
+	return Agent;
+}
+
+// ===========================================================================
+// Rebinding
+// ===========================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacReload_KeepsRunningState,
+	"BehaviacPlugin.Reload.KeepsRunningState",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacReload_KeepsRunningState::RunTest(const FString&)
+{
+	int32 PrepCalls = 0;
+	int32 Work2Calls = 0;
+	UBehaviacAgentComponent* A = BT_MakeReloadAgent(PrepCalls, Work2Calls);
+
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = BT_MakeIdSequence(1, { BT_MakeIdAction(2, TEXT("Prep")), BT_MakeIdAction(3, TEXT("Work")) });
+	TestTrue(TEXT("Tree loads"), A->LoadBehaviorTree(Tree));
+	TestEqual(TEXT("Sequence parks on Work"), A->GetCurrentTreeTask()->Tick(A), EBehaviacStatus::Running);
+	TestEqual(TEXT("Prep ran once"), PrepCalls, 1);
+
+	// Same layout, edited parameter on the running leaf
+	Tree->RootNode = BT_MakeIdSequence(1, { BT_MakeIdAction(2, TEXT("Prep")), BT_MakeIdAction(3, TEXT("Work2")) });
+	TestTrue(TEXT("Agent notices the new definition"), A->NeedsRebind());
+
+	UBehaviacBehaviorTreeTask* TaskBefore = A->GetCurrentTreeTask();
+	const FBehaviacRebindResult Result = A->GetCurrentTreeTask()->RebindTree(Tree->RootNode, A);
+	TestEqual(TEXT("Every task kept"), Result.NumCreated, 0);
+	TestEqual(TEXT("Tree task itself is not replaced"), A->GetCurrentTreeTask(), TaskBefore);
+	TestFalse(TEXT("Agent is up to date"), A->NeedsRebind());
+
+	TestEqual(TEXT("Still running"), A->GetCurrentTreeTask()->Tick(A), EBehaviacStatus::Running);
+	TestEqual(TEXT("Sequence resumed on the running child"), PrepCalls, 1);
+	TestEqual(TEXT("Edited method is used"), Work2Calls, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacReload_ChangedLayoutRestarts,
+	"BehaviacPlugin.Reload.ChangedLayoutRestarts",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacReload_ChangedLayoutRestarts::RunTest(const FString&)
+{
+	int32 PrepCalls = 0;
+	int32 Work2Calls = 0;
+	UBehaviacAgentComponent* A = BT_MakeReloadAgent(PrepCalls, Work2Calls);
+
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = BT_MakeIdSequence(1, { BT_MakeIdAction(2, TEXT("Prep")), BT_MakeIdAction(3, TEXT("Work")) });
+	A->LoadBehaviorTree(Tree);
+	A->GetCurrentTreeTask()->Tick(A);
+
+	// A child was inserted, so the sequence's progress no longer maps onto the new layout
+	Tree->RootNode = BT_MakeIdSequence(1, { BT_MakeIdAction(2, TEXT("Prep")), BT_MakeIdAction(4, TEXT("Prep")), BT_MakeIdAction(3, TEXT("Work2")) });
+	const FBehaviacRebindResult Result = A->GetCurrentTreeTask()->RebindTree(Tree->RootNode, A);
+	TestEqual(TEXT("Whole sequence rebuilt"), Result.NumCreated, 4);
+
+	TestEqual(TEXT("Rebuilt tree runs"), A->GetCurrentTreeTask()->Tick(A), EBehaviacStatus::Running);
+	TestEqual(TEXT("Sequence restarted from the first child"), PrepCalls, 3);
+	TestEqual(TEXT("New layout reached the work leaf"), Work2Calls, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacReload_ReplacedTaskExits,
+	"BehaviacPlugin.Reload.ReplacedTaskExits",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacReload_ReplacedTaskExits::RunTest(const FString&)
+{
+	int32 PrepCalls = 0;
+	int32 Work2Calls = 0;
+	UBehaviacAgentComponent* A = BT_MakeReloadAgent(PrepCalls, Work2Calls);
+	A->SetFloatArrayProperty(TEXT("Ranges"), { 1.0f, 2.0f });
+
+	UBehaviacAction* Body = BT_MakeIdAction(3, TEXT("Work"));
+	UBehaviacDecoratorIterator* Iter = BT_WrapDecorator<UBehaviacDecoratorIterator>(Body);
+	Iter->NodeId = 2;
+	Iter->ArrayProperty = TEXT("Ranges");
+	Iter->ElementProperty = TEXT("Range");
+
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = BT_MakeIdSequence(1, { Iter });
+	A->LoadBehaviorTree(Tree);
+	TestEqual(TEXT("Iterator parks on its body"), A->GetCurrentTreeTask()->Tick(A), EBehaviacStatus::Running);
+	TestTrue(TEXT("Slot bound while iterating"), A->IsCollectionSlotValid(TEXT("Range")));
+
+	// The running iterator is swapped for an action, so its task is dropped mid-iteration
+	Tree->RootNode = BT_MakeIdSequence(1, { BT_MakeIdAction(2, TEXT("Prep")) });
+	A->GetCurrentTreeTask()->RebindTree(Tree->RootNode, A);
+	TestFalse(TEXT("Replaced iterator released its slot"), A->IsCollectionSlotValid(TEXT("Range")));
+	TestEqual(TEXT("Rebuilt tree runs"), A->GetCurrentTreeTask()->Tick(A), EBehaviacStatus::Success);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacReload_KeptTaskReadsNewConfig,
+	"BehaviacPlugin.Reload.KeptTaskReadsNewConfig",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacReload_KeptTaskReadsNewConfig::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+
+	UBehaviacWait* LongWait = NewObject<UBehaviacWait>(GetTransientPackage());
+	LongWait->NodeId = 2;
+	LongWait->Duration = 1000.0f;
+
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = BT_MakeIdSequence(1, { LongWait });
+	A->LoadBehaviorTree(Tree);
+	TestEqual(TEXT("Long wait is running"), A->GetCurrentTreeTask()->Tick(A), EBehaviacStatus::Running);
+
+	UBehaviacWait* NoWait = NewObject<UBehaviacWait>(GetTransientPackage());
+	NoWait->NodeId = 2;
+	NoWait->Duration = 0.0f;
+	Tree->RootNode = BT_MakeIdSequence(1, { NoWait });
+
+	const FBehaviacRebindResult Result = A->GetCurrentTreeTask()->RebindTree(Tree->RootNode, A);
+	TestEqual(TEXT("Wait task kept"), Result.NumCreated, 0);
+	TestEqual(TEXT("Kept wait uses the edited duration"), A->GetCurrentTreeTask()->Tick(A), EBehaviacStatus::Success);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacReload_KeptIteratorReadsNewCollection,
+	"BehaviacPlugin.Reload.KeptIteratorReadsNewCollection",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacReload_KeptIteratorReadsNewCollection::RunTest(const FString&)
+{
+	int32 PrepCalls = 0;
+	int32 Work2Calls = 0;
+	UBehaviacAgentComponent* A = BT_MakeReloadAgent(PrepCalls, Work2Calls);
+	A->SetFloatArrayProperty(TEXT("Ranges"), { 1.0f, 2.0f });
+	A->SetFloatArrayProperty(TEXT("Delays"), { 5.0f, 6.0f, 7.0f });
+
+	auto MakeIterator = [](const TCHAR* ArrayProperty, const TCHAR* ElementProperty)
+	{
+		UBehaviacDecoratorIterator* Iter = BT_WrapDecorator<UBehaviacDecoratorIterator>(BT_MakeIdAction(3, TEXT("Work")));
+		Iter->NodeId = 2;
+		Iter->ArrayProperty = ArrayProperty;
+		Iter->ElementProperty = ElementProperty;
+		return Iter;
+	};
+
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = BT_MakeIdSequence(1, { MakeIterator(TEXT("Ranges"), TEXT("Range")) });
+	A->LoadBehaviorTree(Tree);
+	TestEqual(TEXT("Iterator parks on its body"), A->GetCurrentTreeTask()->Tick(A), EBehaviacStatus::Running);
+
+	Tree->RootNode = BT_MakeIdSequence(1, { MakeIterator(TEXT("Delays"), TEXT("Delay")) });
+	const FBehaviacRebindResult Result = A->GetCurrentTreeTask()->RebindTree(Tree->RootNode, A);
+	TestEqual(TEXT("Iterator task kept"), Result.NumCreated, 0);
+	TestFalse(TEXT("Old slot released"), A->IsCollectionSlotValid(TEXT("Range")));
+	TestTrue(TEXT("New slot bound"), A->IsCollectionSlotValid(TEXT("Delay")));
+	TestEqual(TEXT("New slot reads the new collection at the kept position"), A->GetSlotFloat(TEXT("Delay")), 5.0f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacReload_NodesWithoutIdRebuild,
+	"BehaviacPlugin.Reload.NodesWithoutIdRebuild",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacReload_NodesWithoutIdRebuild::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = BT_MakeSequence({ BT_MakeNoop() });
+	A->LoadBehaviorTree(Tree);
+
+	Tree->RootNode = BT_MakeSequence({ BT_MakeNoop() });
+	TestTrue(TEXT("Rebind succeeds"), A->RebindBehaviorTree(Tree));
+	TestFalse(TEXT("Agent is up to date"), A->NeedsRebind());
+	TestEqual(TEXT("Rebuilt tree runs"), A->GetCurrentTreeTask()->Tick(A), EBehaviacStatus::Success);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacReload_BadXMLKeepsTree,
+	"BehaviacPlugin.Reload.BadXMLKeepsTree",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacReload_BadXMLKeepsTree::RunTest(const FString&)
+{
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	UBehaviacBehaviorNode* Root = BT_MakeSequence({ BT_MakeNoop() });
+	Tree->RootNode = Root;
+
+	int32 Broadcasts = 0;
+	const FDelegateHandle Handle = UBehaviacBehaviorTree::OnTreeReloaded.AddLambda([&Broadcasts](UBehaviacBehaviorTree*)
+	{
+		++Broadcasts;
+	});
+
+	AddExpectedError(TEXT("No <node> element found in XML"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Reload without nodes fails"), Tree->LoadFromXML(TEXT("<behavior name=\"Broken\"></behavior>")));
+	UBehaviacBehaviorTree::OnTreeReloaded.Remove(Handle);
+
+	TestEqual(TEXT("Previous root is kept"), Tree->GetRootNode(), Root);
+	TestEqual(TEXT("Failed reload is not broadcast"), Broadcasts, 0);
+	return true;
+}
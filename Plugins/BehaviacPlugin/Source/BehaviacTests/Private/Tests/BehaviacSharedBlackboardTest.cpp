@@ -0,0 +1,154 @@
+// Behaviac UE5 Plugin — Shared Blackboard Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.SharedBlackboard
+
+#include "Misc/AutomationTest.h"
+#include "BehaviacTestHelpers.h"
+#include "BehaviacSharedBlackboard.h"
+
+static UBehaviacSharedBlackboard* BT_MakeSharedBlackboard()
+{
+	return NewObject<UBehaviacSharedBlackboard>(GetTransientPackage());
+}
+
+// ===========================================================================
+// Scope resolution
+// ===========================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacSharedBlackboard_TeamReadAcrossAgents,
+	"BehaviacPlugin.SharedBlackboard.TeamReadAcrossAgents",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacSharedBlackboard_TeamReadAcrossAgents::RunTest(const FString&)
+{
+	UBehaviacSharedBlackboard* Team = BT_MakeSharedBlackboard();
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	UBehaviacAgentComponent* B = BT_MakeAgent();
+	A->SetSharedBlackboard(EBehaviacBlackboardScope::Team, Team);
+	B->SetSharedBlackboard(EBehaviacBlackboardScope::Team, Team);
+
+	A->SetPropertyValue(TEXT("Team.LaneFront"), TEXT("1200"));
+	TestEqual(TEXT("B sees value written by A"), B->GetPropertyValue(TEXT("Team.LaneFront")), TEXT("1200"));
+	TestTrue(TEXT("HasProperty resolves shared scope"), B->HasProperty(TEXT("Team.LaneFront")));
+	TestFalse(TEXT("Shared key does not leak into agent scope"), B->HasProperty(TEXT("LaneFront")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacSharedBlackboard_UnboundScope,
+	"BehaviacPlugin.SharedBlackboard.UnboundScope",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacSharedBlackboard_UnboundScope::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->SetPropertyValue(TEXT("Squad.Leader"), TEXT("Bob"));
+	TestFalse(TEXT("Write to unbound scope is dropped"), A->HasProperty(TEXT("Squad.Leader")));
+	TestEqual(TEXT("Read from unbound scope is empty"), A->GetPropertyValue(TEXT("Squad.Leader")), FString());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacSharedBlackboard_ConditionReadsTeam,
+	"BehaviacPlugin.SharedBlackboard.ConditionReadsTeam",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacSharedBlackboard_ConditionReadsTeam::RunTest(const FString&)
+{
+	UBehaviacSharedBlackboard* Team = BT_MakeSharedBlackboard();
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->SetSharedBlackboard(EBehaviacBlackboardScope::Team, Team);
+	Team->SetValue(TEXT("CoreContested"), TEXT("true"));
+
+	UBehaviacCondition* Cond = BT_MakeCondition(TEXT("Team.CoreContested"), EBehaviacOperatorType::Equal, TEXT("true"));
+	TestEqual(TEXT("Condition resolves Team. operand"), BT_ExecOnce(Cond, A), EBehaviacStatus::Success);
+
+	Team->SetValue(TEXT("CoreContested"), TEXT("false"));
+	TestEqual(TEXT("Condition sees updated team value"), BT_ExecOnce(Cond, A), EBehaviacStatus::Failure);
+	return true;
+}
+
+// ===========================================================================
+// Versioning
+// ===========================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacSharedBlackboard_VersionOnChangeOnly,
+	"BehaviacPlugin.SharedBlackboard.VersionOnChangeOnly",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacSharedBlackboard_VersionOnChangeOnly::RunTest(const FString&)
+{
+	UBehaviacSharedBlackboard* Board = BT_MakeSharedBlackboard();
+	Board->SetValue(TEXT("Goal"), TEXT("A"));
+	const int32 V1 = Board->GetVersion();
+	const uint32 E1 = Board->GetEntryVersion(TEXT("Goal"));
+
+	Board->SetValue(TEXT("Goal"), TEXT("A"));
+	TestEqual(TEXT("Same value does not bump version"), Board->GetVersion(), V1);
+	TestEqual(TEXT("Same value keeps entry version"), Board->GetEntryVersion(TEXT("Goal")), E1);
+
+	Board->SetValue(TEXT("Goal"), TEXT("B"));
+	TestTrue(TEXT("Changed value bumps version"), Board->GetVersion() > V1);
+	TestTrue(TEXT("Changed value bumps entry version"), Board->GetEntryVersion(TEXT("Goal")) > E1);
+	TestEqual(TEXT("Missing key has version 0"), Board->GetEntryVersion(TEXT("Missing")), 0u);
+	return true;
+}
+
+// ===========================================================================
+// Producers
+// ===========================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacSharedBlackboard_ProducerInterval,
+	"BehaviacPlugin.SharedBlackboard.ProducerInterval",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacSharedBlackboard_ProducerInterval::RunTest(const FString&)
+{
+	UBehaviacSharedBlackboard* Board = BT_MakeSharedBlackboard();
+	int32 Calls = 0;
+	Board->RegisterProducer(TEXT("NearestHero"), 0.5f, [&Calls]()
+	{
+		return FString::FromInt(++Calls);
+	});
+
+	Board->TickProducers(0.1f);
+	TestEqual(TEXT("First tick publishes immediately"), Calls, 1);
+	TestEqual(TEXT("Value published"), Board->GetValue(TEXT("NearestHero")), TEXT("1"));
+
+	Board->TickProducers(0.1f);
+	Board->TickProducers(0.1f);
+	TestEqual(TEXT("No recompute inside the interval"), Calls, 1);
+
+	Board->TickProducers(0.4f);
+	TestEqual(TEXT("Recompute once the interval elapsed"), Calls, 2);
+
+	Board->UnregisterProducer(TEXT("NearestHero"));
+	Board->TickProducers(1.0f);
+	TestEqual(TEXT("Unregistered producer no longer runs"), Calls, 2);
+	TestEqual(TEXT("Last value is kept"), Board->GetValue(TEXT("NearestHero")), TEXT("2"));
+	return true;
+}
+
+// ===========================================================================
+// Memory
+// ===========================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacSharedBlackboard_MemoryUsage,
+	"BehaviacPlugin.SharedBlackboard.MemoryUsage",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacSharedBlackboard_MemoryUsage::RunTest(const FString&)
+{
+	UBehaviacSharedBlackboard* Board = BT_MakeSharedBlackboard();
+	FBehaviacMemoryUsage EmptyUsage;
+	Board->GetMemoryUsage(EmptyUsage);
+	TestEqual(TEXT("Empty board has no entries"), EmptyUsage.BlackboardEntries, 0);
+
+	Board->SetValue(TEXT("LaneFront"), TEXT("1200"));
+	Board->SetValue(TEXT("GoalLocation"), TEXT("X=0 Y=0 Z=0"));
+	FBehaviacMemoryUsage Usage;
+	Board->GetMemoryUsage(Usage);
+	TestEqual(TEXT("Entries counted"), Usage.BlackboardEntries, 2);
+	TestTrue(TEXT("Entry memory counted"), Usage.BlackboardBytes > EmptyUsage.BlackboardBytes);
+	TestEqual(TEXT("Only blackboard counters touched"), Usage.NumTasks, 0);
+	return true;
+}
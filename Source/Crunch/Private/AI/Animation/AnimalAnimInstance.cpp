@@ -22,12 +22,13 @@ void UAnimalAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 
 	if (OwnerCharacter)
 	{
-		FVector Velocity = OwnerCharacter->GetVelocity();
-		Speed = Velocity.Length();
+		GatheredVelocity = OwnerCharacter->GetVelocity();
 	}
 }
 
 void UAnimalAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
 {
 	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+	Speed = GatheredVelocity.Length();
 }
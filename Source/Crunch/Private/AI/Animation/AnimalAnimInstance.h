@@ -37,4 +37,7 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Animation")
 	float Speed;
 
+	// Gathered on the game thread, turned into Speed on the worker thread
+	FVector GatheredVelocity = FVector::ZeroVector;
+
 };
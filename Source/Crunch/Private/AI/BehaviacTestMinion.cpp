@@ -4,14 +4,19 @@
 #include "AIController.h"
 #include "GenericTeamAgentInterface.h"
 #include "BrainComponent.h"
-#include "Perception/AIPerceptionComponent.h"
 #include "Navigation/PathFollowingComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
+#include "AI/CBlackboardSyncComponent.h"
+#include "AI/MinionBarrack.h"
+#include "AI/CFlowFieldSubsystem.h"
+#include "AI/CPathRequestSubsystem.h"
+#include "Framework/CSpatialIndexSubsystem.h"
 #include "GAS/CGameplayAbilityTypes.h"
-#include "Kismet/GameplayStatics.h"
 #include "BehaviacAgent.h"
+#include "BehaviacSharedBlackboard.h"
+#include "UObject/SoftObjectPath.h"
 #include "BehaviorTree/BehaviacBehaviorTree.h"
 #include "BehaviacTypes.h"
 
@@ -24,6 +29,9 @@ ABehaviacTestMinion::ABehaviacTestMinion()
 	// Manually tick from our own Tick() for ordering control
 	BehaviacAgent->bAutoTick = false;
 
+	// Pushes GAS / perception / movement changes into the agent's blackboard
+	BlackboardSync = CreateDefaultSubobject<UCBlackboardSyncComponent>(TEXT("BlackboardSync"));
+
 	// Defaults
 	DetectionRadius     = 1000.0f;
 	WalkSpeed           = 200.0f;
@@ -38,8 +46,6 @@ ABehaviacTestMinion::ABehaviacTestMinion()
 	CurrentPatrolIndex  = 0;
 	TickCounter         = 0;
 	DebugTimer          = 0.0f;
-	PropertyUpdateInterval   = 0.2f;
-	LastPropertyUpdateTime   = 0.0f;
 }
 
 void ABehaviacTestMinion::BeginPlay()
@@ -103,15 +109,17 @@ void ABehaviacTestMinion::BeginPlay()
 	BehaviacAgent->RegisterMethodHandler(TEXT("ReturnToPost"),      [this]() { return ReturnToPost(); });
 
 	// ── Seed initial blackboard properties ─────────────────────────────
-	BehaviacAgent->SetIntProperty  (TEXT("Health"),           100);
-	BehaviacAgent->SetBoolProperty (TEXT("HasTarget"),        false);
-	BehaviacAgent->SetFloatProperty(TEXT("DistanceToTarget"), 999999.0f);
-	BehaviacAgent->SetBoolProperty (TEXT("IsMoving"),         false);
 	BehaviacAgent->SetFloatProperty(TEXT("DetectionRadius"),  DetectionRadius);
 	BehaviacAgent->SetFloatProperty(TEXT("WalkSpeed"),        WalkSpeed);
 	BehaviacAgent->SetFloatProperty(TEXT("RunSpeed"),         RunSpeed);
 	BehaviacAgent->SetPropertyValue(TEXT("AIState"),          TEXT("Patrol"));
 
+	// ── Bind shared blackboards (Global./Team./Squad. facts computed once per team or lane) ──
+	BindSharedBlackboards();
+
+	// ── Push-based keys (Health, IsDead/IsStunned/IsAiming, HasTarget, DistanceToTarget, IsMoving) ──
+	BlackboardSync->Bind(BehaviacAgent);
+
 	// ── Load behavior tree ─────────────────────────────────────────────
 	bool bLoaded = false;
 	if (BehaviorTree)
@@ -143,14 +151,6 @@ void ABehaviacTestMinion::Tick(float DeltaTime)
 		return;
 	}
 
-	// Periodic blackboard sync
-	LastPropertyUpdateTime += DeltaTime;
-	if (LastPropertyUpdateTime >= PropertyUpdateInterval)
-	{
-		UpdateBehaviacProperties();
-		LastPropertyUpdateTime = 0.0f;
-	}
-
 	// Tick behavior tree
 	TickCounter++;
 	EBehaviacStatus Status = BehaviacAgent->TickBehaviorTree();
@@ -196,43 +196,115 @@ void ABehaviacTestMinion::SetGoal(AActor* Goal)
 	Super::SetGoal(Goal);
 }
 
+void ABehaviacTestMinion::SetGenericTeamId(const FGenericTeamId& NewTeamId)
+{
+	Super::SetGenericTeamId(NewTeamId);
+
+	// Before BeginPlay the board is bound with the final team anyway
+	if (HasActorBegunPlay())
+	{
+		BindSharedBlackboards();
+	}
+}
+
+void ABehaviacTestMinion::BindSharedBlackboards()
+{
+	if (!bUseBehaviacAI || !BehaviacAgent)
+	{
+		return;
+	}
+
+	if (UBehaviacBlackboardSubsystem* Blackboards = GetWorld()->GetSubsystem<UBehaviacBlackboardSubsystem>())
+	{
+		BehaviacAgent->SetSharedBlackboard(EBehaviacBlackboardScope::Global, Blackboards->GetGlobalBlackboard());
+		BehaviacAgent->SetSharedBlackboard(EBehaviacBlackboardScope::Team, Blackboards->GetTeamBlackboard(GetGenericTeamId().GetId()));
+
+		// Barracks spawn their minions with themselves as owner
+		if (const AMinionBarrack* Barrack = Cast<AMinionBarrack>(GetOwner()))
+		{
+			LaneBlackboard = Blackboards->GetSquadBlackboard(Barrack->GetLaneName());
+			BehaviacAgent->SetSharedBlackboard(EBehaviacBlackboardScope::Squad, LaneBlackboard);
+		}
+	}
+}
+
+// ============================================================
+// Team facts
+// ============================================================
+
+APawn* ABehaviacTestMinion::GetLaneEnemyHero() const
+{
+	if (!LaneBlackboard)
+	{
+		return nullptr;
+	}
+
+	// Resolve the published path only when the fact changes, not on every read
+	static const FString NearestEnemyHeroKey = TEXT("NearestEnemyHero");
+	const uint32 FactVersion = LaneBlackboard->GetEntryVersion(NearestEnemyHeroKey);
+	if (FactVersion != LaneEnemyHeroVersion)
+	{
+		LaneEnemyHeroVersion = FactVersion;
+		const FString* HeroPath = LaneBlackboard->FindValue(NearestEnemyHeroKey);
+		LaneEnemyHero = HeroPath && !HeroPath->IsEmpty() ? Cast<APawn>(FSoftObjectPath(*HeroPath).ResolveObject()) : nullptr;
+	}
+
+	return LaneEnemyHero.Get();
+}
+
+float ABehaviacTestMinion::GetLaneMarchSpeed() const
+{
+	if (BehaviacAgent->GetBoolProperty(TEXT("Team.CoreContested")))
+	{
+		return RunSpeed;
+	}
+
+	FVector LaneFront;
+	if (LaneFront.InitFromString(BehaviacAgent->GetPropertyValue(TEXT("Squad.LaneFront")))
+		&& FVector::DistSquared(GetActorLocation(), LaneFront) > FMath::Square(GuardRadius))
+	{
+		return RunSpeed;
+	}
+
+	return WalkSpeed;
+}
+
 // ============================================================
 // Target detection
 // ============================================================
 
+void ABehaviacTestMinion::SetCurrentTarget(AActor* NewTarget)
+{
+	CurrentTarget = NewTarget;
+	BlackboardSync->SetTarget(NewTarget);
+}
+
 bool ABehaviacTestMinion::FindTargetViaPerception()
 {
-	// Use AIPerception's hostile-only list first — mirrors ACAIController which
-	// configures SightConfig with bDetectEnemies=true / bDetectFriendlies=false.
-	if (AAIController* AIC = GetController<AAIController>())
+	// Use the batched sight's hostile-only list first — ACAIController registers
+	// every controller with UCPerceptionSubsystem, which only senses enemies, and
+	// BlackboardSync keeps the list as perception pushes it.
+	for (const TWeakObjectPtr<AActor>& Hostile : BlackboardSync->GetPerceivedEnemies())
 	{
-		if (UAIPerceptionComponent* Perc = AIC->GetAIPerceptionComponent())
+		if (Hostile.IsValid())
 		{
-			TArray<AActor*> HostileActors;
-			Perc->GetPerceivedHostileActors(HostileActors);
-			if (HostileActors.Num() > 0)
-			{
-				CurrentTarget = HostileActors[0];
-				return true;
-			}
+			SetCurrentTarget(Hostile.Get());
+			return true;
 		}
 	}
 
-	// Fallback: manual radius scan, but only accept actors that are
-	// ETeamAttitude::Hostile toward us (same logic as the rest of the codebase).
-	if (APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0))
+	// Fallback: nearest hostile pawn of any kind (heroes and minions alike)
+	// from the team-partitioned spatial index.
+	if (const UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this))
 	{
-		if (FVector::Dist(GetActorLocation(), Player->GetActorLocation()) <= DetectionRadius)
+		if (APawn* Hostile = SpatialIndex->FindNearest(GetActorLocation(), DetectionRadius, FCSpatialQueryFilter::Hostile(this)))
 		{
-			if (GetTeamAttitudeTowards(*Player) == ETeamAttitude::Hostile)
-			{
-				CurrentTarget = Player;
-				return true;
-			}
+			SetCurrentTarget(Hostile);
+			return true;
 		}
 	}
 
-	CurrentTarget = nullptr;
+	SetCurrentTarget(nullptr);
 	return false;
 }
 
@@ -243,10 +315,6 @@ bool ABehaviacTestMinion::FindTargetViaPerception()
 EBehaviacStatus ABehaviacTestMinion::FindPlayer()
 {
 	bool bFound = FindTargetViaPerception();
-	if (BehaviacAgent)
-	{
-		BehaviacAgent->SetBoolProperty(TEXT("HasTarget"), bFound);
-	}
 	return bFound ? EBehaviacStatus::Success : EBehaviacStatus::Failure;
 }
 
@@ -266,14 +334,13 @@ EBehaviacStatus ABehaviacTestMinion::MoveToTarget()
 	// Already in attack range — report Success so the Sequence advances to FaceTarget/Attack.
 	if (Dist <= AttackRange)
 	{
-		AIC->StopMovement();
+		StopPathFollowing();
 		return EBehaviacStatus::Success;
 	}
 
 	GetCharacterMovement()->MaxWalkSpeed = (Dist > DetectionRadius * 0.5f) ? RunSpeed : WalkSpeed;
 
-	EPathFollowingRequestResult::Type Result = AIC->MoveToActor(
-		CurrentTarget, AttackRange * 0.8f, true, true, false, nullptr, true);
+	EPathFollowingRequestResult::Type Result = RequestMoveToActor(CurrentTarget, AttackRange * 0.8f);
 
 	// AlreadyAtGoal also means we're close enough — treat as success.
 	if (Result == EPathFollowingRequestResult::AlreadyAtGoal)
@@ -303,7 +370,7 @@ EBehaviacStatus ABehaviacTestMinion::Patrol()
 	{
 		CurrentPatrolIndex = (CurrentPatrolIndex + 1) % PatrolPoints.Num();
 		Target = PatrolPoints[CurrentPatrolIndex];
-		AIC->MoveToLocation(Target, 50.0f);
+		RequestMoveToLocation(Target, 50.0f);
 		return EBehaviacStatus::Running;
 	}
 
@@ -313,7 +380,7 @@ EBehaviacStatus ABehaviacTestMinion::Patrol()
 		return EBehaviacStatus::Running;
 	}
 
-	EPathFollowingRequestResult::Type Result = AIC->MoveToLocation(Target, 50.0f);
+	EPathFollowingRequestResult::Type Result = RequestMoveToLocation(Target, 50.0f);
 	if (Result == EPathFollowingRequestResult::Failed)
 	{
 		BEHAVIAC_VLOG(TEXT("[BehaviacTestMinion] Patrol: MoveToLocation failed (no NavMesh?)"));
@@ -330,7 +397,7 @@ EBehaviacStatus ABehaviacTestMinion::PatrolToGoal()
 	// ── If a Goal actor is assigned (set by MinionBarrack), march toward it ──
 	if (GoalActor)
 	{
-		GetCharacterMovement()->MaxWalkSpeed = WalkSpeed;
+		GetCharacterMovement()->MaxWalkSpeed = GetLaneMarchSpeed();
 
 		// Already at goal — keep returning Success so the BT loops back here
 		// and the minion idles at the objective.
@@ -340,12 +407,27 @@ EBehaviacStatus ABehaviacTestMinion::PatrolToGoal()
 		}
 
 		UPathFollowingComponent* PF = AIC->GetPathFollowingComponent();
+
+		// March along the team's shared lane flow field; per-agent pathfinding is
+		// only used off-lane or until the barrack's field has been built.
+		FVector FlowDirection;
+		const UCFlowFieldSubsystem* FlowFields = UCFlowFieldSubsystem::Get(this);
+		if (FlowFields && FlowFields->SampleDirection(GetGenericTeamId().GetId(), GoalActor, GetActorLocation(), FlowDirection))
+		{
+			if (PF && PF->GetStatus() != EPathFollowingStatus::Idle)
+			{
+				StopPathFollowing();
+			}
+			AddMovementInput(FlowDirection);
+			return EBehaviacStatus::Running;
+		}
+
 		if (PF && PF->GetStatus() == EPathFollowingStatus::Moving)
 		{
 			return EBehaviacStatus::Running;
 		}
 
-		EPathFollowingRequestResult::Type Result = AIC->MoveToActor(GoalActor, MoveAcceptanceRadius);
+		EPathFollowingRequestResult::Type Result = RequestMoveToActor(GoalActor, MoveAcceptanceRadius);
 		if (Result == EPathFollowingRequestResult::Failed)
 		{
 			BEHAVIAC_VLOG(TEXT("[BehaviacTestMinion] %s PatrolToGoal: MoveToActor failed (no NavMesh?)"), *GetName());
@@ -363,7 +445,8 @@ EBehaviacStatus ABehaviacTestMinion::UpdateAIState()
 	FString NewState = TEXT("Patrol");
 	float DistFromPost = FVector::Dist(GetActorLocation(), GuardCenter);
 
-	AActor* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	// The lane's nearest enemy hero is found once per lane, not per minion
+	AActor* Player = GetLaneEnemyHero();
 	if (!Player)
 	{
 		// Also check perception
@@ -392,21 +475,21 @@ EBehaviacStatus ABehaviacTestMinion::UpdateAIState()
 
 		if (bCanSee && DistToPlayer <= AttackRange)
 		{
-			CurrentTarget = Player;
+			SetCurrentTarget(Player);
 			bHasLastKnownPos = true;
 			LastKnownPlayerPos = Player->GetActorLocation();
 			NewState = TEXT("Combat");
 		}
 		else if (bCanSee && PlayerFromPost <= GuardRadius)
 		{
-			CurrentTarget = Player;
+			SetCurrentTarget(Player);
 			bHasLastKnownPos = true;
 			LastKnownPlayerPos = Player->GetActorLocation();
 			NewState = TEXT("Chase");
 		}
 		else if (bCanSee && PlayerFromPost > GuardRadius)
 		{
-			CurrentTarget = nullptr;
+			SetCurrentTarget(nullptr);
 			bHasLastKnownPos = false;
 			LastKnownPlayerPos = FVector::ZeroVector;
 			NewState = TEXT("ReturnToPost");
@@ -416,7 +499,7 @@ EBehaviacStatus ABehaviacTestMinion::UpdateAIState()
 			// Cannot see player
 			if (bHasLastKnownPos || CurrentTarget != nullptr)
 			{
-				CurrentTarget = nullptr;
+				SetCurrentTarget(nullptr);
 				bHasLastKnownPos = false;
 				LastKnownPlayerPos = FVector::ZeroVector;
 				NewState = TEXT("ReturnToPost");
@@ -429,7 +512,7 @@ EBehaviacStatus ABehaviacTestMinion::UpdateAIState()
 	}
 	else
 	{
-		CurrentTarget = nullptr;
+		SetCurrentTarget(nullptr);
 		bHasLastKnownPos = false;
 		NewState = (DistFromPost > GuardRadius) ? TEXT("ReturnToPost") : TEXT("Patrol");
 	}
@@ -451,7 +534,7 @@ EBehaviacStatus ABehaviacTestMinion::ChasePlayer()
 {
 	if (BehaviacAgent && BehaviacAgent->GetPropertyValue(TEXT("AIState")) != TEXT("Chase"))
 	{
-		if (AAIController* AIC = GetController<AAIController>()) AIC->StopMovement();
+		StopPathFollowing();
 		return EBehaviacStatus::Failure;
 	}
 	if (!CurrentTarget) return EBehaviacStatus::Failure;
@@ -463,7 +546,10 @@ EBehaviacStatus ABehaviacTestMinion::ChasePlayer()
 	if (Dist <= AttackRange) return EBehaviacStatus::Success;
 
 	GetCharacterMovement()->MaxWalkSpeed = RunSpeed;
-	AIC->MoveToActor(CurrentTarget, AttackRange * 0.8f);
+
+	// Repeated requests for the same target are coalesced; the path is refreshed
+	// once the target has moved past the repath tolerance.
+	RequestMoveToActor(CurrentTarget, AttackRange * 0.8f);
 	return EBehaviacStatus::Running;
 }
 
@@ -498,7 +584,7 @@ EBehaviacStatus ABehaviacTestMinion::AttackTarget()
 
 EBehaviacStatus ABehaviacTestMinion::StopMovement()
 {
-	if (AAIController* AIC = GetController<AAIController>()) AIC->StopMovement();
+	StopPathFollowing();
 	return EBehaviacStatus::Success;
 }
 
@@ -537,7 +623,7 @@ EBehaviacStatus ABehaviacTestMinion::MoveToLastKnownPos()
 		return EBehaviacStatus::Success;
 	}
 
-	EPathFollowingRequestResult::Type Result = AIC->MoveToLocation(LastKnownPlayerPos, 80.0f);
+	EPathFollowingRequestResult::Type Result = RequestMoveToLocation(LastKnownPlayerPos, 80.0f);
 	return (Result != EPathFollowingRequestResult::Failed)
 		? EBehaviacStatus::Running : EBehaviacStatus::Failure;
 }
@@ -555,7 +641,7 @@ EBehaviacStatus ABehaviacTestMinion::ClearLastKnownPos()
 {
 	bHasLastKnownPos = false;
 	LastKnownPlayerPos = FVector::ZeroVector;
-	CurrentTarget = nullptr;
+	SetCurrentTarget(nullptr);
 	if (BehaviacAgent)
 	{
 		BehaviacAgent->SetPropertyValue(TEXT("AIState"), TEXT("Patrol"));
@@ -579,38 +665,51 @@ EBehaviacStatus ABehaviacTestMinion::ReturnToPost()
 	}
 
 	GetCharacterMovement()->MaxWalkSpeed = WalkSpeed;
-	EPathFollowingRequestResult::Type Result = AIC->MoveToLocation(GuardCenter, 80.0f);
+	EPathFollowingRequestResult::Type Result = RequestMoveToLocation(GuardCenter, 80.0f);
 	return (Result != EPathFollowingRequestResult::Failed)
 		? EBehaviacStatus::Running : EBehaviacStatus::Failure;
 }
 
-bool ABehaviacTestMinion::IsPlayerInRange()
+EPathFollowingRequestResult::Type ABehaviacTestMinion::RequestMoveToActor(AActor* Goal, float AcceptanceRadius)
 {
-	APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
-	if (!Player) return false;
-	return FVector::Dist(GetActorLocation(), Player->GetActorLocation()) <= DetectionRadius;
-}
+	AAIController* AIC = GetController<AAIController>();
+	if (!AIC) return EPathFollowingRequestResult::Failed;
 
-// ============================================================
-// Blackboard property sync
-// ============================================================
+	if (UCPathRequestSubsystem* PathRequests = UCPathRequestSubsystem::Get(this))
+	{
+		return PathRequests->RequestMoveToActor(AIC, Goal, AcceptanceRadius);
+	}
+	return AIC->MoveToActor(Goal, AcceptanceRadius);
+}
 
-void ABehaviacTestMinion::UpdateBehaviacProperties()
+EPathFollowingRequestResult::Type ABehaviacTestMinion::RequestMoveToLocation(const FVector& Goal, float AcceptanceRadius)
 {
-	if (!BehaviacAgent) return;
+	AAIController* AIC = GetController<AAIController>();
+	if (!AIC) return EPathFollowingRequestResult::Failed;
 
-	// Health via GAS (placeholder — extend when GAS attribute getter is available)
-	BehaviacAgent->SetIntProperty(TEXT("Health"), 100);
+	if (UCPathRequestSubsystem* PathRequests = UCPathRequestSubsystem::Get(this))
+	{
+		return PathRequests->RequestMoveToLocation(AIC, Goal, AcceptanceRadius);
+	}
+	return AIC->MoveToLocation(Goal, AcceptanceRadius);
+}
 
-	BehaviacAgent->SetBoolProperty(TEXT("HasTarget"), CurrentTarget != nullptr);
+void ABehaviacTestMinion::StopPathFollowing()
+{
+	AAIController* AIC = GetController<AAIController>();
+	if (!AIC) return;
 
-	float Dist = 999999.0f;
-	if (CurrentTarget)
+	if (UCPathRequestSubsystem* PathRequests = UCPathRequestSubsystem::Get(this))
 	{
-		Dist = FVector::Dist(GetActorLocation(), CurrentTarget->GetActorLocation());
+		PathRequests->StopMovement(AIC);
+		return;
 	}
-	BehaviacAgent->SetFloatProperty(TEXT("DistanceToTarget"), Dist);
+	AIC->StopMovement();
+}
 
-	bool bMoving = GetCharacterMovement() && GetCharacterMovement()->Velocity.SizeSquared() > 100.0f;
-	BehaviacAgent->SetBoolProperty(TEXT("IsMoving"), bMoving);
+bool ABehaviacTestMinion::IsPlayerInRange()
+{
+	APawn* Player = GetLaneEnemyHero();
+	if (!Player) return false;
+	return FVector::Dist(GetActorLocation(), Player->GetActorLocation()) <= DetectionRadius;
 }
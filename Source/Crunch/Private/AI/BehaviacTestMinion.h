@@ -5,6 +5,7 @@
 
 #include "CoreMinimal.h"
 #include "AI/Minion.h"
+#include "AITypes.h"
 #include "BehaviacAgent.h"
 #include "BehaviacTypes.h"
 #include "BehaviorTree/BehaviacBehaviorTree.h"
@@ -23,7 +24,7 @@
  *  - Uses Behaviac for decision-making instead of ACAIController
  *  - Lambda-based method registration via RegisterMethodHandler
  *  - Full guard/patrol/combat state machine (mirrors BehaviacAINPC)
- *  - Perception-based target detection (uses AIPerceptionComponent)
+ *  - Perception-based target detection (uses UCPerceptionSubsystem sight)
  *
  * Methods Exposed to Behaviac:
  *  - FindPlayer / HasTarget / InAttackRange
@@ -34,10 +35,22 @@
  *
  * Properties Available in XML:
  *  - Health (int): Current health value
+ *  - IsDead / IsStunned / IsAiming (bool): GAS status tags
  *  - HasTarget (bool): Whether target is acquired
  *  - DistanceToTarget (float): Distance to current target
  *  - IsMoving (bool): Whether currently navigating
+ *  - PerceivedEnemies (actor array): Hostiles currently in sight
+ *  These are pushed on change by UCBlackboardSyncComponent, not polled.
  *  - AIState (string): "Patrol" / "Chase" / "Combat" / "Investigate" / "ReturnToPost"
+ *
+ * Lane facts (Squad. prefix), produced once per lane by the owning AMinionBarrack:
+ *  - Squad.GoalLocation / Squad.LaneFront (vector string)
+ *  - Squad.NearestEnemyHero (object path, empty when no hero is near the front);
+ *    UpdateAIState chases the hero it names
+ * Team facts (Team. prefix), produced once per team:
+ *  - Team.CoreContested (bool): PatrolToGoal runs instead of walks while true,
+ *    and also while the minion trails Squad.LaneFront by more than GuardRadius
+ *  The team board is rebound whenever SetGenericTeamId changes the team.
  */
 UCLASS()
 class ABehaviacTestMinion : public AMinion
@@ -52,6 +65,7 @@ public:
 	// exist when the BT is stopped. We capture the goal actor directly instead.
 	virtual void SetGoal(AActor* Goal) override;
 
+	virtual void SetGenericTeamId(const FGenericTeamId& NewTeamId) override;
 
 protected:
 	virtual void BeginPlay() override;
@@ -144,12 +158,38 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac AI", meta = (AllowPrivateAccess = "true"))
 	UBehaviacAgentComponent* BehaviacAgent;
 
-	// Update Behaviac blackboard properties from game state
-	void UpdateBehaviacProperties();
+	// Writes changed game state into the agent's blackboard
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac AI", meta = (AllowPrivateAccess = "true"))
+	class UCBlackboardSyncComponent* BlackboardSync;
+
+	// Bind the Global. board, the Team. board of the current team and the Squad. board of the owning barrack's lane
+	void BindSharedBlackboards();
+
+	// Hostile hero named by the lane's Squad.NearestEnemyHero fact
+	APawn* GetLaneEnemyHero() const;
+
+	UPROPERTY()
+	class UBehaviacSharedBlackboard* LaneBlackboard = nullptr;
+
+	// LaneEnemyHero was resolved from the NearestEnemyHero entry at this version
+	mutable TWeakObjectPtr<APawn> LaneEnemyHero;
+	mutable uint32 LaneEnemyHeroVersion = 0;
+
+	// RunSpeed while the core is contested or the wave has left this minion behind
+	float GetLaneMarchSpeed() const;
+
+	// Assign CurrentTarget and publish HasTarget / DistanceToTarget
+	void SetCurrentTarget(AActor* NewTarget);
 
 	// Perception-based target finding (returns true if a hostile actor was found)
 	bool FindTargetViaPerception();
 
+	// Moves go through UCPathRequestSubsystem, which coalesces repeated requests
+	// and throttles repaths; the controller is used directly if it is missing.
+	EPathFollowingRequestResult::Type RequestMoveToActor(AActor* Goal, float AcceptanceRadius);
+	EPathFollowingRequestResult::Type RequestMoveToLocation(const FVector& Goal, float AcceptanceRadius);
+	void StopPathFollowing();
+
 	// Cached references
 	UPROPERTY()
 	AActor* CurrentTarget;
@@ -167,10 +207,6 @@ private:
 	TArray<FVector> PatrolPoints;
 	int32 CurrentPatrolIndex;
 
-	// Periodic property sync
-	float PropertyUpdateInterval;
-	float LastPropertyUpdateTime;
-
 	// Debug
 	int32 TickCounter;
 	float DebugTimer;
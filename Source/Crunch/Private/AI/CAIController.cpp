@@ -2,34 +2,52 @@
 
 
 #include "AI/CAIController.h"
+#include "AI/CFlowFieldSubsystem.h"
 #include "Character/CCharacter.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "GAS/CAbilitySystemStatics.h"
-#include "Perception/AIPerceptionComponent.h"
-#include "Perception/AISenseConfig_Sight.h"
+#include "Navigation/PathFollowingComponent.h"
 
 ACAIController::ACAIController()
 {
-	AIPerceptionComponent = CreateDefaultSubobject<UAIPerceptionComponent>("AI Perception Component");
-	SightConfig = CreateDefaultSubobject<UAISenseConfig_Sight>("Sight Config");
-
-	SightConfig->DetectionByAffiliation.bDetectEnemies = true;
-	SightConfig->DetectionByAffiliation.bDetectFriendlies = false;
-	SightConfig->DetectionByAffiliation.bDetectNeutrals = false;
-
-	SightConfig->SightRadius = 1000.f;
-	SightConfig->LoseSightRadius = 1200.f;
+	// Enemies only; sight is served by UCPerceptionSubsystem instead of a per-controller AIPerception sense
+	Sight.SightRadius = 1000.f;
+	Sight.LoseSightRadius = 1200.f;
+	Sight.MaxAge = 5.f;
+	Sight.PeripheralVisionAngleDegrees = 180.f;
+}
 
-	SightConfig->SetMaxAge(5.f);
+FPathFollowingRequestResult ACAIController::MoveTo(const FAIMoveRequest& MoveRequest, FNavPathSharedPtr* OutPath)
+{
+	AActor* GoalActor = MoveRequest.IsMoveToActorRequest() ? MoveRequest.GetGoalActor() : nullptr;
+	UCFlowFieldSubsystem* FlowFields = UCFlowFieldSubsystem::Get(this);
+	if (!GoalActor || !FlowFields || !GetPawn() || !MoveRequest.IsUsingPathfinding()
+		|| !GetPathFollowingComponent() || GetPathFollowingComponent()->HasReached(MoveRequest))
+	{
+		return Super::MoveTo(MoveRequest, OutPath);
+	}
 
-	SightConfig->PeripheralVisionAngleDegrees = 180.f;
+	FNavPathSharedPtr Path = FlowFields->BuildNavPath(*this, GoalActor);
+	if (!Path.IsValid())
+	{
+		return Super::MoveTo(MoveRequest, OutPath);
+	}
 
-	AIPerceptionComponent->ConfigureSense(*SightConfig);
-	AIPerceptionComponent->OnTargetPerceptionUpdated.AddDynamic(this, &ACAIController::TargetPerceptionUpdated);
-	AIPerceptionComponent->OnTargetPerceptionForgotten.AddDynamic(this, &ACAIController::TargetForgotten);
+	FPathFollowingRequestResult Result;
+	Result.MoveId = RequestMove(MoveRequest, Path);
+	Result.Code = Result.MoveId.IsValid() ? EPathFollowingRequestResult::RequestSuccessful : EPathFollowingRequestResult::Failed;
+	if (Result.MoveId.IsValid())
+	{
+		bAllowStrafe = MoveRequest.CanStrafe();
+		if (OutPath)
+		{
+			*OutPath = Path;
+		}
+	}
+	return Result;
 }
 
 void ACAIController::OnPossess(APawn* NewPawn)
@@ -40,6 +58,12 @@ void ACAIController::OnPossess(APawn* NewPawn)
 	if (PawnTeamInterface)
 	{
 		SetGenericTeamId(PawnTeamInterface->GetGenericTeamId());
+		if (UCPerceptionSubsystem* Perception = UCPerceptionSubsystem::Get(this))
+		{
+			Perception->RegisterListener(this, Sight,
+				FCOnTargetPerceptionUpdated::CreateUObject(this, &ACAIController::TargetPerceptionUpdated),
+				FCOnTargetPerceptionForgotten::CreateUObject(this, &ACAIController::TargetForgotten));
+		}
 		ClearAndDisableAllSenses();
 		EnableAllSenses();
 	}
@@ -52,15 +76,25 @@ void ACAIController::OnPossess(APawn* NewPawn)
 	}
 }
 
+void ACAIController::OnUnPossess()
+{
+	if (UCPerceptionSubsystem* Perception = UCPerceptionSubsystem::Get(this))
+	{
+		Perception->UnregisterListener(this);
+	}
+
+	Super::OnUnPossess();
+}
+
 void ACAIController::BeginPlay()
 {
 	Super::BeginPlay();
 	RunBehaviorTree(BehaviorTree);
 }
 
-void ACAIController::TargetPerceptionUpdated(AActor* TargetActor, FAIStimulus Stimulus)
+void ACAIController::TargetPerceptionUpdated(AActor* TargetActor, bool bSuccessfullySensed)
 {
-	if (Stimulus.WasSuccessfullySensed())
+	if (bSuccessfullySensed)
 	{
 		if (!GetCurrentTarget())
 		{
@@ -112,10 +146,10 @@ void ACAIController::SetCurrentTarget(AActor* NewTarget)
 
 AActor* ACAIController::GetNextPerceivedActor() const
 {
-	if (PerceptionComponent)
+	if (const UCPerceptionSubsystem* Perception = UCPerceptionSubsystem::Get(this))
 	{
 		TArray<AActor*> Actors;
-		AIPerceptionComponent->GetPerceivedHostileActors(Actors);
+		Perception->GetPerceivedActors(this, Actors);
 
 		if (Actors.Num() != 0)
 		{
@@ -134,28 +168,18 @@ void ACAIController::ForgetActorIfDead(AActor* ActorToForget)
 
 	if (ActorASC->HasMatchingGameplayTag(UCAbilitySystemStatics::GetDeadStatTag()))
 	{
-		for (UAIPerceptionComponent::TActorPerceptionContainer::TIterator Iter = AIPerceptionComponent->GetPerceptualDataIterator(); Iter; ++Iter)
+		if (UCPerceptionSubsystem* Perception = UCPerceptionSubsystem::Get(this))
 		{
-			if (Iter->Key != ActorToForget)
-			{
-				continue;
-			}
-
-			for (FAIStimulus& Stimuli : Iter->Value.LastSensedStimuli)
-			{
-				Stimuli.SetStimulusAge(TNumericLimits<float>::Max());
-			}
+			Perception->ForgetTarget(this, ActorToForget);
 		}
 	}
 }
 
 void ACAIController::ClearAndDisableAllSenses()
 {
-	AIPerceptionComponent->AgeStimuli(TNumericLimits<float>::Max());
-
-	for (auto SenseConfigIt = AIPerceptionComponent->GetSensesConfigIterator(); SenseConfigIt; ++SenseConfigIt)
+	if (UCPerceptionSubsystem* Perception = UCPerceptionSubsystem::Get(this))
 	{
-		AIPerceptionComponent->SetSenseEnabled((*SenseConfigIt)->GetSenseImplementation(), false);
+		Perception->SetListenerEnabled(this, false);
 	}
 
 	if (GetBlackboardComponent())
@@ -166,9 +190,9 @@ void ACAIController::ClearAndDisableAllSenses()
 
 void ACAIController::EnableAllSenses()
 {
-	for (auto SenseConfigIt = AIPerceptionComponent->GetSensesConfigIterator(); SenseConfigIt; ++SenseConfigIt)
+	if (UCPerceptionSubsystem* Perception = UCPerceptionSubsystem::Get(this))
 	{
-		AIPerceptionComponent->SetSenseEnabled((*SenseConfigIt)->GetSenseImplementation(), true);
+		Perception->SetListenerEnabled(this, true);
 	}
 }
 
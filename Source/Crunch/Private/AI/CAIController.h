@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "AIController.h"
 #include "GameplayTagContainer.h"
+#include "AI/CPerceptionSubsystem.h"
 // ----------------------------------------------------------------------------
 // File: CAIController.h
 // Purpose: AI controller managing perception-driven targeting and integrating
@@ -14,15 +15,17 @@
 // Key API:
 //  - TargetBlackboardKeyName: name of blackboard key storing current target.
 //  - BehaviorTree: the BT asset to run on BeginPlay.
-//  - Perception components: UAIPerceptionComponent + UAISenseConfig_Sight.
+//  - Sight: FCSightConfig registered with UCPerceptionSubsystem (batched sight).
 //  - Tag handlers: PawnDeadTagUpdated / PawnStunTagUpdated.
+//  - MoveTo: moves to a lane goal follow the team's flow field route
+//    (UCFlowFieldSubsystem::BuildNavPath) instead of a navmesh query.
 // ----------------------------------------------------------------------------
 #include "CAIController.generated.h"
 
 /**
  * Controller that:
  *  - Runs the assigned BehaviorTree.
- *  - Uses AIPerception (Sight) to set/clear a blackboard Target key.
+ *  - Uses UCPerceptionSubsystem sight to set/clear a blackboard Target key.
  *  - Mirrors the pawn's team ID (IGenericTeamAgentInterface).
  *  - Reacts to GAS Dead/Stun tags to stop/start brain and toggle senses.
  *
@@ -31,6 +34,9 @@
  *  - On forgetting: switches to next perceived hostile actor.
  *  - On Dead tag applied: stop logic, disable senses, mark dead.
  *  - On Stun tag applied: stop logic (unless dead). On removal: resume.
+ *  - Behavior tree MoveTo toward a goal with a lane flow field (the barrack's
+ *    Goal) gets a path traced from the field, so a wave marching down a lane
+ *    shares one integration instead of one A* per minion.
  */
 UCLASS()
 class ACAIController : public AAIController
@@ -41,7 +47,9 @@ public:
 	ACAIController();
 
 	virtual void OnPossess(APawn* NewPawn) override;
+	virtual void OnUnPossess() override;
 	virtual void BeginPlay() override;
+	virtual FPathFollowingRequestResult MoveTo(const FAIMoveRequest& MoveRequest, FNavPathSharedPtr* OutPath = nullptr) override;
 private:
 	UPROPERTY(EditDefaultsOnly, Category = "AI Behavior")
 	FName TargetBlackboardKeyName = "Target";
@@ -49,15 +57,10 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "AI Behavior")
 	class UBehaviorTree* BehaviorTree;
 
-	UPROPERTY(VisibleDefaultsOnly, Category = "Perception")
-	class UAIPerceptionComponent* AIPerceptionComponent;
-	
-	UPROPERTY(VisibleDefaultsOnly, Category = "Perception")
-	class UAISenseConfig_Sight* SightConfig;
+	UPROPERTY(EditDefaultsOnly, Category = "Perception")
+	FCSightConfig Sight;
 
-	UFUNCTION()
-	void TargetPerceptionUpdated(AActor* TargetActor, FAIStimulus Stimulus);
-	UFUNCTION()
+	void TargetPerceptionUpdated(AActor* TargetActor, bool bSuccessfullySensed);
 	void TargetForgotten(AActor* ForgottenActor);
 
 	const UObject* GetCurrentTarget() const;
@@ -0,0 +1,271 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/CBlackboardSyncComponent.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "AIController.h"
+#include "AI/CPerceptionSubsystem.h"
+#include "BehaviacAgent.h"
+#include "Engine/World.h"
+#include "GAS/CAbilitySystemStatics.h"
+#include "GAS/CAttributeSet.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Blackboard Sync Writes"), STAT_CBlackboardSyncWrites, STATGROUP_AI);
+
+/** Written while there is no target, matching the value the trees were authored against */
+static constexpr float NoTargetDistance = 999999.0f;
+
+UCBlackboardSyncComponent::UCBlackboardSyncComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UCBlackboardSyncComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAbilitySystemComponent* ASC = BoundASC.Get())
+	{
+		ASC->GetGameplayAttributeValueChangeDelegate(UCAttributeSet::GetHealthAttribute()).RemoveAll(this);
+		ASC->RegisterGameplayTagEvent(UCAbilitySystemStatics::GetDeadStatTag()).RemoveAll(this);
+		ASC->RegisterGameplayTagEvent(UCAbilitySystemStatics::GetStunStatTag()).RemoveAll(this);
+		ASC->RegisterGameplayTagEvent(UCAbilitySystemStatics::GetAimStatTag()).RemoveAll(this);
+	}
+	BoundASC.Reset();
+
+	if (UCPerceptionSubsystem* Perception = UCPerceptionSubsystem::Get(this))
+	{
+		Perception->RemovePerceivedActorsChangedHandler(BoundController.Get(), PerceivedActorsChangedHandle);
+	}
+	BoundController.Reset();
+	PerceivedActorsChangedHandle.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UCBlackboardSyncComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const AActor* Owner = GetOwner();
+	if (!Agent || !Owner)
+	{
+		return;
+	}
+
+	// Movement-threshold triggers, polled every SyncInterval: the owner and its
+	// target move every frame, but the keys only change on a threshold
+	if (Target.IsValid())
+	{
+		WriteDistance(GetTargetDistance());
+	}
+	else if (bHasTarget)
+	{
+		// Target destroyed without the owner noticing
+		SetTarget(nullptr);
+	}
+	WriteBool(TEXT("IsMoving"), Owner->GetVelocity().SizeSquared() > FMath::Square(MovingSpeedThreshold), bIsMoving);
+
+	// DeltaTime spans the whole tick interval
+	SecondTimer += DeltaTime;
+	if (SecondTimer >= 1.f)
+	{
+		WritesPerSecond = WritesThisSecond;
+		WritesThisSecond = 0;
+		SecondTimer = 0.f;
+	}
+}
+
+void UCBlackboardSyncComponent::Bind(UBehaviacAgentComponent* InAgent)
+{
+	Agent = InAgent;
+	if (!Agent)
+	{
+		return;
+	}
+
+	if (UAbilitySystemComponent* ASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetOwner()))
+	{
+		BoundASC = ASC;
+		ASC->GetGameplayAttributeValueChangeDelegate(UCAttributeSet::GetHealthAttribute()).AddUObject(this, &UCBlackboardSyncComponent::HealthUpdated);
+		ASC->RegisterGameplayTagEvent(UCAbilitySystemStatics::GetDeadStatTag()).AddUObject(this, &UCBlackboardSyncComponent::DeadTagUpdated);
+		ASC->RegisterGameplayTagEvent(UCAbilitySystemStatics::GetStunStatTag()).AddUObject(this, &UCBlackboardSyncComponent::StunTagUpdated);
+		ASC->RegisterGameplayTagEvent(UCAbilitySystemStatics::GetAimStatTag()).AddUObject(this, &UCBlackboardSyncComponent::AimTagUpdated);
+
+		WriteHealth(ASC->GetNumericAttribute(UCAttributeSet::GetHealthAttribute()));
+		WriteBool(TEXT("IsDead"), ASC->HasMatchingGameplayTag(UCAbilitySystemStatics::GetDeadStatTag()), bIsDead, true);
+		WriteBool(TEXT("IsStunned"), ASC->HasMatchingGameplayTag(UCAbilitySystemStatics::GetStunStatTag()), bIsStunned, true);
+		WriteBool(TEXT("IsAiming"), ASC->HasMatchingGameplayTag(UCAbilitySystemStatics::GetAimStatTag()), bIsAiming, true);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UCBlackboardSyncComponent: %s has no ability system, Health and status keys are not synced"), *GetNameSafe(GetOwner()));
+	}
+
+	// Perception pushes the enemy list instead of the owner pulling it every decision
+	if (const APawn* Pawn = Cast<APawn>(GetOwner()))
+	{
+		AAIController* Controller = Pawn->GetController<AAIController>();
+		UCPerceptionSubsystem* Perception = UCPerceptionSubsystem::Get(this);
+		if (Controller && Perception)
+		{
+			Perception->RemovePerceivedActorsChangedHandler(BoundController.Get(), PerceivedActorsChangedHandle);
+			BoundController = Controller;
+			PerceivedActorsChangedHandle = Perception->AddPerceivedActorsChangedHandler(Controller,
+				FCOnPerceivedActorsChanged::FDelegate::CreateUObject(this, &UCBlackboardSyncComponent::PerceivedActorsChanged));
+			PerceivedActorsChanged(Controller);
+		}
+	}
+
+	// A target may have been set before the agent was bound
+	WriteBool(TEXT("HasTarget"), Target.IsValid(), bHasTarget, true);
+	LastDistance = -1.f;
+	WriteDistance(GetTargetDistance());
+	WriteBool(TEXT("IsMoving"), false, bIsMoving, true);
+
+	SetComponentTickInterval(SyncInterval);
+	SetComponentTickEnabled(true);
+}
+
+void UCBlackboardSyncComponent::SetTarget(AActor* NewTarget)
+{
+	if (Target.Get() == NewTarget && bHasTarget == (NewTarget != nullptr))
+	{
+		return;
+	}
+
+	Target = NewTarget;
+	WriteBool(TEXT("HasTarget"), NewTarget != nullptr, bHasTarget);
+
+	// Always publish the new target's distance right away, even within the threshold of the old one
+	LastDistance = -1.f;
+	WriteDistance(GetTargetDistance());
+}
+
+float UCBlackboardSyncComponent::GetTargetDistance() const
+{
+	const AActor* Owner = GetOwner();
+	const AActor* TargetActor = Target.Get();
+	return TargetActor && Owner ? FVector::Dist(Owner->GetActorLocation(), TargetActor->GetActorLocation()) : NoTargetDistance;
+}
+
+void UCBlackboardSyncComponent::PerceivedActorsChanged(AAIController* Controller)
+{
+	if (const UCPerceptionSubsystem* Perception = UCPerceptionSubsystem::Get(this))
+	{
+		TArray<AActor*> Enemies;
+		Perception->GetPerceivedActors(Controller, Enemies);
+		SetPerceivedEnemies(Enemies);
+	}
+}
+
+void UCBlackboardSyncComponent::SetPerceivedEnemies(const TArray<AActor*>& Enemies)
+{
+	bool bChanged = Enemies.Num() != PerceivedEnemies.Num();
+	for (int32 Index = 0; !bChanged && Index < Enemies.Num(); ++Index)
+	{
+		bChanged = PerceivedEnemies[Index].Get() != Enemies[Index];
+	}
+	if (!bChanged || !Agent)
+	{
+		return;
+	}
+
+	PerceivedEnemies.Reset(Enemies.Num());
+	for (AActor* Enemy : Enemies)
+	{
+		PerceivedEnemies.Add(Enemy);
+	}
+	Agent->SetActorArrayProperty(TEXT("PerceivedEnemies"), Enemies);
+	CountWrite();
+}
+
+void UCBlackboardSyncComponent::HealthUpdated(const FOnAttributeChangeData& ChangeData)
+{
+	WriteHealth(ChangeData.NewValue);
+}
+
+void UCBlackboardSyncComponent::DeadTagUpdated(const FGameplayTag Tag, int32 Count)
+{
+	WriteBool(TEXT("IsDead"), Count != 0, bIsDead);
+}
+
+void UCBlackboardSyncComponent::StunTagUpdated(const FGameplayTag Tag, int32 Count)
+{
+	WriteBool(TEXT("IsStunned"), Count != 0, bIsStunned);
+}
+
+void UCBlackboardSyncComponent::AimTagUpdated(const FGameplayTag Tag, int32 Count)
+{
+	WriteBool(TEXT("IsAiming"), Count != 0, bIsAiming);
+}
+
+void UCBlackboardSyncComponent::WriteHealth(float Health)
+{
+	const int32 NewHealth = FMath::RoundToInt32(Health);
+	if (!Agent || NewHealth == LastHealth)
+	{
+		return;
+	}
+
+	LastHealth = NewHealth;
+	Agent->SetIntProperty(TEXT("Health"), NewHealth);
+	CountWrite();
+}
+
+void UCBlackboardSyncComponent::WriteBool(const TCHAR* Key, bool bValue, bool& CachedValue, bool bForce)
+{
+	if (!Agent || (!bForce && bValue == CachedValue))
+	{
+		return;
+	}
+
+	CachedValue = bValue;
+	Agent->SetBoolProperty(Key, bValue);
+	CountWrite();
+}
+
+void UCBlackboardSyncComponent::WriteDistance(float Distance)
+{
+	if (!Agent || (LastDistance >= 0.f && FMath::Abs(Distance - LastDistance) < DistanceWriteThreshold))
+	{
+		return;
+	}
+
+	LastDistance = Distance;
+	Agent->SetFloatProperty(TEXT("DistanceToTarget"), Distance);
+	CountWrite();
+}
+
+void UCBlackboardSyncComponent::CountWrite()
+{
+	++TotalWrites;
+	++WritesThisSecond;
+	INC_DWORD_STAT(STAT_CBlackboardSyncWrites);
+}
+
+static void BlackboardSyncReport(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	int32 NumAgents = 0;
+	int64 SumWritesPerSecond = 0;
+	for (TObjectIterator<UCBlackboardSyncComponent> It; It; ++It)
+	{
+		if (It->GetWorld() != World || !It->IsRegistered())
+		{
+			continue;
+		}
+
+		Ar.Logf(TEXT("  %-40s %4d writes/s  %lld total"), *GetNameSafe(It->GetOwner()), It->GetWritesPerSecond(), It->GetTotalWrites());
+		SumWritesPerSecond += It->GetWritesPerSecond();
+		++NumAgents;
+	}
+
+	Ar.Logf(TEXT("Blackboard sync: %d agents, %.1f writes/s per agent"), NumAgents, NumAgents > 0 ? double(SumWritesPerSecond) / NumAgents : 0.0);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice BlackboardSyncReportCommand(
+	TEXT("Crunch.BlackboardSync.Report"),
+	TEXT("Crunch.BlackboardSync.Report: print blackboard writes per second for every synced agent in this world."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&BlackboardSyncReport));
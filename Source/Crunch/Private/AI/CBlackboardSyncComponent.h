@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GameplayTagContainer.h"
+// ----------------------------------------------------------------------------
+// File: CBlackboardSyncComponent.h
+// Purpose: Push game state into a Behaviac agent's blackboard as it changes,
+//          instead of rewriting every key on a timer.
+// Key API:
+//  - Bind: subscribe to the owner's GAS attribute and tag events and to its
+//    controller's UCPerceptionSubsystem perceived-actors event.
+//  - SetTarget: called by the owner when it picks a target.
+//  - GetPerceivedEnemies: the last list pushed by perception.
+//  - GetWritesPerSecond: blackboard writes made for this agent.
+// Notes:
+//  - Distance and IsMoving are polled every SyncInterval, not every frame, and
+//    DistanceToTarget is rewritten only after moving DistanceWriteThreshold.
+//  - Crunch.BlackboardSync.Report prints writes/s per agent.
+// ----------------------------------------------------------------------------
+#include "CBlackboardSyncComponent.generated.h"
+
+class UBehaviacAgentComponent;
+class UAbilitySystemComponent;
+class AAIController;
+struct FOnAttributeChangeData;
+
+/**
+ * Keeps these agent keys in sync with the owner:
+ *  - Health (int): GAS Health attribute change delegate.
+ *  - IsDead / IsStunned / IsAiming (bool): GAS tag events.
+ *  - HasTarget (bool), DistanceToTarget (float): SetTarget + movement threshold.
+ *  - IsMoving (bool): written when the owner starts or stops moving.
+ *  - PerceivedEnemies (actor array): pushed by UCPerceptionSubsystem when the list changes.
+ * Every key is written only when its value changes.
+ */
+UCLASS(ClassGroup = (AI), meta = (BlueprintSpawnableComponent))
+class UCBlackboardSyncComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UCBlackboardSyncComponent();
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Subscribe to the owner's ability system and perception and write the current value of every key */
+	void Bind(UBehaviacAgentComponent* InAgent);
+
+	void SetTarget(AActor* NewTarget);
+
+	/** Hostiles the owner's controller currently sees, oldest sensed first */
+	const TArray<TWeakObjectPtr<AActor>>& GetPerceivedEnemies() const { return PerceivedEnemies; }
+
+	/** Blackboard writes over the last full second */
+	int32 GetWritesPerSecond() const { return WritesPerSecond; }
+	int64 GetTotalWrites() const { return TotalWrites; }
+
+	/** DistanceToTarget is rewritten once the distance has changed by this much */
+	UPROPERTY(EditAnywhere, Category = "Blackboard Sync")
+	float DistanceWriteThreshold = 25.f;
+
+	/** Speed above which the owner counts as moving */
+	UPROPERTY(EditAnywhere, Category = "Blackboard Sync")
+	float MovingSpeedThreshold = 10.f;
+
+	/** Seconds between two polls of DistanceToTarget and IsMoving */
+	UPROPERTY(EditAnywhere, Category = "Blackboard Sync", meta = (ClampMin = "0"))
+	float SyncInterval = 0.1f;
+
+private:
+	void HealthUpdated(const FOnAttributeChangeData& ChangeData);
+	void DeadTagUpdated(const FGameplayTag Tag, int32 Count);
+	void StunTagUpdated(const FGameplayTag Tag, int32 Count);
+	void AimTagUpdated(const FGameplayTag Tag, int32 Count);
+	void PerceivedActorsChanged(AAIController* Controller);
+
+	void SetPerceivedEnemies(const TArray<AActor*>& Enemies);
+	float GetTargetDistance() const;
+
+	void WriteHealth(float Health);
+	void WriteBool(const TCHAR* Key, bool bValue, bool& CachedValue, bool bForce = false);
+	void WriteDistance(float Distance);
+	void CountWrite();
+
+	UPROPERTY()
+	UBehaviacAgentComponent* Agent = nullptr;
+
+	TWeakObjectPtr<UAbilitySystemComponent> BoundASC;
+	TWeakObjectPtr<AAIController> BoundController;
+	FDelegateHandle PerceivedActorsChangedHandle;
+	TWeakObjectPtr<AActor> Target;
+	TArray<TWeakObjectPtr<AActor>> PerceivedEnemies;
+
+	int32 LastHealth = INDEX_NONE;
+	float LastDistance = -1.f;
+	bool bHasTarget = false;
+	bool bIsMoving = false;
+	bool bIsDead = false;
+	bool bIsStunned = false;
+	bool bIsAiming = false;
+
+	int64 TotalWrites = 0;
+	int32 WritesThisSecond = 0;
+	int32 WritesPerSecond = 0;
+	float SecondTimer = 0.f;
+};
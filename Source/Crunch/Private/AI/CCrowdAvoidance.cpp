@@ -0,0 +1,294 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/CCrowdAvoidance.h"
+#include "Async/ParallelFor.h"
+
+namespace CrowdAvoidance
+{
+	/** Velocities on the left of Direction (through Point) are allowed */
+	struct FLine
+	{
+		FVector2f Point = FVector2f::ZeroVector;
+		FVector2f Direction = FVector2f::ZeroVector;
+	};
+
+	typedef TArray<FLine, TInlineAllocator<16>> FLineArray;
+
+	static constexpr float Epsilon = 0.00001f;
+
+	static float Det(const FVector2f& A, const FVector2f& B)
+	{
+		return A.X * B.Y - A.Y * B.X;
+	}
+
+	/** Best velocity on line LineNo that satisfies the lines before it */
+	static bool LinearProgram1(const FLineArray& Lines, int32 LineNo, float Radius, const FVector2f& OptVelocity, bool bDirectionOpt, FVector2f& Result)
+	{
+		const FLine& Line = Lines[LineNo];
+		const float DotProduct = Line.Point | Line.Direction;
+		const float Discriminant = FMath::Square(DotProduct) + FMath::Square(Radius) - Line.Point.SizeSquared();
+		if (Discriminant < 0.f)
+		{
+			// The max speed circle invalidates the whole line
+			return false;
+		}
+
+		const float SqrtDiscriminant = FMath::Sqrt(Discriminant);
+		float TLeft = -DotProduct - SqrtDiscriminant;
+		float TRight = -DotProduct + SqrtDiscriminant;
+
+		for (int32 Index = 0; Index < LineNo; ++Index)
+		{
+			const float Denominator = Det(Line.Direction, Lines[Index].Direction);
+			const float Numerator = Det(Lines[Index].Direction, Line.Point - Lines[Index].Point);
+			if (FMath::Abs(Denominator) <= Epsilon)
+			{
+				// Parallel lines
+				if (Numerator < 0.f)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const float T = Numerator / Denominator;
+			if (Denominator >= 0.f)
+			{
+				TRight = FMath::Min(TRight, T);
+			}
+			else
+			{
+				TLeft = FMath::Max(TLeft, T);
+			}
+
+			if (TLeft > TRight)
+			{
+				return false;
+			}
+		}
+
+		if (bDirectionOpt)
+		{
+			Result = Line.Point + ((OptVelocity | Line.Direction) > 0.f ? TRight : TLeft) * Line.Direction;
+		}
+		else
+		{
+			const float T = Line.Direction | (OptVelocity - Line.Point);
+			Result = Line.Point + FMath::Clamp(T, TLeft, TRight) * Line.Direction;
+		}
+		return true;
+	}
+
+	/** Returns the index of the first line that could not be satisfied, or Lines.Num() */
+	static int32 LinearProgram2(const FLineArray& Lines, float Radius, const FVector2f& OptVelocity, bool bDirectionOpt, FVector2f& Result)
+	{
+		if (bDirectionOpt)
+		{
+			Result = OptVelocity * Radius;
+		}
+		else if (OptVelocity.SizeSquared() > FMath::Square(Radius))
+		{
+			Result = OptVelocity.GetSafeNormal() * Radius;
+		}
+		else
+		{
+			Result = OptVelocity;
+		}
+
+		for (int32 Index = 0; Index < Lines.Num(); ++Index)
+		{
+			if (Det(Lines[Index].Direction, Lines[Index].Point - Result) > 0.f)
+			{
+				const FVector2f TempResult = Result;
+				if (!LinearProgram1(Lines, Index, Radius, OptVelocity, bDirectionOpt, Result))
+				{
+					Result = TempResult;
+					return Index;
+				}
+			}
+		}
+		return Lines.Num();
+	}
+
+	/** No velocity satisfies every line: minimize the largest violation instead */
+	static void LinearProgram3(const FLineArray& Lines, int32 BeginLine, float Radius, FVector2f& Result)
+	{
+		float Distance = 0.f;
+		FLineArray ProjectedLines;
+		for (int32 Index = BeginLine; Index < Lines.Num(); ++Index)
+		{
+			if (Det(Lines[Index].Direction, Lines[Index].Point - Result) <= Distance)
+			{
+				continue;
+			}
+
+			ProjectedLines.Reset();
+			for (int32 Other = 0; Other < Index; ++Other)
+			{
+				FLine Line;
+				const float Determinant = Det(Lines[Index].Direction, Lines[Other].Direction);
+				if (FMath::Abs(Determinant) <= Epsilon)
+				{
+					if ((Lines[Index].Direction | Lines[Other].Direction) > 0.f)
+					{
+						// Same direction
+						continue;
+					}
+					Line.Point = 0.5f * (Lines[Index].Point + Lines[Other].Point);
+				}
+				else
+				{
+					Line.Point = Lines[Index].Point + (Det(Lines[Other].Direction, Lines[Index].Point - Lines[Other].Point) / Determinant) * Lines[Index].Direction;
+				}
+				Line.Direction = (Lines[Other].Direction - Lines[Index].Direction).GetSafeNormal();
+				ProjectedLines.Add(Line);
+			}
+
+			const FVector2f TempResult = Result;
+			const FVector2f Perpendicular(-Lines[Index].Direction.Y, Lines[Index].Direction.X);
+			if (LinearProgram2(ProjectedLines, Radius, Perpendicular, true, Result) < ProjectedLines.Num())
+			{
+				// Can only happen through floating point error; keep the previous result
+				Result = TempResult;
+			}
+			Distance = Det(Lines[Index].Direction, Lines[Index].Point - Result);
+		}
+	}
+
+	/** Half-plane of velocities that keeps Agent clear of Other for TimeHorizon, taking half the responsibility (all of it if Other does not avoid) */
+	static FLine MakeAgentLine(const FCCrowdAgent& Agent, const FCCrowdAgent& Other, float InvTimeHorizon, float InvDeltaTime)
+	{
+		const FVector2f RelativePosition = Other.Position - Agent.Position;
+		const FVector2f RelativeVelocity = Agent.Velocity - Other.Velocity;
+		const float DistanceSquared = RelativePosition.SizeSquared();
+		const float CombinedRadius = Agent.Radius + Other.Radius;
+		const float CombinedRadiusSquared = FMath::Square(CombinedRadius);
+
+		FLine Line;
+		FVector2f U;
+		if (DistanceSquared > CombinedRadiusSquared)
+		{
+			// Vector from the cutoff center to the relative velocity
+			const FVector2f W = RelativeVelocity - InvTimeHorizon * RelativePosition;
+			const float WLengthSquared = W.SizeSquared();
+			const float DotProduct1 = W | RelativePosition;
+
+			if (DotProduct1 < 0.f && FMath::Square(DotProduct1) > CombinedRadiusSquared * WLengthSquared)
+			{
+				// Project on the cutoff circle
+				const float WLength = FMath::Sqrt(WLengthSquared);
+				const FVector2f UnitW = W / WLength;
+				Line.Direction = FVector2f(UnitW.Y, -UnitW.X);
+				U = (CombinedRadius * InvTimeHorizon - WLength) * UnitW;
+			}
+			else
+			{
+				// Project on the legs of the velocity obstacle
+				const float Leg = FMath::Sqrt(DistanceSquared - CombinedRadiusSquared);
+				if (Det(RelativePosition, W) > 0.f)
+				{
+					Line.Direction = FVector2f(RelativePosition.X * Leg - RelativePosition.Y * CombinedRadius, RelativePosition.X * CombinedRadius + RelativePosition.Y * Leg) / DistanceSquared;
+				}
+				else
+				{
+					Line.Direction = -FVector2f(RelativePosition.X * Leg + RelativePosition.Y * CombinedRadius, -RelativePosition.X * CombinedRadius + RelativePosition.Y * Leg) / DistanceSquared;
+				}
+				const float DotProduct2 = RelativeVelocity | Line.Direction;
+				U = DotProduct2 * Line.Direction - RelativeVelocity;
+			}
+		}
+		else
+		{
+			// Already overlapping: separate within this step
+			const FVector2f W = RelativeVelocity - InvDeltaTime * RelativePosition;
+			const float WLength = W.Size();
+			const FVector2f UnitW = WLength > Epsilon ? W / WLength : FVector2f(1.f, 0.f);
+			Line.Direction = FVector2f(UnitW.Y, -UnitW.X);
+			U = (CombinedRadius * InvDeltaTime - WLength) * UnitW;
+		}
+
+		Line.Point = Agent.Velocity + (Other.bAvoids ? 0.5f : 1.f) * U;
+		return Line;
+	}
+
+	static FIntPoint ToCell(const FVector2f& Position, float CellSize)
+	{
+		return FIntPoint(FMath::FloorToInt32(Position.X / CellSize), FMath::FloorToInt32(Position.Y / CellSize));
+	}
+}
+
+void FCCrowdAvoidance::ComputeVelocities(TConstArrayView<FCCrowdAgent> Agents, const FCCrowdAvoidanceSettings& Settings, float DeltaTime, TArrayView<FVector2f> OutVelocities)
+{
+	using namespace CrowdAvoidance;
+	check(Agents.Num() == OutVelocities.Num());
+
+	if (Agents.Num() == 0 || DeltaTime <= 0.f)
+	{
+		return;
+	}
+
+	// Cells as large as the neighbour radius: every neighbour is in the 3x3 block around an agent
+	const float CellSize = FMath::Max(Settings.NeighbourRadius, 1.f);
+	TMap<FIntPoint, TArray<int32, TInlineAllocator<8>>> Grid;
+	Grid.Reserve(Agents.Num());
+	for (int32 Index = 0; Index < Agents.Num(); ++Index)
+	{
+		Grid.FindOrAdd(ToCell(Agents[Index].Position, CellSize)).Add(Index);
+	}
+
+	const float InvTimeHorizon = 1.f / FMath::Max(Settings.TimeHorizon, UE_KINDA_SMALL_NUMBER);
+	const float InvDeltaTime = 1.f / DeltaTime;
+	const float NeighbourRadiusSquared = FMath::Square(Settings.NeighbourRadius);
+	const int32 MaxNeighbours = FMath::Max(Settings.MaxNeighbours, 0);
+
+	ParallelFor(Agents.Num(), [&](int32 Index)
+	{
+		const FCCrowdAgent& Agent = Agents[Index];
+		if (!Agent.bAvoids)
+		{
+			OutVelocities[Index] = Agent.PreferredVelocity;
+			return;
+		}
+
+		// Closest neighbours, nearest first
+		TArray<TPair<float, int32>, TInlineAllocator<32>> Neighbours;
+		const FIntPoint Cell = ToCell(Agent.Position, CellSize);
+		for (int32 Y = Cell.Y - 1; Y <= Cell.Y + 1; ++Y)
+		{
+			for (int32 X = Cell.X - 1; X <= Cell.X + 1; ++X)
+			{
+				if (const TArray<int32, TInlineAllocator<8>>* CellAgents = Grid.Find(FIntPoint(X, Y)))
+				{
+					for (const int32 Other : *CellAgents)
+					{
+						const float DistanceSquared = FVector2f::DistSquared(Agent.Position, Agents[Other].Position);
+						if (Other != Index && DistanceSquared < NeighbourRadiusSquared)
+						{
+							Neighbours.Emplace(DistanceSquared, Other);
+						}
+					}
+				}
+			}
+		}
+		Neighbours.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+		if (Neighbours.Num() > MaxNeighbours)
+		{
+			Neighbours.SetNum(MaxNeighbours, EAllowShrinking::No);
+		}
+
+		FLineArray Lines;
+		for (const TPair<float, int32>& Neighbour : Neighbours)
+		{
+			Lines.Add(MakeAgentLine(Agent, Agents[Neighbour.Value], InvTimeHorizon, InvDeltaTime));
+		}
+
+		FVector2f NewVelocity = FVector2f::ZeroVector;
+		const int32 LineFail = LinearProgram2(Lines, Agent.MaxSpeed, Agent.PreferredVelocity, false, NewVelocity);
+		if (LineFail < Lines.Num())
+		{
+			LinearProgram3(Lines, LineFail, Agent.MaxSpeed, NewVelocity);
+		}
+		OutVelocities[Index] = NewVelocity;
+	});
+}
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+// ----------------------------------------------------------------------------
+// File: CCrowdAvoidance.h
+// Purpose: Reciprocal velocity obstacle (ORCA) avoidance for crowds of AI
+//          characters, solved for every agent of a frame at once.
+// Key API:
+//  - FCCrowdAgent: one agent's snapshot (2D position, velocity, preferred velocity).
+//    Agents with bAvoids false (heroes) are avoided but keep their velocity.
+//  - FCCrowdAvoidance::ComputeVelocities: collision-free velocities for all agents.
+// Notes:
+//  - Neighbours come from a uniform grid built over the snapshot; agents are
+//    solved in parallel and only read the snapshot.
+// ----------------------------------------------------------------------------
+
+/** One agent of an avoidance step; positions and velocities are horizontal */
+struct FCCrowdAgent
+{
+	FVector2f Position = FVector2f::ZeroVector;
+	FVector2f Velocity = FVector2f::ZeroVector;
+	FVector2f PreferredVelocity = FVector2f::ZeroVector;
+	float Radius = 0.f;
+	float MaxSpeed = 0.f;
+
+	/** False for obstacles that move on their own: others take the whole avoidance and its velocity is kept */
+	bool bAvoids = true;
+};
+
+struct FCCrowdAvoidanceSettings
+{
+	/** Agents farther apart than this ignore each other */
+	float NeighbourRadius = 400.f;
+
+	/** Closest neighbours considered per agent */
+	int32 MaxNeighbours = 10;
+
+	/** Seconds ahead in which collisions with other agents are avoided */
+	float TimeHorizon = 1.f;
+};
+
+/**
+ * Optimal reciprocal collision avoidance (van den Berg et al.). Each neighbour
+ * adds a half-plane of velocities that keep the pair apart for TimeHorizon,
+ * with each agent taking half of the responsibility; the new velocity is the
+ * one closest to the preferred velocity inside every half-plane and the
+ * max speed circle, or the least penetrating one when there is none.
+ */
+struct FCCrowdAvoidance
+{
+	static void ComputeVelocities(TConstArrayView<FCCrowdAgent> Agents, const FCCrowdAvoidanceSettings& Settings, float DeltaTime, TArrayView<FVector2f> OutVelocities);
+};
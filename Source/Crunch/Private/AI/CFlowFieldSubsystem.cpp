@@ -0,0 +1,675 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/CFlowFieldSubsystem.h"
+#include "AIController.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "NavigationSystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Flow Field Sample Navmesh"), STAT_CFlowFieldSample, STATGROUP_AI);
+DECLARE_CYCLE_STAT(TEXT("Flow Field Integrate"), STAT_CFlowFieldIntegrate, STATGROUP_AI);
+
+static TAutoConsoleVariable<bool> CVarFlowFieldEnable(
+	TEXT("Crunch.FlowField.Enable"),
+	true,
+	TEXT("Let minions march along the shared lane flow fields. When off, every minion pathfinds to its goal on its own."));
+
+static TAutoConsoleVariable<int32> CVarFlowFieldSamplesPerFrame(
+	TEXT("Crunch.FlowField.SamplesPerFrame"),
+	256,
+	TEXT("Maximum navmesh projections per frame spent building or repairing lane flow fields."));
+
+static TAutoConsoleVariable<int32> CVarFlowFieldIntegrationCellsPerFrame(
+	TEXT("Crunch.FlowField.IntegrationCellsPerFrame"),
+	2048,
+	TEXT("Maximum cells settled per frame by the lane flow field integration (Dijkstra), shared by every field."));
+
+/** 8-connected neighbour steps, orthogonal first */
+static const FIntPoint FlowFieldNeighbours[] =
+{
+	FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1),
+	FIntPoint(1, 1), FIntPoint(1, -1), FIntPoint(-1, 1), FIntPoint(-1, -1)
+};
+
+/** Goal actors usually block the navmesh under them, so seed every walkable cell this close to the goal */
+static constexpr int32 FlowFieldGoalSeedRadius = 3;
+
+FIntPoint FCFlowField::ToCell(const FVector& Location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt32((Location.X - Origin.X) / UCFlowFieldSubsystem::CellSize),
+		FMath::FloorToInt32((Location.Y - Origin.Y) / UCFlowFieldSubsystem::CellSize));
+}
+
+FVector FCFlowField::GetCellCenter(int32 X, int32 Y) const
+{
+	return FVector(
+		Origin.X + (X + 0.5f) * UCFlowFieldSubsystem::CellSize,
+		Origin.Y + (Y + 0.5f) * UCFlowFieldSubsystem::CellSize,
+		Origin.Z);
+}
+
+FVector FCFlowField::GetFloorLocation(int32 X, int32 Y) const
+{
+	FVector Location = GetCellCenter(X, Y);
+	Location.Z = FloorHeights[ToIndex(X, Y)];
+	return Location;
+}
+
+bool FCFlowField::IsGoalSeedCell(const FIntPoint& Cell, const FIntPoint& InGoalCell) const
+{
+	return FMath::Abs(Cell.X - InGoalCell.X) <= FlowFieldGoalSeedRadius && FMath::Abs(Cell.Y - InGoalCell.Y) <= FlowFieldGoalSeedRadius;
+}
+
+static bool IsFlowFieldWalkable(const FCFlowField& Field, int32 X, int32 Y)
+{
+	return Field.IsValidCell(X, Y) && Field.Walkable[Field.ToIndex(X, Y)];
+}
+
+/** Diagonal steps may not cut the corner of a blocked cell */
+static bool CanFlowFieldStep(const FCFlowField& Field, int32 X, int32 Y, const FIntPoint& Step)
+{
+	return IsFlowFieldWalkable(Field, X + Step.X, Y + Step.Y)
+		&& (Step.X == 0 || Step.Y == 0 || (IsFlowFieldWalkable(Field, X + Step.X, Y) && IsFlowFieldWalkable(Field, X, Y + Step.Y)));
+}
+
+static bool FlowFieldCheaper(const TPair<float, int32>& A, const TPair<float, int32>& B)
+{
+	return A.Key < B.Key;
+}
+
+FBox FCFlowField::GetBounds() const
+{
+	return FBox(
+		FVector(Origin.X, Origin.Y, Origin.Z - SampleHeight),
+		FVector(Origin.X + SizeX * UCFlowFieldSubsystem::CellSize, Origin.Y + SizeY * UCFlowFieldSubsystem::CellSize, Origin.Z + SampleHeight));
+}
+
+void UCFlowFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Runtime navmesh rebuilds (dynamic obstacles, streamed tiles) invalidate the lane samples under the dirtied areas
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavigationDirtiedHandle = NavSys->OnNavigationDirtied.AddUObject(this, &UCFlowFieldSubsystem::HandleNavigationDirtied);
+		NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &UCFlowFieldSubsystem::HandleNavigationGenerationFinished);
+	}
+}
+
+void UCFlowFieldSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationDirtied.Remove(NavigationDirtiedHandle);
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &UCFlowFieldSubsystem::HandleNavigationGenerationFinished);
+	}
+	NavigationDirtiedHandle.Reset();
+	DirtyAreas.Empty();
+	Fields.Empty();
+	Super::Deinitialize();
+}
+
+void UCFlowFieldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	int32 SampleBudget = CVarFlowFieldSamplesPerFrame.GetValueOnGameThread();
+	int32 CellBudget = CVarFlowFieldIntegrationCellsPerFrame.GetValueOnGameThread();
+	for (auto It = Fields.CreateIterator(); It; ++It)
+	{
+		FCFlowField& Field = It->Value;
+		const AActor* Goal = Field.Goal.Get();
+		if (!Goal)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (Field.PendingSamples.Num() > 0)
+		{
+			SampleBudget -= ProcessSamples(Field, SampleBudget);
+
+			// Keep steering with the previous directions until the repair is complete
+			if (Field.PendingSamples.Num() > 0)
+			{
+				continue;
+			}
+		}
+
+		// A goal that moves (e.g. a roaming objective) needs a new integration pass
+		const FIntPoint GoalCell = Field.ToCell(Goal->GetActorLocation());
+		if (GoalCell != (Field.bIntegrating ? Field.PendingGoalCell : Field.GoalCell))
+		{
+			Field.bNeedsIntegration = true;
+		}
+
+		if (Field.bNeedsIntegration || (!Field.bReady && !Field.bIntegrating))
+		{
+			BeginIntegration(Field);
+		}
+
+		if (Field.bIntegrating && CellBudget > 0)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_CFlowFieldIntegrate);
+			const double SliceStart = FPlatformTime::Seconds();
+			CellBudget -= ContinueIntegration(Field, CellBudget);
+			const double SliceSeconds = FPlatformTime::Seconds() - SliceStart;
+
+			Field.IntegrationSeconds += SliceSeconds;
+			++Field.IntegrationFrames;
+			Counters.MaxSliceSeconds = FMath::Max(Counters.MaxSliceSeconds, SliceSeconds);
+			if (!Field.bIntegrating)
+			{
+				++Counters.Integrations;
+				Counters.LastIntegrationSeconds = Field.IntegrationSeconds;
+				Counters.LastIntegrationFrames = Field.IntegrationFrames;
+			}
+		}
+	}
+}
+
+TStatId UCFlowFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCFlowFieldSubsystem, STATGROUP_Tickables);
+}
+
+UCFlowFieldSubsystem* UCFlowFieldSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCFlowFieldSubsystem>() : nullptr;
+}
+
+void UCFlowFieldSubsystem::RegisterLane(uint8 TeamId, AActor* Goal, const FBox& LaneBounds)
+{
+	if (!Goal || !LaneBounds.IsValid)
+	{
+		return;
+	}
+
+	const FLaneKey Key(TeamId, Goal);
+	FBox Bounds = LaneBounds + Goal->GetActorLocation();
+	if (const FCFlowField* Existing = Fields.Find(Key))
+	{
+		if (Existing->GetBounds().IsInsideXY(Bounds))
+		{
+			return;
+		}
+		Bounds += Existing->GetBounds();
+	}
+
+	FCFlowField& Field = Fields.Add(Key);
+	Field.Goal = Goal;
+	Field.TeamId = TeamId;
+	Field.Origin = FVector(Bounds.Min.X, Bounds.Min.Y, Bounds.GetCenter().Z);
+	Field.SizeX = FMath::Max(1, FMath::CeilToInt32(Bounds.GetSize().X / CellSize));
+	Field.SizeY = FMath::Max(1, FMath::CeilToInt32(Bounds.GetSize().Y / CellSize));
+	// Leave room for slopes along the lane when projecting onto the navmesh
+	Field.SampleHeight = Bounds.GetExtent().Z + 500.f;
+
+	Field.Walkable.Init(false, Field.NumCells());
+	Field.FloorHeights.Init(Field.Origin.Z, Field.NumCells());
+	Field.IsPending.Init(false, Field.NumCells());
+	QueueSamples(Field, Field.GetBounds());
+
+	UE_LOG(LogTemp, Log, TEXT("Flow field for team %d -> %s: %dx%d cells"), TeamId, *Goal->GetName(), Field.SizeX, Field.SizeY);
+}
+
+bool UCFlowFieldSubsystem::SampleDirection(uint8 TeamId, const AActor* Goal, const FVector& Location, FVector& OutDirection) const
+{
+	if (!CVarFlowFieldEnable.GetValueOnGameThread() || !Goal)
+	{
+		return false;
+	}
+
+	const FCFlowField* Field = Fields.Find(FLaneKey(TeamId, Goal));
+	if (!Field || !Field->bReady)
+	{
+		return false;
+	}
+
+	const FIntPoint Cell = Field->ToCell(Location);
+	if (!Field->IsValidCell(Cell.X, Cell.Y) || Field->Directions[Field->ToIndex(Cell.X, Cell.Y)].IsNearlyZero())
+	{
+		return false;
+	}
+
+	// Blend the four cells around Location so minions turn smoothly instead of in 45 degree steps
+	const float GridX = (Location.X - Field->Origin.X) / CellSize - 0.5f;
+	const float GridY = (Location.Y - Field->Origin.Y) / CellSize - 0.5f;
+	const int32 X0 = FMath::FloorToInt32(GridX);
+	const int32 Y0 = FMath::FloorToInt32(GridY);
+	const float TX = GridX - X0;
+	const float TY = GridY - Y0;
+
+	FVector2f Blended = FVector2f::ZeroVector;
+	for (int32 DY = 0; DY <= 1; ++DY)
+	{
+		for (int32 DX = 0; DX <= 1; ++DX)
+		{
+			if (Field->IsValidCell(X0 + DX, Y0 + DY))
+			{
+				const float Weight = (DX ? TX : 1.f - TX) * (DY ? TY : 1.f - TY);
+				Blended += Field->Directions[Field->ToIndex(X0 + DX, Y0 + DY)] * Weight;
+			}
+		}
+	}
+
+	if (Blended.IsNearlyZero())
+	{
+		return false;
+	}
+
+	OutDirection = FVector(Blended.X, Blended.Y, 0.f).GetSafeNormal();
+	return true;
+}
+
+bool UCFlowFieldSubsystem::BuildPath(uint8 TeamId, const AActor* Goal, const FVector& Start, TArray<FVector>& OutPoints)
+{
+	if (!CVarFlowFieldEnable.GetValueOnGameThread() || !Goal)
+	{
+		return false;
+	}
+
+	const FCFlowField* Field = Fields.Find(FLaneKey(TeamId, Goal));
+	if (!Field)
+	{
+		return false;
+	}
+
+	if (!Field->bReady || !TracePath(*Field, *Goal, Start, OutPoints))
+	{
+		++Counters.PathsRefused;
+		return false;
+	}
+
+	++Counters.PathsBuilt;
+	return true;
+}
+
+FNavPathSharedPtr UCFlowFieldSubsystem::BuildNavPath(const AAIController& Controller, const AActor* Goal)
+{
+	const APawn* Pawn = Controller.GetPawn();
+	TArray<FVector> PathPoints;
+	if (!Pawn || !BuildPath(Controller.GetGenericTeamId().GetId(), Goal, Pawn->GetActorLocation(), PathPoints))
+	{
+		return nullptr;
+	}
+
+	// Keep the nav data, so a navmesh rebuild under the path still triggers a regular repath
+	FNavPathSharedPtr Path = MakeShared<FNavigationPath, ESPMode::ThreadSafe>(PathPoints);
+	if (const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		Path->SetNavigationDataUsed(NavSys->GetNavDataForProps(Controller.GetNavAgentPropertiesRef(), Controller.GetNavAgentLocation()));
+	}
+	Path->SetQuerier(&Controller);
+	return Path;
+}
+
+bool UCFlowFieldSubsystem::TracePath(const FCFlowField& Field, const AActor& Goal, const FVector& Start, TArray<FVector>& OutPoints)
+{
+	// Around the goal a regular path is short and more precise
+	FIntPoint Cell = Field.ToCell(Start);
+	if (!Field.IsValidCell(Cell.X, Cell.Y) || Field.IsGoalSeedCell(Cell, Field.GoalCell))
+	{
+		return false;
+	}
+
+	OutPoints.Reset();
+	OutPoints.Add(FVector(Start.X, Start.Y, Field.FloorHeights[Field.ToIndex(Cell.X, Cell.Y)]));
+
+	// Non-seed cells point at a neighbour, so the route is a chain of cells; keep the cells where it turns
+	FIntPoint LastStep = FIntPoint::ZeroValue;
+	for (int32 NumSteps = 0; NumSteps < Field.NumCells(); ++NumSteps)
+	{
+		if (Field.IsGoalSeedCell(Cell, Field.GoalCell))
+		{
+			const FVector GoalLocation = Goal.GetActorLocation();
+			OutPoints.Add(FVector(GoalLocation.X, GoalLocation.Y, Field.FloorHeights[Field.ToIndex(Cell.X, Cell.Y)]));
+			return true;
+		}
+
+		const FVector2f Direction = Field.Directions[Field.ToIndex(Cell.X, Cell.Y)];
+		const FIntPoint Step(FMath::RoundToInt32(Direction.X), FMath::RoundToInt32(Direction.Y));
+		if (Step == FIntPoint::ZeroValue)
+		{
+			// Unreachable from here
+			return false;
+		}
+
+		if (NumSteps > 0 && Step != LastStep)
+		{
+			OutPoints.Add(Field.GetFloorLocation(Cell.X, Cell.Y));
+		}
+		LastStep = Step;
+		Cell += Step;
+	}
+
+	return false;
+}
+
+int32 UCFlowFieldSubsystem::GetNumCells() const
+{
+	int32 NumCells = 0;
+	for (const TPair<FLaneKey, FCFlowField>& Pair : Fields)
+	{
+		NumCells += Pair.Value.NumCells();
+	}
+	return NumCells;
+}
+
+void UCFlowFieldSubsystem::MarkDirty(const FBox& Bounds)
+{
+	for (TPair<FLaneKey, FCFlowField>& Pair : Fields)
+	{
+		if (Pair.Value.GetBounds().IntersectXY(Bounds))
+		{
+			QueueSamples(Pair.Value, Bounds);
+		}
+	}
+}
+
+void UCFlowFieldSubsystem::HandleNavigationDirtied(const FBox& Bounds)
+{
+	// The tiles under Bounds are rebuilt later; sampling them now would read the old navmesh
+	if (Bounds.IsValid)
+	{
+		DirtyAreas.Add(Bounds);
+	}
+}
+
+void UCFlowFieldSubsystem::HandleNavigationGenerationFinished(ANavigationData* NavData)
+{
+	// A full rebuild dirties nothing on its own, so resample whole lanes only then
+	if (DirtyAreas.Num() == 0)
+	{
+		for (TPair<FLaneKey, FCFlowField>& Pair : Fields)
+		{
+			QueueSamples(Pair.Value, Pair.Value.GetBounds());
+		}
+		return;
+	}
+
+	for (const FBox& Bounds : DirtyAreas)
+	{
+		MarkDirty(Bounds);
+	}
+	DirtyAreas.Reset();
+}
+
+void UCFlowFieldSubsystem::QueueSamples(FCFlowField& Field, const FBox& Bounds)
+{
+	const FIntPoint MinCell = Field.ToCell(Bounds.Min);
+	const FIntPoint MaxCell = Field.ToCell(Bounds.Max);
+	for (int32 Y = FMath::Max(MinCell.Y, 0); Y <= FMath::Min(MaxCell.Y, Field.SizeY - 1); ++Y)
+	{
+		for (int32 X = FMath::Max(MinCell.X, 0); X <= FMath::Min(MaxCell.X, Field.SizeX - 1); ++X)
+		{
+			const int32 Index = Field.ToIndex(X, Y);
+			if (!Field.IsPending[Index])
+			{
+				Field.IsPending[Index] = true;
+				Field.PendingSamples.Add(Index);
+			}
+		}
+	}
+}
+
+int32 UCFlowFieldSubsystem::ProcessSamples(FCFlowField& Field, int32 MaxSamples)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CFlowFieldSample);
+
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys)
+	{
+		return 0;
+	}
+
+	const float HalfCell = CellSize * 0.5f;
+	const FVector Extent(HalfCell, HalfCell, Field.SampleHeight);
+
+	int32 NumSampled = 0;
+	while (Field.PendingSamples.Num() > 0 && NumSampled < MaxSamples)
+	{
+		const int32 Index = Field.PendingSamples.Pop(EAllowShrinking::No);
+		Field.IsPending[Index] = false;
+		++NumSampled;
+
+		// Only count the cell as walkable if the projection stayed inside it
+		const FVector Center = Field.GetCellCenter(Index % Field.SizeX, Index / Field.SizeX);
+		FNavLocation NavLocation;
+		const bool bWalkable = NavSys->ProjectPointToNavigation(Center, NavLocation, Extent)
+			&& FMath::Abs(NavLocation.Location.X - Center.X) <= HalfCell
+			&& FMath::Abs(NavLocation.Location.Y - Center.Y) <= HalfCell;
+
+		if (bWalkable)
+		{
+			Field.FloorHeights[Index] = NavLocation.Location.Z;
+		}
+
+		if (Field.Walkable[Index] != bWalkable)
+		{
+			Field.Walkable[Index] = bWalkable;
+			Field.bNeedsIntegration = true;
+		}
+	}
+	return NumSampled;
+}
+
+void UCFlowFieldSubsystem::BeginIntegration(FCFlowField& Field)
+{
+	Field.bNeedsIntegration = false;
+	const AActor* Goal = Field.Goal.Get();
+	if (!Goal)
+	{
+		return;
+	}
+
+	Field.PendingIntegration.Init(TNumericLimits<float>::Max(), Field.NumCells());
+	Field.Open.Reset();
+	Field.PendingGoalLocation = Goal->GetActorLocation();
+	Field.PendingGoalCell = Field.ToCell(Field.PendingGoalLocation);
+	Field.bIntegrating = true;
+	Field.IntegrationFrames = 0;
+	Field.IntegrationSeconds = 0.0;
+
+	const FIntPoint& GoalCell = Field.PendingGoalCell;
+	for (int32 Y = GoalCell.Y - FlowFieldGoalSeedRadius; Y <= GoalCell.Y + FlowFieldGoalSeedRadius; ++Y)
+	{
+		for (int32 X = GoalCell.X - FlowFieldGoalSeedRadius; X <= GoalCell.X + FlowFieldGoalSeedRadius; ++X)
+		{
+			if (IsFlowFieldWalkable(Field, X, Y))
+			{
+				const int32 Index = Field.ToIndex(X, Y);
+				Field.PendingIntegration[Index] = FVector2D::Distance(FVector2D(X, Y), FVector2D(GoalCell));
+				Field.Open.HeapPush(TPair<float, int32>(Field.PendingIntegration[Index], Index), FlowFieldCheaper);
+			}
+		}
+	}
+}
+
+int32 UCFlowFieldSubsystem::ContinueIntegration(FCFlowField& Field, int32 MaxCells)
+{
+	int32 NumSettled = 0;
+	while (Field.Open.Num() > 0 && NumSettled < MaxCells)
+	{
+		TPair<float, int32> Current;
+		Field.Open.HeapPop(Current, FlowFieldCheaper, EAllowShrinking::No);
+		if (Current.Key > Field.PendingIntegration[Current.Value])
+		{
+			continue;
+		}
+		++NumSettled;
+
+		const int32 X = Current.Value % Field.SizeX;
+		const int32 Y = Current.Value / Field.SizeX;
+		for (const FIntPoint& Step : FlowFieldNeighbours)
+		{
+			if (!CanFlowFieldStep(Field, X, Y, Step))
+			{
+				continue;
+			}
+
+			const int32 Neighbour = Field.ToIndex(X + Step.X, Y + Step.Y);
+			const float Cost = Current.Key + ((Step.X != 0 && Step.Y != 0) ? UE_SQRT_2 : 1.f);
+			if (Cost < Field.PendingIntegration[Neighbour])
+			{
+				Field.PendingIntegration[Neighbour] = Cost;
+				Field.Open.HeapPush(TPair<float, int32>(Cost, Neighbour), FlowFieldCheaper);
+			}
+		}
+	}
+
+	if (Field.Open.Num() == 0)
+	{
+		FinishIntegration(Field);
+	}
+	return NumSettled;
+}
+
+void UCFlowFieldSubsystem::FinishIntegration(FCFlowField& Field)
+{
+	// One linear pass; swap the finished pass in so queries never see a half-built field
+	Field.Integration = MoveTemp(Field.PendingIntegration);
+	Field.PendingIntegration.Reset();
+	Field.Open.Empty();
+	Field.GoalCell = Field.PendingGoalCell;
+	Field.bIntegrating = false;
+	Field.bReady = true;
+
+	Field.Directions.Init(FVector2f::ZeroVector, Field.NumCells());
+	for (int32 Y = 0; Y < Field.SizeY; ++Y)
+	{
+		for (int32 X = 0; X < Field.SizeX; ++X)
+		{
+			const int32 Index = Field.ToIndex(X, Y);
+			if (Field.Integration[Index] == TNumericLimits<float>::Max())
+			{
+				continue;
+			}
+
+			// Seed cells head straight for the goal, everything else for its cheapest neighbour
+			if (Field.IsGoalSeedCell(FIntPoint(X, Y), Field.GoalCell))
+			{
+				const FVector ToGoal = Field.PendingGoalLocation - Field.GetCellCenter(X, Y);
+				Field.Directions[Index] = FVector2f(FVector2D(ToGoal).GetSafeNormal());
+				continue;
+			}
+
+			float BestCost = Field.Integration[Index];
+			for (const FIntPoint& Step : FlowFieldNeighbours)
+			{
+				if (CanFlowFieldStep(Field, X, Y, Step) && Field.Integration[Field.ToIndex(X + Step.X, Y + Step.Y)] < BestCost)
+				{
+					BestCost = Field.Integration[Field.ToIndex(X + Step.X, Y + Step.Y)];
+					Field.Directions[Index] = FVector2f(Step.X, Step.Y).GetSafeNormal();
+				}
+			}
+		}
+	}
+}
+
+void UCFlowFieldSubsystem::Benchmark(int32 NumPaths, FOutputDevice& Ar) const
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance() : nullptr;
+
+	for (const TPair<FLaneKey, FCFlowField>& Pair : Fields)
+	{
+		const FCFlowField& Field = Pair.Value;
+		const AActor* Goal = Field.Goal.Get();
+		if (!Field.bReady || !Goal)
+		{
+			continue;
+		}
+
+		// A copy, so the live field keeps its state
+		FCFlowField Scratch = Field;
+		const double IntegrateStart = FPlatformTime::Seconds();
+		BeginIntegration(Scratch);
+		ContinueIntegration(Scratch, MAX_int32);
+		const double IntegrateSeconds = FPlatformTime::Seconds() - IntegrateStart;
+
+		TArray<FVector> Starts;
+		FRandomStream Stream(Field.SizeX * 31 + Field.SizeY);
+		for (int32 Attempt = 0; Attempt < NumPaths * 20 && Starts.Num() < NumPaths; ++Attempt)
+		{
+			const int32 X = Stream.RandHelper(Field.SizeX);
+			const int32 Y = Stream.RandHelper(Field.SizeY);
+			if (Field.Walkable[Field.ToIndex(X, Y)] && !Field.IsGoalSeedCell(FIntPoint(X, Y), Field.GoalCell))
+			{
+				Starts.Add(Field.GetFloorLocation(X, Y));
+			}
+		}
+
+		TArray<FVector> Points;
+		int32 NumFieldPaths = 0;
+		const double FieldStart = FPlatformTime::Seconds();
+		for (const FVector& Start : Starts)
+		{
+			NumFieldPaths += TracePath(Field, *Goal, Start, Points) ? 1 : 0;
+		}
+		const double FieldSeconds = FPlatformTime::Seconds() - FieldStart;
+
+		int32 NumNavPaths = 0;
+		const double NavStart = FPlatformTime::Seconds();
+		if (NavData)
+		{
+			for (const FVector& Start : Starts)
+			{
+				const FPathFindingQuery Query(nullptr, *NavData, Start, Goal->GetActorLocation());
+				NumNavPaths += NavSys->FindPathSync(Query).IsSuccessful() ? 1 : 0;
+			}
+		}
+		const double NavSeconds = FPlatformTime::Seconds() - NavStart;
+
+		Ar.Logf(TEXT("Flow field team %d -> %s: %dx%d cells"), Field.TeamId, *Goal->GetName(), Field.SizeX, Field.SizeY);
+		Ar.Logf(TEXT("  full integration %.2f ms in one frame, ~%d frames at %d cells per frame"), IntegrateSeconds * 1000.0,
+			FMath::DivideAndRoundUp(Field.Walkable.CountSetBits(), FMath::Max(CVarFlowFieldIntegrationCellsPerFrame.GetValueOnGameThread(), 1)),
+			CVarFlowFieldIntegrationCellsPerFrame.GetValueOnGameThread());
+		Ar.Logf(TEXT("  %d field paths %.1f us each, %d navmesh paths %.1f us each"),
+			NumFieldPaths, Starts.Num() > 0 ? FieldSeconds * 1000000.0 / Starts.Num() : 0.0,
+			NumNavPaths, Starts.Num() > 0 && NavData ? NavSeconds * 1000000.0 / Starts.Num() : 0.0);
+	}
+}
+
+static void FlowFieldStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UCFlowFieldSubsystem* FlowFields = UCFlowFieldSubsystem::Get(World);
+	if (!FlowFields)
+	{
+		Ar.Log(TEXT("Crunch.FlowField.Stats: no flow field subsystem in this world"));
+		return;
+	}
+
+	const FCFlowFieldCounters& Counters = FlowFields->GetCounters();
+	Ar.Logf(TEXT("Flow fields: %d fields, %d cells"), FlowFields->GetNumFields(), FlowFields->GetNumCells());
+	Ar.Logf(TEXT("  integrations %d, last %.2f ms over %d frames, worst frame %.2f ms"),
+		Counters.Integrations, Counters.LastIntegrationSeconds * 1000.0, Counters.LastIntegrationFrames, Counters.MaxSliceSeconds * 1000.0);
+	Ar.Logf(TEXT("  lane moves answered by a field path %lld, sent to pathfinding %lld"), Counters.PathsBuilt, Counters.PathsRefused);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice FlowFieldStatsCommand(
+	TEXT("Crunch.FlowField.Stats"),
+	TEXT("Crunch.FlowField.Stats: print the lane flow fields, the cost of their integration and how many minion moves they answered."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FlowFieldStats));
+
+static void FlowFieldBenchmark(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UCFlowFieldSubsystem* FlowFields = UCFlowFieldSubsystem::Get(World);
+	if (!FlowFields || FlowFields->GetNumFields() == 0)
+	{
+		Ar.Log(TEXT("Crunch.FlowField.Benchmark: no lane flow field in this world"));
+		return;
+	}
+
+	FlowFields->Benchmark(Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 200, Ar);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice FlowFieldBenchmarkCommand(
+	TEXT("Crunch.FlowField.Benchmark"),
+	TEXT("Crunch.FlowField.Benchmark [Paths=200]: time a full integration of every lane flow field, and field paths against navmesh paths from the same random lane cells."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FlowFieldBenchmark));
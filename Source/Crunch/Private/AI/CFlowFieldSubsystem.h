@@ -0,0 +1,194 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AI/Navigation/NavigationTypes.h"
+// ----------------------------------------------------------------------------
+// File: CFlowFieldSubsystem.h
+// Purpose: Shared lane navigation for minion waves. One flow field per
+//          (team, goal) is baked over the lane's navmesh and sampled by every
+//          minion marching down that lane, instead of each minion requesting
+//          its own path to the same goal.
+// Key API:
+//  - RegisterLane: called by AMinionBarrack with the lane bounds.
+//  - SampleDirection: O(1) cell lookup returning the direction toward the goal.
+//  - BuildPath: the corners of the field's route to the goal.
+//  - BuildNavPath: the same route as a navigation path, handed to path
+//    following by ACAIController::MoveTo and UCPathRequestSubsystem instead
+//    of a navmesh query.
+//  - MarkDirty: resample the navmesh under a box. Areas the navigation system
+//    dirties (dynamic obstacles, streamed tiles) are resampled this way once
+//    the navmesh has been rebuilt.
+// Notes:
+//  - Navmesh samples (Crunch.FlowField.SamplesPerFrame) and integration
+//    (Crunch.FlowField.IntegrationCellsPerFrame) are spread over frames.
+//  - Crunch.FlowField.Enable 0 sends minions back to per-agent pathfinding.
+//  - Crunch.FlowField.Stats prints the integration cost and how many moves the
+//    fields answered; Crunch.FlowField.Benchmark compares them with navmesh paths.
+// ----------------------------------------------------------------------------
+#include "CFlowFieldSubsystem.generated.h"
+
+class AAIController;
+class ANavigationData;
+
+/**
+ * Uniform grid over one lane. Walkable cells hold their navmesh floor height,
+ * their cost-to-goal (integration field) and the direction toward their
+ * cheapest neighbour (flow field).
+ */
+struct FCFlowField
+{
+	TWeakObjectPtr<AActor> Goal;
+	uint8 TeamId = 0;
+
+	/** Minimum corner of the grid; Z is the reference height for navmesh samples */
+	FVector Origin = FVector::ZeroVector;
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+	float SampleHeight = 0.f;
+
+	TBitArray<> Walkable;
+	TArray<float> FloorHeights;
+	TArray<float> Integration;
+	TArray<FVector2f> Directions;
+
+	/** Cells still waiting for a navmesh sample */
+	TArray<int32> PendingSamples;
+	TBitArray<> IsPending;
+
+	FIntPoint GoalCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+	bool bNeedsIntegration = false;
+
+	/**
+	 * Integration in progress, spread over frames. Integration, Directions and
+	 * GoalCell keep serving queries until it completes.
+	 */
+	TArray<float> PendingIntegration;
+	TArray<TPair<float, int32>> Open;
+	FVector PendingGoalLocation = FVector::ZeroVector;
+	FIntPoint PendingGoalCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+	bool bIntegrating = false;
+	int32 IntegrationFrames = 0;
+	double IntegrationSeconds = 0.0;
+
+	/** Set once the first full sample + integration pass is done */
+	bool bReady = false;
+
+	int32 NumCells() const { return SizeX * SizeY; }
+	bool IsValidCell(int32 X, int32 Y) const { return X >= 0 && Y >= 0 && X < SizeX && Y < SizeY; }
+	int32 ToIndex(int32 X, int32 Y) const { return Y * SizeX + X; }
+	FIntPoint ToCell(const FVector& Location) const;
+	FVector GetCellCenter(int32 X, int32 Y) const;
+	/** Cell center on the navmesh floor */
+	FVector GetFloorLocation(int32 X, int32 Y) const;
+	bool IsGoalSeedCell(const FIntPoint& Cell, const FIntPoint& InGoalCell) const;
+	FBox GetBounds() const;
+};
+
+/** Integration and path totals since the world started, for Crunch.FlowField.Stats */
+struct FCFlowFieldCounters
+{
+	int32 Integrations = 0;
+	/** Sum of the slices of the last completed integration, and over how many frames */
+	double LastIntegrationSeconds = 0.0;
+	int32 LastIntegrationFrames = 0;
+	/** Most expensive single frame of integration */
+	double MaxSliceSeconds = 0.0;
+
+	/** Moves answered by BuildPath, and lane moves it could not answer */
+	int64 PathsBuilt = 0;
+	int64 PathsRefused = 0;
+};
+
+/**
+ * UCFlowFieldSubsystem owns the lane flow fields of a world and keeps them in
+ * sync with the navmesh. Fields are keyed by team and goal actor, so barracks
+ * of the same team sending minions to the same goal share one field.
+ *
+ * Integration is an incremental Dijkstra: at most IntegrationCellsPerFrame
+ * cells are settled per frame, into scratch arrays, and the directions are
+ * swapped in once the pass is complete. A goal that changes cell mid-pass
+ * restarts it.
+ */
+UCLASS()
+class UCFlowFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Create (or grow) the field for this team and goal so it covers LaneBounds */
+	void RegisterLane(uint8 TeamId, AActor* Goal, const FBox& LaneBounds);
+
+	/**
+	 * Direction (unit, horizontal) from Location toward the goal along the lane.
+	 * Returns false when the field is disabled, not built yet, or Location is off
+	 * the lane; callers should fall back to regular pathfinding.
+	 */
+	bool SampleDirection(uint8 TeamId, const AActor* Goal, const FVector& Location, FVector& OutDirection) const;
+
+	/**
+	 * Trace the field from Start to the goal and return the route's corners on
+	 * the navmesh floor, Start and the goal included. Returns false (callers
+	 * pathfind) when the field is disabled or not built, Start is off the lane
+	 * or already around the goal.
+	 */
+	bool BuildPath(uint8 TeamId, const AActor* Goal, const FVector& Start, TArray<FVector>& OutPoints);
+
+	/** BuildPath from Controller's pawn with its team, as a path ready for RequestMove; null when the field cannot answer */
+	FNavPathSharedPtr BuildNavPath(const AAIController& Controller, const AActor* Goal);
+
+	const FCFlowFieldCounters& GetCounters() const { return Counters; }
+	int32 GetNumFields() const { return Fields.Num(); }
+	int32 GetNumCells() const;
+
+	/** Time a full integration of every field and NumPaths field paths against navmesh paths */
+	void Benchmark(int32 NumPaths, FOutputDevice& Ar) const;
+
+	/** Resample the navmesh under Bounds in every field that overlaps it */
+	void MarkDirty(const FBox& Bounds);
+
+	static UCFlowFieldSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Edge length of a flow field cell */
+	static constexpr float CellSize = 200.f;
+
+private:
+	typedef TPair<uint8, TObjectKey<AActor>> FLaneKey;
+
+	void QueueSamples(FCFlowField& Field, const FBox& Bounds);
+
+	/** Returns the number of navmesh samples taken */
+	int32 ProcessSamples(FCFlowField& Field, int32 MaxSamples);
+
+	/** Seed a new Dijkstra pass from the cells around the goal */
+	static void BeginIntegration(FCFlowField& Field);
+
+	/** Settle up to MaxCells cells; once the pass is complete, point every cell at its cheapest neighbour. Returns the cells settled. */
+	static int32 ContinueIntegration(FCFlowField& Field, int32 MaxCells);
+
+	static void FinishIntegration(FCFlowField& Field);
+
+	/** BuildPath on one field, without counting */
+	static bool TracePath(const FCFlowField& Field, const AActor& Goal, const FVector& Start, TArray<FVector>& OutPoints);
+
+	void HandleNavigationDirtied(const FBox& Bounds);
+
+	UFUNCTION()
+	void HandleNavigationGenerationFinished(ANavigationData* NavData);
+
+	TMap<FLaneKey, FCFlowField> Fields;
+
+	/** Areas dirtied since the last navmesh build; resampled when it finishes */
+	TArray<FBox> DirtyAreas;
+
+	FDelegateHandle NavigationDirtiedHandle;
+
+	FCFlowFieldCounters Counters;
+};
@@ -0,0 +1,384 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/CMinionLODSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "AI/CFlowFieldSubsystem.h"
+#include "AI/Minion.h"
+#include "AI/MinionBarrack.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "Framework/CSpatialIndexSubsystem.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GAS/CAttributeSet.h"
+#include "HAL/IConsoleManager.h"
+#include "NavigationSystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Minion LOD"), STAT_CMinionLOD, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Minion LOD Records"), STAT_CMinionLODRecords, STATGROUP_AI);
+
+static TAutoConsoleVariable<bool> CVarMinionLODEnable(
+	TEXT("Crunch.MinionLOD.Enable"),
+	true,
+	TEXT("Demote minions far from every hero to simulated records. Turning it off promotes every record."));
+
+static TAutoConsoleVariable<float> CVarMinionLODCheckInterval(
+	TEXT("Crunch.MinionLOD.CheckInterval"),
+	0.5f,
+	TEXT("Seconds between two demote / promote passes."));
+
+static TAutoConsoleVariable<float> CVarMinionLODDemoteDistance(
+	TEXT("Crunch.MinionLOD.DemoteDistance"),
+	6000.f,
+	TEXT("A minion with no hero closer than this is demoted."));
+
+static TAutoConsoleVariable<float> CVarMinionLODPromoteDistance(
+	TEXT("Crunch.MinionLOD.PromoteDistance"),
+	4500.f,
+	TEXT("A record with a hero closer than this is promoted. Keep it below DemoteDistance."));
+
+static TAutoConsoleVariable<float> CVarMinionLODEngageRange(
+	TEXT("Crunch.MinionLOD.EngageRange"),
+	400.f,
+	TEXT("Records fight enemy records within this range; a hostile actor within this range promotes a record and keeps a minion from being demoted."));
+
+static TAutoConsoleVariable<float> CVarMinionLODGoalDistance(
+	TEXT("Crunch.MinionLOD.GoalDistance"),
+	1500.f,
+	TEXT("Minions this close to their goal are never simulated, so the goal is always reached by an actor."));
+
+/** Vertical reach of the floor projection; lanes climb less than this between two refreshes */
+static constexpr float MinionLODFloorSearchHeight = 1000.f;
+
+void UCMinionLODSubsystem::Deinitialize()
+{
+	Lanes.Empty();
+	Positions.Empty();
+	Directions.Empty();
+	HalfHeights.Empty();
+	Healths.Empty();
+	Speeds.Empty();
+	DamagePerSecond.Empty();
+	RecordLanes.Empty();
+	Targets.Empty();
+	Super::Deinitialize();
+}
+
+void UCMinionLODSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Lanes.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CMinionLOD);
+
+	const UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this);
+	if (!CVarMinionLODEnable.GetValueOnGameThread())
+	{
+		if (Positions.Num() > 0)
+		{
+			PromoteRecords(SpatialIndex, true);
+		}
+		return;
+	}
+
+	CheckTimer -= DeltaTime;
+	if (CheckTimer <= 0.f)
+	{
+		CheckTimer = CVarMinionLODCheckInterval.GetValueOnGameThread();
+		GatherHeroLocations();
+		PromoteRecords(SpatialIndex, false);
+		DemoteMinions(SpatialIndex);
+		RefreshRecords();
+	}
+
+	Simulate(DeltaTime);
+	SET_DWORD_STAT(STAT_CMinionLODRecords, Positions.Num());
+}
+
+TStatId UCMinionLODSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCMinionLODSubsystem, STATGROUP_Tickables);
+}
+
+void UCMinionLODSubsystem::RegisterBarrack(AMinionBarrack* Barrack)
+{
+	if (!Barrack || Lanes.ContainsByPredicate([Barrack](const FLane& Lane) { return Lane.Barrack == Barrack; }))
+	{
+		return;
+	}
+
+	FLane& Lane = Lanes.AddDefaulted_GetRef();
+	Lane.Barrack = Barrack;
+	Lane.Goal = Barrack->GetGoal();
+	Lane.TeamId = Barrack->GetBarrackTeamId().GetId();
+}
+
+UCMinionLODSubsystem* UCMinionLODSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCMinionLODSubsystem>() : nullptr;
+}
+
+void UCMinionLODSubsystem::GatherHeroLocations()
+{
+	HeroLocations.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (const APawn* Hero = PlayerController ? PlayerController->GetPawn() : nullptr)
+		{
+			HeroLocations.Add(Hero->GetActorLocation());
+		}
+	}
+}
+
+bool UCMinionLODSubsystem::IsNearHero(const FVector& Location, float Distance) const
+{
+	const float DistanceSquared = FMath::Square(Distance);
+	for (const FVector& HeroLocation : HeroLocations)
+	{
+		if (FVector::DistSquared(Location, HeroLocation) < DistanceSquared)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void UCMinionLODSubsystem::DemoteMinions(const UCSpatialIndexSubsystem* SpatialIndex)
+{
+	const float DemoteDistance = CVarMinionLODDemoteDistance.GetValueOnGameThread();
+	const float EngageRange = CVarMinionLODEngageRange.GetValueOnGameThread();
+	const float GoalDistanceSquared = FMath::Square(CVarMinionLODGoalDistance.GetValueOnGameThread());
+
+	for (int32 LaneIndex = 0; LaneIndex < Lanes.Num(); ++LaneIndex)
+	{
+		AMinionBarrack* Barrack = Lanes[LaneIndex].Barrack.Get();
+		const AActor* Goal = Lanes[LaneIndex].Goal.Get();
+		if (!Barrack)
+		{
+			continue;
+		}
+
+		for (AMinion* Minion : Barrack->GetMinionPool())
+		{
+			if (!IsValid(Minion) || !Minion->IsActive())
+			{
+				continue;
+			}
+
+			const FVector Location = Minion->GetActorLocation();
+			if (IsNearHero(Location, DemoteDistance)
+				|| (Goal && FVector::DistSquared2D(Location, Goal->GetActorLocation()) < GoalDistanceSquared)
+				|| (SpatialIndex && SpatialIndex->FindNearest(Location, EngageRange, FCSpatialQueryFilter::Hostile(Minion))))
+			{
+				continue;
+			}
+
+			const UAbilitySystemComponent* ASC = Minion->GetAbilitySystemComponent();
+			const float Health = ASC ? ASC->GetNumericAttribute(UCAttributeSet::GetHealthAttribute()) : 0.f;
+			if (Health <= 0.f)
+			{
+				continue;
+			}
+
+			const float AttackDamage = ASC->GetNumericAttribute(UCAttributeSet::GetAttackDamageAttribute());
+			AddRecord(LaneIndex, Location, Minion->GetCapsuleComponent()->GetScaledCapsuleHalfHeight(), Health, Minion->GetCharacterMovement()->MaxWalkSpeed, AttackDamage * Barrack->GetSimulatedAttacksPerSecond());
+
+			Barrack->DemoteMinion(Minion);
+			++NumDemoted;
+		}
+	}
+}
+
+void UCMinionLODSubsystem::PromoteRecords(const UCSpatialIndexSubsystem* SpatialIndex, bool bPromoteAll)
+{
+	const float PromoteDistance = CVarMinionLODPromoteDistance.GetValueOnGameThread();
+	const float EngageRange = CVarMinionLODEngageRange.GetValueOnGameThread();
+	const float GoalDistanceSquared = FMath::Square(CVarMinionLODGoalDistance.GetValueOnGameThread());
+
+	for (int32 Index = Positions.Num() - 1; Index >= 0; --Index)
+	{
+		const FLane& Lane = Lanes[RecordLanes[Index]];
+		AMinionBarrack* Barrack = Lane.Barrack.Get();
+		if (!Barrack)
+		{
+			RemoveRecord(Index);
+			continue;
+		}
+
+		bool bPromote = bPromoteAll || IsNearHero(Positions[Index], PromoteDistance);
+		if (!bPromote && Lane.Goal.IsValid())
+		{
+			bPromote = FVector::DistSquared2D(Positions[Index], Lane.Goal->GetActorLocation()) < GoalDistanceSquared;
+		}
+		if (!bPromote && SpatialIndex)
+		{
+			FCSpatialQueryFilter Filter;
+			Filter.QuerierTeam = FGenericTeamId(Lane.TeamId);
+			bPromote = SpatialIndex->FindNearest(Positions[Index], EngageRange, Filter) != nullptr;
+		}
+		if (!bPromote)
+		{
+			continue;
+		}
+
+		// Directions moved the record in 2D since the last refresh; start the actor on the floor under it
+		SnapToFloor(Index);
+		const FRotator Rotation = Directions[Index].IsNearlyZero() ? Barrack->GetActorRotation() : Directions[Index].ToOrientationRotator();
+		if (AMinion* Minion = Barrack->ActivateMinionAt(FTransform(Rotation, Positions[Index])))
+		{
+			if (UAbilitySystemComponent* ASC = Minion->GetAbilitySystemComponent())
+			{
+				ASC->SetNumericAttributeBase(UCAttributeSet::GetHealthAttribute(), Healths[Index]);
+			}
+		}
+
+		RemoveRecord(Index);
+		++NumPromoted;
+	}
+}
+
+void UCMinionLODSubsystem::RefreshRecords()
+{
+	const UCFlowFieldSubsystem* FlowFields = UCFlowFieldSubsystem::Get(this);
+	const float EngageRangeSquared = FMath::Square(CVarMinionLODEngageRange.GetValueOnGameThread());
+
+	for (int32 Index = 0; Index < Positions.Num(); ++Index)
+	{
+		const FLane& Lane = Lanes[RecordLanes[Index]];
+		const AActor* Goal = Lane.Goal.Get();
+
+		FVector Direction = FVector::ZeroVector;
+		if (!FlowFields || !FlowFields->SampleDirection(Lane.TeamId, Goal, Positions[Index], Direction))
+		{
+			Direction = Goal ? (Goal->GetActorLocation() - Positions[Index]).GetSafeNormal2D() : FVector::ZeroVector;
+		}
+		Directions[Index] = Direction;
+		SnapToFloor(Index);
+
+		// Brute force: records only exist in the empty parts of the map, where there are few of them
+		Targets[Index] = INDEX_NONE;
+		float BestDistanceSquared = EngageRangeSquared;
+		for (int32 Other = 0; Other < Positions.Num(); ++Other)
+		{
+			if (Lanes[RecordLanes[Other]].TeamId == Lane.TeamId)
+			{
+				continue;
+			}
+
+			const float DistanceSquared = FVector::DistSquared2D(Positions[Index], Positions[Other]);
+			if (DistanceSquared < BestDistanceSquared)
+			{
+				BestDistanceSquared = DistanceSquared;
+				Targets[Index] = Other;
+			}
+		}
+	}
+}
+
+void UCMinionLODSubsystem::Simulate(float DeltaTime)
+{
+	const int32 NumRecords = Positions.Num();
+
+	// Walk the lane; engaged records hold their position
+	for (int32 Index = 0; Index < NumRecords; ++Index)
+	{
+		const float Step = Targets[Index] == INDEX_NONE ? Speeds[Index] * DeltaTime : 0.f;
+		Positions[Index] += Directions[Index] * Step;
+	}
+
+	// Simplified damage exchange: constant damage per second, no armor or abilities
+	for (int32 Index = 0; Index < NumRecords; ++Index)
+	{
+		if (Targets[Index] != INDEX_NONE)
+		{
+			Healths[Targets[Index]] -= DamagePerSecond[Index] * DeltaTime;
+		}
+	}
+
+	bool bAnyKilled = false;
+	for (int32 Index = NumRecords - 1; Index >= 0; --Index)
+	{
+		if (Healths[Index] <= 0.f)
+		{
+			// The minion is already back in its barrack's pool
+			RemoveRecord(Index);
+			++NumKilled;
+			bAnyKilled = true;
+		}
+	}
+
+	if (bAnyKilled)
+	{
+		RefreshRecords();
+	}
+}
+
+bool UCMinionLODSubsystem::SnapToFloor(int32 Index)
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys)
+	{
+		return false;
+	}
+
+	const FVector Floor = Positions[Index] - FVector(0.f, 0.f, HalfHeights[Index]);
+	FNavLocation NavLocation;
+	if (!NavSys->ProjectPointToNavigation(Floor, NavLocation, FVector(UCFlowFieldSubsystem::CellSize, UCFlowFieldSubsystem::CellSize, MinionLODFloorSearchHeight)))
+	{
+		return false;
+	}
+
+	Positions[Index] = NavLocation.Location + FVector(0.f, 0.f, HalfHeights[Index]);
+	return true;
+}
+
+void UCMinionLODSubsystem::AddRecord(int32 Lane, const FVector& Position, float HalfHeight, float Health, float Speed, float InDamagePerSecond)
+{
+	Positions.Add(Position);
+	Directions.Add(FVector::ZeroVector);
+	HalfHeights.Add(HalfHeight);
+	Healths.Add(Health);
+	Speeds.Add(Speed);
+	DamagePerSecond.Add(InDamagePerSecond);
+	RecordLanes.Add(Lane);
+	Targets.Add(INDEX_NONE);
+}
+
+void UCMinionLODSubsystem::RemoveRecord(int32 Index)
+{
+	Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Directions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	HalfHeights.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Healths.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Speeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	DamagePerSecond.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RecordLanes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Targets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+static void MinionLODStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UCMinionLODSubsystem* MinionLOD = UCMinionLODSubsystem::Get(World);
+	if (!MinionLOD)
+	{
+		Ar.Log(TEXT("Crunch.MinionLOD.Stats: no minion LOD subsystem in this world"));
+		return;
+	}
+
+	Ar.Logf(TEXT("Minion LOD: %d simulated"), MinionLOD->GetNumSimulated());
+	Ar.Logf(TEXT("  demoted  %d"), MinionLOD->GetNumDemoted());
+	Ar.Logf(TEXT("  promoted %d"), MinionLOD->GetNumPromoted());
+	Ar.Logf(TEXT("  killed while simulated %d"), MinionLOD->GetNumKilled());
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice MinionLODStatsCommand(
+	TEXT("Crunch.MinionLOD.Stats"),
+	TEXT("Crunch.MinionLOD.Stats: print how many minions are simulated as records and how many were demoted, promoted and killed."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&MinionLODStats));
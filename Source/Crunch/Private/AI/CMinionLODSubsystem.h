@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+// ----------------------------------------------------------------------------
+// File: CMinionLODSubsystem.h
+// Purpose: Simulation LOD for lane minions. Minions far from every hero are
+//          demoted from a full AMinion (mesh, ASC, controller, perception) to a
+//          small record advanced by a batched lane simulator, and promoted back
+//          to an actor from their barrack's pool when they become relevant.
+// Key API:
+//  - RegisterBarrack: AMinionBarrack opts its minions in.
+//  - GetNumSimulated: minions currently living as records.
+// Notes:
+//  - Records walk the lane flow field and fight enemy records in range with a
+//    simplified damage exchange. Their height follows the navmesh floor.
+//  - Crunch.MinionLOD.* CVars tune distances; Crunch.MinionLOD.Stats prints counts.
+// ----------------------------------------------------------------------------
+#include "CMinionLODSubsystem.generated.h"
+
+class AMinion;
+class AMinionBarrack;
+class UCSpatialIndexSubsystem;
+
+/**
+ * UCMinionLODSubsystem checks every Crunch.MinionLOD.CheckInterval seconds:
+ *  - Demote: an active minion of a registered barrack with no hero within
+ *    Crunch.MinionLOD.DemoteDistance and no hostile pawn within engage range is
+ *    returned to the pool and replaced by a record.
+ *  - Promote: a record within Crunch.MinionLOD.PromoteDistance of a hero, within
+ *    engage range of a hostile pawn, or near its goal becomes an actor again,
+ *    keeping its health.
+ *
+ * Records are stored as parallel arrays. Every frame one loop advances them
+ * along their cached lane direction and applies damage between engaged records;
+ * directions, engagements and the floor height under each record are refreshed
+ * on the check interval, so a promoted minion lands on the lane even on slopes.
+ */
+UCLASS()
+class UCMinionLODSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterBarrack(AMinionBarrack* Barrack);
+
+	int32 GetNumSimulated() const { return Positions.Num(); }
+	int32 GetNumPromoted() const { return NumPromoted; }
+	int32 GetNumDemoted() const { return NumDemoted; }
+	int32 GetNumKilled() const { return NumKilled; }
+
+	static UCMinionLODSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	struct FLane
+	{
+		TWeakObjectPtr<AMinionBarrack> Barrack;
+		TWeakObjectPtr<AActor> Goal;
+		uint8 TeamId = 0;
+	};
+
+	void GatherHeroLocations();
+	bool IsNearHero(const FVector& Location, float Distance) const;
+
+	void DemoteMinions(const UCSpatialIndexSubsystem* SpatialIndex);
+	void PromoteRecords(const UCSpatialIndexSubsystem* SpatialIndex, bool bPromoteAll);
+
+	/** Lane direction, floor height and nearest enemy record of every record */
+	void RefreshRecords();
+
+	/** Put the record on the navmesh floor under it; false when there is no navmesh close enough */
+	bool SnapToFloor(int32 Index);
+
+	void Simulate(float DeltaTime);
+
+	void AddRecord(int32 Lane, const FVector& Position, float HalfHeight, float Health, float Speed, float InDamagePerSecond);
+	void RemoveRecord(int32 Index);
+
+	TArray<FLane> Lanes;
+	TArray<FVector> HeroLocations;
+
+	// Records, one entry per demoted minion in every array
+	TArray<FVector> Positions;
+	TArray<FVector> Directions;
+	/** Capsule half height of the demoted minion: Positions are capsule centers, HalfHeight above the floor */
+	TArray<float> HalfHeights;
+	TArray<float> Healths;
+	TArray<float> Speeds;
+	TArray<float> DamagePerSecond;
+	TArray<int32> RecordLanes;
+	TArray<int32> Targets;
+
+	float CheckTimer = 0.f;
+	int32 NumPromoted = 0;
+	int32 NumDemoted = 0;
+	int32 NumKilled = 0;
+};
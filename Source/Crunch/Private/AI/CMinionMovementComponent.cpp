@@ -0,0 +1,858 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/CMinionMovementComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GAS/CForceFieldSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "NavigationData.h"
+#include "NavigationSystem.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Net/UnrealNetwork.h"
+#include "UObject/CoreNet.h"
+
+DECLARE_CYCLE_STAT(TEXT("Minion Movement Batch"), STAT_CMinionMovementBatch, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Minion Movement Updates"), STAT_CMinionMovementUpdates, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Minion Movement Nav Projections"), STAT_CMinionMovementProjections, STATGROUP_AI);
+DECLARE_CYCLE_STAT(TEXT("Minion Crowd Avoidance"), STAT_CMinionCrowdAvoidance, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Minion Crowd Agents"), STAT_CMinionCrowdAgents, STATGROUP_AI);
+
+static TAutoConsoleVariable<bool> CVarMinionMovementBatched(
+	TEXT("Crunch.MinionMovement.Batched"),
+	true,
+	TEXT("Move minion movement components in the batch. Read on the server when a character begins play; clients follow the server."));
+
+static TAutoConsoleVariable<bool> CVarMinionMovementAvoidance(
+	TEXT("Crunch.MinionMovement.Avoidance"),
+	true,
+	TEXT("Steer batched characters around each other with reciprocal velocity obstacles."));
+
+static TAutoConsoleVariable<float> CVarMinionMovementAvoidanceRadius(
+	TEXT("Crunch.MinionMovement.AvoidanceRadius"),
+	400.f,
+	TEXT("Batched characters farther apart than this ignore each other."));
+
+static TAutoConsoleVariable<int32> CVarMinionMovementAvoidanceNeighbours(
+	TEXT("Crunch.MinionMovement.AvoidanceNeighbours"),
+	10,
+	TEXT("Closest neighbours each batched character avoids."));
+
+static TAutoConsoleVariable<float> CVarMinionMovementAvoidanceTimeHorizon(
+	TEXT("Crunch.MinionMovement.AvoidanceTimeHorizon"),
+	1.f,
+	TEXT("Seconds ahead in which batched characters avoid colliding with each other."));
+
+/** Shortest and longest time a client spends blending onto the trajectory of one update */
+static constexpr float MinionMoveMinBlendTime = 1.f / 60.f;
+static constexpr float MinionMoveMaxBlendTime = 0.2f;
+
+/** Clients stop extrapolating a state after this long; the server assumes the same */
+static constexpr float MinionMoveMaxExtrapolationTime = 1.f;
+
+/** FCMinionMoveState quantization */
+static constexpr float MinionMoveLocationUnit = 2.f;
+static constexpr float MinionMoveVelocityUnit = 8.f;
+static constexpr uint32 MinionMoveAlongBits = 16;
+static constexpr uint32 MinionMoveLateralBits = 12;
+static constexpr uint32 MinionMoveHeightBits = 10;
+static constexpr uint32 MinionMoveCounterBits = 3;
+static constexpr uint8 MinionMoveCounterMask = (1 << MinionMoveCounterBits) - 1;
+
+static bool FitsSignedBits(int32 Value, uint32 NumBits)
+{
+	const int32 Bias = 1 << (NumBits - 1);
+	return Value >= -Bias && Value < Bias;
+}
+
+/** Offset binary, so the archive only deals with unsigned bits */
+static void SerializeSignedBits(FArchive& Ar, int16& Value, uint32 NumBits)
+{
+	const int32 Bias = 1 << (NumBits - 1);
+	uint32 Bits = uint32(int32(Value) + Bias);
+	Ar.SerializeBits(&Bits, NumBits);
+	if (Ar.IsLoading())
+	{
+		Value = int16(int32(Bits & ((1u << NumBits) - 1)) - Bias);
+	}
+}
+
+bool FCMinionMoveState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	SerializeSignedBits(Ar, Along, MinionMoveAlongBits);
+	SerializeSignedBits(Ar, Lateral, MinionMoveLateralBits);
+	SerializeSignedBits(Ar, Height, MinionMoveHeightBits);
+	Ar << Yaw;
+
+	uint8 Counters = (TeleportCount & MinionMoveCounterMask) | ((FrameSequence & MinionMoveCounterMask) << MinionMoveCounterBits);
+	Ar.SerializeBits(&Counters, MinionMoveCounterBits * 2);
+
+	uint8 bMoving = VelocityAlong != 0 || VelocityLateral != 0;
+	Ar.SerializeBits(&bMoving, 1);
+	if (bMoving & 1)
+	{
+		Ar << VelocityAlong;
+		Ar << VelocityLateral;
+	}
+
+	if (Ar.IsLoading())
+	{
+		TeleportCount = Counters & MinionMoveCounterMask;
+		FrameSequence = (Counters >> MinionMoveCounterBits) & MinionMoveCounterMask;
+		if (!(bMoving & 1))
+		{
+			VelocityAlong = VelocityLateral = 0;
+		}
+	}
+
+	bOutSuccess = true;
+	return true;
+}
+
+bool FCMinionLaneFrame::Encode(const FVector& Location, const FVector& Velocity, float InYaw, FCMinionMoveState& OutState) const
+{
+	float Sin, Cos;
+	FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(FRotator::DecompressAxisFromShort(Yaw)));
+
+	const FVector Offset = Location - FVector(Origin);
+	const int32 Along = FMath::RoundToInt32((Offset.X * Cos + Offset.Y * Sin) / MinionMoveLocationUnit);
+	const int32 Lateral = FMath::RoundToInt32((Offset.Y * Cos - Offset.X * Sin) / MinionMoveLocationUnit);
+	const int32 Height = FMath::RoundToInt32(Offset.Z / MinionMoveLocationUnit);
+	if (!FitsSignedBits(Along, MinionMoveAlongBits) || !FitsSignedBits(Lateral, MinionMoveLateralBits) || !FitsSignedBits(Height, MinionMoveHeightBits))
+	{
+		return false;
+	}
+
+	OutState.Along = int16(Along);
+	OutState.Lateral = int16(Lateral);
+	OutState.Height = int16(Height);
+	OutState.VelocityAlong = int8(FMath::Clamp(FMath::RoundToInt32((Velocity.X * Cos + Velocity.Y * Sin) / MinionMoveVelocityUnit), -127, 127));
+	OutState.VelocityLateral = int8(FMath::Clamp(FMath::RoundToInt32((Velocity.Y * Cos - Velocity.X * Sin) / MinionMoveVelocityUnit), -127, 127));
+	OutState.Yaw = FRotator::CompressAxisToByte(InYaw);
+	OutState.FrameSequence = Sequence;
+	return true;
+}
+
+FVector FCMinionLaneFrame::DecodeLocation(const FCMinionMoveState& State) const
+{
+	float Sin, Cos;
+	FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(FRotator::DecompressAxisFromShort(Yaw)));
+
+	const float Along = State.Along * MinionMoveLocationUnit;
+	const float Lateral = State.Lateral * MinionMoveLocationUnit;
+	return FVector(Origin) + FVector(Along * Cos - Lateral * Sin, Along * Sin + Lateral * Cos, State.Height * MinionMoveLocationUnit);
+}
+
+FVector FCMinionLaneFrame::DecodeVelocity(const FCMinionMoveState& State) const
+{
+	float Sin, Cos;
+	FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(FRotator::DecompressAxisFromShort(Yaw)));
+
+	const float Along = State.VelocityAlong * MinionMoveVelocityUnit;
+	const float Lateral = State.VelocityLateral * MinionMoveVelocityUnit;
+	return FVector(Along * Cos - Lateral * Sin, Along * Sin + Lateral * Cos, 0.f);
+}
+
+void FCMinionLaneFrame::Rebase(const FVector& Location, float InYaw)
+{
+	// What FVector_NetQuantize delivers, so both sides decode against the same origin
+	Origin = FVector(FMath::RoundToDouble(Location.X), FMath::RoundToDouble(Location.Y), FMath::RoundToDouble(Location.Z));
+	Yaw = FRotator::CompressAxisToShort(InYaw);
+	Sequence = (Sequence + 1) & MinionMoveCounterMask;
+}
+
+FCMinionMoveStateWriter::EResult FCMinionMoveStateWriter::Write(FCMinionLaneFrame& Frame, FCMinionMoveState& State, const FVector& Location, const FVector& Velocity, float Yaw, double Time, bool bTeleported, float Tolerance)
+{
+	// Head the frame down the lane while walking, so the lateral offset stays small
+	const float FrameYaw = Velocity.SizeSquared2D() > FMath::Square(MinionMoveVelocityUnit) ? Velocity.ToOrientationRotator().Yaw : Yaw;
+
+	EResult Result = EResult::StateChanged;
+	if (bTeleported || !bHasState)
+	{
+		if (bTeleported)
+		{
+			State.TeleportCount = (State.TeleportCount + 1) & MinionMoveCounterMask;
+		}
+		Frame.Rebase(Location, FrameYaw);
+		Result = EResult::FrameChanged;
+	}
+	else
+	{
+		// Where clients show the character now
+		const float Age = FMath::Min(float(Time - StateTime), MinionMoveMaxExtrapolationTime);
+		const FVector Predicted = Frame.DecodeLocation(State) + Frame.DecodeVelocity(State) * Age;
+		const int32 YawSteps = FMath::Abs(int32(int8(uint8(FRotator::CompressAxisToByte(Yaw) - State.Yaw))));
+		if (FVector::DistSquared(Predicted, Location) <= FMath::Square(Tolerance) && YawSteps <= 1)
+		{
+			return EResult::Unchanged;
+		}
+	}
+
+	if (!Frame.Encode(Location, Velocity, Yaw, State))
+	{
+		Frame.Rebase(Location, FrameYaw);
+		Frame.Encode(Location, Velocity, Yaw, State);
+		Result = EResult::FrameChanged;
+	}
+
+	StateTime = Time;
+	bHasState = true;
+	return Result;
+}
+
+UCMinionMovementComponent::UCMinionMovementComponent()
+{
+	// Carries MoveState
+	SetIsReplicatedByDefault(true);
+}
+
+void UCMinionMovementComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Clients start batching when the first state arrives, so they follow whatever the server does
+	if (CharacterOwner && CharacterOwner->HasAuthority() && CVarMinionMovementBatched.GetValueOnGameThread())
+	{
+		StartBatching();
+	}
+}
+
+void UCMinionMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCMinionMovementSubsystem* Subsystem = UCMinionMovementSubsystem::Get(this))
+	{
+		Subsystem->Unregister(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void UCMinionMovementComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// Push model: only compared when WriteMoveState produced a new state
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCMinionMovementComponent, LaneFrame, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCMinionMovementComponent, MoveState, Params);
+}
+
+void UCMinionMovementComponent::SetComponentTickEnabled(bool bEnabled)
+{
+	if (!bBatched)
+	{
+		Super::SetComponentTickEnabled(bEnabled);
+		return;
+	}
+
+	bBatchTickEnabled = bEnabled;
+	Super::SetComponentTickEnabled(bEnabled && bFullSimulation);
+}
+
+bool UCMinionMovementComponent::WantsBatchedUpdate() const
+{
+	return bBatched && bBatchTickEnabled && UpdatedComponent && CharacterOwner;
+}
+
+void UCMinionMovementComponent::StartBatching()
+{
+	UCMinionMovementSubsystem* Subsystem = UCMinionMovementSubsystem::Get(this);
+	if (bBatched || !Subsystem || !CharacterOwner || !UpdatedComponent)
+	{
+		return;
+	}
+
+	bBatchTickEnabled = IsComponentTickEnabled();
+	bBatched = true;
+	Super::SetComponentTickEnabled(false);
+
+	if (CharacterOwner->HasAuthority())
+	{
+		// FCMinionMoveState replaces the stock replicated movement
+		CharacterOwner->SetReplicatingMovement(false);
+		LastMovedLocation = UpdatedComponent->GetComponentLocation();
+		WriteMoveState();
+	}
+
+	Subsystem->Register(this);
+}
+
+bool UCMinionMovementComponent::NeedsFullSimulation() const
+{
+	return !PendingLaunchVelocity.IsZero()
+		|| !PendingImpulseToApply.IsZero()
+		|| !PendingForceToApply.IsZero()
+		|| HasRootMotionSources()
+		|| (CharacterOwner && CharacterOwner->IsPlayingRootMotion())
+		|| IsFalling();
+}
+
+void UCMinionMovementComponent::SetFullSimulation(bool bEnabled)
+{
+	bFullSimulation = bEnabled;
+	Super::SetComponentTickEnabled(bBatchTickEnabled && bFullSimulation);
+
+	// The stock movement owns Velocity meanwhile, so there is no field part to take out afterwards
+	AppliedFieldVelocity = FVector::ZeroVector;
+
+	if (!bEnabled)
+	{
+		// The stock movement may have moved the character anywhere
+		bHasNavFloor = false;
+		LastMovedLocation = UpdatedComponent->GetComponentLocation();
+	}
+}
+
+bool UCMinionMovementComponent::IsCrowdAgent() const
+{
+	return CharacterOwner->GetActorEnableCollision() && CharacterOwner->GetCapsuleComponent()->IsCollisionEnabled();
+}
+
+bool UCMinionMovementComponent::PrepareServerStep(FCCrowdAgent& OutAgent)
+{
+	if (NeedsFullSimulation())
+	{
+		// The stock movement runs until the character walks again; clients still follow it through MoveState
+		if (!bFullSimulation)
+		{
+			SetFullSimulation(true);
+		}
+		WriteMoveState();
+		return false;
+	}
+
+	if (bFullSimulation)
+	{
+		SetFullSimulation(false);
+	}
+
+	if (MovementMode == MOVE_None)
+	{
+		Velocity = FVector::ZeroVector;
+		AppliedFieldVelocity = FVector::ZeroVector;
+		bHasRequestedVelocity = false;
+		ConsumeInputVector();
+		// Stops the clients' extrapolation
+		WriteMoveState();
+		return false;
+	}
+
+	const float MaxSpeed = GetMaxSpeed();
+	FVector Desired = FVector::ZeroVector;
+	if (bHasRequestedVelocity)
+	{
+		// Path following (RequestDirectMove)
+		Desired = bRequestedMoveWithMaxSpeed ? RequestedVelocity.GetSafeNormal2D() * MaxSpeed : RequestedVelocity;
+		bHasRequestedVelocity = false;
+	}
+	else
+	{
+		// AddMovementInput, e.g. the lane flow field
+		Desired = ConsumeInputVector().GetClampedToMaxSize(1.f) * MaxSpeed;
+	}
+	Desired = Desired.GetClampedToMaxSize2D(MaxSpeed);
+
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	if (!Location.Equals(LastMovedLocation, 1.f))
+	{
+		// Moved by someone else (pool activation, respawn, SetActorLocation)
+		bHasNavFloor = false;
+		bPendingTeleport = true;
+	}
+
+	OutAgent.Position = FVector2f(Location.X, Location.Y);
+	OutAgent.Velocity = FVector2f(Velocity.X, Velocity.Y);
+	OutAgent.PreferredVelocity = FVector2f(Desired.X, Desired.Y);
+	OutAgent.Radius = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius() + AvoidancePadding;
+	OutAgent.MaxSpeed = MaxSpeed;
+	return true;
+}
+
+void UCMinionMovementComponent::ApplyServerStep(float DeltaTime, const FVector2f& TargetVelocity)
+{
+	const FVector Desired(TargetVelocity.X, TargetVelocity.Y, 0.f);
+	const float Acceleration = Desired.IsNearlyZero() ? GetMaxBrakingDeceleration() : GetMaxAcceleration();
+
+	// Only the minion's own velocity accelerates towards Desired; the field part of the last step is replaced
+	const FVector OwnVelocity = FMath::VInterpConstantTo(FVector(Velocity.X - AppliedFieldVelocity.X, Velocity.Y - AppliedFieldVelocity.Y, 0.f), Desired, DeltaTime, Acceleration);
+
+	// Velocity includes the fields, so MoveState replicates the pull and clients extrapolate it
+	const UCForceFieldSubsystem* ForceFields = UCForceFieldSubsystem::Get(this);
+	AppliedFieldVelocity = ForceFields ? ForceFields->GetFieldVelocity(CharacterOwner) : FVector::ZeroVector;
+	AppliedFieldVelocity.Z = 0.f;
+	Velocity = OwnVelocity + AppliedFieldVelocity;
+
+	const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+	FVector NewLocation = OldLocation + Velocity * DeltaTime;
+	DistanceSinceProjection += Velocity.Size2D() * DeltaTime;
+
+	const UCapsuleComponent* Capsule = CharacterOwner->GetCapsuleComponent();
+	const float HalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+	if (!bHasNavFloor || DistanceSinceProjection >= NavProjectionDistance)
+	{
+		INC_DWORD_STAT(STAT_CMinionMovementProjections);
+
+		FNavLocation NavLocation;
+		const ANavigationData* Nav = FindNavData();
+		const FVector Extent(Capsule->GetScaledCapsuleRadius(), Capsule->GetScaledCapsuleRadius(), HalfHeight * 2.f);
+		if (Nav && Nav->ProjectPoint(NewLocation, NavLocation, Extent))
+		{
+			NavFloorZ = NavLocation.Location.Z;
+			bHasNavFloor = true;
+			DistanceSinceProjection = 0.f;
+		}
+		else if (bHasNavFloor)
+		{
+			// Would leave the navmesh
+			NewLocation = OldLocation;
+			Velocity = FVector::ZeroVector;
+			AppliedFieldVelocity = FVector::ZeroVector;
+		}
+	}
+
+	if (bHasNavFloor)
+	{
+		NewLocation.Z = NavFloorZ + HalfHeight;
+	}
+
+	FRotator NewRotation = UpdatedComponent->GetComponentRotation();
+	// Face the minion's own heading; a vortex should not spin it around
+	if (bOrientRotationToMovement && !Velocity.IsZero() && OwnVelocity.SizeSquared2D() > UE_KINDA_SMALL_NUMBER)
+	{
+		NewRotation.Yaw = FMath::FixedTurn(NewRotation.Yaw, OwnVelocity.ToOrientationRotator().Yaw, RotationRate.Yaw * DeltaTime);
+	}
+
+	UpdatedComponent->SetWorldLocationAndRotation(NewLocation, NewRotation, false, nullptr, ETeleportType::None);
+	UpdateComponentVelocity();
+	LastMovedLocation = UpdatedComponent->GetComponentLocation();
+	WriteMoveState();
+}
+
+void UCMinionMovementComponent::ClientUpdate(float DeltaTime)
+{
+	if (!bHasClientState || StateAge >= StateDuration)
+	{
+		Velocity = FVector::ZeroVector;
+		return;
+	}
+
+	StateAge = FMath::Min(StateAge + DeltaTime, StateDuration);
+
+	FVector NewLocation;
+	FRotator NewRotation(0.f, StateYaw, 0.f);
+	if (StateAge < BlendDuration)
+	{
+		// Hermite curve from the displayed location and velocity onto the state's trajectory
+		const float Alpha = StateAge / BlendDuration;
+		const FVector BlendFromTangent = BlendFromVelocity * BlendDuration;
+		const FVector BlendTo = StateLocation + StateVelocity * BlendDuration;
+		const FVector BlendToTangent = StateVelocity * BlendDuration;
+		NewLocation = FMath::CubicInterp(BlendFromLocation, BlendFromTangent, BlendTo, BlendToTangent, Alpha);
+		Velocity = FMath::CubicInterpDerivative(BlendFromLocation, BlendFromTangent, BlendTo, BlendToTangent, Alpha) / BlendDuration;
+		NewRotation = FMath::Lerp(FRotator(0.f, BlendFromYaw, 0.f), NewRotation, Alpha);
+	}
+	else
+	{
+		NewLocation = StateLocation + StateVelocity * StateAge;
+		Velocity = StateAge < StateDuration ? StateVelocity : FVector::ZeroVector;
+	}
+
+	UpdatedComponent->SetWorldLocationAndRotation(NewLocation, NewRotation, false, nullptr, ETeleportType::None);
+	UpdateComponentVelocity();
+}
+
+const ANavigationData* UCMinionMovementComponent::FindNavData()
+{
+	if (!NavData.IsValid())
+	{
+		if (const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+		{
+			NavData = NavSys->GetNavDataForProps(GetNavAgentPropertiesRef(), UpdatedComponent->GetComponentLocation());
+		}
+	}
+	return NavData.Get();
+}
+
+void UCMinionMovementComponent::WriteMoveState()
+{
+	const FCMinionMoveStateWriter::EResult Result = MoveStateWriter.Write(LaneFrame, MoveState,
+		UpdatedComponent->GetComponentLocation(), Velocity, UpdatedComponent->GetComponentRotation().Yaw,
+		GetWorld()->GetTimeSeconds(), bPendingTeleport, MoveStateTolerance);
+	bPendingTeleport = false;
+
+	if (Result == FCMinionMoveStateWriter::EResult::FrameChanged)
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(UCMinionMovementComponent, LaneFrame, this);
+	}
+	if (Result != FCMinionMoveStateWriter::EResult::Unchanged)
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(UCMinionMovementComponent, MoveState, this);
+	}
+}
+
+void UCMinionMovementComponent::OnRep_LaneFrame()
+{
+	ApplyMoveState();
+}
+
+void UCMinionMovementComponent::OnRep_MoveState()
+{
+	bPendingMoveState = true;
+	ApplyMoveState();
+}
+
+void UCMinionMovementComponent::ApplyMoveState()
+{
+	// A state encoded in a frame that has not arrived yet waits for OnRep_LaneFrame
+	if (!bPendingMoveState || MoveState.FrameSequence != LaneFrame.Sequence)
+	{
+		return;
+	}
+	bPendingMoveState = false;
+
+	if (!bBatched)
+	{
+		StartBatching();
+	}
+	if (!UpdatedComponent)
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const FVector Current = UpdatedComponent->GetComponentLocation();
+	StateLocation = LaneFrame.DecodeLocation(MoveState);
+	StateVelocity = LaneFrame.DecodeVelocity(MoveState);
+	StateYaw = FRotator::DecompressAxisFromByte(MoveState.Yaw);
+	StateAge = 0.f;
+
+	const bool bSnap = !bHasClientState
+		|| MoveState.TeleportCount != LastTeleportCount
+		|| FVector::DistSquared(Current, StateLocation) > FMath::Square(ClientSnapDistance);
+	if (bSnap)
+	{
+		UpdatedComponent->SetWorldLocationAndRotation(StateLocation, FRotator(0.f, StateYaw, 0.f), false, nullptr, ETeleportType::TeleportPhysics);
+		BlendDuration = 0.f;
+	}
+	else
+	{
+		// Blend over the measured update spacing, so actors replicated at any rate move continuously
+		BlendFromLocation = Current;
+		BlendFromVelocity = Velocity;
+		BlendFromYaw = UpdatedComponent->GetComponentRotation().Yaw;
+		BlendDuration = FMath::Clamp(float(Now - LastStateTime), MinionMoveMinBlendTime, MinionMoveMaxBlendTime);
+	}
+	// A standing character needs no update once the blend is over
+	StateDuration = StateVelocity.IsZero() ? BlendDuration : MinionMoveMaxExtrapolationTime;
+
+	LastTeleportCount = MoveState.TeleportCount;
+	LastStateTime = Now;
+	bHasClientState = true;
+}
+
+void UCMinionMovementSubsystem::Deinitialize()
+{
+	Components.Empty();
+	Obstacles.Empty();
+	Super::Deinitialize();
+}
+
+void UCMinionMovementSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_CMinionMovementBatch);
+	const double StartTime = FPlatformTime::Seconds();
+
+	StepComponents.Reset();
+	StepAgents.Reset();
+	int32 NumUpdated = 0;
+	for (int32 Index = Components.Num() - 1; Index >= 0; --Index)
+	{
+		UCMinionMovementComponent* Component = Components[Index].Get();
+		if (!Component)
+		{
+			Components.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		if (!Component->WantsBatchedUpdate())
+		{
+			continue;
+		}
+		++NumUpdated;
+
+		if (!Component->GetOwner()->HasAuthority())
+		{
+			Component->ClientUpdate(DeltaTime);
+			continue;
+		}
+
+		FCCrowdAgent Agent;
+		if (!Component->PrepareServerStep(Agent))
+		{
+			continue;
+		}
+
+		if (Component->IsCrowdAgent())
+		{
+			StepComponents.Add(Component);
+			StepAgents.Add(Agent);
+		}
+		else
+		{
+			// Nobody avoids it (dead, no collision), so it can move before the solve
+			Component->ApplyServerStep(DeltaTime, Agent.PreferredVelocity);
+		}
+	}
+
+	// Obstacles follow the stepping components in StepAgents and only take part in the solve
+	const int32 NumAgents = StepComponents.Num();
+	if (NumAgents > 0)
+	{
+		GatherObstacles();
+	}
+
+	StepVelocities.SetNumUninitialized(StepAgents.Num(), EAllowShrinking::No);
+	for (int32 Index = 0; Index < StepAgents.Num(); ++Index)
+	{
+		StepVelocities[Index] = StepAgents[Index].PreferredVelocity;
+	}
+
+	const double AvoidanceStartTime = FPlatformTime::Seconds();
+	if (CVarMinionMovementAvoidance.GetValueOnGameThread() && StepAgents.Num() > 1)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_CMinionCrowdAvoidance);
+
+		FCCrowdAvoidanceSettings Settings;
+		Settings.NeighbourRadius = CVarMinionMovementAvoidanceRadius.GetValueOnGameThread();
+		Settings.MaxNeighbours = CVarMinionMovementAvoidanceNeighbours.GetValueOnGameThread();
+		Settings.TimeHorizon = CVarMinionMovementAvoidanceTimeHorizon.GetValueOnGameThread();
+		FCCrowdAvoidance::ComputeVelocities(StepAgents, Settings, DeltaTime, StepVelocities);
+	}
+	LastAvoidanceSeconds = FPlatformTime::Seconds() - AvoidanceStartTime;
+	LastNumAgents = NumAgents;
+
+	for (int32 Index = 0; Index < NumAgents; ++Index)
+	{
+		StepComponents[Index]->ApplyServerStep(DeltaTime, StepVelocities[Index]);
+	}
+	StepComponents.Reset();
+
+	LastNumUpdated = NumUpdated;
+	LastBatchSeconds = FPlatformTime::Seconds() - StartTime;
+	INC_DWORD_STAT_BY(STAT_CMinionMovementUpdates, NumUpdated);
+	INC_DWORD_STAT_BY(STAT_CMinionCrowdAgents, NumAgents);
+}
+
+TStatId UCMinionMovementSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCMinionMovementSubsystem, STATGROUP_Tickables);
+}
+
+void UCMinionMovementSubsystem::Register(UCMinionMovementComponent* Component)
+{
+	Components.AddUnique(Component);
+}
+
+void UCMinionMovementSubsystem::Unregister(UCMinionMovementComponent* Component)
+{
+	Components.RemoveSingleSwap(Component, EAllowShrinking::No);
+}
+
+void UCMinionMovementSubsystem::RegisterObstacle(ACharacter* Character)
+{
+	Obstacles.AddUnique(Character);
+}
+
+void UCMinionMovementSubsystem::UnregisterObstacle(ACharacter* Character)
+{
+	Obstacles.RemoveSingleSwap(Character, EAllowShrinking::No);
+}
+
+void UCMinionMovementSubsystem::GatherObstacles()
+{
+	for (int32 Index = Obstacles.Num() - 1; Index >= 0; --Index)
+	{
+		const ACharacter* Character = Obstacles[Index].Get();
+		if (!Character)
+		{
+			Obstacles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		// Dead heroes lose their capsule collision, so minions walk through them like through dead minions
+		const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+		if (!Character->GetActorEnableCollision() || !Capsule->IsCollisionEnabled())
+		{
+			continue;
+		}
+
+		const FVector Location = Character->GetActorLocation();
+		const FVector Velocity = Character->GetVelocity();
+		FCCrowdAgent& Agent = StepAgents.AddDefaulted_GetRef();
+		Agent.Position = FVector2f(Location.X, Location.Y);
+		Agent.Velocity = FVector2f(Velocity.X, Velocity.Y);
+		Agent.PreferredVelocity = Agent.Velocity;
+		Agent.Radius = Capsule->GetScaledCapsuleRadius();
+		Agent.MaxSpeed = Velocity.Size2D();
+		Agent.bAvoids = false;
+	}
+}
+
+UCMinionMovementSubsystem* UCMinionMovementSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCMinionMovementSubsystem>() : nullptr;
+}
+
+static void MinionMovementStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UCMinionMovementSubsystem* MinionMovement = UCMinionMovementSubsystem::Get(World);
+	if (!MinionMovement)
+	{
+		Ar.Log(TEXT("Crunch.MinionMovement.Stats: no minion movement subsystem in this world"));
+		return;
+	}
+
+	const int32 NumUpdated = MinionMovement->GetLastNumUpdated();
+	const double BatchMicroseconds = MinionMovement->GetLastBatchSeconds() * 1000000.0;
+	Ar.Logf(TEXT("Minion movement: %d batched, %d updated last frame"), MinionMovement->GetNumComponents(), NumUpdated);
+	Ar.Logf(TEXT("  batch %.1f us, %.2f us per updated character"), BatchMicroseconds, NumUpdated > 0 ? BatchMicroseconds / NumUpdated : 0.0);
+	Ar.Logf(TEXT("  crowd avoidance %.1f us for %d agents"), MinionMovement->GetLastAvoidanceSeconds() * 1000000.0, MinionMovement->GetLastNumAgents());
+	Ar.Log(TEXT("  compare with Crunch.MinionMovement.Batched 0 and \"stat Character\" on the same map"));
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice MinionMovementStatsCommand(
+	TEXT("Crunch.MinionMovement.Stats"),
+	TEXT("Crunch.MinionMovement.Stats: print how many characters the minion movement batch moved last frame and what it cost."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&MinionMovementStats));
+
+static void MinionMovementNetBenchmark(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	const int32 NumMinions = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100;
+	const float Seconds = Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 1.f) : 20.f;
+	const float Tolerance = GetDefault<UCMinionMovementComponent>()->MoveStateTolerance;
+
+	// A 30 Hz server tick. Every minion walks a bending lane at its own speed with
+	// crowd avoidance wobble, and stops to fight now and then.
+	const float TickInterval = 1.f / 30.f;
+	const int32 NumTicks = FMath::CeilToInt32(Seconds / TickInterval);
+
+	int64 StockBits = 0;
+	int64 StockUpdates = 0;
+	int64 WholeCmBits = 0;
+	int64 CompactBits = 0;
+	int64 CompactUpdates = 0;
+	int64 FrameUpdates = 0;
+	FNetBitWriter Writer(nullptr, 1024);
+
+	for (int32 MinionIndex = 0; MinionIndex < NumMinions; ++MinionIndex)
+	{
+		FRandomStream Stream(MinionIndex);
+		FVector Location(Stream.FRandRange(-20000.f, 20000.f), Stream.FRandRange(-20000.f, 20000.f), 100.f);
+		float Heading = Stream.FRandRange(0.f, 360.f);
+		float BendRate = 0.f;
+		float Yaw = Heading;
+		const float Speed = Stream.FRandRange(280.f, 340.f);
+		const float WobblePeriod = Stream.FRandRange(2.f, 4.f);
+		float FightTime = Stream.FRandRange(4.f, 8.f);
+		float NextBend = 0.f;
+
+		FCMinionLaneFrame Frame;
+		FCMinionMoveState State;
+		FCMinionMoveStateWriter StateWriter;
+		FRepMovement LastStock;
+		bool bHasStock = false;
+
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			const float Time = Tick * TickInterval;
+			if (Time >= NextBend)
+			{
+				BendRate = Stream.FRandRange(-15.f, 15.f);
+				NextBend = Time + Stream.FRandRange(2.f, 6.f);
+			}
+			Heading += BendRate * TickInterval;
+
+			// Fights last two seconds
+			const bool bFighting = Time >= FightTime;
+			if (Time >= FightTime + 2.f)
+			{
+				FightTime = Time + Stream.FRandRange(4.f, 8.f);
+			}
+
+			FVector Velocity = FVector::ZeroVector;
+			if (!bFighting)
+			{
+				const FVector Forward = FRotator(0.f, Heading, 0.f).Vector();
+				const FVector Right(-Forward.Y, Forward.X, 0.f);
+				Velocity = Forward * Speed + Right * 40.f * FMath::Sin(UE_TWO_PI * Time / WobblePeriod);
+				Yaw = FMath::FixedTurn(Yaw, Velocity.ToOrientationRotator().Yaw, 360.f * TickInterval);
+			}
+			Location += Velocity * TickInterval;
+
+			// Stock ACharacter: FRepMovement and the server timestamp whenever either changed
+			FRepMovement Stock;
+			Stock.Location = Location;
+			Stock.Rotation = FRotator(0.f, Yaw, 0.f);
+			Stock.LinearVelocity = Velocity;
+			if (!bHasStock || !Stock.Location.Equals(LastStock.Location) || !Stock.Rotation.Equals(LastStock.Rotation) || !Stock.LinearVelocity.Equals(LastStock.LinearVelocity))
+			{
+				bool bSuccess = true;
+				Writer.Reset();
+				Stock.NetSerialize(Writer, nullptr, bSuccess);
+				StockBits += Writer.GetNumBits() + 32;
+				++StockUpdates;
+				LastStock = Stock;
+				bHasStock = true;
+			}
+
+			// The previous channel: whole centimeter location, yaw and teleport count every moving tick
+			if (!bFighting || Tick == 0)
+			{
+				bool bSuccess = true;
+				FVector_NetQuantize WholeCm = Location;
+				Writer.Reset();
+				WholeCm.NetSerialize(Writer, nullptr, bSuccess);
+				WholeCmBits += Writer.GetNumBits() + 16;
+			}
+
+			const FCMinionMoveStateWriter::EResult Result = StateWriter.Write(Frame, State, Location, Velocity, Yaw, Time, false, Tolerance);
+			if (Result == FCMinionMoveStateWriter::EResult::FrameChanged)
+			{
+				bool bSuccess = true;
+				Writer.Reset();
+				Frame.Origin.NetSerialize(Writer, nullptr, bSuccess);
+				CompactBits += Writer.GetNumBits() + 16 + 8;
+				++FrameUpdates;
+			}
+			if (Result != FCMinionMoveStateWriter::EResult::Unchanged)
+			{
+				bool bSuccess = true;
+				Writer.Reset();
+				State.NetSerialize(Writer, nullptr, bSuccess);
+				CompactBits += Writer.GetNumBits();
+				++CompactUpdates;
+			}
+		}
+	}
+
+	const double MinionSeconds = double(NumMinions) * NumTicks * TickInterval;
+	auto BytesPerSecond = [MinionSeconds](int64 Bits) { return Bits / 8.0 / MinionSeconds; };
+	Ar.Logf(TEXT("Crunch.MinionMovement.NetBenchmark: %d minions, %.0f s at 30 Hz, tolerance %.0f cm (payload bits only)"), NumMinions, NumTicks * TickInterval, Tolerance);
+	Ar.Logf(TEXT("  stock FRepMovement:   %7.1f B/s per minion, %5.1f updates/s"), BytesPerSecond(StockBits), StockUpdates / MinionSeconds);
+	Ar.Logf(TEXT("  whole cm every tick:  %7.1f B/s per minion"), BytesPerSecond(WholeCmBits));
+	Ar.Logf(TEXT("  lane frame + dead reckoning: %7.1f B/s per minion, %5.1f updates/s, %.2f frame moves/s"), BytesPerSecond(CompactBits), CompactUpdates / MinionSeconds, FrameUpdates / MinionSeconds);
+	if (CompactBits > 0)
+	{
+		Ar.Logf(TEXT("  Reduction vs stock: %.1fx"), double(StockBits) / CompactBits);
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice MinionMovementNetBenchmarkCommand(
+	TEXT("Crunch.MinionMovement.NetBenchmark"),
+	TEXT("Crunch.MinionMovement.NetBenchmark [Minions=100] [Seconds=20]: replay synthetic lane walks at a 30 Hz server tick and compare the movement bytes per minion of the stock replication and the minion movement channel."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&MinionMovementNetBenchmark));
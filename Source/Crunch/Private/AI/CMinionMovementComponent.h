@@ -0,0 +1,331 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AI/CCrowdAvoidance.h"
+#include "Engine/NetSerialization.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Subsystems/WorldSubsystem.h"
+// ----------------------------------------------------------------------------
+// File: CMinionMovementComponent.h
+// Purpose: Lightweight movement for AI characters that only walk on the navmesh
+//          (minions, AStormCore). Replaces the per-character floor sweeps,
+//          step-ups and networked corrections of UCharacterMovementComponent
+//          with a navmesh projection, and moves every such character from one
+//          batched loop in UCMinionMovementSubsystem.
+// Key API:
+//  - UCMinionMovementComponent: drop-in CharacterMovementComponentName subobject.
+//  - UCMinionMovementSubsystem: registers components and ticks them as a batch.
+//  - Server steps are steered by FCCrowdAvoidance (ORCA) so waves flow around
+//    each other instead of pushing capsules.
+// Notes:
+//  - Launches, impulses, forces and root motion fall back to the stock character
+//    movement until the character walks again.
+//  - Force field velocities (UCForceFieldSubsystem) are added to the server step
+//    and to the replicated velocity; only the minion's own part is steered.
+//  - Clients receive a lane-relative quantized location, velocity and 8-bit yaw,
+//    only when their extrapolation of the last state would drift (dead
+//    reckoning), and blend toward the server trajectory with a Hermite curve.
+//  - Crunch.MinionMovement.Batched 0 keeps the stock movement (for comparisons);
+//    Crunch.MinionMovement.Stats prints the batch cost per moving character;
+//    Crunch.MinionMovement.NetBenchmark the bandwidth per minion.
+//  - Crunch.MinionMovement.Avoidance* CVars tune the crowd avoidance.
+// ----------------------------------------------------------------------------
+#include "CMinionMovementComponent.generated.h"
+
+class ANavigationData;
+
+/**
+ * Movement state the server replicates for a batched character, relative to its
+ * FCMinionLaneFrame. Serialized in 53 bits while standing, 69 while moving:
+ * location in 2 cm steps (16 bits along the lane, 12 across, 10 up), velocity
+ * in 8 cm/s steps (8 + 8 bits, skipped when zero), 8-bit yaw and two 3-bit counters.
+ */
+USTRUCT()
+struct FCMinionMoveState
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int16 Along = 0;
+
+	UPROPERTY()
+	int16 Lateral = 0;
+
+	UPROPERTY()
+	int16 Height = 0;
+
+	UPROPERTY()
+	int8 VelocityAlong = 0;
+
+	UPROPERTY()
+	int8 VelocityLateral = 0;
+
+	/** FRotator::CompressAxisToByte */
+	UPROPERTY()
+	uint8 Yaw = 0;
+
+	/** Bumped when the server moves the character without walking; clients snap instead of interpolating */
+	UPROPERTY()
+	uint8 TeleportCount = 0;
+
+	/** FCMinionLaneFrame::Sequence of the frame this state is encoded in */
+	UPROPERTY()
+	uint8 FrameSequence = 0;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FCMinionMoveState> : public TStructOpsTypeTraitsBase2<FCMinionMoveState>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+/**
+ * Origin and heading FCMinionMoveState locations are encoded in. The server
+ * re-anchors it on the character, heading along its velocity, whenever the
+ * character leaves the range of the state's fields or teleports, so it follows
+ * the lane and only replicates a few times per walk.
+ */
+USTRUCT()
+struct FCMinionLaneFrame
+{
+	GENERATED_BODY()
+
+	/** Whole centimeters */
+	UPROPERTY()
+	FVector_NetQuantize Origin = FVector::ZeroVector;
+
+	/** FRotator::CompressAxisToShort */
+	UPROPERTY()
+	uint16 Yaw = 0;
+
+	/** Bumped (3 bits) every time the frame moves */
+	UPROPERTY()
+	uint8 Sequence = 0;
+
+	/** Fill the location, velocity, yaw and frame sequence of OutState. False when Location is out of range. */
+	bool Encode(const FVector& Location, const FVector& Velocity, float InYaw, FCMinionMoveState& OutState) const;
+
+	FVector DecodeLocation(const FCMinionMoveState& State) const;
+	FVector DecodeVelocity(const FCMinionMoveState& State) const;
+
+	/** Anchor the frame at Location, heading along InYaw */
+	void Rebase(const FVector& Location, float InYaw);
+};
+
+/**
+ * Server side of the movement channel. Clients extrapolate the last state along
+ * its velocity, so a new state is only written when that extrapolation drifts
+ * more than Tolerance from the real location, the yaw turns by more than one
+ * step, or the character teleports. A character walking straight down a lane
+ * sends a state about once per extrapolation limit (1 s).
+ */
+struct FCMinionMoveStateWriter
+{
+	enum class EResult : uint8
+	{
+		Unchanged,
+		StateChanged,
+		/** The frame moved and the state changed */
+		FrameChanged
+	};
+
+	EResult Write(FCMinionLaneFrame& Frame, FCMinionMoveState& State, const FVector& Location, const FVector& Velocity, float Yaw, double Time, bool bTeleported, float Tolerance);
+
+	/** World time of the last written state */
+	double StateTime = 0.0;
+	bool bHasState = false;
+};
+
+/**
+ * UCMinionMovementComponent is a UCharacterMovementComponent whose own tick stays
+ * off while the character walks. UCMinionMovementSubsystem::Tick updates it
+ * once per frame instead:
+ *  - Server: PrepareServerStep consumes the path following velocity (or the
+ *    movement input) as the preferred velocity of a crowd agent. Once the
+ *    subsystem has solved the avoidance of all agents (and of the registered
+ *    hero obstacles), ApplyServerStep
+ *    accelerates toward the avoiding velocity, moves without a sweep and keeps
+ *    the capsule on the navmesh, which is re-projected every
+ *    NavProjectionDistance travelled.
+ *  - Client: ClientUpdate blends from the displayed location and velocity onto the trajectory
+ *    of the last replicated FCMinionMoveState (cubic Hermite over the update
+ *    spacing), then extrapolate along its velocity for up to 1 s.
+ *
+ * Movement mode and the usual walking settings (MaxWalkSpeed, MaxAcceleration,
+ * BrakingDecelerationWalking, bOrientRotationToMovement, RotationRate) keep
+ * their meaning. MOVE_None (DisableMovement) stops the character.
+ *
+ * Batched characters never sweep their capsule, so crowds of minions cost no
+ * capsule-vs-capsule collision resolution; the avoidance keeps them apart.
+ */
+UCLASS(ClassGroup = (AI))
+class UCMinionMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	UCMinionMovementComponent();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** While batched, enabling tick means "updated by the batch"; the stock tick only runs during a fallback */
+	virtual void SetComponentTickEnabled(bool bEnabled) override;
+
+	bool IsBatched() const { return bBatched; }
+
+	/** True when the batch should update this component this frame */
+	bool WantsBatchedUpdate() const;
+
+	/** Server: fill the crowd agent of this step. False when the character does not walk this frame. */
+	bool PrepareServerStep(FCCrowdAgent& OutAgent);
+
+	/** Server: move with the velocity the avoidance picked (or the preferred one) */
+	void ApplyServerStep(float DeltaTime, const FVector2f& TargetVelocity);
+
+	/** Client: blend toward and extrapolate the replicated state */
+	void ClientUpdate(float DeltaTime);
+
+	/** False while the capsule has no collision (dead, pooled): others walk through the character */
+	bool IsCrowdAgent() const;
+
+	/** Added to the capsule radius when other characters avoid this one */
+	UPROPERTY(EditAnywhere, Category = "Minion Movement")
+	float AvoidancePadding = 10.f;
+
+	/** Distance walked before the navmesh floor is projected again */
+	UPROPERTY(EditAnywhere, Category = "Minion Movement")
+	float NavProjectionDistance = 50.f;
+
+	/** Clients jump straight to a replicated location this far from the displayed one */
+	UPROPERTY(EditAnywhere, Category = "Minion Movement")
+	float ClientSnapDistance = 500.f;
+
+	/** Server: a new state is replicated when the clients' extrapolation drifts this far from the real location */
+	UPROPERTY(EditAnywhere, Category = "Minion Movement")
+	float MoveStateTolerance = 10.f;
+
+private:
+	/** Turn the stock tick off and hand the component to the subsystem */
+	void StartBatching();
+
+	bool NeedsFullSimulation() const;
+	void SetFullSimulation(bool bEnabled);
+
+	const ANavigationData* FindNavData();
+	void WriteMoveState();
+
+	/** Client: start blending toward MoveState once its frame has arrived */
+	void ApplyMoveState();
+
+	UFUNCTION()
+	void OnRep_LaneFrame();
+
+	UFUNCTION()
+	void OnRep_MoveState();
+
+	UPROPERTY(ReplicatedUsing = OnRep_LaneFrame)
+	FCMinionLaneFrame LaneFrame;
+
+	UPROPERTY(ReplicatedUsing = OnRep_MoveState)
+	FCMinionMoveState MoveState;
+
+	bool bBatched = false;
+
+	/** Tick state requested through SetComponentTickEnabled while batched */
+	bool bBatchTickEnabled = true;
+
+	/** The stock movement runs (launch, impulse, root motion) */
+	bool bFullSimulation = false;
+
+	// Server
+	FCMinionMoveStateWriter MoveStateWriter;
+	TWeakObjectPtr<const ANavigationData> NavData;
+	FVector LastMovedLocation = FVector::ZeroVector;
+	/** Force field part of Velocity from the last ApplyServerStep */
+	FVector AppliedFieldVelocity = FVector::ZeroVector;
+	float NavFloorZ = 0.f;
+	float DistanceSinceProjection = 0.f;
+	bool bHasNavFloor = false;
+	bool bPendingTeleport = false;
+
+	// Client
+	FVector BlendFromLocation = FVector::ZeroVector;
+	FVector BlendFromVelocity = FVector::ZeroVector;
+	float BlendFromYaw = 0.f;
+	FVector StateLocation = FVector::ZeroVector;
+	FVector StateVelocity = FVector::ZeroVector;
+	float StateYaw = 0.f;
+	float BlendDuration = 0.f;
+	/** Seconds since the state arrived, and after which the character stops */
+	float StateAge = 0.f;
+	float StateDuration = 0.f;
+	double LastStateTime = 0.0;
+	uint8 LastTeleportCount = 0;
+	bool bHasClientState = false;
+	/** A state arrived before the frame it is encoded in */
+	bool bPendingMoveState = false;
+};
+
+/**
+ * UCMinionMovementSubsystem updates every batched UCMinionMovementComponent of
+ * the world in one loop, so the per-component tick function overhead and the
+ * scattered memory access of hundreds of movement ticks go away. On the server
+ * a frame has three passes: gather the crowd agents, solve their avoidance in
+ * parallel (FCCrowdAvoidance) and apply the moves. Registered obstacles (heroes)
+ * join the solve as agents that do not avoid back, so minions steer around them.
+ */
+UCLASS()
+class UCMinionMovementSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void Register(UCMinionMovementComponent* Component);
+	void Unregister(UCMinionMovementComponent* Component);
+
+	/** Characters with their own movement that minions avoid without being avoided by them */
+	void RegisterObstacle(ACharacter* Character);
+	void UnregisterObstacle(ACharacter* Character);
+
+	int32 GetNumComponents() const { return Components.Num(); }
+
+	/** Components updated by the last Tick and how long the batch took */
+	int32 GetLastNumUpdated() const { return LastNumUpdated; }
+	double GetLastBatchSeconds() const { return LastBatchSeconds; }
+
+	/** Agents of the last avoidance solve and how long it took */
+	int32 GetLastNumAgents() const { return LastNumAgents; }
+	double GetLastAvoidanceSeconds() const { return LastAvoidanceSeconds; }
+
+	static UCMinionMovementSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	TArray<TWeakObjectPtr<UCMinionMovementComponent>> Components;
+	TArray<TWeakObjectPtr<ACharacter>> Obstacles;
+
+	/** Append the obstacles with collision to StepAgents */
+	void GatherObstacles();
+
+	// Server step scratch, one entry per stepping component in each array
+	TArray<UCMinionMovementComponent*> StepComponents;
+	TArray<FCCrowdAgent> StepAgents;
+	TArray<FVector2f> StepVelocities;
+
+	int32 LastNumUpdated = 0;
+	double LastBatchSeconds = 0.0;
+	int32 LastNumAgents = 0;
+	double LastAvoidanceSeconds = 0.0;
+};
@@ -0,0 +1,353 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/CPathRequestSubsystem.h"
+#include "AI/CFlowFieldSubsystem.h"
+#include "AIController.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "NavigationSystem.h"
+#include "Navigation/PathFollowingComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Path Requests Tick"), STAT_CPathRequestsTick, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Requests Issued"), STAT_CPathRequestsIssued, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Requests Coalesced"), STAT_CPathRequestsCoalesced, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Requests Throttled"), STAT_CPathRequestsThrottled, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Queries Computed"), STAT_CPathQueriesComputed, STATGROUP_AI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Path Queries Queued"), STAT_CPathQueriesQueued, STATGROUP_AI);
+
+static TAutoConsoleVariable<int32> CVarPathRequestsQueriesPerFrame(
+	TEXT("Crunch.PathRequests.QueriesPerFrame"),
+	8,
+	TEXT("Maximum async path queries dispatched per frame. Further requests wait in the queue."));
+
+static TAutoConsoleVariable<float> CVarPathRequestsRepathTolerance(
+	TEXT("Crunch.PathRequests.RepathTolerance"),
+	150.f,
+	TEXT("How far a goal may move (or differ from the goal being followed) before a new path is computed."));
+
+static TAutoConsoleVariable<float> CVarPathRequestsMinRepathInterval(
+	TEXT("Crunch.PathRequests.MinRepathInterval"),
+	0.5f,
+	TEXT("Minimum seconds between two path queries of the same agent."));
+
+bool UCPathRequestSubsystem::FMoveGoal::Matches(const FMoveGoal& Other, float Tolerance) const
+{
+	return Actor == Other.Actor
+		&& FMath::IsNearlyEqual(AcceptanceRadius, Other.AcceptanceRadius)
+		&& FVector::DistSquared(Location, Other.Location) <= FMath::Square(Tolerance);
+}
+
+void UCPathRequestSubsystem::Deinitialize()
+{
+	Agents.Empty();
+	Queue.Empty();
+	Super::Deinitialize();
+}
+
+void UCPathRequestSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	SCOPE_CYCLE_COUNTER(STAT_CPathRequestsTick);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const float Tolerance = CVarPathRequestsRepathTolerance.GetValueOnGameThread();
+	const float MinInterval = CVarPathRequestsMinRepathInterval.GetValueOnGameThread();
+
+	for (auto It = Agents.CreateIterator(); It; ++It)
+	{
+		FAgentState& State = It.Value();
+		AAIController* Controller = State.Controller.Get();
+		if (!Controller || !Controller->GetPawn())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (!State.bHasDesired)
+		{
+			continue;
+		}
+
+		if (State.Desired.Actor.IsValid())
+		{
+			State.Desired.Location = State.Desired.Actor->GetActorLocation();
+		}
+		else if (State.Desired.Actor.IsStale())
+		{
+			// The goal actor is gone; behavior code will pick a new goal
+			State.bHasDesired = false;
+			State.bWantsQuery = false;
+			continue;
+		}
+
+		// A goal actor drifted away from the end of the path being followed
+		if (!State.bWantsQuery && IsFollowingPath(State, *Controller) && !State.PathGoal.Matches(State.Desired, Tolerance))
+		{
+			State.bWantsQuery = true;
+		}
+
+		if (State.bWantsQuery && !State.bQueued && State.PendingQueryId == INVALID_NAVQUERYID && Now - State.LastQueryTime >= MinInterval)
+		{
+			State.bQueued = true;
+			Queue.Add(It.Key());
+		}
+	}
+
+	const int32 Budget = FMath::Max(1, CVarPathRequestsQueriesPerFrame.GetValueOnGameThread());
+	int32 NumDispatched = 0;
+	int32 NumConsumed = 0;
+	for (; NumConsumed < Queue.Num() && NumDispatched < Budget; ++NumConsumed)
+	{
+		FAgentState* State = Agents.Find(Queue[NumConsumed]);
+		if (!State || !State->bQueued)
+		{
+			// Stopped or destroyed while waiting
+			continue;
+		}
+
+		State->bQueued = false;
+		if (DispatchQuery(*State, Now))
+		{
+			++NumDispatched;
+		}
+	}
+	Queue.RemoveAt(0, NumConsumed, EAllowShrinking::No);
+
+	SET_DWORD_STAT(STAT_CPathQueriesQueued, Queue.Num());
+}
+
+TStatId UCPathRequestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCPathRequestSubsystem, STATGROUP_Tickables);
+}
+
+UCPathRequestSubsystem* UCPathRequestSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCPathRequestSubsystem>() : nullptr;
+}
+
+EPathFollowingRequestResult::Type UCPathRequestSubsystem::RequestMoveToActor(AAIController* Controller, AActor* Goal, float AcceptanceRadius)
+{
+	if (!Goal)
+	{
+		++Counters.Issued;
+		INC_DWORD_STAT(STAT_CPathRequestsIssued);
+		return EPathFollowingRequestResult::Failed;
+	}
+
+	FMoveGoal MoveGoal;
+	MoveGoal.Actor = Goal;
+	MoveGoal.Location = Goal->GetActorLocation();
+	MoveGoal.AcceptanceRadius = AcceptanceRadius;
+	return RequestMove(Controller, MoveGoal);
+}
+
+EPathFollowingRequestResult::Type UCPathRequestSubsystem::RequestMoveToLocation(AAIController* Controller, const FVector& Goal, float AcceptanceRadius)
+{
+	FMoveGoal MoveGoal;
+	MoveGoal.Location = Goal;
+	MoveGoal.AcceptanceRadius = AcceptanceRadius;
+	return RequestMove(Controller, MoveGoal);
+}
+
+EPathFollowingRequestResult::Type UCPathRequestSubsystem::RequestMove(AAIController* Controller, const FMoveGoal& Goal)
+{
+	++Counters.Issued;
+	INC_DWORD_STAT(STAT_CPathRequestsIssued);
+
+	if (!Controller || !Controller->GetPawn())
+	{
+		return EPathFollowingRequestResult::Failed;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const float Tolerance = CVarPathRequestsRepathTolerance.GetValueOnGameThread();
+	const float MinInterval = CVarPathRequestsMinRepathInterval.GetValueOnGameThread();
+
+	FAgentState& State = Agents.FindOrAdd(Controller);
+	State.Controller = Controller;
+
+	// Keep answering Failed for an unreachable goal instead of querying it every tick
+	if (State.bLastQueryFailed && State.FailedGoal.Matches(Goal, Tolerance) && Now - State.LastQueryTime < MinInterval)
+	{
+		return EPathFollowingRequestResult::Failed;
+	}
+
+	State.Desired = Goal;
+	State.bHasDesired = true;
+
+	// The queued query reads Desired when it is dispatched, so it picks up this goal too
+	const bool bInFlight = State.PendingQueryId != INVALID_NAVQUERYID;
+	if (State.bQueued
+		|| (bInFlight && State.PendingGoal.Matches(Goal, Tolerance))
+		|| (!bInFlight && IsFollowingPath(State, *Controller) && State.PathGoal.Matches(Goal, Tolerance)))
+	{
+		++Counters.Coalesced;
+		INC_DWORD_STAT(STAT_CPathRequestsCoalesced);
+		return EPathFollowingRequestResult::RequestSuccessful;
+	}
+
+	if (!bInFlight && IsAtGoal(Goal, *Controller))
+	{
+		State.bWantsQuery = false;
+		return EPathFollowingRequestResult::AlreadyAtGoal;
+	}
+
+	State.bWantsQuery = true;
+	if (bInFlight || Now - State.LastQueryTime < MinInterval)
+	{
+		++Counters.Throttled;
+		INC_DWORD_STAT(STAT_CPathRequestsThrottled);
+	}
+	return EPathFollowingRequestResult::RequestSuccessful;
+}
+
+void UCPathRequestSubsystem::StopMovement(AAIController* Controller)
+{
+	if (!Controller)
+	{
+		return;
+	}
+
+	if (FAgentState* State = Agents.Find(Controller))
+	{
+		// Queue entries are skipped once bQueued is cleared; in-flight results no longer match
+		State->bHasDesired = false;
+		State->bWantsQuery = false;
+		State->bQueued = false;
+		State->PendingQueryId = INVALID_NAVQUERYID;
+		State->MoveRequestId = FAIRequestID::InvalidRequest;
+	}
+	Controller->StopMovement();
+}
+
+bool UCPathRequestSubsystem::IsFollowingPath(const FAgentState& State, const AAIController& Controller)
+{
+	const UPathFollowingComponent* PathFollowing = Controller.GetPathFollowingComponent();
+	return PathFollowing
+		&& PathFollowing->GetStatus() != EPathFollowingStatus::Idle
+		&& State.MoveRequestId.IsValid()
+		&& PathFollowing->GetCurrentRequestId() == State.MoveRequestId;
+}
+
+bool UCPathRequestSubsystem::IsAtGoal(const FMoveGoal& Goal, const AAIController& Controller)
+{
+	const APawn* Pawn = Controller.GetPawn();
+	return Pawn && Goal.AcceptanceRadius >= 0.f
+		&& FVector::DistSquared(Pawn->GetActorLocation(), Goal.Location) <= FMath::Square(Goal.AcceptanceRadius);
+}
+
+bool UCPathRequestSubsystem::DispatchQuery(FAgentState& State, double Now)
+{
+	State.bWantsQuery = false;
+
+	AAIController* Controller = State.Controller.Get();
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!Controller || !NavSys || !State.bHasDesired)
+	{
+		return false;
+	}
+
+	FAIMoveRequest MoveRequest;
+	if (AActor* GoalActor = State.Desired.Actor.Get())
+	{
+		MoveRequest.SetGoalActor(GoalActor);
+	}
+	else
+	{
+		MoveRequest.SetGoalLocation(State.Desired.Location);
+	}
+	MoveRequest.SetAcceptanceRadius(State.Desired.AcceptanceRadius);
+	MoveRequest.SetUsePathfinding(true);
+	MoveRequest.SetAllowPartialPath(true);
+
+	// A wave marching down its lane shares the team's flow field instead of one query per minion
+	UCFlowFieldSubsystem* FlowFields = UCFlowFieldSubsystem::Get(this);
+	if (FlowFields && MoveRequest.IsMoveToActorRequest())
+	{
+		if (FNavPathSharedPtr LanePath = FlowFields->BuildNavPath(*Controller, MoveRequest.GetGoalActor()))
+		{
+			++Counters.LanePaths;
+			State.LastQueryTime = Now;
+			State.bLastQueryFailed = false;
+			State.PathGoal = State.Desired;
+			State.MoveRequestId = Controller->RequestMove(MoveRequest, LanePath);
+			return true;
+		}
+	}
+
+	FPathFindingQuery Query;
+	if (!Controller->BuildPathfindingQuery(MoveRequest, Query))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UCPathRequestSubsystem: could not build a path query for %s"), *Controller->GetName());
+		State.bHasDesired = false;
+		return false;
+	}
+
+	State.PendingGoal = State.Desired;
+	State.PendingRequest = MoveRequest;
+	State.LastQueryTime = Now;
+	State.PendingQueryId = NavSys->FindPathAsync(Controller->GetNavAgentPropertiesRef(), Query,
+		FNavPathQueryDelegate::CreateUObject(this, &UCPathRequestSubsystem::HandlePathFound, State.Controller));
+	return State.PendingQueryId != INVALID_NAVQUERYID;
+}
+
+void UCPathRequestSubsystem::HandlePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, TWeakObjectPtr<AAIController> Controller)
+{
+	++Counters.Computed;
+	INC_DWORD_STAT(STAT_CPathQueriesComputed);
+
+	AAIController* AIC = Controller.Get();
+	FAgentState* State = AIC ? Agents.Find(AIC) : nullptr;
+	if (!State || State->PendingQueryId != QueryId)
+	{
+		// Stopped, superseded or destroyed while the query was running
+		return;
+	}
+	State->PendingQueryId = INVALID_NAVQUERYID;
+
+	if (Result != ENavigationQueryResult::Success || !Path.IsValid())
+	{
+		++Counters.Failed;
+		State->bLastQueryFailed = true;
+		State->FailedGoal = State->PendingGoal;
+		State->bHasDesired = false;
+		return;
+	}
+
+	State->bLastQueryFailed = false;
+	State->PathGoal = State->PendingGoal;
+	State->MoveRequestId = AIC->RequestMove(State->PendingRequest, Path);
+}
+
+static void PathRequestsStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UCPathRequestSubsystem* PathRequests = UCPathRequestSubsystem::Get(World);
+	if (!PathRequests)
+	{
+		Ar.Log(TEXT("Crunch.PathRequests.Stats: no path request subsystem in this world"));
+		return;
+	}
+
+	const FCPathRequestCounters& Counters = PathRequests->GetCounters();
+	Ar.Logf(TEXT("Path requests: %d agents, %d queued"), PathRequests->GetNumAgents(), PathRequests->GetNumQueued());
+	Ar.Logf(TEXT("  issued    %lld"), Counters.Issued);
+	Ar.Logf(TEXT("  coalesced %lld (%.1f%%)"), Counters.Coalesced, Counters.Issued > 0 ? 100.0 * Counters.Coalesced / Counters.Issued : 0.0);
+	Ar.Logf(TEXT("  throttled %lld"), Counters.Throttled);
+	Ar.Logf(TEXT("  lane      %lld"), Counters.LanePaths);
+	Ar.Logf(TEXT("  computed  %lld (%lld without a path)"), Counters.Computed, Counters.Failed);
+
+	if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+	{
+		PathRequests->ResetCounters();
+		Ar.Log(TEXT("Counters reset"));
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice PathRequestsStatsCommand(
+	TEXT("Crunch.PathRequests.Stats"),
+	TEXT("Crunch.PathRequests.Stats [reset]: print how many move requests were issued, coalesced, throttled, answered by a lane flow field and computed."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&PathRequestsStats));
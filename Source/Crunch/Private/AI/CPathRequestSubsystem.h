@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AITypes.h"
+#include "AI/Navigation/NavigationTypes.h"
+// ----------------------------------------------------------------------------
+// File: CPathRequestSubsystem.h
+// Purpose: Movement-request layer between AI code and AAIController. Behavior
+//          code asks for a move every tick; this layer turns that stream into
+//          the few path queries that are actually needed.
+// Key API:
+//  - RequestMoveToActor / RequestMoveToLocation: drop-in for MoveToActor /
+//    MoveToLocation. Returns RequestSuccessful while a path is queued or followed.
+//  - StopMovement: cancels queued queries as well as the current move.
+//  - GetCounters: issued / coalesced / throttled / computed totals.
+// Notes:
+//  - Moves to a lane goal follow the team's flow field route
+//    (UCFlowFieldSubsystem::BuildNavPath); other paths are computed with
+//    FindPathAsync. At most Crunch.PathRequests.QueriesPerFrame are dispatched
+//    per frame.
+//  - Crunch.PathRequests.Stats prints the counters; "stat AI" shows per-frame ones.
+// ----------------------------------------------------------------------------
+#include "CPathRequestSubsystem.generated.h"
+
+class AAIController;
+
+/** Running totals since the world started (or since ResetCounters) */
+struct FCPathRequestCounters
+{
+	/** Calls to RequestMoveToActor / RequestMoveToLocation */
+	int64 Issued = 0;
+
+	/** Requests answered by a path already followed, queued or in flight */
+	int64 Coalesced = 0;
+
+	/** Requests for a new goal deferred because the agent repathed too recently */
+	int64 Throttled = 0;
+
+	/** Dispatched moves answered by a lane flow field instead of a path query */
+	int64 LanePaths = 0;
+
+	/** Async path queries that came back, successful or not */
+	int64 Computed = 0;
+
+	/** Computed queries that found no path */
+	int64 Failed = 0;
+};
+
+/**
+ * UCPathRequestSubsystem owns one move state per AI controller.
+ *
+ * A request whose goal is within Crunch.PathRequests.RepathTolerance of the goal
+ * being followed (or queued) is coalesced. A new goal, or a goal actor that has
+ * drifted past the tolerance, triggers a repath, but never more often than
+ * Crunch.PathRequests.MinRepathInterval per agent. Pending queries are served
+ * first-in first-out from one queue shared by every agent.
+ */
+UCLASS()
+class UCPathRequestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Move toward Goal and keep following it. The path ends where the goal was
+	 * when it was computed; the subsystem repaths once the goal drifts away.
+	 */
+	EPathFollowingRequestResult::Type RequestMoveToActor(AAIController* Controller, AActor* Goal, float AcceptanceRadius = -1.f);
+	EPathFollowingRequestResult::Type RequestMoveToLocation(AAIController* Controller, const FVector& Goal, float AcceptanceRadius = -1.f);
+
+	/** Forget the agent's goal, drop its queued query and stop its path following */
+	void StopMovement(AAIController* Controller);
+
+	const FCPathRequestCounters& GetCounters() const { return Counters; }
+	void ResetCounters() { Counters = FCPathRequestCounters(); }
+
+	int32 GetNumAgents() const { return Agents.Num(); }
+	int32 GetNumQueued() const { return Queue.Num(); }
+
+	static UCPathRequestSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	struct FMoveGoal
+	{
+		/** Null for location goals */
+		TWeakObjectPtr<AActor> Actor;
+
+		/** The goal location; for actor goals, where the actor was when sampled */
+		FVector Location = FVector::ZeroVector;
+		float AcceptanceRadius = -1.f;
+
+		bool Matches(const FMoveGoal& Other, float Tolerance) const;
+	};
+
+	struct FAgentState
+	{
+		TWeakObjectPtr<AAIController> Controller;
+
+		/** Latest goal asked for by behavior code */
+		FMoveGoal Desired;
+		bool bHasDesired = false;
+
+		/** A query for Desired should be dispatched once the repath interval allows */
+		bool bWantsQuery = false;
+
+		/** Waiting in Queue for the per-frame budget */
+		bool bQueued = false;
+
+		/** In flight; results with any other ID are stale */
+		uint32 PendingQueryId = INVALID_NAVQUERYID;
+		FMoveGoal PendingGoal;
+		FAIMoveRequest PendingRequest;
+
+		/** Goal of the path handed to the path following component */
+		FMoveGoal PathGoal;
+		FAIRequestID MoveRequestId = FAIRequestID::InvalidRequest;
+
+		/** Last query that found no path; repeated requests for it fail until the interval has passed */
+		FMoveGoal FailedGoal;
+		bool bLastQueryFailed = false;
+
+		double LastQueryTime = -UE_BIG_NUMBER;
+	};
+
+	EPathFollowingRequestResult::Type RequestMove(AAIController* Controller, const FMoveGoal& Goal);
+
+	/** True while the path following component still runs the move this subsystem started */
+	static bool IsFollowingPath(const FAgentState& State, const AAIController& Controller);
+	static bool IsAtGoal(const FMoveGoal& Goal, const AAIController& Controller);
+
+	/** Follow the lane flow field or start a path query. Returns false when neither could be started; the agent's goal is then dropped */
+	bool DispatchQuery(FAgentState& State, double Now);
+
+	void HandlePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, TWeakObjectPtr<AAIController> Controller);
+
+	TMap<TObjectKey<AAIController>, FAgentState> Agents;
+
+	/** Agents waiting for a query, oldest first */
+	TArray<TObjectKey<AAIController>> Queue;
+
+	FCPathRequestCounters Counters;
+};
@@ -0,0 +1,469 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/CPerceptionSubsystem.h"
+#include "AIController.h"
+#include "Engine/World.h"
+#include "Framework/CSpatialIndexSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Perception Update Listeners"), STAT_CPerceptionUpdate, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Perception Pairs Checked"), STAT_CPerceptionPairs, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Perception Visibility Cache Hits"), STAT_CPerceptionCacheHits, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Perception Visibility Traces"), STAT_CPerceptionTraces, STATGROUP_AI);
+
+static TAutoConsoleVariable<float> CVarPerceptionUpdateInterval(
+	TEXT("Crunch.Perception.UpdateInterval"),
+	0.15f,
+	TEXT("Seconds between two sight updates of the same listener."));
+
+static TAutoConsoleVariable<int32> CVarPerceptionListenersPerFrame(
+	TEXT("Crunch.Perception.ListenersPerFrame"),
+	32,
+	TEXT("Maximum listeners whose sight is updated in one frame. Late listeners are picked up next frame."));
+
+static TAutoConsoleVariable<int32> CVarPerceptionTracesPerFrame(
+	TEXT("Crunch.Perception.TracesPerFrame"),
+	64,
+	TEXT("Maximum async visibility traces issued per frame."));
+
+static TAutoConsoleVariable<float> CVarPerceptionVisibilityTTL(
+	TEXT("Crunch.Perception.VisibilityTTL"),
+	0.25f,
+	TEXT("Seconds a pawn pair's line-of-sight result is reused before it is traced again."));
+
+/** Cache entries nobody asked about for this long are dropped */
+static constexpr double PerceptionVisibilityIdleTime = 2.0;
+
+void UCPerceptionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	TraceDelegate.BindUObject(this, &UCPerceptionSubsystem::HandleTraceDone);
+}
+
+void UCPerceptionSubsystem::Deinitialize()
+{
+	TraceDelegate.Unbind();
+	Listeners.Empty();
+	PerceivedActorsChangedHandlers.Empty();
+	Visibility.Empty();
+	TraceQueue.Empty();
+	PendingTraces.Empty();
+	Super::Deinitialize();
+}
+
+void UCPerceptionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this);
+	if (SpatialIndex && Listeners.Num() > 0)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_CPerceptionUpdate);
+
+		const int32 MaxUpdates = FMath::Max(1, CVarPerceptionListenersPerFrame.GetValueOnGameThread());
+		const int32 NumToVisit = Listeners.Num();
+		int32 NumUpdated = 0;
+		for (int32 Visited = 0; Visited < NumToVisit && NumUpdated < MaxUpdates && Listeners.Num() > 0; ++Visited)
+		{
+			NextListener = NextListener % Listeners.Num();
+			const int32 ListenerIndex = NextListener++;
+
+			if (!Listeners[ListenerIndex].Controller.IsValid())
+			{
+				Listeners.RemoveAtSwap(ListenerIndex);
+				continue;
+			}
+
+			if (Listeners[ListenerIndex].NextUpdateTime <= Now)
+			{
+				UpdateListener(ListenerIndex, Now, *SpatialIndex);
+				++NumUpdated;
+			}
+		}
+	}
+
+	DispatchTraces(Now);
+
+	if (Now - LastPruneTime > 1.0)
+	{
+		PruneVisibility(Now);
+		LastPruneTime = Now;
+	}
+}
+
+TStatId UCPerceptionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCPerceptionSubsystem, STATGROUP_Tickables);
+}
+
+UCPerceptionSubsystem* UCPerceptionSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCPerceptionSubsystem>() : nullptr;
+}
+
+void UCPerceptionSubsystem::RegisterListener(AAIController* Controller, const FCSightConfig& Sight, FCOnTargetPerceptionUpdated OnUpdated, FCOnTargetPerceptionForgotten OnForgotten)
+{
+	if (!Controller)
+	{
+		return;
+	}
+
+	FListener* Listener = FindListener(Controller);
+	if (!Listener)
+	{
+		Listener = &Listeners.AddDefaulted_GetRef();
+		Listener->Controller = Controller;
+	}
+
+	Listener->Sight = Sight;
+	Listener->OnUpdated = MoveTemp(OnUpdated);
+	Listener->OnForgotten = MoveTemp(OnForgotten);
+	Listener->Perceived.Reset();
+	Listener->bEnabled = true;
+
+	// Stagger first updates so listeners spawned together do not share a frame forever
+	Listener->NextUpdateTime = GetWorld()->GetTimeSeconds() + FMath::FRand() * CVarPerceptionUpdateInterval.GetValueOnGameThread();
+}
+
+void UCPerceptionSubsystem::UnregisterListener(AAIController* Controller)
+{
+	const int32 Index = Listeners.IndexOfByPredicate([Controller](const FListener& Listener)
+	{
+		return Listener.Controller == Controller;
+	});
+	if (Index != INDEX_NONE)
+	{
+		Listeners.RemoveAtSwap(Index);
+	}
+}
+
+void UCPerceptionSubsystem::SetListenerEnabled(AAIController* Controller, bool bEnabled)
+{
+	if (FListener* Listener = FindListener(Controller))
+	{
+		Listener->bEnabled = bEnabled;
+		if (!bEnabled && Listener->Perceived.Num() > 0)
+		{
+			Listener->Perceived.Reset();
+			BroadcastPerceivedActorsChanged(Controller);
+		}
+	}
+}
+
+void UCPerceptionSubsystem::ForgetTarget(AAIController* Controller, AActor* Target)
+{
+	FListener* Listener = FindListener(Controller);
+	if (!Listener)
+	{
+		return;
+	}
+
+	for (FPerceivedTarget& Perceived : Listener->Perceived)
+	{
+		if (Perceived.Actor == Target && !Perceived.bSensed)
+		{
+			Perceived.LastSensedTime = -UE_BIG_NUMBER;
+			Listener->NextUpdateTime = 0.0;
+		}
+	}
+}
+
+void UCPerceptionSubsystem::GetPerceivedActors(const AAIController* Controller, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reset();
+	if (const FListener* Listener = FindListener(Controller))
+	{
+		for (const FPerceivedTarget& Perceived : Listener->Perceived)
+		{
+			if (Perceived.bSensed && Perceived.Actor.IsValid())
+			{
+				OutActors.Add(Perceived.Actor.Get());
+			}
+		}
+	}
+}
+
+FDelegateHandle UCPerceptionSubsystem::AddPerceivedActorsChangedHandler(const AAIController* Controller, FCOnPerceivedActorsChanged::FDelegate Handler)
+{
+	if (!Controller)
+	{
+		return FDelegateHandle();
+	}
+	return PerceivedActorsChangedHandlers.FindOrAdd(Controller).Add(MoveTemp(Handler));
+}
+
+void UCPerceptionSubsystem::RemovePerceivedActorsChangedHandler(const AAIController* Controller, FDelegateHandle Handle)
+{
+	if (FCOnPerceivedActorsChanged* Handlers = PerceivedActorsChangedHandlers.Find(Controller))
+	{
+		Handlers->Remove(Handle);
+		if (!Handlers->IsBound())
+		{
+			PerceivedActorsChangedHandlers.Remove(Controller);
+		}
+	}
+}
+
+void UCPerceptionSubsystem::BroadcastPerceivedActorsChanged(AAIController* Controller)
+{
+	// Copied: a handler may subscribe another controller and grow the map
+	if (const FCOnPerceivedActorsChanged* Handlers = PerceivedActorsChangedHandlers.Find(Controller))
+	{
+		const FCOnPerceivedActorsChanged HandlersCopy = *Handlers;
+		HandlersCopy.Broadcast(Controller);
+	}
+}
+
+UCPerceptionSubsystem::FPairKey UCPerceptionSubsystem::MakePairKey(const AActor* A, const AActor* B)
+{
+	const TObjectKey<AActor> KeyA(A);
+	const TObjectKey<AActor> KeyB(B);
+	return KeyA < KeyB ? FPairKey(KeyA, KeyB) : FPairKey(KeyB, KeyA);
+}
+
+UCPerceptionSubsystem::FListener* UCPerceptionSubsystem::FindListener(const AAIController* Controller)
+{
+	return Listeners.FindByPredicate([Controller](const FListener& Listener)
+	{
+		return Listener.Controller == Controller;
+	});
+}
+
+const UCPerceptionSubsystem::FListener* UCPerceptionSubsystem::FindListener(const AAIController* Controller) const
+{
+	return Listeners.FindByPredicate([Controller](const FListener& Listener)
+	{
+		return Listener.Controller == Controller;
+	});
+}
+
+void UCPerceptionSubsystem::UpdateListener(int32 ListenerIndex, double Now, const UCSpatialIndexSubsystem& SpatialIndex)
+{
+	FListener& Listener = Listeners[ListenerIndex];
+	Listener.NextUpdateTime = Now + CVarPerceptionUpdateInterval.GetValueOnGameThread();
+
+	APawn* Pawn = Listener.Controller->GetPawn();
+	if (!Listener.bEnabled || !Pawn)
+	{
+		return;
+	}
+
+	const FCSightConfig& Sight = Listener.Sight;
+	const FVector Origin = Pawn->GetActorLocation();
+	const FVector Forward = Pawn->GetActorForwardVector().GetSafeNormal2D();
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(Sight.PeripheralVisionAngleDegrees, 0.f, 180.f)));
+
+	TArray<APawn*> Candidates;
+	SpatialIndex.QueryRadius(Origin, FMath::Max(Sight.SightRadius, Sight.LoseSightRadius), FCSpatialQueryFilter::Hostile(Pawn), Candidates);
+
+	// Targets that stay sensed this update: visible, or sensed before and still waiting for a trace
+	TSet<AActor*> StillSensed;
+	TArray<AActor*> NewlySensed;
+	for (APawn* Candidate : Candidates)
+	{
+		const int32 PerceivedIndex = Listener.Perceived.IndexOfByPredicate([Candidate](const FPerceivedTarget& Perceived)
+		{
+			return Perceived.Actor == Candidate;
+		});
+		const bool bWasSensed = PerceivedIndex != INDEX_NONE && Listener.Perceived[PerceivedIndex].bSensed;
+
+		const FVector ToCandidate = Candidate->GetActorLocation() - Origin;
+		const float Range = bWasSensed ? Sight.LoseSightRadius : Sight.SightRadius;
+		if (ToCandidate.SizeSquared() > FMath::Square(Range))
+		{
+			continue;
+		}
+		if (CosHalfAngle > -1.f && FVector::DotProduct(ToCandidate.GetSafeNormal2D(), Forward) < CosHalfAngle)
+		{
+			continue;
+		}
+
+		INC_DWORD_STAT(STAT_CPerceptionPairs);
+		const EVisibility PairVisibility = GetVisibility(Pawn, Candidate, Now);
+		if (PairVisibility == EVisibility::Visible)
+		{
+			StillSensed.Add(Candidate);
+			if (PerceivedIndex == INDEX_NONE)
+			{
+				FPerceivedTarget& Perceived = Listener.Perceived.AddDefaulted_GetRef();
+				Perceived.Actor = Candidate;
+				Perceived.LastSensedTime = Now;
+				Perceived.bSensed = true;
+				NewlySensed.Add(Candidate);
+			}
+			else
+			{
+				FPerceivedTarget& Perceived = Listener.Perceived[PerceivedIndex];
+				Perceived.LastSensedTime = Now;
+				if (!Perceived.bSensed)
+				{
+					Perceived.bSensed = true;
+					NewlySensed.Add(Candidate);
+				}
+			}
+		}
+		else if (PairVisibility == EVisibility::Unknown && bWasSensed)
+		{
+			StillSensed.Add(Candidate);
+		}
+	}
+
+	TArray<AActor*> LostSight;
+	TArray<AActor*> Forgotten;
+	for (int32 Index = Listener.Perceived.Num() - 1; Index >= 0; --Index)
+	{
+		FPerceivedTarget& Perceived = Listener.Perceived[Index];
+		AActor* Target = Perceived.Actor.Get();
+		if (!Target)
+		{
+			Listener.Perceived.RemoveAt(Index);
+			continue;
+		}
+
+		if (Perceived.bSensed)
+		{
+			if (!StillSensed.Contains(Target))
+			{
+				Perceived.bSensed = false;
+				LostSight.Add(Target);
+			}
+		}
+		else if (Sight.MaxAge > 0.f && Now - Perceived.LastSensedTime > Sight.MaxAge)
+		{
+			Listener.Perceived.RemoveAt(Index);
+			Forgotten.Add(Target);
+		}
+	}
+
+	if (NewlySensed.Num() == 0 && LostSight.Num() == 0 && Forgotten.Num() == 0)
+	{
+		return;
+	}
+
+	// Callbacks may register or unregister listeners, so nothing below touches Listener
+	AAIController* Controller = Listener.Controller.Get();
+	const FCOnTargetPerceptionUpdated OnUpdated = Listener.OnUpdated;
+	const FCOnTargetPerceptionForgotten OnForgotten = Listener.OnForgotten;
+	for (AActor* Target : NewlySensed)
+	{
+		OnUpdated.ExecuteIfBound(Target, true);
+	}
+	for (AActor* Target : LostSight)
+	{
+		OnUpdated.ExecuteIfBound(Target, false);
+	}
+	for (AActor* Target : Forgotten)
+	{
+		OnForgotten.ExecuteIfBound(Target);
+	}
+
+	// Forgetting a lost target does not change the sensed list
+	if (NewlySensed.Num() > 0 || LostSight.Num() > 0)
+	{
+		BroadcastPerceivedActorsChanged(Controller);
+	}
+}
+
+UCPerceptionSubsystem::EVisibility UCPerceptionSubsystem::GetVisibility(AActor* Listener, AActor* Target, double Now)
+{
+	const FPairKey Key = MakePairKey(Listener, Target);
+	FVisibilityEntry& Entry = Visibility.FindOrAdd(Key);
+	Entry.LastUsedTime = Now;
+
+	if (Entry.bHasResult && Now < Entry.ExpireTime)
+	{
+		INC_DWORD_STAT(STAT_CPerceptionCacheHits);
+		return Entry.bVisible ? EVisibility::Visible : EVisibility::Blocked;
+	}
+
+	if (!Entry.bTracePending)
+	{
+		Entry.First = Listener;
+		Entry.Second = Target;
+		Entry.bTracePending = true;
+		TraceQueue.Add(Key);
+	}
+
+	// An expired result is still the best answer until the new trace lands
+	if (Entry.bHasResult)
+	{
+		return Entry.bVisible ? EVisibility::Visible : EVisibility::Blocked;
+	}
+	return EVisibility::Unknown;
+}
+
+void UCPerceptionSubsystem::DispatchTraces(double Now)
+{
+	UWorld* World = GetWorld();
+	const int32 Budget = FMath::Max(1, CVarPerceptionTracesPerFrame.GetValueOnGameThread());
+
+	int32 NumIssued = 0;
+	int32 NumConsumed = 0;
+	for (; NumConsumed < TraceQueue.Num() && NumIssued < Budget; ++NumConsumed)
+	{
+		const FPairKey& Key = TraceQueue[NumConsumed];
+		FVisibilityEntry* Entry = Visibility.Find(Key);
+		if (!Entry)
+		{
+			continue;
+		}
+
+		const APawn* First = Cast<APawn>(Entry->First.Get());
+		const APawn* Second = Cast<APawn>(Entry->Second.Get());
+		if (!First || !Second)
+		{
+			Visibility.Remove(Key);
+			continue;
+		}
+
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(CPerceptionSight), false);
+		Params.AddIgnoredActor(First);
+		Params.AddIgnoredActor(Second);
+
+		const uint32 TraceId = ++NextTraceId;
+		PendingTraces.Add(TraceId, Key);
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Test, First->GetPawnViewLocation(), Second->GetPawnViewLocation(),
+			ECC_Visibility, Params, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, TraceId);
+
+		++NumIssued;
+		INC_DWORD_STAT(STAT_CPerceptionTraces);
+	}
+	TraceQueue.RemoveAt(0, NumConsumed, EAllowShrinking::No);
+}
+
+void UCPerceptionSubsystem::HandleTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	FPairKey Key;
+	if (!PendingTraces.RemoveAndCopyValue(Datum.UserData, Key))
+	{
+		return;
+	}
+
+	FVisibilityEntry* Entry = Visibility.Find(Key);
+	if (!Entry)
+	{
+		return;
+	}
+
+	const bool bBlocked = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit;
+	Entry->bVisible = !bBlocked;
+	Entry->bHasResult = true;
+	Entry->bTracePending = false;
+	Entry->ExpireTime = GetWorld()->GetTimeSeconds() + CVarPerceptionVisibilityTTL.GetValueOnGameThread();
+}
+
+void UCPerceptionSubsystem::PruneVisibility(double Now)
+{
+	for (auto It = Visibility.CreateIterator(); It; ++It)
+	{
+		const FVisibilityEntry& Entry = It.Value();
+		if (!Entry.bTracePending && Now - Entry.LastUsedTime > PerceptionVisibilityIdleTime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
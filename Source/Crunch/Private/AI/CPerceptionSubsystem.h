@@ -0,0 +1,175 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+// ----------------------------------------------------------------------------
+// File: CPerceptionSubsystem.h
+// Purpose: Batched sight for AI controllers. Replaces one UAIPerceptionComponent
+//          sight sense per minion with a single service that pulls candidate
+//          pairs from UCSpatialIndexSubsystem and checks line of sight with
+//          async traces shared by both pawns of a pair.
+// Key API:
+//  - RegisterListener / UnregisterListener: controller + FCSightConfig + callbacks.
+//  - GetPerceivedActors: currently sensed hostiles (GetPerceivedHostileActors).
+//  - AddPerceivedActorsChangedHandler: push notification when that list changes.
+//  - ForgetTarget / SetListenerEnabled: mirror stimulus aging and sense toggling.
+// Notes:
+//  - Crunch.Perception.ListenersPerFrame / TracesPerFrame bound the work per frame.
+//  - Visibility per pawn pair is cached for Crunch.Perception.VisibilityTTL.
+// ----------------------------------------------------------------------------
+#include "CPerceptionSubsystem.generated.h"
+
+class AAIController;
+class UCSpatialIndexSubsystem;
+
+/** Sight settings of one listener; same meaning as the UAISenseConfig_Sight fields */
+USTRUCT(BlueprintType)
+struct FCSightConfig
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sight")
+	float SightRadius = 1000.f;
+
+	/** A sensed target stays sensed up to this distance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sight")
+	float LoseSightRadius = 1200.f;
+
+	/** Half angle from the pawn's forward vector; 180 sees all around */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sight")
+	float PeripheralVisionAngleDegrees = 180.f;
+
+	/** Seconds a lost target is remembered before it is forgotten; 0 never forgets */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sight")
+	float MaxAge = 5.f;
+};
+
+/** Fired when a target is sensed, and again with false when sight of it is lost */
+DECLARE_DELEGATE_TwoParams(FCOnTargetPerceptionUpdated, AActor* /*TargetActor*/, bool /*bSuccessfullySensed*/);
+
+/** Fired when a lost target has aged out and is no longer perceived at all */
+DECLARE_DELEGATE_OneParam(FCOnTargetPerceptionForgotten, AActor* /*ForgottenActor*/);
+
+/** Fired once per listener update that changed what GetPerceivedActors returns */
+DECLARE_MULTICAST_DELEGATE_OneParam(FCOnPerceivedActorsChanged, AAIController* /*Controller*/);
+
+/**
+ * UCPerceptionSubsystem updates every listener on an interval, spread over
+ * frames. A listener's candidates are the hostile pawns the spatial index finds
+ * within its lose-sight radius and view cone. Each candidate pair is answered
+ * from the visibility cache or queued for an async visibility trace, so the
+ * number of traces follows the number of pawn pairs that are close to each
+ * other, not listeners times targets.
+ *
+ * Visibility is cached per unordered pawn pair: an eye-to-eye trace between a
+ * minion of each team answers both of them.
+ */
+UCLASS()
+class UCPerceptionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Start (or restart) sensing for Controller's pawn. Previously perceived targets are dropped. */
+	void RegisterListener(AAIController* Controller, const FCSightConfig& Sight, FCOnTargetPerceptionUpdated OnUpdated, FCOnTargetPerceptionForgotten OnForgotten);
+	void UnregisterListener(AAIController* Controller);
+
+	/** A disabled listener perceives nothing and loses its current targets without events */
+	void SetListenerEnabled(AAIController* Controller, bool bEnabled);
+
+	/** Age a lost target out right away; it is forgotten on the listener's next update */
+	void ForgetTarget(AAIController* Controller, AActor* Target);
+
+	/** Targets the listener currently sees, oldest sensed first */
+	void GetPerceivedActors(const AAIController* Controller, TArray<AActor*>& OutActors) const;
+
+	/** Subscribe to changes of Controller's perceived actors; kept across RegisterListener restarts */
+	FDelegateHandle AddPerceivedActorsChangedHandler(const AAIController* Controller, FCOnPerceivedActorsChanged::FDelegate Handler);
+	void RemovePerceivedActorsChangedHandler(const AAIController* Controller, FDelegateHandle Handle);
+
+	int32 GetNumListeners() const { return Listeners.Num(); }
+	int32 GetNumCachedPairs() const { return Visibility.Num(); }
+
+	static UCPerceptionSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	struct FPerceivedTarget
+	{
+		TWeakObjectPtr<AActor> Actor;
+		double LastSensedTime = 0.0;
+		bool bSensed = false;
+	};
+
+	struct FListener
+	{
+		TWeakObjectPtr<AAIController> Controller;
+		FCSightConfig Sight;
+		FCOnTargetPerceptionUpdated OnUpdated;
+		FCOnTargetPerceptionForgotten OnForgotten;
+		TArray<FPerceivedTarget> Perceived;
+		double NextUpdateTime = 0.0;
+		bool bEnabled = true;
+	};
+
+	enum class EVisibility : uint8
+	{
+		Visible,
+		Blocked,
+		Unknown,
+	};
+
+	/** Unordered pawn pair, smaller key first */
+	typedef TPair<TObjectKey<AActor>, TObjectKey<AActor>> FPairKey;
+
+	struct FVisibilityEntry
+	{
+		TWeakObjectPtr<AActor> First;
+		TWeakObjectPtr<AActor> Second;
+		double ExpireTime = 0.0;
+		double LastUsedTime = 0.0;
+		bool bHasResult = false;
+		bool bVisible = false;
+		bool bTracePending = false;
+	};
+
+	static FPairKey MakePairKey(const AActor* A, const AActor* B);
+
+	FListener* FindListener(const AAIController* Controller);
+	const FListener* FindListener(const AAIController* Controller) const;
+
+	void UpdateListener(int32 ListenerIndex, double Now, const UCSpatialIndexSubsystem& SpatialIndex);
+
+	/** Cached visibility of the pair; Unknown queues a trace unless one is already pending */
+	EVisibility GetVisibility(AActor* Listener, AActor* Target, double Now);
+
+	void BroadcastPerceivedActorsChanged(AAIController* Controller);
+
+	void DispatchTraces(double Now);
+	void HandleTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+	void PruneVisibility(double Now);
+
+	TArray<FListener> Listeners;
+
+	TMap<TObjectKey<AAIController>, FCOnPerceivedActorsChanged> PerceivedActorsChangedHandlers;
+
+	/** Listener index the next frame's update pass starts from */
+	int32 NextListener = 0;
+
+	TMap<FPairKey, FVisibilityEntry> Visibility;
+	TArray<FPairKey> TraceQueue;
+
+	/** Traces in flight by the ID stored in FTraceDatum::UserData */
+	TMap<uint32, FPairKey> PendingTraces;
+	uint32 NextTraceId = 0;
+
+	FTraceDelegate TraceDelegate;
+	double LastPruneTime = 0.0;
+};
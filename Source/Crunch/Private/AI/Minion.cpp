@@ -3,7 +3,51 @@
 
 #include "AI/Minion.h"
 #include "AIController.h"
+#include "AI/CMinionMovementComponent.h"
+#include "AI/CPerceptionSubsystem.h"
+#include "AbilitySystemComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BrainComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Framework/CSpatialIndexSubsystem.h"
+#include "GAS/CAbilitySystemComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "IAnimationBudgetAllocator.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "TimerManager.h"
+
+AMinion::AMinion(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer
+		.SetDefaultSubobjectClass<UCMinionMovementComponent>(ACharacter::CharacterMovementComponentName)
+		.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
+{
+	if (USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh()))
+	{
+		// Let the animation budget allocator rank minions by distance to the view
+		BudgetedMesh->SetAutoCalculateSignificance(true);
+	}
+
+	// Nobody predicts for a minion: clients only need the cues and effect-granted tags, not the effects
+	GetAbilitySystemComponent()->SetReplicationMode(EGameplayEffectReplicationMode::Minimal);
+}
+
+void AMinion::BeginPlay()
+{
+	if (IsNetMode(NM_DedicatedServer))
+	{
+		// Nobody looks at the pose on a dedicated server. Bones are only needed by montage
+		// notifies that read sockets (AN_SendTargetGroup), so refresh them only during montages.
+		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesAndRefreshBonesWhenPlayingMontages;
+
+		// The budget allocator ranks by view distance, which a server does not have
+		if (USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh()))
+		{
+			BudgetedMesh->SetAutoRegisterWithBudgetAllocator(false);
+		}
+	}
+
+	Super::BeginPlay();
+}
 
 void AMinion::SetGenericTeamId(const FGenericTeamId& NewTeamId)
 {
@@ -13,12 +57,31 @@ void AMinion::SetGenericTeamId(const FGenericTeamId& NewTeamId)
 
 bool AMinion::IsActive() const
 {
-	return !IsDead();
+	return !IsDead() && !bPooled;
 }
 
 void AMinion::Activate()
 {
-	RespawnImmediately();
+	bPooled = false;
+	GetWorldTimerManager().ClearTimer(PoolSleepTimerHandle);
+	Wake();
+
+	// Demoted minions come back alive and possibly damaged, dead ones with their Dead effect
+	if (UCAbilitySystemComponent* ASC = Cast<UCAbilitySystemComponent>(GetAbilitySystemComponent()))
+	{
+		ASC->ResetForReuse();
+	}
+	else
+	{
+		RespawnImmediately();
+	}
+}
+
+void AMinion::EnterPool()
+{
+	bPooled = true;
+	GetWorldTimerManager().ClearTimer(PoolSleepTimerHandle);
+	Sleep();
 }
 
 void AMinion::SetGoal(AActor* Goal)
@@ -45,3 +108,130 @@ void AMinion::OnRep_TeamID()
 {
 	PickSkinBasedOnTeamID();
 }
+
+void AMinion::OnDead()
+{
+	if (HasAuthority())
+	{
+		OnMinionInactive.Broadcast(this);
+	}
+
+	// Runs on clients too, so idle pool entries stop ticking everywhere
+	GetWorldTimerManager().SetTimer(PoolSleepTimerHandle, this, &AMinion::EnterPool, PoolSleepDelay);
+}
+
+void AMinion::OnRespawn()
+{
+	bPooled = false;
+	GetWorldTimerManager().ClearTimer(PoolSleepTimerHandle);
+	Wake();
+}
+
+void AMinion::Sleep()
+{
+	if (bAsleep)
+	{
+		return;
+	}
+	bAsleep = true;
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	GetMesh()->SetSimulatePhysics(false);
+	SetAnimBudgetRegistered(false);
+	GetMesh()->SetComponentTickEnabled(false);
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+
+	if (UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this))
+	{
+		SpatialIndex->SetPawnTargetable(this, false);
+	}
+
+	if (AAIController* AIController = GetController<AAIController>())
+	{
+		AIController->StopMovement();
+		AIController->SetActorTickEnabled(false);
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->PauseLogic(TEXT("Pooled"));
+		}
+		if (UCPerceptionSubsystem* Perception = UCPerceptionSubsystem::Get(this))
+		{
+			Perception->SetListenerEnabled(AIController, false);
+		}
+	}
+
+	// Clients keep the last replicated state (hidden) until the minion is activated again
+	if (HasAuthority())
+	{
+		SetNetDormancy(DORM_DormantAll);
+	}
+}
+
+void AMinion::Wake()
+{
+	if (!bAsleep)
+	{
+		return;
+	}
+	bAsleep = false;
+
+	// Wake before any state change so clients receive the activation
+	if (HasAuthority())
+	{
+		SetNetDormancy(DORM_Awake);
+	}
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	GetMesh()->SetComponentTickEnabled(true);
+	SetAnimBudgetRegistered(true);
+
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+
+	if (UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this))
+	{
+		SpatialIndex->SetPawnTargetable(this, !IsDead());
+	}
+
+	if (AAIController* AIController = GetController<AAIController>())
+	{
+		AIController->SetActorTickEnabled(true);
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->ResumeLogic(TEXT("Pooled"));
+		}
+		if (UCPerceptionSubsystem* Perception = UCPerceptionSubsystem::Get(this))
+		{
+			Perception->SetListenerEnabled(AIController, !IsDead());
+		}
+	}
+}
+
+void AMinion::SetAnimBudgetRegistered(bool bRegistered)
+{
+	USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh());
+	IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+	if (!BudgetedMesh || !Allocator || !BudgetedMesh->GetAutoRegisterWithBudgetAllocator())
+	{
+		return;
+	}
+
+	// The allocator drives the mesh tick, so a sleeping minion must leave it
+	if (bRegistered)
+	{
+		Allocator->RegisterComponent(BudgetedMesh);
+	}
+	else
+	{
+		Allocator->UnregisterComponent(BudgetedMesh);
+	}
+}
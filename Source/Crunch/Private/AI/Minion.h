@@ -12,7 +12,11 @@
 // Key API:
 //  - SetGenericTeamId: updates team and applies team-specific skeletal mesh.
 //  - IsActive / Activate: mirrors death/respawn semantics in ACCharacter.
+//  - EnterPool / OnMinionInactive: pooled minions sleep (no tick, movement,
+//    perception or replication) until AMinionBarrack activates them again.
 //  - SetGoal: writes a Goal actor reference to the controller's blackboard.
+//  - Animation: budgeted skeletal mesh (AnimationBudgetAllocator); on dedicated
+//    servers bones are only refreshed while a montage plays.
 // ----------------------------------------------------------------------------
 #include "Minion.generated.h"
 
@@ -21,8 +25,12 @@
  *
  * Responsibilities:
  *  - Team visuals: applies a SkeletalMesh from SkinMap keyed by FGenericTeamId.
- *  - Lifecycle: IsActive() reflects !IsDead(); Activate() performs immediate
- *    respawn via RespawnImmediately().
+ *  - Lifecycle: IsActive() is false while dead or pooled; Activate() wakes the
+ *    minion and resets its ability system (effects of its previous life removed,
+ *    full stats), which also respawns a dead minion.
+ *  - Pooling: on death the server fires OnMinionInactive so the owning barrack
+ *    can reuse the minion; PoolSleepDelay later (after the death animation) it
+ *    falls asleep until activated.
  *  - Behavior input: SetGoal(AActor*) writes a Goal object into the
  *    controller's UBlackboardComponent under GoalBlackboardKeyName.
  *
@@ -30,22 +38,53 @@
  *  - OnRep_TeamID ensures replicated team changes also update visuals.
  *  - GoalBlackboardKeyName defaults to "Goal" and is editable per instance.
  */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnMinionInactive, class AMinion* /*Minion*/);
+
 UCLASS()
 class AMinion : public ACCharacter
 {
     GENERATED_BODY()
 public:
+    // Walks with UCMinionMovementComponent instead of the stock character movement
+    AMinion(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
     virtual void SetGenericTeamId(const FGenericTeamId& NewTeamId) override;
 
     bool IsActive() const;
     void Activate();
     virtual void SetGoal(AActor* Goal);
 
+    /** Put an unused minion to sleep right away (pool prewarm) */
+    void EnterPool();
+    bool IsPooled() const { return bPooled; }
+
+    /** Server only: the minion died and may be reused */
+    FOnMinionInactive OnMinionInactive;
+
+protected:
+    virtual void BeginPlay() override;
+
 private:
     void PickSkinBasedOnTeamID();
 
     virtual void OnRep_TeamID() override;
 
+    virtual void OnDead() override;
+    virtual void OnRespawn() override;
+
+    /** Turn off everything that costs frame time or bandwidth while pooled */
+    void Sleep();
+    void Wake();
+    void SetAnimBudgetRegistered(bool bRegistered);
+
+    /** Seconds after death before a pooled minion sleeps, so the death animation can play */
+    UPROPERTY(EditDefaultsOnly, Category = "Pool")
+    float PoolSleepDelay = 3.f;
+
+    FTimerHandle PoolSleepTimerHandle;
+    bool bPooled = false;
+    bool bAsleep = false;
+
     UPROPERTY(EditDefaultsOnly, Category = "AI")
     FName GoalBlackboardKeyName = "Goal";
 
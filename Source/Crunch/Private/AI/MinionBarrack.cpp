@@ -3,13 +3,22 @@
 
 #include "AI/MinionBarrack.h"
 #include "AI/Minion.h"
+#include "AI/CFlowFieldSubsystem.h"
+#include "AI/CMinionLODSubsystem.h"
+#include "Framework/CSpatialIndexSubsystem.h"
+#include "Framework/StormCore.h"
 #include "GameFramework/PlayerStart.h"
+#include "Kismet/GameplayStatics.h"
+#include "Player/CPlayerCharacter.h"
+#include "BehaviacSharedBlackboard.h"
 
 // Sets default values
 AMinionBarrack::AMinionBarrack()
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+	// Only ticks while a wave is being spawned
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 }
 
@@ -20,6 +29,14 @@ void AMinionBarrack::BeginPlay()
 	if (HasAuthority())
 	{
 		GetWorldTimerManager().SetTimer(SpawnIntervalTimerHandle, this, &AMinionBarrack::SpawnNewGroup, GroupSpawnInterval, true);
+		RegisterTeamBlackboardProducers();
+		RegisterLaneFlowField();
+		PrewarmPool();
+
+		if (UCMinionLODSubsystem* MinionLOD = UCMinionLODSubsystem::Get(this))
+		{
+			MinionLOD->RegisterBarrack(this);
+		}
 	}
 }
 
@@ -28,6 +45,16 @@ void AMinionBarrack::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	for (int i = 0; i < FMath::Max(MaxSpawnsPerFrame, 1) && PendingSpawns > 0; ++i)
+	{
+		SpawnOne();
+		--PendingSpawns;
+	}
+
+	if (PendingSpawns <= 0)
+	{
+		SetActorTickEnabled(false);
+	}
 }
 
 const APlayerStart* AMinionBarrack::GetNextSpawnSpot()
@@ -47,53 +74,203 @@ const APlayerStart* AMinionBarrack::GetNextSpawnSpot()
 	return SpawnSpots[NextSpawnSpotIndex];
 }
 
+void AMinionBarrack::PrewarmPool()
+{
+	FreeMinions.Reserve(PoolPrewarmCount);
+	for (int i = 0; i < PoolPrewarmCount; i++)
+	{
+		AMinion* NewMinion = SpawnNewMinion(GetActorTransform());
+		if (!NewMinion)
+			break;
+
+		NewMinion->EnterPool();
+		FreeMinions.Push(NewMinion);
+	}
+}
+
 void AMinionBarrack::SpawnNewGroup()
 {
-	int i = MinionPerGroup;
+	// Spread the wave over the next frames instead of spawning it all at once
+	PendingSpawns += MinionPerGroup;
+	SetActorTickEnabled(true);
+}
 
-	while (i > 0)
+void AMinionBarrack::SpawnOne()
+{
+	FTransform SpawnTransfrom = GetActorTransform();
+	if (const APlayerStart* NextSpawnSpot = GetNextSpawnSpot())
 	{
-		FTransform SpawnTransfrom = GetActorTransform();
-		if (const APlayerStart* NextSpawnSpot = GetNextSpawnSpot())
-		{
-			SpawnTransfrom = NextSpawnSpot->GetActorTransform();
-		}
-		
-		AMinion* NextAvaliableMinon = GetNextAvaliableMinion();
-		if (!NextAvaliableMinon)
-			break;
+		SpawnTransfrom = NextSpawnSpot->GetActorTransform();
+	}
 
-		NextAvaliableMinon->SetActorTransform(SpawnTransfrom);
+	ActivateMinionAt(SpawnTransfrom);
+}
+
+AMinion* AMinionBarrack::ActivateMinionAt(const FTransform& SpawnTransform)
+{
+	if (AMinion* NextAvaliableMinon = PopFreeMinion())
+	{
+		NextAvaliableMinon->SetActorTransform(SpawnTransform);
 		NextAvaliableMinon->Activate();
-		--i;
+		return NextAvaliableMinon;
+	}
+
+	return SpawnNewMinion(SpawnTransform);
+}
+
+void AMinionBarrack::DemoteMinion(AMinion* Minion)
+{
+	if (!Minion || !Minion->IsActive())
+		return;
+
+	Minion->EnterPool();
+	FreeMinions.Push(Minion);
+}
+
+AMinion* AMinionBarrack::SpawnNewMinion(const FTransform& SpawnTransform)
+{
+	// No encroachment search: the movement batch's crowd avoidance pushes overlapping minions apart
+	AMinion* NewMinion = GetWorld()->SpawnActorDeferred<AMinion>(MinionClass, SpawnTransform, this, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!NewMinion)
+	{
+		return nullptr;
 	}
 
-	SpawnNewMinions(i);
+	NewMinion->SetGenericTeamId(BarrackTeamId);
+	NewMinion->FinishSpawning(SpawnTransform);
+	NewMinion->SetGoal(Goal);
+	NewMinion->OnMinionInactive.AddUObject(this, &AMinionBarrack::MinionInactive);
+	MinionPool.Add(NewMinion);
+	return NewMinion;
 }
 
-void AMinionBarrack::SpawnNewMinions(int Amt)
+void AMinionBarrack::RegisterTeamBlackboardProducers()
 {
-	for (int i = 0; i < Amt; i++)
+	UBehaviacBlackboardSubsystem* Blackboards = GetWorld()->GetSubsystem<UBehaviacBlackboardSubsystem>();
+	if (!Blackboards || !Goal)
+	{
+		return;
+	}
+
+	StormCore = UGameplayStatics::GetActorOfClass(this, AStormCore::StaticClass());
+
+	// These facts are the same for every minion of this lane (or team), so
+	// publish them once per interval instead of having each minion compute them.
+	// Lane facts go on the barrack's own squad board: a team has several lanes,
+	// and producers on the team board would replace each other.
+	UBehaviacSharedBlackboard* LaneBlackboard = Blackboards->GetSquadBlackboard(GetLaneName());
+	TWeakObjectPtr<AMinionBarrack> WeakThis = this;
+	LaneBlackboard->RegisterProducer(TEXT("GoalLocation"), TeamFactUpdateInterval, [WeakThis]()
+	{
+		return WeakThis.IsValid() && WeakThis->Goal ? WeakThis->Goal->GetActorLocation().ToString() : FString();
+	});
+	LaneBlackboard->RegisterProducer(TEXT("LaneFront"), TeamFactUpdateInterval, [WeakThis]()
 	{
-		FTransform SpawnTransfrom = GetActorTransform();
-		if (const APlayerStart* NextSpawnSpot = GetNextSpawnSpot())
+		return WeakThis.IsValid() && WeakThis->Goal ? WeakThis->ComputeLaneFront().ToString() : FString();
+	});
+	LaneBlackboard->RegisterProducer(TEXT("NearestEnemyHero"), TeamFactUpdateInterval, [WeakThis]()
+	{
+		return WeakThis.IsValid() && WeakThis->Goal ? WeakThis->ProduceNearestEnemyHero() : FString();
+	});
+
+	// Every barrack of the team computes the same value here, so it does not matter whose producer is kept
+	UBehaviacSharedBlackboard* TeamBlackboard = Blackboards->GetTeamBlackboard(BarrackTeamId.GetId());
+	TeamBlackboard->RegisterProducer(TEXT("CoreContested"), TeamFactUpdateInterval, [WeakThis]()
+	{
+		return WeakThis.IsValid() ? WeakThis->ProduceCoreContested() : FString(TEXT("false"));
+	});
+}
+
+FVector AMinionBarrack::ComputeLaneFront() const
+{
+	// The active minion closest to the goal leads the wave; before the first
+	// wave the front is the barrack itself.
+	const FVector GoalLocation = Goal->GetActorLocation();
+	FVector LaneFront = GetActorLocation();
+	float BestDistSquared = FVector::DistSquared(LaneFront, GoalLocation);
+	for (const AMinion* Minion : MinionPool)
+	{
+		if (!IsValid(Minion) || !Minion->IsActive())
+			continue;
+
+		const float DistSquared = FVector::DistSquared(Minion->GetActorLocation(), GoalLocation);
+		if (DistSquared < BestDistSquared)
+		{
+			BestDistSquared = DistSquared;
+			LaneFront = Minion->GetActorLocation();
+		}
+	}
+
+	return LaneFront;
+}
+
+FString AMinionBarrack::ProduceNearestEnemyHero() const
+{
+	const UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this);
+	if (!SpatialIndex)
+	{
+		return FString();
+	}
+
+	FCSpatialQueryFilter Filter;
+	Filter.QuerierTeam = BarrackTeamId;
+
+	// Hostile minions crowd the front, so look past them for the first hero
+	TArray<APawn*> Hostiles;
+	SpatialIndex->FindNearest(ComputeLaneFront(), EnemyHeroSearchRadius, 16, Filter, Hostiles);
+	for (APawn* Hostile : Hostiles)
+	{
+		if (Hostile->IsA<ACPlayerCharacter>())
 		{
-			SpawnTransfrom = NextSpawnSpot->GetActorTransform();
+			return Hostile->GetPathName();
 		}
+	}
+
+	return FString();
+}
+
+FString AMinionBarrack::ProduceCoreContested() const
+{
+	const UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this);
+	if (!StormCore || !SpatialIndex)
+	{
+		return TEXT("false");
+	}
+
+	FCSpatialQueryFilter Filter;
+	Filter.QuerierTeam = BarrackTeamId;
+	const bool bContested = SpatialIndex->FindNearest(StormCore->GetActorLocation(), CoreContestRadius, Filter) != nullptr;
+	return bContested ? TEXT("true") : TEXT("false");
+}
+
+void AMinionBarrack::RegisterLaneFlowField()
+{
+	UCFlowFieldSubsystem* FlowFields = UCFlowFieldSubsystem::Get(this);
+	if (!FlowFields || !Goal)
+	{
+		return;
+	}
 
-		AMinion* NewMinion = GetWorld()->SpawnActorDeferred<AMinion>(MinionClass, SpawnTransfrom, this, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
-		NewMinion->SetGenericTeamId(BarrackTeamId);
-		NewMinion->FinishSpawning(SpawnTransfrom);
-		NewMinion->SetGoal(Goal);
-		MinionPool.Add(NewMinion);
+	FBox LaneBounds(GetActorLocation(), GetActorLocation());
+	for (const APlayerStart* SpawnSpot : SpawnSpots)
+	{
+		if (SpawnSpot)
+		{
+			LaneBounds += SpawnSpot->GetActorLocation();
+		}
 	}
+	LaneBounds += Goal->GetActorLocation();
+
+	FlowFields->RegisterLane(BarrackTeamId.GetId(), Goal, LaneBounds.ExpandBy(FVector(LaneFlowFieldMargin, LaneFlowFieldMargin, 0.f)));
 }
 
-AMinion* AMinionBarrack::GetNextAvaliableMinion() const
+AMinion* AMinionBarrack::PopFreeMinion()
 {
-	for(AMinion* Minion : MinionPool)
+	while (FreeMinions.Num() > 0)
 	{
-		if (!Minion->IsActive())
+		AMinion* Minion = FreeMinions.Pop(EAllowShrinking::No);
+		// Skip entries that were destroyed or already brought back
+		if (IsValid(Minion) && !Minion->IsActive())
 		{
 			return Minion;
 		}
@@ -102,3 +279,8 @@ AMinion* AMinionBarrack::GetNextAvaliableMinion() const
 	return nullptr;
 }
 
+void AMinionBarrack::MinionInactive(AMinion* Minion)
+{
+	FreeMinions.Push(Minion);
+}
+
@@ -7,21 +7,35 @@
 #include "GenericTeamAgentInterface.h"
 // ----------------------------------------------------------------------------
 // File: MinionBarrack.h
-// Purpose: Defines AMinionBarrack, a server-side spawner and simple pool
-//          manager for AMinion units. Spawns groups on an interval, assigns
-//          team and goal, and reuses inactive minions when available.
+// Purpose: Defines AMinionBarrack, a server-side spawner and pool manager for
+//          AMinion units. Spawns groups on an interval, assigns team and goal,
+//          and reuses inactive minions from a free list.
 // Key API:
 //  - BarrackTeamId, MinionPerGroup, GroupSpawnInterval: spawn configuration.
+//  - PoolPrewarmCount, MaxSpawnsPerFrame: pool size at match load and how a
+//    wave is spread over frames.
 //  - Goal, MinionClass, SpawnSpots: runtime wiring for behavior and placement.
-//  - SpawnNewGroup / SpawnNewMinions / GetNextAvaliableMinion / GetNextSpawnSpot
-//    implement pooling and round-robin spawn spot selection.
+//  - SpawnNewGroup / SpawnOne / PopFreeMinion / GetNextSpawnSpot implement
+//    pooling and round-robin spawn spot selection.
+//  - RegisterTeamBlackboardProducers publishes lane facts (GoalLocation,
+//    LaneFront, NearestEnemyHero) to the squad blackboard named GetLaneName()
+//    and the CoreContested team fact to the team's shared Behaviac blackboard,
+//    once per TeamFactUpdateInterval.
+//  - ActivateMinionAt / DemoteMinion let UCMinionLODSubsystem move minions
+//    between full actors and simulated records.
+//  - RegisterLaneFlowField bakes the team's shared flow field from the spawn
+//    spots to Goal so minions do not each pathfind down the same lane.
 // ----------------------------------------------------------------------------
 #include "MinionBarrack.generated.h"
 
 /**
- * AMinionBarrack is a server-side spawner and simple pool manager for AMinion units.
+ * AMinionBarrack is a server-side spawner and pool manager for AMinion units.
  * It spawns groups of minions on a configurable interval, assigns them to a team and goal,
  * and reuses inactive minions when available.
+ *
+ * Dead minions report themselves through AMinion::OnMinionInactive and are pushed on
+ * FreeMinions, so taking one is O(1). A group only queues spawns; Tick activates at most
+ * MaxSpawnsPerFrame minions per frame and turns itself off when the queue is empty.
  */
 UCLASS()
 class AMinionBarrack : public AActor
@@ -40,6 +54,20 @@ public:
     // Called every frame
     virtual void Tick(float DeltaTime) override;
 
+    FGenericTeamId GetBarrackTeamId() const { return BarrackTeamId; }
+    AActor* GetGoal() const { return Goal; }
+    const TArray<class AMinion*>& GetMinionPool() const { return MinionPool; }
+    float GetSimulatedAttacksPerSecond() const { return SimulatedAttacksPerSecond; }
+
+    // Name of the squad blackboard that holds this barrack's lane facts
+    FName GetLaneName() const { return GetFName(); }
+
+    // Activate a pooled minion, or spawn one when the pool is empty
+    AMinion* ActivateMinionAt(const FTransform& SpawnTransform);
+
+    // Put an active minion back in the pool without killing it
+    void DemoteMinion(AMinion* Minion);
+
 private:
     UPROPERTY(EditAnywhere, Category = "Spawn")
     FGenericTeamId BarrackTeamId;
@@ -50,9 +78,23 @@ private:
     UPROPERTY(EditAnywhere, Category = "Spawn")
     float GroupSpawnInterval = 5.f;
     
+    // Minions spawned and put to sleep at match load, so early waves never spawn actors
+    UPROPERTY(EditAnywhere, Category = "Spawn")
+    int PoolPrewarmCount = 12;
+
+    // Minions activated or spawned per frame while a wave is pending
+    UPROPERTY(EditAnywhere, Category = "Spawn")
+    int MaxSpawnsPerFrame = 1;
+
     UPROPERTY()
     TArray<class AMinion*> MinionPool;
 
+    // Inactive minions of MinionPool, used as a stack
+    UPROPERTY()
+    TArray<class AMinion*> FreeMinions;
+
+    int PendingSpawns = 0;
+
     UPROPERTY(EditAnywhere, Category = "Spawn")
     AActor* Goal;
 
@@ -62,13 +104,46 @@ private:
     UPROPERTY(EditAnywhere, Category = "Spawn")
     TArray<class APlayerStart*> SpawnSpots;
 
+    // How often lane and team facts (e.g. GoalLocation) are republished to the team's shared Behaviac blackboard
+    UPROPERTY(EditAnywhere, Category = "AI")
+    float TeamFactUpdateInterval = 0.5f;
+
+    // How far from the lane front a hostile hero is reported as NearestEnemyHero
+    UPROPERTY(EditAnywhere, Category = "AI")
+    float EnemyHeroSearchRadius = 3000.f;
+
+    // Hostile pawns this close to the StormCore make CoreContested true; matches AStormCore's default InfluenceRadius
+    UPROPERTY(EditAnywhere, Category = "AI")
+    float CoreContestRadius = 1000.f;
+
+    UPROPERTY()
+    AActor* StormCore;
+
+    // Extra space around the spawn spots and goal covered by the lane flow field
+    UPROPERTY(EditAnywhere, Category = "AI")
+    float LaneFlowFieldMargin = 1500.f;
+
+    // Attack rate of this barrack's minions while simulated by UCMinionLODSubsystem (damage = AttackDamage per attack)
+    UPROPERTY(EditAnywhere, Category = "AI")
+    float SimulatedAttacksPerSecond = 1.f;
+
     int NextSpawnSpotIndex = -1;
 
     const APlayerStart* GetNextSpawnSpot();
 
+    void PrewarmPool();
     void SpawnNewGroup();
-    void SpawnNewMinions(int Amt);
-    AMinion* GetNextAvaliableMinion() const;
+    void SpawnOne();
+    AMinion* SpawnNewMinion(const FTransform& SpawnTransform);
+    AMinion* PopFreeMinion();
+    void MinionInactive(AMinion* Minion);
+    void RegisterTeamBlackboardProducers();
+
+    // Lane and team fact producers, each called once per TeamFactUpdateInterval
+    FVector ComputeLaneFront() const;
+    FString ProduceNearestEnemyHero() const;
+    FString ProduceCoreContested() const;
+    void RegisterLaneFlowField();
 
     FTimerHandle SpawnIntervalTimerHandle;
 
@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Animations/ANS_MeleeHitWindow.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "Components/SkeletalMeshComponent.h"
+
+void UANS_MeleeHitWindow::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
+
+	if (UCMeleeHitComponent* MeleeHitComponent = GetMeleeHitComponent(MeshComp))
+	{
+		MeleeHitComponent->BeginWindow(MeshComp, HitSettings);
+	}
+}
+
+void UANS_MeleeHitWindow::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+{
+	// Also reached when the montage is interrupted, so a window never stays open
+	UCMeleeHitComponent* MeleeHitComponent = GetMeleeHitComponent(MeshComp);
+	if (MeleeHitComponent && MeleeHitComponent->IsWindowOpenOn(MeshComp))
+	{
+		MeleeHitComponent->EndWindow();
+	}
+
+	Super::NotifyEnd(MeshComp, Animation, EventReference);
+}
+
+FString UANS_MeleeHitWindow::GetNotifyName_Implementation() const
+{
+	return "Melee Hit Window";
+}
+
+UCMeleeHitComponent* UANS_MeleeHitWindow::GetMeleeHitComponent(const USkeletalMeshComponent* MeshComp)
+{
+	if (!MeshComp || !MeshComp->GetOwner())
+		return nullptr;
+
+	if (!UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(MeshComp->GetOwner()))
+		return nullptr;
+
+	return MeshComp->GetOwner()->FindComponentByClass<UCMeleeHitComponent>();
+}
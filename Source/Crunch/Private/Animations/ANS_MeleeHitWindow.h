@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "Character/CMeleeHitComponent.h"
+// ----------------------------------------------------------------------------
+// File: ANS_MeleeHitWindow.h
+// Purpose: Animation notify state spanning the frames a melee swing can hit.
+//          Opens a hit window on the owner's UCMeleeHitComponent at the start
+//          and closes it at the end, so the socket chain is swept every frame
+//          in between instead of on a single notify frame.
+// Key API:
+//  - HitSettings: sockets, radius, team filter, cue tags and event tag.
+// Notes:
+//  - The gameplay event is sent once, when the window ends, with every
+//    actor hit during it; the cues play on the frame of the hit.
+// ----------------------------------------------------------------------------
+#include "ANS_MeleeHitWindow.generated.h"
+
+/**
+ * UAnimNotifyState driving UCMeleeHitComponent::BeginWindow / EndWindow.
+ * Owners without the component (e.g. editor previews) are ignored.
+ */
+UCLASS()
+class UANS_MeleeHitWindow : public UAnimNotifyState
+{
+	GENERATED_BODY()
+public:
+	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference) override;
+	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
+
+private:
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability", meta = (ShowOnlyInnerProperties))
+	FCMeleeHitSettings HitSettings;
+
+	virtual FString GetNotifyName_Implementation() const;
+
+	static UCMeleeHitComponent* GetMeleeHitComponent(const USkeletalMeshComponent* MeshComp);
+};
@@ -3,11 +3,7 @@
 
 #include "Animations/AN_SendTargetGroup.h"
 #include "AbilitySystemBlueprintLibrary.h"
-#include "Abilities/GameplayAbilityTargetTypes.h"
-#include "AbilitySystemGlobals.h"
-#include "GameplayCueManager.h"
-#include "Kismet/KismetSystemLibrary.h"
-#include "GameplayEffectTypes.h"
+#include "Components/SkeletalMeshComponent.h"
 
 void UAN_SendTargetGroup::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
 {
@@ -24,64 +20,39 @@ void UAN_SendTargetGroup::Notify(USkeletalMeshComponent* MeshComp, UAnimSequence
 		return;
 	}
 
-	FGameplayEventData Data;
-	TSet<AActor*> HitActors;
-	AActor* OwnerActor = MeshComp->GetOwner();
-	const IGenericTeamAgentInterface* OwnerTeamInterface = Cast<IGenericTeamAgentInterface>(OwnerActor);
-
-	for (int i = 1; i < TargetSocketNames.Num(); ++i)
+	if (UCMeleeHitComponent* MeleeHitComponent = MeshComp->GetOwner()->FindComponentByClass<UCMeleeHitComponent>())
 	{
-		FVector StartLoc = MeshComp->GetSocketLocation(TargetSocketNames[i-1]);
-		FVector EndLoc = MeshComp->GetSocketLocation(TargetSocketNames[i]);
-
-		TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
-		ObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_Pawn));
-		TArray<FHitResult> HitResults;
-
-		TArray<AActor*> ActorsToIgnore;
-		if (bIgnoreOwner)
-		{
-			ActorsToIgnore.Add(OwnerActor);
-		}
-
-		EDrawDebugTrace::Type DrawDebugTrace = bDrawDebug ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None;
-
-		UKismetSystemLibrary::SphereTraceMultiForObjects(MeshComp, StartLoc, EndLoc, SphereSweepRadius, 
-			ObjectTypes, false, ActorsToIgnore, DrawDebugTrace, HitResults, false);
-
-		
-		for (const FHitResult& HitResult : HitResults)
-		{
-			if (HitActors.Contains(HitResult.GetActor()))
-			{
-				continue;
-			}
-
-			if (OwnerTeamInterface)
-			{
-				if (OwnerTeamInterface->GetTeamAttitudeTowards(*HitResult.GetActor()) != TargetTeam)
-				{
-					continue;
-				}
-			}
-
-			FGameplayAbilityTargetData_SingleTargetHit* TargetHit = new FGameplayAbilityTargetData_SingleTargetHit(HitResult);
-			Data.TargetData.Add(TargetHit);
-			SendLocalGameplayCue(HitResult);
-		}
+		MeleeHitComponent->DetectOnce(MeshComp, HitSettings);
 	}
+}
 
-	UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(MeshComp->GetOwner(), EventTag, Data);
+void UAN_SendTargetGroup::PostInitProperties()
+{
+	Super::PostInitProperties();
+	UpdateHitSettings();
 }
 
-void UAN_SendTargetGroup::SendLocalGameplayCue(const FHitResult& HitResult) const
+void UAN_SendTargetGroup::PostLoad()
 {
-	FGameplayCueParameters CueParam;
-	CueParam.Location = HitResult.ImpactPoint;
-	CueParam.Normal = HitResult.ImpactNormal;
+	Super::PostLoad();
+	UpdateHitSettings();
+}
 
-	for (const FGameplayTag& GameplayCueTag : TriggerGameplayCueTags)
-	{
-		UAbilitySystemGlobals::Get().GetGameplayCueManager()->HandleGameplayCue(HitResult.GetActor(), GameplayCueTag, EGameplayCueEvent::Executed, CueParam);
-	}
+#if WITH_EDITOR
+void UAN_SendTargetGroup::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	UpdateHitSettings();
+}
+#endif
+
+void UAN_SendTargetGroup::UpdateHitSettings()
+{
+	HitSettings.TriggerGameplayCueTags = TriggerGameplayCueTags;
+	HitSettings.TargetTeam = TargetTeam;
+	HitSettings.SphereSweepRadius = SphereSweepRadius;
+	HitSettings.bDrawDebug = bDrawDebug;
+	HitSettings.bIgnoreOwner = bIgnoreOwner;
+	HitSettings.EventTag = EventTag;
+	HitSettings.TargetSocketNames = TargetSocketNames;
 }
@@ -6,6 +6,7 @@
 #include "Animation/AnimNotifies/AnimNotify.h"
 #include "GameplayTagContainer.h"
 #include "GenericTeamAgentInterface.h"
+#include "Character/CMeleeHitComponent.h"
 // ----------------------------------------------------------------------------
 // File: AN_SendTargetGroup.h
 // Purpose: Animation notify that finds a group of actors near specified sockets
@@ -19,8 +20,10 @@
 //  - EventTag: optional gameplay event tag to dispatch.
 //  - TargetSocketNames: sockets on the mesh to center the sweeps.
 // Integration:
-//  - Notify: performs the sweep(s), filters by team attitude, and calls
-//    SendLocalGameplayCue to actually emit the cue/event per hit.
+//  - Notify: runs UCMeleeHitComponent::DetectOnce on the owner, which sweeps
+//    from the previous frame's pose to the notify frame, filters by team
+//    attitude, plays the cues per hit and sends the event. Use
+//    UANS_MeleeHitWindow for swings spanning several frames.
 // ----------------------------------------------------------------------------
 #include "AN_SendTargetGroup.generated.h"
 
@@ -39,6 +42,8 @@
  * Notes:
  *  - Typical use: align hit detection and cue triggering to montage frames.
  *  - bIgnoreOwner avoids self-hits during close-range sweeps.
+ *  - The properties are copied into HitSettings on load and on edit, so a
+ *    notify does not rebuild them every time it fires.
  */
 UCLASS()
 class UAN_SendTargetGroup : public UAnimNotify
@@ -46,6 +51,11 @@ class UAN_SendTargetGroup : public UAnimNotify
 	GENERATED_BODY()
 public:	
 	virtual void Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
 private:
 	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
@@ -68,5 +78,6 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
 	TArray<FName> TargetSocketNames;
 
-	void SendLocalGameplayCue(const FHitResult& HitResult) const;
+	FCMeleeHitSettings HitSettings;
+	void UpdateHitSettings();
 };
@@ -26,15 +26,32 @@ void UCAnimInstance::NativeInitializeAnimation()
 
 void UCAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
+	// Game thread: only read what lives on other objects
+	bHasGatheredData = OwnerCharacter != nullptr;
 	if (OwnerCharacter)
 	{
-		FVector Velocity = OwnerCharacter->GetVelocity();
+		GatheredVelocity = OwnerCharacter->GetVelocity();
+		GatheredBodyRot = OwnerCharacter->GetActorRotation();
+		GatheredControlRot = OwnerCharacter->GetBaseAimRotation();
+	}
+
+	if (OwnerMovementComp)
+	{
+		bGatheredIsFalling = OwnerMovementComp->IsFalling();
+	}
+}
+
+void UCAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	if (bHasGatheredData)
+	{
+		const FVector& Velocity = GatheredVelocity;
 		Speed = Velocity.Length();
-		FRotator BodyRot = OwnerCharacter->GetActorRotation();
+		FRotator BodyRot = GatheredBodyRot;
 		FRotator BodyRotDelta = UKismetMathLibrary::NormalizedDeltaRotator(BodyRot, BodyPrevRot);
 		BodyPrevRot = BodyRot;
 
-		YawSpeed = BodyRotDelta.Yaw / DeltaSeconds;
+		YawSpeed = DeltaSeconds > 0.f ? BodyRotDelta.Yaw / DeltaSeconds : 0.f;
 		float YawLerpSpeed = YawSpeedSmoothLerpSpeed;
 		if (YawSpeed == 0)
 		{
@@ -42,22 +59,14 @@ void UCAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 		}
 
 		SmoothedYawSpeed = UKismetMathLibrary::FInterpTo(SmoothedYawSpeed, YawSpeed, DeltaSeconds, YawLerpSpeed);
-		FRotator ControlRot = OwnerCharacter->GetBaseAimRotation();
+		FRotator ControlRot = GatheredControlRot;
 		LookRotOffset = UKismetMathLibrary::NormalizedDeltaRotator(ControlRot, BodyRot);
 
 		FwdSpeed = Velocity.Dot(ControlRot.Vector());
 		RightSpeed = -Velocity.Dot(ControlRot.Vector().Cross(FVector::UpVector));
 	}
 
-	if (OwnerMovementComp)
-	{
-		bIsJumping = OwnerMovementComp->IsFalling();
-	}
-}
-
-void UCAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
-{
-
+	bIsJumping = bGatheredIsFalling;
 }
 
 bool UCAnimInstance::ShouldDoFullBody() const
@@ -12,6 +12,10 @@
  * computes locomotion and look offsets, and exposes thread-safe Blueprint
  * getters for Animation Blueprints.
  *
+ * NativeUpdateAnimation only copies the owner's velocity, rotations and falling
+ * state on the game thread; NativeThreadSafeUpdateAnimation derives everything
+ * below from that copy on a worker thread.
+ *
  * Data computed each tick:
  *  - Speed (magnitude), forward/right planar speed components.
  *  - YawSpeed and a smoothed version using YawSpeedSmoothLerpSpeed and
@@ -101,4 +105,11 @@ private:
 
 	FRotator BodyPrevRot;
 	FRotator LookRotOffset;
+
+	// Gathered on the game thread for NativeThreadSafeUpdateAnimation
+	FVector GatheredVelocity = FVector::ZeroVector;
+	FRotator GatheredBodyRot = FRotator::ZeroRotator;
+	FRotator GatheredControlRot = FRotator::ZeroRotator;
+	bool bGatheredIsFalling = false;
+	bool bHasGatheredData = false;
 };
@@ -6,33 +6,34 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/WidgetComponent.h"
 #include "Components/CapsuleComponent.h"
+#include "Character/CMeleeHitComponent.h"
 #include "Crunch/Crunch.h"
+#include "Framework/CSpatialIndexSubsystem.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GAS/CAbilitySystemComponent.h"
 #include "GAS/CAttributeSet.h"
 #include "GAS/CAbilitySystemStatics.h"
-#include "Kismet/GameplayStatics.h"
 #include "Net/UnrealNetwork.h"
-#include "Perception/AIPerceptionStimuliSourceComponent.h"
-#include "Perception/AISense_Sight.h"
 #include "Widgets/OverHeadStatsGauge.h"
 // Sets default values
-ACCharacter::ACCharacter()
+ACCharacter::ACCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
 {
  	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
 	GetMesh()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_SpringArm, ECR_Ignore);
 	GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Target, ECR_Ignore);
+	GetMesh()->bEnableUpdateRateOptimizations = true;
+	GetMesh()->OnAnimUpdateRateParamsCreated.BindUObject(this, &ACCharacter::SetupAnimUpdateRate);
 
 	CAbilitySystemComponent = CreateDefaultSubobject<UCAbilitySystemComponent>("CAbility System Component");
 	CAttributeSet = CreateDefaultSubobject<UCAttributeSet>("CAttribute Set");
+	MeleeHitComponent = CreateDefaultSubobject<UCMeleeHitComponent>("Melee Hit Component");
 	OverHeadWidgetComponent = CreateDefaultSubobject<UWidgetComponent>("Over Head Widget Component");
 	OverHeadWidgetComponent->SetupAttachment(GetRootComponent());
 
 	BindGASChangeDelegates();
-
-	PerceptionStimuliSourceComponent = CreateDefaultSubobject<UAIPerceptionStimuliSourceComponent>("Perception Stimuli Source Component");
 }
 
 void ACCharacter::ServerSideInit()
@@ -79,7 +80,19 @@ void ACCharacter::BeginPlay()
 	ConfigureOverHeadStatusWidget();
 	MeshRelativeTransform = GetMesh()->GetRelativeTransform();
 
-	PerceptionStimuliSourceComponent->RegisterForSense(UAISense_Sight::StaticClass());
+	if (UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this))
+	{
+		SpatialIndex->RegisterPawn(this);
+	}
+}
+
+void ACCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this))
+	{
+		SpatialIndex->UnregisterPawn(this);
+	}
+	Super::EndPlay(EndPlayReason);
 }
 
 void ACCharacter::PossessedBy(AController* NewController)
@@ -227,11 +240,11 @@ void ACCharacter::ConfigureOverHeadStatusWidget()
 		return;
 	}
 
-	IsPlayerControlled();
-
 	if (IsLocallyControlledByPlayer())
 	{
 		OverHeadWidgetComponent->SetHiddenInGame(true);
+		GetWorldTimerManager().ClearTimer(HeadStatGaugeVisibilityUpdateTimerHandle);
+		GetWorldTimerManager().SetTimer(HeadStatGaugeVisibilityUpdateTimerHandle, this, &ACCharacter::UpdateHeadGaugeVisibility, HeadStatGaugeVisiblityCheckUpdateGap, true, 0.f);
 		return;
 	}
 
@@ -239,25 +252,81 @@ void ACCharacter::ConfigureOverHeadStatusWidget()
 	if (OverheadStatsGuage)
 	{
 		OverheadStatsGuage->ConfigureWithASC(GetAbilitySystemComponent());
-		OverHeadWidgetComponent->SetHiddenInGame(false);
-		GetWorldTimerManager().ClearTimer(HeadStatGaugeVisibilityUpdateTimerHandle);
-		GetWorldTimerManager().SetTimer(HeadStatGaugeVisibilityUpdateTimerHandle, this, &ACCharacter::UpdateHeadGaugeVisibility, HeadStatGaugeVisiblityCheckUpdateGap, true);
+		// Shown by the local character's next UpdateHeadGaugeVisibility once in range
+		OverHeadWidgetComponent->SetHiddenInGame(!bStatusGaugeEnabled || !bHeadGaugeInRange);
+	}
+}
+
+void ACCharacter::NotifyControllerChanged()
+{
+	Super::NotifyControllerChanged();
+
+	// Possession replicates after BeginPlay on clients, so the local character is only known now
+	if (HasActorBegunPlay())
+	{
+		ConfigureOverHeadStatusWidget();
 	}
 }
 
 void ACCharacter::UpdateHeadGaugeVisibility()
 {
-	APawn* LocalPlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
-	if (LocalPlayerPawn)
+	const UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this);
+	if (!SpatialIndex || !IsLocallyControlledByPlayer())
+	{
+		GetWorldTimerManager().ClearTimer(HeadStatGaugeVisibilityUpdateTimerHandle);
+		return;
+	}
+
+	FCSpatialQueryFilter Filter;
+	Filter.QuerierTeam = GetGenericTeamId();
+	Filter.bIncludeFriendly = true;
+	Filter.bIncludeNeutral = true;
+	Filter.bIncludeUntargetable = true;
+	Filter.IgnoreActor = this;
+
+	TArray<APawn*> PawnsInRange;
+	SpatialIndex->QueryRadius(GetActorLocation(), FMath::Sqrt(HeadStatGaugeVisiblityRangeSquared), Filter, PawnsInRange);
+
+	// Only characters that entered or left the range change visibility
+	TArray<TWeakObjectPtr<ACCharacter>> NewGaugesInRange;
+	NewGaugesInRange.Reserve(PawnsInRange.Num());
+	for (APawn* Pawn : PawnsInRange)
+	{
+		if (ACCharacter* Character = Cast<ACCharacter>(Pawn))
+		{
+			Character->SetHeadGaugeInRange(true);
+			NewGaugesInRange.Add(Character);
+		}
+	}
+
+	for (const TWeakObjectPtr<ACCharacter>& Character : HeadGaugesInRange)
+	{
+		if (Character.IsValid() && !NewGaugesInRange.Contains(Character))
+		{
+			Character->SetHeadGaugeInRange(false);
+		}
+	}
+
+	HeadGaugesInRange = MoveTemp(NewGaugesInRange);
+}
+
+void ACCharacter::SetHeadGaugeInRange(bool bInRange)
+{
+	if (bHeadGaugeInRange == bInRange)
+	{
+		return;
+	}
+
+	bHeadGaugeInRange = bInRange;
+	if (bStatusGaugeEnabled && OverHeadWidgetComponent && !IsLocallyControlledByPlayer())
 	{
-		float DistSquared = FVector::DistSquared(GetActorLocation(), LocalPlayerPawn->GetActorLocation());
-		OverHeadWidgetComponent->SetHiddenInGame(DistSquared > HeadStatGaugeVisiblityRangeSquared);
+		OverHeadWidgetComponent->SetHiddenInGame(!bInRange);
 	}
 }
 
 void ACCharacter::SetStatusGaugeEnabled(bool bIsEnabled)
 {
-	GetWorldTimerManager().ClearTimer(HeadStatGaugeVisibilityUpdateTimerHandle);
+	bStatusGaugeEnabled = bIsEnabled;
 	if (bIsEnabled)
 	{
 		ConfigureOverHeadStatusWidget();
@@ -333,13 +402,13 @@ void ACCharacter::StartDeathSequence()
 
 	//GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_None);
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	SetAIPerceptionStimuliSourceEnabled(false);
+	SetSpatialIndexTargetable(false);
 }
 
 void ACCharacter::Respawn()
 {
 	OnRespawn();
-	SetAIPerceptionStimuliSourceEnabled(true);
+	SetSpatialIndexTargetable(true);
 	SetRagdollEnabled(false);
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 	//GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Walking);
@@ -372,6 +441,10 @@ void ACCharacter::OnRespawn()
 void ACCharacter::SetGenericTeamId(const FGenericTeamId& NewTeamID)
 {
 	TeamID = NewTeamID;
+	if (UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this))
+	{
+		SpatialIndex->UpdatePawn(this);
+	}
 }
 
 FGenericTeamId ACCharacter::GetGenericTeamId() const
@@ -384,20 +457,20 @@ void ACCharacter::OnRep_TeamID()
 	//override in child class
 }
 
-void ACCharacter::SetAIPerceptionStimuliSourceEnabled(bool bIsEnabled)
+void ACCharacter::SetSpatialIndexTargetable(bool bIsTargetable)
 {
-	if (!PerceptionStimuliSourceComponent)
-	{
-		return;
-	}
-
-	if (bIsEnabled)
+	if (UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this))
 	{
-		PerceptionStimuliSourceComponent->RegisterWithPerceptionSystem();
-	}
-	else
-	{
-		PerceptionStimuliSourceComponent->UnregisterFromPerceptionSystem();
+		SpatialIndex->SetPawnTargetable(this, bIsTargetable);
 	}
 }
 
+void ACCharacter::SetupAnimUpdateRate(FAnimUpdateRateParameters* Params)
+{
+	if (!Params)
+		return;
+
+	Params->BaseVisibleDistanceFactorThesholds = AnimUpdateRateScreenSizes;
+	Params->MaxEvalRateForInterpolation = AnimUpdateRateScreenSizes.Num() + 1;
+	Params->BaseNonRenderedUpdateRate = AnimNonRenderedUpdateRate;
+}
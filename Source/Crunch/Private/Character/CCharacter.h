@@ -19,14 +19,20 @@
 // Key API:
 //  - GAS: GetAbilitySystemComponent, Server_SendGameplayEventToSelf,
 //          UpgradeAbilityWithInputID, attribute change handlers.
+//  - Melee: UCMeleeHitComponent for anim notify driven hit detection.
 //  - Lifecycle: OnStun/Recover, OnDead/OnRespawn, RespawnImmediately,
 //               ragdoll and death montage sequencing.
 //  - Teams: SetGenericTeamId/GetGenericTeamId with replication via OnRep_TeamID.
-//  - UI: Overhead status widget visibility logic.
-//  - AI: Toggle AIPerceptionStimuli source for sensing systems.
+//  - UI: Overhead status widget visibility; the locally controlled character
+//        shows the gauges of characters in range via UCSpatialIndexSubsystem.
+//  - AI: registers with UCSpatialIndexSubsystem for physics-free proximity
+//        queries and UCPerceptionSubsystem sight.
+//  - Animation: update rate optimization tiers by screen size / off-screen.
 // ----------------------------------------------------------------------------
 #include "CCharacter.generated.h"
 
+struct FAnimUpdateRateParameters;
+
 /**
  * ACCharacter is the project's foundational character class that:
  *  - Implements IAbilitySystemInterface to expose a UCAbilitySystemComponent
@@ -38,7 +44,6 @@
  *  - Manages UI (overhead status widget) with distance-based visibility.
  *  - Handles stun, death, ragdoll, and respawn state machines including
  *    montage timing and timers.
- *  - Registers an AIPerceptionStimuliSourceComponent to interact with AI sight.
  */
 UCLASS()
 class ACCharacter : public ACharacter, public IAbilitySystemInterface, public IGenericTeamAgentInterface, public IRenderActorTargetInterface
@@ -47,7 +52,7 @@ class ACCharacter : public ACharacter, public IAbilitySystemInterface, public IG
 
 public:
 	// Sets default values for this character's properties
-	ACCharacter();
+	ACCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 	void ServerSideInit();
 	void ClientSideInit();
 	bool IsLocallyControlledByPlayer() const;
@@ -67,6 +72,7 @@ protected:
 	// Called when the game starts or when spawned
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void PossessedBy(AController* NewController) override;
 
 public:	
@@ -107,6 +113,10 @@ private:
 	class UCAbilitySystemComponent* CAbilitySystemComponent;
 	UPROPERTY()
 	class UCAttributeSet* CAttributeSet;
+
+	/** Sweeps socket chains for UAN_SendTargetGroup and UANS_MeleeHitWindow */
+	UPROPERTY(VisibleDefaultsOnly, Category = "Gameplay Ability")
+	class UCMeleeHitComponent* MeleeHitComponent;
 	/**********************************************************************/
 	/*                              UI                                    */
 	/**********************************************************************/
@@ -121,9 +131,18 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "UI")
 	float HeadStatGaugeVisiblityRangeSquared = 10000000.f;
 	
+	/** Only runs on the locally controlled character, which updates every other character's gauge */
 	FTimerHandle HeadStatGaugeVisibilityUpdateTimerHandle;
 
+	/** Characters whose gauge the last UpdateHeadGaugeVisibility found in range */
+	TArray<TWeakObjectPtr<ACCharacter>> HeadGaugesInRange;
+
+	bool bStatusGaugeEnabled = true;
+	bool bHeadGaugeInRange = false;
+
+	virtual void NotifyControllerChanged() override;
 	void UpdateHeadGaugeVisibility();
+	void SetHeadGaugeInRange(bool bInRange);
 	void SetStatusGaugeEnabled(bool bIsEnabled);
 	/**********************************************************************/
 	/*                             Stun                                   */
@@ -179,7 +198,21 @@ private:
 	/*                               AI                                 */
 	/**********************************************************************/
 private:
-	void SetAIPerceptionStimuliSourceEnabled(bool bIsEnabled);
-	UPROPERTY()
-	class UAIPerceptionStimuliSourceComponent* PerceptionStimuliSourceComponent;
+	/** Dead characters stay in the spatial index but are skipped by targeting queries */
+	void SetSpatialIndexTargetable(bool bIsTargetable);
+
+	/**********************************************************************/
+	/*                             Animation                              */
+	/**********************************************************************/
+private:
+	/** Update rate optimization tiers, applied when the mesh creates its URO parameters */
+	void SetupAnimUpdateRate(FAnimUpdateRateParameters* Params);
+
+	/** Screen size below which the pose is updated every 2nd, 3rd, 4th frame (interpolated in between) */
+	UPROPERTY(EditDefaultsOnly, Category = "Animation")
+	TArray<float> AnimUpdateRateScreenSizes = { 0.4f, 0.2f, 0.1f };
+
+	/** Frames between pose updates while the mesh is not rendered */
+	UPROPERTY(EditDefaultsOnly, Category = "Animation")
+	int32 AnimNonRenderedUpdateRate = 8;
 };
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Character/CCharacterMovementComponent.h"
+#include "AI/CMinionMovementComponent.h"
+#include "GameFramework/Character.h"
+#include "GAS/CForceFieldSubsystem.h"
+
+/** Saves the field part of Velocity at the start of a move, so a replayed move takes out the same part */
+class FCSavedMove_Character : public FSavedMove_Character
+{
+public:
+	typedef FSavedMove_Character Super;
+
+	virtual void Clear() override
+	{
+		Super::Clear();
+		SavedAppliedFieldVelocity = FVector::ZeroVector;
+	}
+
+	virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override
+	{
+		Super::SetMoveFor(C, InDeltaTime, NewAccel, ClientData);
+		if (const UCCharacterMovementComponent* Movement = Cast<UCCharacterMovementComponent>(C->GetCharacterMovement()))
+		{
+			SavedAppliedFieldVelocity = Movement->AppliedFieldVelocity;
+		}
+	}
+
+	virtual void PrepMoveFor(ACharacter* C) override
+	{
+		Super::PrepMoveFor(C);
+		if (UCCharacterMovementComponent* Movement = Cast<UCCharacterMovementComponent>(C->GetCharacterMovement()))
+		{
+			Movement->AppliedFieldVelocity = SavedAppliedFieldVelocity;
+		}
+	}
+
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override
+	{
+		const FCSavedMove_Character* NewCMove = static_cast<const FCSavedMove_Character*>(NewMove.Get());
+		if (!SavedAppliedFieldVelocity.Equals(NewCMove->SavedAppliedFieldVelocity, 1.f))
+		{
+			return false;
+		}
+		return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+	}
+
+	FVector SavedAppliedFieldVelocity = FVector::ZeroVector;
+};
+
+class FCNetworkPredictionData_Client_Character : public FNetworkPredictionData_Client_Character
+{
+public:
+	FCNetworkPredictionData_Client_Character(const UCharacterMovementComponent& ClientMovement)
+		: FNetworkPredictionData_Client_Character(ClientMovement)
+	{
+	}
+
+	virtual FSavedMovePtr AllocateNewMove() override
+	{
+		return FSavedMovePtr(new FCSavedMove_Character());
+	}
+};
+
+void UCCharacterMovementComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Batched minions never sweep their capsule, so they would walk through heroes without this
+	if (CharacterOwner && CharacterOwner->HasAuthority())
+	{
+		if (UCMinionMovementSubsystem* MinionMovement = UCMinionMovementSubsystem::Get(this))
+		{
+			MinionMovement->RegisterObstacle(CharacterOwner);
+		}
+	}
+}
+
+void UCCharacterMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCMinionMovementSubsystem* MinionMovement = UCMinionMovementSubsystem::Get(this))
+	{
+		MinionMovement->UnregisterObstacle(CharacterOwner);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UCCharacterMovementComponent::CalcVelocity(float DeltaTime, float Friction, bool bFluid, float BrakingDeceleration)
+{
+	Velocity -= AppliedFieldVelocity;
+	Super::CalcVelocity(DeltaTime, Friction, bFluid, BrakingDeceleration);
+
+	const UCForceFieldSubsystem* ForceFields = UCForceFieldSubsystem::Get(this);
+	AppliedFieldVelocity = ForceFields ? ForceFields->GetFieldVelocity(CharacterOwner) : FVector::ZeroVector;
+	Velocity += AppliedFieldVelocity;
+}
+
+FNetworkPredictionData_Client* UCCharacterMovementComponent::GetPredictionData_Client() const
+{
+	if (!ClientPredictionData)
+	{
+		// Engine pattern: the prediction data is created lazily from a const getter
+		UCCharacterMovementComponent* MutableThis = const_cast<UCCharacterMovementComponent*>(this);
+		MutableThis->ClientPredictionData = new FCNetworkPredictionData_Client_Character(*this);
+	}
+	return ClientPredictionData;
+}
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+// ----------------------------------------------------------------------------
+// File: CCharacterMovementComponent.h
+// Purpose: Character movement of player heroes. Adds the velocity of the
+//          force fields around the character (UCForceFieldSubsystem) to every
+//          move, on the server and in the owning client's prediction, so a
+//          pull or push needs no location writes and causes no corrections.
+// Notes:
+//  - On the server the hero registers with UCMinionMovementSubsystem as an
+//    avoidance obstacle, so batched minions steer around its capsule.
+//  - The field part of the velocity is saved with each client move and restored
+//    when moves are replayed after a correction.
+// ----------------------------------------------------------------------------
+#include "CCharacterMovementComponent.generated.h"
+
+/**
+ * UCCharacterMovementComponent keeps the field velocity separate from the
+ * character's own: CalcVelocity takes the contribution of the previous move
+ * out, lets the stock movement accelerate and brake the remaining velocity,
+ * then adds the current contribution back. Walking, falling and input keep
+ * working inside a field, and the contribution disappears as soon as the
+ * character leaves it.
+ */
+UCLASS()
+class UCCharacterMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void CalcVelocity(float DeltaTime, float Friction, bool bFluid, float BrakingDeceleration) override;
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+
+private:
+	friend class FCSavedMove_Character;
+
+	/** Field velocity included in Velocity by the last CalcVelocity */
+	FVector AppliedFieldVelocity = FVector::ZeroVector;
+};
@@ -0,0 +1,392 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Character/CMeleeHitComponent.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "AbilitySystemGlobals.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "Engine/World.h"
+#include "GameplayCueManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Melee Hit Sweeps"), STAT_CMeleeHitSweeps, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Melee Hit Sweep Count"), STAT_CMeleeHitSweepCount, STATGROUP_Game);
+
+UCMeleeHitComponent::UCMeleeHitComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	// After the meshes have finished animating this frame
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void UCMeleeHitComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (AActor* OwnerActor = GetOwner())
+	{
+		TInlineComponentArray<USkeletalMeshComponent*> Meshes(OwnerActor);
+		for (USkeletalMeshComponent* Mesh : Meshes)
+		{
+			TrackMesh(Mesh);
+		}
+	}
+}
+
+void UCMeleeHitComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	bWindowOpen = false;
+	ActiveWindow = FWindow();
+	OnceWindow = FWindow();
+	Chains.Empty();
+
+	for (const FMeshTransformHistory& History : MeshHistories)
+	{
+		if (USkeletalMeshComponent* Mesh = History.Mesh.Get())
+		{
+			Mesh->UnregisterOnBoneTransformsFinalizedDelegate(History.FinalizedHandle);
+		}
+	}
+	MeshHistories.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UCMeleeHitComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!bWindowOpen || !ActiveWindow.Mesh.IsValid())
+	{
+		bWindowOpen = false;
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	SweepToCurrentPose(ActiveWindow);
+}
+
+void UCMeleeHitComponent::BeginWindow(USkeletalMeshComponent* Mesh, const FCMeleeHitSettings& Settings)
+{
+	if (bWindowOpen)
+	{
+		EndWindow();
+	}
+
+	ActiveSettings = Settings;
+	if (!StartWindow(ActiveWindow, Mesh, ActiveSettings))
+	{
+		return;
+	}
+
+	bWindowOpen = true;
+	SetComponentTickEnabled(true);
+}
+
+void UCMeleeHitComponent::EndWindow()
+{
+	if (!bWindowOpen)
+	{
+		return;
+	}
+
+	bWindowOpen = false;
+	SetComponentTickEnabled(false);
+
+	if (ActiveWindow.Mesh.IsValid())
+	{
+		SweepToCurrentPose(ActiveWindow);
+	}
+	FinishWindow(ActiveWindow);
+}
+
+void UCMeleeHitComponent::DetectOnce(USkeletalMeshComponent* Mesh, const FCMeleeHitSettings& Settings)
+{
+	if (!StartWindow(OnceWindow, Mesh, Settings, false))
+	{
+		return;
+	}
+
+	// A mesh from outside the owner starts recording now and sweeps two-pose from its next update on
+	TrackMesh(Mesh);
+
+	// A notify samples one frame; also cover the swing since the last one so a
+	// fast fist or weapon that crossed its target between frames still connects
+	if (SamplePreviousChain(Mesh, Chains[OnceWindow.ChainIndex], OnceWindow.LastLocations))
+	{
+		SweepChain(OnceWindow, OnceWindow.LastLocations);
+		SweepToCurrentPose(OnceWindow);
+	}
+	else
+	{
+		SweepChain(OnceWindow, OnceWindow.LastLocations);
+	}
+	FinishWindow(OnceWindow);
+}
+
+bool UCMeleeHitComponent::IsWindowOpenOn(const USkeletalMeshComponent* Mesh) const
+{
+	return bWindowOpen && ActiveWindow.Mesh.Get() == Mesh;
+}
+
+bool UCMeleeHitComponent::StartWindow(FWindow& Window, USkeletalMeshComponent* Mesh, const FCMeleeHitSettings& Settings, bool bSweepFirstPose)
+{
+	if (!Mesh || Settings.TargetSocketNames.Num() <= 1)
+	{
+		return false;
+	}
+
+	Window.Mesh = Mesh;
+	Window.Settings = &Settings;
+	Window.ChainIndex = FindOrResolveChain(Mesh, Settings.TargetSocketNames);
+	Window.SeenActors.Reset();
+	Window.EventData = FGameplayEventData();
+
+	Window.QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(MeleeHit), false);
+	if (Settings.bIgnoreOwner)
+	{
+		Window.QueryParams.AddIgnoredActor(GetOwner());
+	}
+
+	// The first pose has nothing to interpolate from
+	SampleChain(Mesh, Chains[Window.ChainIndex], Window.LastLocations);
+	if (bSweepFirstPose)
+	{
+		SweepChain(Window, Window.LastLocations);
+	}
+	return true;
+}
+
+void UCMeleeHitComponent::FinishWindow(FWindow& Window)
+{
+	const FCMeleeHitSettings* Settings = Window.Settings;
+	FGameplayEventData EventData = MoveTemp(Window.EventData);
+
+	Window.Mesh.Reset();
+	Window.Settings = nullptr;
+	Window.SeenActors.Reset();
+	Window.EventData = FGameplayEventData();
+
+	if (Settings)
+	{
+		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(GetOwner(), Settings->EventTag, EventData);
+	}
+}
+
+void UCMeleeHitComponent::SweepToCurrentPose(FWindow& Window)
+{
+	const USkeletalMeshComponent* Mesh = Window.Mesh.Get();
+	if (!Mesh || !Window.Settings)
+	{
+		return;
+	}
+
+	SampleChain(Mesh, Chains[Window.ChainIndex], CurrentLocations);
+
+	float MaxTravelSquared = 0.f;
+	for (int32 Index = 0; Index < CurrentLocations.Num(); ++Index)
+	{
+		MaxTravelSquared = FMath::Max(MaxTravelSquared, FVector::DistSquared(Window.LastLocations[Index], CurrentLocations[Index]));
+	}
+
+	// Sweep interpolated poses between the last sample and this one, ending on this one
+	const FCMeleeHitSettings& Settings = *Window.Settings;
+	const int32 NumSteps = FMath::Clamp(FMath::CeilToInt32(FMath::Sqrt(MaxTravelSquared) / FMath::Max(Settings.SubstepDistance, 1.f)), 1, FMath::Max(Settings.MaxSubsteps, 1));
+	for (int32 Step = 1; Step < NumSteps; ++Step)
+	{
+		const float Alpha = float(Step) / NumSteps;
+		StepLocations.SetNumUninitialized(CurrentLocations.Num(), EAllowShrinking::No);
+		for (int32 Index = 0; Index < CurrentLocations.Num(); ++Index)
+		{
+			StepLocations[Index] = FMath::Lerp(Window.LastLocations[Index], CurrentLocations[Index], Alpha);
+		}
+		SweepChain(Window, StepLocations);
+	}
+	SweepChain(Window, CurrentLocations);
+
+	Swap(Window.LastLocations, CurrentLocations);
+}
+
+void UCMeleeHitComponent::SweepChain(FWindow& Window, TConstArrayView<FVector> Locations)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CMeleeHitSweeps);
+
+	UWorld* World = GetWorld();
+	AActor* OwnerActor = GetOwner();
+	if (!World || !OwnerActor)
+	{
+		return;
+	}
+
+	const FCMeleeHitSettings& Settings = *Window.Settings;
+	const IGenericTeamAgentInterface* OwnerTeamInterface = Cast<IGenericTeamAgentInterface>(OwnerActor);
+	const FCollisionShape Sphere = FCollisionShape::MakeSphere(Settings.SphereSweepRadius);
+	static const FCollisionObjectQueryParams ObjectParams(ECC_Pawn);
+
+	for (int32 Index = 1; Index < Locations.Num(); ++Index)
+	{
+		const FVector& StartLoc = Locations[Index - 1];
+		const FVector& EndLoc = Locations[Index];
+
+		HitResults.Reset();
+		World->SweepMultiByObjectType(HitResults, StartLoc, EndLoc, FQuat::Identity, ObjectParams, Sphere, Window.QueryParams);
+		INC_DWORD_STAT(STAT_CMeleeHitSweepCount);
+
+#if ENABLE_DRAW_DEBUG
+		if (Settings.bDrawDebug)
+		{
+			DrawDebugSweptSphere(World, StartLoc, EndLoc, Settings.SphereSweepRadius, HitResults.Num() > 0 ? FColor::Green : FColor::Red, false, 5.f);
+		}
+#endif
+
+		for (const FHitResult& HitResult : HitResults)
+		{
+			AActor* HitActor = HitResult.GetActor();
+			if (!HitActor)
+			{
+				continue;
+			}
+
+			bool bAlreadySeen = false;
+			Window.SeenActors.Add(HitActor, &bAlreadySeen);
+			if (bAlreadySeen)
+			{
+				continue;
+			}
+
+			if (OwnerTeamInterface && OwnerTeamInterface->GetTeamAttitudeTowards(*HitActor) != Settings.TargetTeam)
+			{
+				continue;
+			}
+
+			FGameplayAbilityTargetData_SingleTargetHit* TargetHit = new FGameplayAbilityTargetData_SingleTargetHit(HitResult);
+			Window.EventData.TargetData.Add(TargetHit);
+			SendLocalGameplayCue(Settings, HitResult);
+		}
+	}
+}
+
+void UCMeleeHitComponent::SendLocalGameplayCue(const FCMeleeHitSettings& Settings, const FHitResult& HitResult) const
+{
+	FGameplayCueParameters CueParam;
+	CueParam.Location = HitResult.ImpactPoint;
+	CueParam.Normal = HitResult.ImpactNormal;
+
+	for (const FGameplayTag& GameplayCueTag : Settings.TriggerGameplayCueTags)
+	{
+		UAbilitySystemGlobals::Get().GetGameplayCueManager()->HandleGameplayCue(HitResult.GetActor(), GameplayCueTag, EGameplayCueEvent::Executed, CueParam);
+	}
+}
+
+int32 UCMeleeHitComponent::FindOrResolveChain(const USkeletalMeshComponent* Mesh, const TArray<FName>& SocketNames)
+{
+	const USkeletalMesh* MeshAsset = Mesh->GetSkeletalMeshAsset();
+	for (int32 Index = 0; Index < Chains.Num(); ++Index)
+	{
+		if (Chains[Index].MeshAsset.Get() == MeshAsset && Chains[Index].SocketNames == SocketNames)
+		{
+			return Index;
+		}
+	}
+
+	FSocketChain& Chain = Chains.AddDefaulted_GetRef();
+	Chain.MeshAsset = MeshAsset;
+	Chain.SocketNames = SocketNames;
+	Chain.Sockets.SetNum(SocketNames.Num());
+	for (int32 Index = 0; Index < SocketNames.Num(); ++Index)
+	{
+		FCachedSocket& Socket = Chain.Sockets[Index];
+		if (const USkeletalMeshSocket* MeshSocket = Mesh->GetSocketByName(SocketNames[Index]))
+		{
+			Socket.BoneIndex = Mesh->GetBoneIndex(MeshSocket->BoneName);
+			Socket.LocalOffset = MeshSocket->RelativeLocation;
+		}
+		else
+		{
+			// Not a socket: a bone, or unknown and left at the component location like GetSocketLocation
+			Socket.BoneIndex = Mesh->GetBoneIndex(SocketNames[Index]);
+		}
+	}
+	return Chains.Num() - 1;
+}
+
+void UCMeleeHitComponent::SampleChain(const USkeletalMeshComponent* Mesh, const FSocketChain& Chain, TArray<FVector>& OutLocations) const
+{
+	OutLocations.SetNumUninitialized(Chain.Sockets.Num(), EAllowShrinking::No);
+	for (int32 Index = 0; Index < Chain.Sockets.Num(); ++Index)
+	{
+		const FCachedSocket& Socket = Chain.Sockets[Index];
+		OutLocations[Index] = Socket.BoneIndex != INDEX_NONE
+			? Mesh->GetBoneTransform(Socket.BoneIndex).TransformPosition(Socket.LocalOffset)
+			: Mesh->GetComponentLocation();
+	}
+}
+
+bool UCMeleeHitComponent::SamplePreviousChain(const USkeletalMeshComponent* Mesh, const FSocketChain& Chain, TArray<FVector>& OutLocations) const
+{
+	const TArray<FTransform>& PreviousTransforms = Mesh->GetPreviousComponentTransformsArray();
+	if (PreviousTransforms.Num() == 0 || PreviousTransforms.Num() != Mesh->GetComponentSpaceTransforms().Num())
+	{
+		return false;
+	}
+
+	// The previous bones are in last frame's component space, so place them where the mesh was then
+	const FMeshTransformHistory* History = FindMeshHistory(Mesh);
+	if (!History || History->NumUpdates < 2)
+	{
+		return false;
+	}
+
+	const FTransform& ComponentToWorld = History->PreviousComponentToWorld;
+	OutLocations.SetNumUninitialized(Chain.Sockets.Num(), EAllowShrinking::No);
+	for (int32 Index = 0; Index < Chain.Sockets.Num(); ++Index)
+	{
+		const FCachedSocket& Socket = Chain.Sockets[Index];
+		OutLocations[Index] = PreviousTransforms.IsValidIndex(Socket.BoneIndex)
+			? (PreviousTransforms[Socket.BoneIndex] * ComponentToWorld).TransformPosition(Socket.LocalOffset)
+			: ComponentToWorld.GetLocation();
+	}
+	return true;
+}
+
+void UCMeleeHitComponent::TrackMesh(USkeletalMeshComponent* Mesh)
+{
+	if (!Mesh || FindMeshHistory(Mesh))
+	{
+		return;
+	}
+
+	const int32 HistoryIndex = MeshHistories.Num();
+	FMeshTransformHistory& History = MeshHistories.AddDefaulted_GetRef();
+	History.Mesh = Mesh;
+	History.FinalizedHandle = Mesh->RegisterOnBoneTransformsFinalizedDelegate(
+		FOnBoneTransformsFinalizedMultiCast::FDelegate::CreateUObject(this, &UCMeleeHitComponent::OnMeshBoneTransformsFinalized, HistoryIndex));
+}
+
+void UCMeleeHitComponent::OnMeshBoneTransformsFinalized(int32 HistoryIndex)
+{
+	if (!MeshHistories.IsValidIndex(HistoryIndex))
+	{
+		return;
+	}
+
+	// Shifts in step with the mesh's own current/previous bone buffers, including frames its update rate skips
+	FMeshTransformHistory& History = MeshHistories[HistoryIndex];
+	if (const USkeletalMeshComponent* Mesh = History.Mesh.Get())
+	{
+		History.PreviousComponentToWorld = History.ComponentToWorld;
+		History.ComponentToWorld = Mesh->GetComponentTransform();
+		History.NumUpdates = FMath::Min(History.NumUpdates + 1, 2);
+	}
+}
+
+const UCMeleeHitComponent::FMeshTransformHistory* UCMeleeHitComponent::FindMeshHistory(const USkeletalMeshComponent* Mesh) const
+{
+	return MeshHistories.FindByPredicate([Mesh](const FMeshTransformHistory& History)
+	{
+		return History.Mesh.Get() == Mesh;
+	});
+}
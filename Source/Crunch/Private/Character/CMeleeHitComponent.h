@@ -0,0 +1,183 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GameplayAbilityTypes.h"
+#include "CollisionQueryParams.h"
+#include "Components/ActorComponent.h"
+#include "GameplayTagContainer.h"
+#include "GenericTeamAgentInterface.h"
+// ----------------------------------------------------------------------------
+// File: CMeleeHitComponent.h
+// Purpose: Melee hit detection along a chain of mesh sockets (weapon, fist,
+//          leg). A hit window sweeps the chain every frame while it is open,
+//          sub-stepping between the previous and current pose so fast swings
+//          at low tick rates still connect, and reports every actor hit once
+//          per window in a single gameplay event.
+// Key API:
+//  - FCMeleeHitSettings: sockets, radius, team filter, cue and event tags.
+//  - BeginWindow / EndWindow: driven by UANS_MeleeHitWindow.
+//  - DetectOnce: one-notify window, used by UAN_SendTargetGroup. It sweeps
+//    from the mesh's previous-frame pose to the current one.
+// Notes:
+//  - The owner's skeletal meshes record their world transform whenever their
+//    bone transforms are finalized, so the previous-frame pose is placed where
+//    the mesh was last frame, not where it is now.
+//  - Socket bone indices and offsets are resolved once per mesh asset.
+//  - Sweeps share one hit buffer and one set of query params.
+// ----------------------------------------------------------------------------
+#include "CMeleeHitComponent.generated.h"
+
+class USkeletalMeshComponent;
+class USkeletalMesh;
+
+/** What a melee hit window sweeps and whom it reports */
+USTRUCT(BlueprintType)
+struct FCMeleeHitSettings
+{
+	GENERATED_BODY()
+
+	/** Executed locally on every actor hit */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	FGameplayTagContainer TriggerGameplayCueTags;
+
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	TEnumAsByte<ETeamAttitude::Type> TargetTeam = ETeamAttitude::Hostile;
+
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	float SphereSweepRadius = 60.f;
+
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	bool bDrawDebug = false;
+
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	bool bIgnoreOwner = true;
+
+	/** Sent to the owner when the window ends, with every actor hit as target data */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	FGameplayTag EventTag;
+
+	/** Sockets or bones; a sphere is swept between each consecutive pair */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability")
+	TArray<FName> TargetSocketNames;
+
+	/** A socket moving further than this between two frames is swept at interpolated poses in between */
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability", meta = (ClampMin = "1"))
+	float SubstepDistance = 30.f;
+
+	UPROPERTY(EditAnywhere, Category = "Gameplay Ability", meta = (ClampMin = "1"))
+	int32 MaxSubsteps = 8;
+};
+
+/**
+ * UCMeleeHitComponent runs melee hit windows for its owner's meshes.
+ *
+ * A window samples the socket chain when it begins and then every frame after
+ * the meshes have animated. When the chain moved more than SubstepDistance
+ * since the last sample, the poses in between are linearly interpolated and
+ * swept as well. An actor counts once per window: the first hit plays the cues,
+ * later ones are ignored. EndWindow sweeps the final pose and sends one
+ * gameplay event carrying all hits, even when there were none, so abilities
+ * waiting on the event keep their flow.
+ */
+UCLASS(ClassGroup = (Combat), meta = (BlueprintSpawnableComponent))
+class UCMeleeHitComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UCMeleeHitComponent();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Open a window on Mesh; a window that is still open is ended first */
+	void BeginWindow(USkeletalMeshComponent* Mesh, const FCMeleeHitSettings& Settings);
+
+	/** Sweep up to the current pose, send the window's event and close it */
+	void EndWindow();
+
+	/**
+	 * Sweep from last frame's pose to the current one and send the event right away.
+	 * Both the animation's and the actor's motion since last frame are covered; a mesh
+	 * without two recorded bone updates only sweeps its current pose.
+	 */
+	void DetectOnce(USkeletalMeshComponent* Mesh, const FCMeleeHitSettings& Settings);
+
+	bool IsWindowOpenOn(const USkeletalMeshComponent* Mesh) const;
+
+private:
+	struct FCachedSocket
+	{
+		int32 BoneIndex = INDEX_NONE;
+		FVector LocalOffset = FVector::ZeroVector;
+	};
+
+	/** Socket chain of one settings asset resolved against one mesh asset */
+	struct FSocketChain
+	{
+		TWeakObjectPtr<const USkeletalMesh> MeshAsset;
+		TArray<FName> SocketNames;
+		TArray<FCachedSocket> Sockets;
+	};
+
+	struct FWindow
+	{
+		TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+		const FCMeleeHitSettings* Settings = nullptr;
+		int32 ChainIndex = INDEX_NONE;
+		TArray<FVector> LastLocations;
+		TSet<TWeakObjectPtr<AActor>> SeenActors;
+		FCollisionQueryParams QueryParams;
+		FGameplayEventData EventData;
+	};
+
+	/** Returns false when the chain has fewer than two sockets; bSweepFirstPose = false only samples it */
+	bool StartWindow(FWindow& Window, USkeletalMeshComponent* Mesh, const FCMeleeHitSettings& Settings, bool bSweepFirstPose = true);
+	void FinishWindow(FWindow& Window);
+
+	/** Sweep from the window's last sample to the current pose */
+	void SweepToCurrentPose(FWindow& Window);
+	void SweepChain(FWindow& Window, TConstArrayView<FVector> Locations);
+	void SendLocalGameplayCue(const FCMeleeHitSettings& Settings, const FHitResult& HitResult) const;
+
+	int32 FindOrResolveChain(const USkeletalMeshComponent* Mesh, const TArray<FName>& SocketNames);
+	void SampleChain(const USkeletalMeshComponent* Mesh, const FSocketChain& Chain, TArray<FVector>& OutLocations) const;
+
+	/** Chain at the mesh's previous-frame bone transforms; false when the mesh keeps none */
+	bool SamplePreviousChain(const USkeletalMeshComponent* Mesh, const FSocketChain& Chain, TArray<FVector>& OutLocations) const;
+
+	/** World transform of a mesh at its last two bone transform updates, paired with GetPreviousComponentTransformsArray */
+	struct FMeshTransformHistory
+	{
+		TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+		FDelegateHandle FinalizedHandle;
+		FTransform ComponentToWorld;
+		FTransform PreviousComponentToWorld;
+		int32 NumUpdates = 0;
+	};
+
+	void TrackMesh(USkeletalMeshComponent* Mesh);
+	void OnMeshBoneTransformsFinalized(int32 HistoryIndex);
+	const FMeshTransformHistory* FindMeshHistory(const USkeletalMeshComponent* Mesh) const;
+
+	TArray<FSocketChain> Chains;
+
+	/** One per owner skeletal mesh; indices are stable until EndPlay */
+	TArray<FMeshTransformHistory> MeshHistories;
+
+	/** Window opened by UANS_MeleeHitWindow, ticking until EndWindow */
+	FWindow ActiveWindow;
+	FCMeleeHitSettings ActiveSettings;
+	bool bWindowOpen = false;
+
+	/** Reused by DetectOnce; its settings are the caller's */
+	FWindow OnceWindow;
+
+	/** Scratch buffers shared by every sweep */
+	TArray<FVector> CurrentLocations;
+	TArray<FVector> StepLocations;
+	TArray<FHitResult> HitResults;
+};
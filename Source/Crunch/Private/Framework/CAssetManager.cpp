@@ -67,6 +67,20 @@ const FItemCollection* UCAssetManager::GetIngredientForItem(const UPA_ShopItem*
 	return IngredientMap.Find(Item);
 }
 
+void UCAssetManager::LoadTextureAsync(const TSoftObjectPtr<UTexture2D>& Texture, const FOnTextureLoaded& Callback)
+{
+	if (Texture.IsNull() || Texture.Get())
+	{
+		Callback.ExecuteIfBound(Texture.Get());
+		return;
+	}
+
+	GetStreamableManager().RequestAsyncLoad(Texture.ToSoftObjectPath(), FStreamableDelegate::CreateLambda([Texture, Callback]()
+	{
+		Callback.ExecuteIfBound(Texture.Get());
+	}));
+}
+
 void UCAssetManager::ShopItemLoadFinished(FStreamableDelegate Callback)
 {
 	Callback.ExecuteIfBound();
@@ -13,10 +13,15 @@
 //  - LoadCharacterDefinations / GetLoadedCharacterDefinations
 //  - LoadShopItems / GetLoadedShopItems
 //  - GetCombinationForItem / GetIngredientForItem (built from shop items)
+//  - LoadTextureAsync: UI icons without a synchronous load on the game thread
 // ----------------------------------------------------------------------------
 #include "CAssetManager.generated.h"
 
 class UPA_CharacterDefination;
+
+/** Texture of a LoadTextureAsync request, nullptr when it could not be loaded */
+DECLARE_DELEGATE_OneParam(FOnTextureLoaded, UTexture2D* /*Texture*/);
+
 /**
  * UAssetManager subclass that exposes convenience loaders and lookups for
  * character definitions and shop items. Internally uses streamable manager to
@@ -35,6 +40,9 @@ public:
 	bool GetLoadedShopItems(TArray<const UPA_ShopItem*>& OutItems) const;
 	const FItemCollection* GetCombinationForItem(const UPA_ShopItem* Item) const;
 	const FItemCollection* GetIngredientForItem(const UPA_ShopItem* Item) const;
+
+	/** Stream Texture in; Callback runs right away when it is already loaded (or null) */
+	void LoadTextureAsync(const TSoftObjectPtr<UTexture2D>& Texture, const FOnTextureLoaded& Callback);
 private:
 	void ShopItemLoadFinished(FStreamableDelegate Callback);
 	void BuildItemMaps();
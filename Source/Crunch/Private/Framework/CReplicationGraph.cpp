@@ -0,0 +1,303 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Framework/CReplicationGraph.h"
+#include "Abilities/GameplayAbilityTargetActor.h"
+#include "AI/Minion.h"
+#include "Engine/LevelScriptActor.h"
+#include "Engine/NetConnection.h"
+#include "Framework/StormCore.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "GAS/ProjectileActor.h"
+#include "HAL/IConsoleManager.h"
+#include "Player/CPlayerCharacter.h"
+#include "UObject/UObjectIterator.h"
+
+static TAutoConsoleVariable<float> CVarRepGraphCellSize(
+	TEXT("Crunch.RepGraph.CellSize"),
+	10000.f,
+	TEXT("Size in cm of a replication grid cell."));
+
+static TAutoConsoleVariable<float> CVarRepGraphSpatialBiasX(
+	TEXT("Crunch.RepGraph.SpatialBiasX"),
+	-50000.f,
+	TEXT("X of the replication grid's origin; should be below the smallest X of the map."));
+
+static TAutoConsoleVariable<float> CVarRepGraphSpatialBiasY(
+	TEXT("Crunch.RepGraph.SpatialBiasY"),
+	-50000.f,
+	TEXT("Y of the replication grid's origin; should be below the smallest Y of the map."));
+
+void UCReplicationGraphNode_TeamHeroes::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	Heroes.AddUnique(ActorInfo.Actor);
+	TeamListsFrameNum = MAX_uint32;
+}
+
+bool UCReplicationGraphNode_TeamHeroes::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	TeamListsFrameNum = MAX_uint32;
+	return Heroes.RemoveSwap(ActorInfo.Actor, EAllowShrinking::No) > 0;
+}
+
+void UCReplicationGraphNode_TeamHeroes::NotifyResetAllNetworkActors()
+{
+	Heroes.Reset();
+	TeamLists.Reset();
+	TeamListsFrameNum = MAX_uint32;
+}
+
+void UCReplicationGraphNode_TeamHeroes::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	if (TeamListsFrameNum != Params.ReplicationFrameNum)
+	{
+		RebuildTeamLists(Params.ReplicationFrameNum);
+	}
+
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		const IGenericTeamAgentInterface* TeamAgent = Cast<IGenericTeamAgentInterface>(Viewer.InViewer);
+		const FGenericTeamId TeamId = TeamAgent ? TeamAgent->GetGenericTeamId() : FGenericTeamId::NoTeam;
+		if (TeamId == FGenericTeamId::NoTeam)
+		{
+			continue;
+		}
+
+		const FActorRepListRefView* TeamList = TeamLists.Find(TeamId.GetId());
+		if (TeamList && TeamList->Num() > 0)
+		{
+			Params.OutGatheredReplicationLists.AddReplicationActorList(*TeamList);
+		}
+	}
+}
+
+void UCReplicationGraphNode_TeamHeroes::RebuildTeamLists(uint32 FrameNum)
+{
+	for (TPair<uint8, FActorRepListRefView>& TeamList : TeamLists)
+	{
+		TeamList.Value.Reset();
+	}
+
+	for (AActor* Hero : Heroes)
+	{
+		const IGenericTeamAgentInterface* TeamAgent = Cast<IGenericTeamAgentInterface>(Hero);
+		const FGenericTeamId TeamId = TeamAgent ? TeamAgent->GetGenericTeamId() : FGenericTeamId::NoTeam;
+		if (TeamId != FGenericTeamId::NoTeam)
+		{
+			TeamLists.FindOrAdd(TeamId.GetId()).Add(Hero);
+		}
+	}
+
+	TeamListsFrameNum = FrameNum;
+}
+
+void UCReplicationGraph::ResetGameWorldState()
+{
+	Super::ResetGameWorldState();
+	OwnerOnlyActors.Reset();
+}
+
+void UCReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// Explicit policies; subclasses inherit them, every other class gets GetDefaultMappingPolicy
+	ClassRepNodePolicies.Set(AReplicationGraphDebugActor::StaticClass(), ECClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(ALevelScriptActor::StaticClass(), ECClassRepNodeMapping::NotRouted);
+	// The controller is gathered as its connection's viewer, player states by the frequency limiter
+	ClassRepNodePolicies.Set(APlayerController::StaticClass(), ECClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(APlayerState::StaticClass(), ECClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(AStormCore::StaticClass(), ECClassRepNodeMapping::RelevantAllConnections);
+	ClassRepNodePolicies.Set(AMinion::StaticClass(), ECClassRepNodeMapping::Spatialize_Dormancy);
+	ClassRepNodePolicies.Set(AProjectileActor::StaticClass(), ECClassRepNodeMapping::Spatialize_Dynamic);
+	ClassRepNodePolicies.Set(AGameplayAbilityTargetActor::StaticClass(), ECClassRepNodeMapping::Spatialize_Dynamic);
+
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		const AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject(false));
+		if (!ActorCDO || !ActorCDO->GetIsReplicated())
+		{
+			continue;
+		}
+
+		// Blueprint compilation leftovers
+		const FString ClassName = Class->GetName();
+		if (ClassName.StartsWith(TEXT("SKEL_")) || ClassName.StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		const ECClassRepNodeMapping Policy = GetMappingPolicy(Class);
+		const bool bSpatialized = Policy == ECClassRepNodeMapping::Spatialize_Static
+			|| Policy == ECClassRepNodeMapping::Spatialize_Dynamic
+			|| Policy == ECClassRepNodeMapping::Spatialize_Dormancy;
+
+		FClassReplicationInfo ClassInfo;
+		ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(ActorCDO->GetNetUpdateFrequency());
+		if (bSpatialized)
+		{
+			ClassInfo.SetCullDistanceSquared(ActorCDO->GetNetCullDistanceSquared());
+		}
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	}
+}
+
+void UCReplicationGraph::InitGlobalGraphNodes()
+{
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = CVarRepGraphCellSize.GetValueOnGameThread();
+	GridNode->SpatialBias = FVector2D(CVarRepGraphSpatialBiasX.GetValueOnGameThread(), CVarRepGraphSpatialBiasY.GetValueOnGameThread());
+	// Moving actors of a cell update at a period that grows with distance and angle from the viewer
+	GridNode->CreateCellNodeOverride = [](UReplicationGraphNode_GridSpatialization2D* Parent)
+	{
+		UReplicationGraphNode_GridCell* Cell = Parent->CreateChildNode<UReplicationGraphNode_GridCell>();
+		Cell->CreateDynamicNodeOverride = [](UReplicationGraphNode_GridCell* CellParent) -> UReplicationGraphNode*
+		{
+			return CellParent->CreateChildNode<UReplicationGraphNode_DynamicSpatialFrequency>();
+		};
+		return Cell;
+	};
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+
+	TeamHeroesNode = CreateNewNode<UCReplicationGraphNode_TeamHeroes>();
+	AddGlobalGraphNode(TeamHeroesNode);
+
+	AddGlobalGraphNode(CreateNewNode<UReplicationGraphNode_PlayerStateFrequencyLimiter>());
+}
+
+void UCReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* OwnerNode = CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(OwnerNode, RepGraphConnection);
+	OwnerNodes.Add(RepGraphConnection, OwnerNode);
+}
+
+void UCReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case ECClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	case ECClassRepNodeMapping::Spatialize_Static:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+	case ECClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+	case ECClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+	case ECClassRepNodeMapping::OwnerOnly:
+		// An actor without an owning connection yet only reaches clients as a viewer or view target
+		if (UReplicationGraphNode_AlwaysRelevant_ForConnection* OwnerNode = GetOwnerNode(ActorInfo.Actor))
+		{
+			OwnerNode->NotifyAddNetworkActor(ActorInfo);
+			OwnerOnlyActors.Add(ActorInfo.Actor, OwnerNode);
+		}
+		break;
+	default:
+		break;
+	}
+
+	if (ActorInfo.Actor->IsA<ACPlayerCharacter>())
+	{
+		TeamHeroesNode->NotifyAddNetworkActor(ActorInfo);
+	}
+}
+
+void UCReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case ECClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+	case ECClassRepNodeMapping::Spatialize_Static:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+	case ECClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+	case ECClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+	case ECClassRepNodeMapping::OwnerOnly:
+	{
+		TWeakObjectPtr<UReplicationGraphNode_AlwaysRelevant_ForConnection> OwnerNode;
+		if (OwnerOnlyActors.RemoveAndCopyValue(ActorInfo.Actor, OwnerNode) && OwnerNode.IsValid())
+		{
+			OwnerNode->NotifyRemoveNetworkActor(ActorInfo, false);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+
+	if (ActorInfo.Actor->IsA<ACPlayerCharacter>())
+	{
+		TeamHeroesNode->NotifyRemoveNetworkActor(ActorInfo, false);
+	}
+}
+
+void UCReplicationGraph::RemoveClientConnection(UNetConnection* NetConnection)
+{
+	for (auto It = OwnerNodes.CreateIterator(); It; ++It)
+	{
+		if (!It.Key() || It.Key()->NetConnection == NetConnection)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	Super::RemoveClientConnection(NetConnection);
+}
+
+ECClassRepNodeMapping UCReplicationGraph::GetMappingPolicy(UClass* Class)
+{
+	if (const ECClassRepNodeMapping* Policy = ClassRepNodePolicies.Get(Class))
+	{
+		return *Policy;
+	}
+
+	const ECClassRepNodeMapping Policy = GetDefaultMappingPolicy(Cast<AActor>(Class->GetDefaultObject()));
+	ClassRepNodePolicies.Set(Class, Policy);
+	return Policy;
+}
+
+ECClassRepNodeMapping UCReplicationGraph::GetDefaultMappingPolicy(const AActor* ActorCDO) const
+{
+	if (!ActorCDO)
+	{
+		return ECClassRepNodeMapping::NotRouted;
+	}
+	if (ActorCDO->bAlwaysRelevant)
+	{
+		return ECClassRepNodeMapping::RelevantAllConnections;
+	}
+	if (ActorCDO->bOnlyRelevantToOwner)
+	{
+		return ECClassRepNodeMapping::OwnerOnly;
+	}
+	if (ActorCDO->IsA<APawn>() || ActorCDO->IsReplicatingMovement())
+	{
+		return ECClassRepNodeMapping::Spatialize_Dynamic;
+	}
+	return ECClassRepNodeMapping::Spatialize_Static;
+}
+
+UReplicationGraphNode_AlwaysRelevant_ForConnection* UCReplicationGraph::GetOwnerNode(const AActor* Actor)
+{
+	UNetConnection* Connection = Actor ? Actor->GetNetConnection() : nullptr;
+	UNetReplicationGraphConnection* ConnectionManager = Connection ? FindOrAddConnectionManager(Connection) : nullptr;
+	UReplicationGraphNode_AlwaysRelevant_ForConnection** OwnerNode = ConnectionManager ? OwnerNodes.Find(ConnectionManager) : nullptr;
+	return OwnerNode ? *OwnerNode : nullptr;
+}
@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericTeamAgentInterface.h"
+#include "ReplicationGraph.h"
+#include "ReplicationGraphTypes.h"
+#include "UObject/ObjectKey.h"
+// ----------------------------------------------------------------------------
+// File: CReplicationGraph.h
+// Purpose: Replication graph of a match. Instead of testing every replicated
+//          actor against every connection, actors are routed once into nodes
+//          and each connection only gathers the nodes that can concern it:
+//          the grid cells around its view, the always relevant actors, its
+//          own actors and its team's heroes.
+// Key API:
+//  - UCReplicationGraph: routes actors by class policy (see ECClassRepNodeMapping).
+//  - UCReplicationGraphNode_TeamHeroes: heroes replicate to their teammates
+//    wherever they are on the map.
+// Notes:
+//  - Enabled through ReplicationDriverClassName in DefaultEngine.ini.
+//  - Crunch.RepGraph.CellSize / SpatialBiasX / SpatialBiasY tune the grid;
+//    they are read when a graph is created (next map load).
+//  - Net.RepGraph.PrintGraph prints the nodes; Crunch.Net.Stats the bytes per client.
+// ----------------------------------------------------------------------------
+#include "CReplicationGraph.generated.h"
+
+class UReplicationGraphNode_ActorList;
+class UReplicationGraphNode_AlwaysRelevant_ForConnection;
+class UReplicationGraphNode_GridSpatialization2D;
+
+/** Where the actors of a class are routed */
+UENUM()
+enum class ECClassRepNodeMapping : uint8
+{
+	/** Not routed: replicated through a connection's own node or not at all */
+	NotRouted,
+	/** Every connection, e.g. game state, storm core, shared subsystem replicators */
+	RelevantAllConnections,
+	/** Grid, never moves */
+	Spatialize_Static,
+	/** Grid, moves every frame */
+	Spatialize_Dynamic,
+	/** Grid, moves while awake and counts as static while dormant (pooled minions) */
+	Spatialize_Dormancy,
+	/** Only the owning connection (bOnlyRelevantToOwner actors) */
+	OwnerOnly,
+};
+
+/**
+ * UCReplicationGraphNode_TeamHeroes keeps every hero and hands each connection
+ * the heroes of its viewer's team, so allies stay replicated beyond the grid's
+ * cull distance (minimap, ally gauges). Enemy heroes only come from the grid.
+ * Teams are read from the heroes once per replication frame, which follows
+ * team changes without re-routing.
+ */
+UCLASS()
+class UCReplicationGraphNode_TeamHeroes : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+private:
+	void RebuildTeamLists(uint32 FrameNum);
+
+	TArray<AActor*> Heroes;
+	TMap<uint8, FActorRepListRefView> TeamLists;
+	/** MAX_uint32 when heroes were added or removed since the last rebuild */
+	uint32 TeamListsFrameNum = MAX_uint32;
+};
+
+/**
+ * UCReplicationGraph routes each replicated actor once, when it is added:
+ *  - Pawns and projectiles go into a 2D grid whose cells update their actors
+ *    at a rate that drops with distance and view angle from each viewer.
+ *  - Minions are dormancy aware: a pooled (dormant) minion leaves the dynamic
+ *    lists and costs nothing until it wakes.
+ *  - Always relevant actors (game state, AStormCore, subsystem replicators) go
+ *    into one list every connection gathers.
+ *  - Player states are spread over frames by a frequency limiter.
+ *  - Each connection has its own node for its controller, view target and
+ *    owner-only actors, and heroes also go into UCReplicationGraphNode_TeamHeroes.
+ */
+UCLASS(Transient)
+class UCReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	virtual void ResetGameWorldState() override;
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual void RemoveClientConnection(UNetConnection* NetConnection) override;
+
+private:
+	ECClassRepNodeMapping GetMappingPolicy(UClass* Class);
+	ECClassRepNodeMapping GetDefaultMappingPolicy(const AActor* ActorCDO) const;
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* GetOwnerNode(const AActor* Actor);
+
+	UPROPERTY()
+	UReplicationGraphNode_GridSpatialization2D* GridNode = nullptr;
+
+	UPROPERTY()
+	UReplicationGraphNode_ActorList* AlwaysRelevantNode = nullptr;
+
+	UPROPERTY()
+	UCReplicationGraphNode_TeamHeroes* TeamHeroesNode = nullptr;
+
+	/** Per connection: controller, view target and owner-only actors */
+	UPROPERTY()
+	TMap<UNetReplicationGraphConnection*, UReplicationGraphNode_AlwaysRelevant_ForConnection*> OwnerNodes;
+
+	/** Owner-only actors and the node they were routed to, for removal */
+	TMap<FObjectKey, TWeakObjectPtr<UReplicationGraphNode_AlwaysRelevant_ForConnection>> OwnerOnlyActors;
+
+	TClassMap<ECClassRepNodeMapping> ClassRepNodePolicies;
+};
@@ -0,0 +1,476 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Framework/CSpatialIndexSubsystem.h"
+#include "Engine/OverlapResult.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+FCSpatialQueryFilter FCSpatialQueryFilter::Hostile(const AActor* Querier)
+{
+	FCSpatialQueryFilter Filter;
+	if (const IGenericTeamAgentInterface* TeamInterface = Cast<IGenericTeamAgentInterface>(Querier))
+	{
+		Filter.QuerierTeam = TeamInterface->GetGenericTeamId();
+	}
+	Filter.IgnoreActor = Querier;
+	return Filter;
+}
+
+bool FCSpatialQueryFilter::AcceptsAttitude(ETeamAttitude::Type Attitude) const
+{
+	switch (Attitude)
+	{
+	case ETeamAttitude::Hostile:	return bIncludeHostile;
+	case ETeamAttitude::Friendly:	return bIncludeFriendly;
+	default:						return bIncludeNeutral;
+	}
+}
+
+ETeamAttitude::Type FCSpatialQueryFilter::GetAttitudeTowards(uint8 TeamId) const
+{
+	// The default solver would make teamless pawns hostile to both teams
+	if (TeamId == FGenericTeamId::NoTeam.GetId())
+	{
+		return ETeamAttitude::Neutral;
+	}
+	return FGenericTeamId::GetAttitude(QuerierTeam, FGenericTeamId(TeamId));
+}
+
+void UCSpatialIndexSubsystem::Deinitialize()
+{
+	for (FEntry& Entry : Entries)
+	{
+		if (APawn* Pawn = Entry.Pawn.Get())
+		{
+			if (USceneComponent* RootComponent = Pawn->GetRootComponent())
+			{
+				RootComponent->TransformUpdated.Remove(Entry.TransformUpdatedHandle);
+			}
+		}
+	}
+	Entries.Empty();
+	PawnToEntry.Empty();
+	TeamGrids.Empty();
+	DirtyEntries.Empty();
+	Super::Deinitialize();
+}
+
+void UCSpatialIndexSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Only pawns that moved since the last tick; EndPlay unregisters the rest
+	TArray<int32> EntriesToRefresh = MoveTemp(DirtyEntries);
+	DirtyEntries.Reset();
+	for (int32 EntryIndex : EntriesToRefresh)
+	{
+		FEntry& Entry = Entries[EntryIndex];
+		Entry.bDirty = false;
+		if (Entry.Pawn.IsValid())
+		{
+			RefreshEntry(EntryIndex);
+		}
+		else
+		{
+			RemoveEntry(EntryIndex);
+		}
+	}
+}
+
+TStatId UCSpatialIndexSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCSpatialIndexSubsystem, STATGROUP_Tickables);
+}
+
+UCSpatialIndexSubsystem* UCSpatialIndexSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCSpatialIndexSubsystem>() : nullptr;
+}
+
+void UCSpatialIndexSubsystem::RegisterPawn(APawn* Pawn)
+{
+	if (!Pawn || PawnToEntry.Contains(Pawn))
+	{
+		return;
+	}
+
+	FEntry Entry;
+	Entry.Pawn = Pawn;
+	Entry.PawnKey = Pawn;
+	Entry.CollisionRadius = Pawn->GetSimpleCollisionRadius();
+	Entry.Cell = ToCell(Pawn->GetActorLocation());
+	Entry.TeamId = ReadTeamId(Pawn);
+	MaxCollisionRadius = FMath::Max(MaxCollisionRadius, Entry.CollisionRadius);
+
+	if (USceneComponent* RootComponent = Pawn->GetRootComponent())
+	{
+		Entry.TransformUpdatedHandle = RootComponent->TransformUpdated.AddUObject(this, &UCSpatialIndexSubsystem::OnPawnTransformUpdated);
+	}
+
+	const int32 EntryIndex = Entries.Add(Entry);
+	PawnToEntry.Add(Pawn, EntryIndex);
+	AddToGrid(EntryIndex);
+}
+
+void UCSpatialIndexSubsystem::UnregisterPawn(APawn* Pawn)
+{
+	if (const int32* EntryIndex = PawnToEntry.Find(Pawn))
+	{
+		RemoveEntry(*EntryIndex);
+	}
+}
+
+void UCSpatialIndexSubsystem::UpdatePawn(APawn* Pawn)
+{
+	if (const int32* EntryIndex = PawnToEntry.Find(Pawn))
+	{
+		RefreshEntry(*EntryIndex);
+	}
+}
+
+void UCSpatialIndexSubsystem::SetPawnTargetable(APawn* Pawn, bool bTargetable)
+{
+	if (const int32* EntryIndex = PawnToEntry.Find(Pawn))
+	{
+		Entries[*EntryIndex].bTargetable = bTargetable;
+	}
+}
+
+FIntPoint UCSpatialIndexSubsystem::ToCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+uint8 UCSpatialIndexSubsystem::ReadTeamId(const APawn* Pawn)
+{
+	const IGenericTeamAgentInterface* TeamInterface = Cast<IGenericTeamAgentInterface>(Pawn);
+	return TeamInterface ? TeamInterface->GetGenericTeamId().GetId() : FGenericTeamId::NoTeam.GetId();
+}
+
+void UCSpatialIndexSubsystem::AddToGrid(int32 EntryIndex)
+{
+	const FEntry& Entry = Entries[EntryIndex];
+	FTeamGrid& TeamGrid = TeamGrids.FindOrAdd(Entry.TeamId);
+	TeamGrid.Cells.FindOrAdd(Entry.Cell).Add(EntryIndex);
+	TeamGrid.NumPawns++;
+}
+
+void UCSpatialIndexSubsystem::RemoveFromGrid(int32 EntryIndex)
+{
+	const FEntry& Entry = Entries[EntryIndex];
+	FTeamGrid* TeamGrid = TeamGrids.Find(Entry.TeamId);
+	if (!TeamGrid)
+	{
+		return;
+	}
+
+	if (TArray<int32>* Cell = TeamGrid->Cells.Find(Entry.Cell))
+	{
+		Cell->RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+		if (Cell->Num() == 0)
+		{
+			TeamGrid->Cells.Remove(Entry.Cell);
+		}
+	}
+	TeamGrid->NumPawns--;
+}
+
+void UCSpatialIndexSubsystem::RefreshEntry(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	const APawn* Pawn = Entry.Pawn.Get();
+	if (!Pawn)
+	{
+		return;
+	}
+
+	const FIntPoint NewCell = ToCell(Pawn->GetActorLocation());
+	const uint8 NewTeamId = ReadTeamId(Pawn);
+	if (NewCell == Entry.Cell && NewTeamId == Entry.TeamId)
+	{
+		return;
+	}
+
+	RemoveFromGrid(EntryIndex);
+	Entry.Cell = NewCell;
+	Entry.TeamId = NewTeamId;
+	AddToGrid(EntryIndex);
+}
+
+void UCSpatialIndexSubsystem::RemoveEntry(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	if (APawn* Pawn = Entry.Pawn.Get())
+	{
+		if (USceneComponent* RootComponent = Pawn->GetRootComponent())
+		{
+			RootComponent->TransformUpdated.Remove(Entry.TransformUpdatedHandle);
+		}
+	}
+	if (Entry.bDirty)
+	{
+		DirtyEntries.RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+	}
+
+	RemoveFromGrid(EntryIndex);
+	PawnToEntry.Remove(Entries[EntryIndex].PawnKey);
+	Entries.RemoveAt(EntryIndex);
+}
+
+void UCSpatialIndexSubsystem::MarkDirty(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	if (!Entry.bDirty)
+	{
+		Entry.bDirty = true;
+		DirtyEntries.Add(EntryIndex);
+	}
+}
+
+void UCSpatialIndexSubsystem::OnPawnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	if (const int32* EntryIndex = PawnToEntry.Find(Cast<APawn>(UpdatedComponent->GetOwner())))
+	{
+		MarkDirty(*EntryIndex);
+	}
+}
+
+template<typename FuncType>
+void UCSpatialIndexSubsystem::ForEachCandidate(const FVector& Origin, float Radius, const FCSpatialQueryFilter& Filter, FuncType&& Func) const
+{
+	const float Reach = Radius + MaxCollisionRadius;
+	const FIntPoint MinCell = ToCell(Origin - FVector(Reach));
+	const FIntPoint MaxCell = ToCell(Origin + FVector(Reach));
+	const int64 NumRangeCells = int64(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1);
+
+	auto VisitCell = [this, &Filter, &Func](const TArray<int32>& Cell)
+	{
+		for (int32 EntryIndex : Cell)
+		{
+			const FEntry& Entry = Entries[EntryIndex];
+			if (!Entry.bTargetable && !Filter.bIncludeUntargetable)
+			{
+				continue;
+			}
+
+			APawn* Pawn = Entry.Pawn.Get();
+			if (Pawn && Pawn != Filter.IgnoreActor)
+			{
+				Func(Entry, Pawn);
+			}
+		}
+	};
+
+	for (const TPair<uint8, FTeamGrid>& TeamGrid : TeamGrids)
+	{
+		if (TeamGrid.Value.NumPawns == 0 || !Filter.AcceptsAttitude(Filter.GetAttitudeTowards(TeamGrid.Key)))
+		{
+			continue;
+		}
+
+		// Large queries over a sparse team walk the occupied cells instead of the whole range
+		if (NumRangeCells > TeamGrid.Value.Cells.Num())
+		{
+			for (const TPair<FIntPoint, TArray<int32>>& Cell : TeamGrid.Value.Cells)
+			{
+				if (Cell.Key.X >= MinCell.X && Cell.Key.X <= MaxCell.X && Cell.Key.Y >= MinCell.Y && Cell.Key.Y <= MaxCell.Y)
+				{
+					VisitCell(Cell.Value);
+				}
+			}
+			continue;
+		}
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				if (const TArray<int32>* Cell = TeamGrid.Value.Cells.Find(FIntPoint(X, Y)))
+				{
+					VisitCell(*Cell);
+				}
+			}
+		}
+	}
+}
+
+void UCSpatialIndexSubsystem::FindNearest(const FVector& Origin, float Radius, int32 MaxResults, const FCSpatialQueryFilter& Filter, TArray<APawn*>& OutPawns) const
+{
+	OutPawns.Reset();
+	if (MaxResults <= 0)
+	{
+		return;
+	}
+
+	// Max-heap on distance keeps the K best seen so far with the worst on top
+	typedef TPair<float, APawn*> FCandidate;
+	auto FartherFirst = [](const FCandidate& A, const FCandidate& B) { return A.Key > B.Key; };
+	TArray<FCandidate, TInlineAllocator<16>> Best;
+
+	ForEachCandidate(Origin, Radius, Filter, [&](const FEntry& Entry, APawn* Pawn)
+	{
+		const float DistSquared = FVector::DistSquared(Origin, Pawn->GetActorLocation());
+		if (DistSquared > FMath::Square(Radius + Entry.CollisionRadius))
+		{
+			return;
+		}
+
+		if (Best.Num() < MaxResults)
+		{
+			Best.HeapPush(FCandidate(DistSquared, Pawn), FartherFirst);
+		}
+		else if (DistSquared < Best.HeapTop().Key)
+		{
+			Best.HeapPopDiscard(FartherFirst, EAllowShrinking::No);
+			Best.HeapPush(FCandidate(DistSquared, Pawn), FartherFirst);
+		}
+	});
+
+	Best.Sort([](const FCandidate& A, const FCandidate& B) { return A.Key < B.Key; });
+	OutPawns.Reserve(Best.Num());
+	for (const FCandidate& Candidate : Best)
+	{
+		OutPawns.Add(Candidate.Value);
+	}
+}
+
+APawn* UCSpatialIndexSubsystem::FindNearest(const FVector& Origin, float Radius, const FCSpatialQueryFilter& Filter) const
+{
+	TArray<APawn*> Nearest;
+	FindNearest(Origin, Radius, 1, Filter, Nearest);
+	return Nearest.Num() > 0 ? Nearest[0] : nullptr;
+}
+
+void UCSpatialIndexSubsystem::QueryRadius(const FVector& Origin, float Radius, const FCSpatialQueryFilter& Filter, TArray<APawn*>& OutPawns) const
+{
+	OutPawns.Reset();
+	ForEachCandidate(Origin, Radius, Filter, [&](const FEntry& Entry, APawn* Pawn)
+	{
+		if (FVector::DistSquared(Origin, Pawn->GetActorLocation()) <= FMath::Square(Radius + Entry.CollisionRadius))
+		{
+			OutPawns.Add(Pawn);
+		}
+	});
+}
+
+void UCSpatialIndexSubsystem::QueryCone(const FVector& Origin, const FVector& Direction, float Radius, float HalfAngleDegrees, const FCSpatialQueryFilter& Filter, TArray<APawn*>& OutPawns) const
+{
+	OutPawns.Reset();
+	const FVector Forward = Direction.GetSafeNormal();
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(HalfAngleDegrees));
+
+	ForEachCandidate(Origin, Radius, Filter, [&](const FEntry& Entry, APawn* Pawn)
+	{
+		const FVector ToPawn = Pawn->GetActorLocation() - Origin;
+		if (ToPawn.SizeSquared() > FMath::Square(Radius + Entry.CollisionRadius))
+		{
+			return;
+		}
+
+		// A pawn standing on the origin is always inside the cone
+		const FVector ToPawnDir = ToPawn.GetSafeNormal();
+		if (ToPawnDir.IsZero() || FVector::DotProduct(Forward, ToPawnDir) >= CosHalfAngle)
+		{
+			OutPawns.Add(Pawn);
+		}
+	});
+}
+
+void UCSpatialIndexSubsystem::RunBenchmark(int32 Iterations, float Radius, FOutputDevice& Ar) const
+{
+	UWorld* World = GetWorld();
+	TArray<APawn*> Queriers;
+	for (const FEntry& Entry : Entries)
+	{
+		if (APawn* Pawn = Entry.Pawn.Get())
+		{
+			Queriers.Add(Pawn);
+		}
+	}
+
+	if (!World || Queriers.Num() == 0)
+	{
+		Ar.Log(TEXT("Crunch.SpatialIndex.Benchmark: no registered pawns in this world"));
+		return;
+	}
+
+	// Physics path: what GAP_Dead and TargetActor_GroundPick did before the index
+	int64 PhysicsResults = 0;
+	const double PhysicsStart = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (const APawn* Querier : Queriers)
+		{
+			FCollisionObjectQueryParams ObjectQueryParams;
+			ObjectQueryParams.AddObjectTypesToQuery(ECC_Pawn);
+			FCollisionShape CollisionShape;
+			CollisionShape.SetSphere(Radius);
+
+			TArray<FOverlapResult> OverlapResults;
+			World->OverlapMultiByObjectType(OverlapResults, Querier->GetActorLocation(), FQuat::Identity, ObjectQueryParams, CollisionShape);
+
+			TSet<AActor*> Hostiles;
+			for (const FOverlapResult& OverlapResult : OverlapResults)
+			{
+				const IGenericTeamAgentInterface* OtherTeamInterface = Cast<IGenericTeamAgentInterface>(OverlapResult.GetActor());
+				if (OtherTeamInterface && OtherTeamInterface->GetTeamAttitudeTowards(*Querier) == ETeamAttitude::Hostile)
+				{
+					Hostiles.Add(OverlapResult.GetActor());
+				}
+			}
+			PhysicsResults += Hostiles.Num();
+		}
+	}
+	const double PhysicsSeconds = FPlatformTime::Seconds() - PhysicsStart;
+
+	int64 IndexResults = 0;
+	TArray<APawn*> Hostiles;
+	const double IndexStart = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (const APawn* Querier : Queriers)
+		{
+			FCSpatialQueryFilter Filter = FCSpatialQueryFilter::Hostile(Querier);
+			Filter.bIncludeUntargetable = true;
+			QueryRadius(Querier->GetActorLocation(), Radius, Filter, Hostiles);
+			IndexResults += Hostiles.Num();
+		}
+	}
+	const double IndexSeconds = FPlatformTime::Seconds() - IndexStart;
+
+	const int64 NumQueries = int64(Iterations) * Queriers.Num();
+	Ar.Logf(TEXT("Crunch.SpatialIndex.Benchmark: %d pawns, %lld hostile radius queries of %.0f"), Queriers.Num(), NumQueries, Radius);
+	Ar.Logf(TEXT("  Physics overlap: %8.3f us/query, %.2f hits/query"), PhysicsSeconds * 1e6 / NumQueries, double(PhysicsResults) / NumQueries);
+	Ar.Logf(TEXT("  Spatial index:   %8.3f us/query, %.2f hits/query"), IndexSeconds * 1e6 / NumQueries, double(IndexResults) / NumQueries);
+	if (IndexSeconds > 0.0)
+	{
+		Ar.Logf(TEXT("  Speedup: %.1fx"), PhysicsSeconds / IndexSeconds);
+	}
+}
+
+/**********************************************************************/
+/*                          Console command                           */
+/**********************************************************************/
+
+static void SpatialIndexBenchmark(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	const UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(World);
+	if (!SpatialIndex)
+	{
+		Ar.Log(TEXT("Crunch.SpatialIndex.Benchmark: no spatial index in this world"));
+		return;
+	}
+
+	const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100;
+	const float Radius = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 1500.f;
+	SpatialIndex->RunBenchmark(Iterations, Radius, Ar);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice SpatialIndexBenchmarkCommand(
+	TEXT("Crunch.SpatialIndex.Benchmark"),
+	TEXT("Crunch.SpatialIndex.Benchmark [Iterations=100] [Radius=1500]: time hostile radius queries around every indexed pawn, physics overlap vs spatial index."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&SpatialIndexBenchmark));
@@ -0,0 +1,147 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GenericTeamAgentInterface.h"
+// ----------------------------------------------------------------------------
+// File: CSpatialIndexSubsystem.h
+// Purpose: Per-world spatial index of team pawns for gameplay proximity
+//          queries (targeting, rewards, area abilities) without physics.
+// Key API:
+//  - RegisterPawn / UnregisterPawn: pawns opt in from BeginPlay/EndPlay; only
+//    ACCharacter (heroes, minions) and AStormCore do, so other pawns (e.g. the
+//    Behaviac animals) never appear in query results. Pawns without
+//    IGenericTeamAgentInterface are indexed under NoTeam and count as neutral.
+//  - SetPawnTargetable: dead pawns stay indexed but are skipped by default.
+//  - FindNearest / QueryRadius / QueryCone with an FCSpatialQueryFilter.
+//  - Crunch.SpatialIndex.Benchmark console command compares against
+//    OverlapMultiByObjectType on the current world.
+// ----------------------------------------------------------------------------
+#include "CSpatialIndexSubsystem.generated.h"
+
+/**
+ * Which pawns a spatial query accepts, expressed relative to the querier's team.
+ * Attitude is resolved once per team bucket through FGenericTeamId::GetAttitude.
+ */
+struct FCSpatialQueryFilter
+{
+	FGenericTeamId QuerierTeam = FGenericTeamId::NoTeam;
+	bool bIncludeHostile = true;
+	bool bIncludeFriendly = false;
+	bool bIncludeNeutral = false;
+
+	/** Include dead / untargetable pawns */
+	bool bIncludeUntargetable = false;
+
+	/** Usually the querier itself */
+	const AActor* IgnoreActor = nullptr;
+
+	/** Hostile, targetable pawns other than the querier */
+	static FCSpatialQueryFilter Hostile(const AActor* Querier);
+
+	bool AcceptsAttitude(ETeamAttitude::Type Attitude) const;
+
+	/** Attitude towards a team bucket; the NoTeam bucket is neutral to everyone */
+	ETeamAttitude::Type GetAttitudeTowards(uint8 TeamId) const;
+};
+
+/**
+ * UCSpatialIndexSubsystem keeps a uniform XY grid of every registered team pawn,
+ * with one grid per team so a query only visits the buckets whose attitude it
+ * accepts.
+ *
+ * Each pawn's root component TransformUpdated event marks its entry dirty, and
+ * Tick only refreshes dirty entries, so idle pawns cost nothing per frame. A
+ * pawn only touches the grid when it crosses into a new cell or changes team. Distance tests read the pawn's
+ * live location and pad the query radius by its collision radius, which
+ * approximates a sphere overlap against its capsule.
+ */
+UCLASS()
+class UCSpatialIndexSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Index a pawn until UnregisterPawn; only registered pawns are visible to queries */
+	void RegisterPawn(APawn* Pawn);
+	void UnregisterPawn(APawn* Pawn);
+
+	/** Re-read the pawn's team and location right away instead of waiting for the next tick */
+	void UpdatePawn(APawn* Pawn);
+	void SetPawnTargetable(APawn* Pawn, bool bTargetable);
+
+	/** Up to MaxResults accepted pawns within Radius of Origin, nearest first */
+	void FindNearest(const FVector& Origin, float Radius, int32 MaxResults, const FCSpatialQueryFilter& Filter, TArray<APawn*>& OutPawns) const;
+	APawn* FindNearest(const FVector& Origin, float Radius, const FCSpatialQueryFilter& Filter) const;
+
+	/** Every accepted pawn overlapping the sphere, in no particular order */
+	void QueryRadius(const FVector& Origin, float Radius, const FCSpatialQueryFilter& Filter, TArray<APawn*>& OutPawns) const;
+
+	/** Every accepted pawn within Radius whose direction from Origin is within HalfAngleDegrees of Direction */
+	void QueryCone(const FVector& Origin, const FVector& Direction, float Radius, float HalfAngleDegrees, const FCSpatialQueryFilter& Filter, TArray<APawn*>& OutPawns) const;
+
+	int32 GetNumPawns() const { return PawnToEntry.Num(); }
+
+	/** Time QueryRadius against OverlapMultiByObjectType around every registered pawn */
+	void RunBenchmark(int32 Iterations, float Radius, FOutputDevice& Ar) const;
+
+	static UCSpatialIndexSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Edge length of a grid cell; roughly the typical query radius */
+	static constexpr float CellSize = 1000.f;
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<APawn> Pawn;
+
+		/** Still valid for the PawnToEntry lookup after the pawn is destroyed */
+		TObjectKey<APawn> PawnKey;
+		float CollisionRadius = 0.f;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		uint8 TeamId = FGenericTeamId::NoTeam.GetId();
+		bool bTargetable = true;
+
+		/** Queued in DirtyEntries for the next Tick */
+		bool bDirty = false;
+		FDelegateHandle TransformUpdatedHandle;
+	};
+
+	/** Entry indices per occupied cell for one team */
+	struct FTeamGrid
+	{
+		TMap<FIntPoint, TArray<int32>> Cells;
+		int32 NumPawns = 0;
+	};
+
+	static FIntPoint ToCell(const FVector& Location);
+	static uint8 ReadTeamId(const APawn* Pawn);
+
+	void AddToGrid(int32 EntryIndex);
+	void RemoveFromGrid(int32 EntryIndex);
+	void RefreshEntry(int32 EntryIndex);
+	void RemoveEntry(int32 EntryIndex);
+	void MarkDirty(int32 EntryIndex);
+
+	void OnPawnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	/** Visit every accepted entry whose cell overlaps the XY box around Origin */
+	template<typename FuncType>
+	void ForEachCandidate(const FVector& Origin, float Radius, const FCSpatialQueryFilter& Filter, FuncType&& Func) const;
+
+	TSparseArray<FEntry> Entries;
+	TMap<TObjectKey<APawn>, int32> PawnToEntry;
+	TMap<uint8, FTeamGrid> TeamGrids;
+
+	/** Entries whose pawn moved since the last Tick */
+	TArray<int32> DirtyEntries;
+
+	/** Largest registered collision radius, used to pad the cell range of queries */
+	float MaxCollisionRadius = 0.f;
+};
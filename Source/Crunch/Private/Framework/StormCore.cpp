@@ -3,6 +3,9 @@
 
 #include "Framework/StormCore.h"
 #include "AIController.h"
+#include "AI/CMinionMovementComponent.h"
+#include "AI/CPathRequestSubsystem.h"
+#include "Framework/CSpatialIndexSubsystem.h"
 #include "Components/SphereComponent.h"
 #include "Components/DecalComponent.h"
 #include "Camera/CameraComponent.h"
@@ -11,7 +14,8 @@
 #include "Net/UnrealNetwork.h"
 
 // Sets default values
-AStormCore::AStormCore()
+AStormCore::AStormCore(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UCMinionMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
  	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
@@ -54,6 +58,21 @@ void AStormCore::BeginPlay()
 	GoalOffset.Z = 0;
 
 	TravelLength = GoalOffset.Length();
+
+	// Teamless, so indexed as neutral: only queries with bIncludeNeutral see the core
+	if (UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this))
+	{
+		SpatialIndex->RegisterPawn(this);
+	}
+}
+
+void AStormCore::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this))
+	{
+		SpatialIndex->UnregisterPawn(this);
+	}
+	Super::EndPlay(EndPlayReason);
 }
 
 void AStormCore::PossessedBy(AController* NewController)
@@ -176,13 +195,16 @@ void AStormCore::UpdateGoal()
 	if (!GetCharacterMovement())
 		return;
 
-	if (TeamWeight > 0)
+	AActor* Goal = TeamWeight > 0 ? TeamOneGoal : TeamTwoGoal;
+
+	// Capture changes re-issue the same goal often; the request layer only repaths when it changes
+	if (UCPathRequestSubsystem* PathRequests = UCPathRequestSubsystem::Get(this))
 	{
-		OwnerAIC->MoveToActor(TeamOneGoal);
+		PathRequests->RequestMoveToActor(OwnerAIC, Goal);
 	}
 	else
 	{
-		OwnerAIC->MoveToActor(TeamTwoGoal);
+		OwnerAIC->MoveToActor(Goal);
 	}
 
 	float Speed = MaxMoveSpeed * FMath::Abs(TeamWeight);
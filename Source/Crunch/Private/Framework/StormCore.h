@@ -35,7 +35,7 @@ public:
     FOnGoalReachedDelegate OnGoalReachedDelegate;
     FonTeamInfluncerCountUpdatedDelegate OnTeamInfluenceCountUpdated;
     // Sets default values for this character's properties
-    AStormCore();
+    AStormCore(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
     float GetProgress() const;
@@ -43,6 +43,7 @@ public:
 protected:
     // Called when the game starts or when spawned
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void PossessedBy(AController* NewController) override;
 
 public: 
@@ -15,6 +15,8 @@ UCAbilitySystemComponent::UCAbilitySystemComponent()
 	GetGameplayAttributeValueChangeDelegate(UCAttributeSet::GetHealthAttribute()).AddUObject(this, &UCAbilitySystemComponent::HealthUpdated);
 	GetGameplayAttributeValueChangeDelegate(UCAttributeSet::GetManaAttribute()).AddUObject(this, &UCAbilitySystemComponent::ManaUpdated);
 	GetGameplayAttributeValueChangeDelegate(UCHeroAttributeSet::GetExperienceAttribute()).AddUObject(this, &UCAbilitySystemComponent::ExperienceUpdated);
+	OnActiveGameplayEffectAddedDelegateToSelf.AddUObject(this, &UCAbilitySystemComponent::DurationEffectAdded);
+	OnAnyGameplayEffectRemovedDelegate().AddUObject(this, &UCAbilitySystemComponent::DurationEffectRemoved);
 	GenericConfirmInputID = (int32)ECAbilityInputID::Confirm;
 	GenericCancelInputID = (int32)ECAbilityInputID::Cancel;
 }
@@ -26,17 +28,7 @@ void UCAbilitySystemComponent::InitializeBaseAttributes()
 		return;
 	}
 
-	const UDataTable* BaseStatDataTable = AbilitySystemGenerics->GetBaseStatDataTable();
-	const FHeroBaseStats* BaseStats = nullptr;
-
-	for (const TPair<FName, uint8*>& DataPair : BaseStatDataTable->GetRowMap())
-	{
-		BaseStats = BaseStatDataTable->FindRow<FHeroBaseStats>(DataPair.Key, "");
-		if (BaseStats && BaseStats->Class == GetOwner()->GetClass())
-		{
-			break;
-		}
-	}
+	const FHeroBaseStats* BaseStats = AbilitySystemGenerics->FindBaseStats(GetOwner()->GetClass());
 
 	if (BaseStats)
 	{
@@ -52,13 +44,12 @@ void UCAbilitySystemComponent::InitializeBaseAttributes()
 		SetNumericAttributeBase(UCHeroAttributeSet::GetIntelligenceGrowthRateAttribute(), BaseStats->IntelligenceGrowthRate);
 	}
 
-	const FRealCurve* ExperienceCurve = AbilitySystemGenerics->GetExperienceCurve();
-	if (ExperienceCurve)
+	const int32 MaxLevel = AbilitySystemGenerics->GetMaxLevel();
+	if (MaxLevel > 0)
 	{
-		int MaxLevel = ExperienceCurve->GetNumKeys();
 		SetNumericAttributeBase(UCHeroAttributeSet::GetMaxLevelAttribute(), MaxLevel);
 
-		float MaxExp = ExperienceCurve->GetKeyValue(ExperienceCurve->GetLastKeyHandle());
+		float MaxExp = AbilitySystemGenerics->GetMaxLevelExperience();
 		SetNumericAttributeBase(UCHeroAttributeSet::GetMaxLevelExperienceAttribute(), MaxExp);
 
 		UE_LOG(LogTemp, Warning, TEXT("Max Level is: %d, max experience is: %f"), MaxLevel, MaxExp);
@@ -120,6 +111,24 @@ void UCAbilitySystemComponent::ApplyFullStatEffect()
 	AuthApplyGameplayEffect(AbilitySystemGenerics->GetFullStatEffect());
 }
 
+void UCAbilitySystemComponent::ResetForReuse()
+{
+	if (!GetOwner() || !GetOwner()->HasAuthority())
+		return;
+
+	CancelAllAbilities();
+
+	// Initial effects (regeneration etc.) belong to the actor, everything else to its previous life
+	FGameplayEffectQuery NotInitialEffects;
+	NotInitialEffects.CustomMatchDelegate.BindLambda([this](const FActiveGameplayEffect& Effect)
+	{
+		return !AbilitySystemGenerics || !Effect.Spec.Def || !AbilitySystemGenerics->GetInitialEffects().Contains(Effect.Spec.Def->GetClass());
+	});
+	RemoveActiveEffects(NotInitialEffects);
+
+	ApplyFullStatEffect();
+}
+
 const TMap<ECAbilityInputID, TSubclassOf<UGameplayAbility>>& UCAbilitySystemComponent::GetAbilities() const
 {
 	return Abilities;
@@ -263,29 +272,14 @@ void UCAbilitySystemComponent::ExperienceUpdated(const FOnAttributeChangeData& C
 
 	float CurrentExp = ChangeData.NewValue;
 
-	const FRealCurve* ExperienceCurve = AbilitySystemGenerics->GetExperienceCurve();
-	if (!ExperienceCurve)
+	if (AbilitySystemGenerics->GetMaxLevel() <= 0)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Can't find Experience Data!!"));
 		return;
 	}
 
-	float PrevLevelExp = 0;
-	float NextLevelExp = 0;
-	float NewLevel = 1;
-
-	for (auto Iter = ExperienceCurve->GetKeyHandleIterator(); Iter; ++Iter)
-	{
-		float ExperienceToReachLevel = ExperienceCurve->GetKeyValue(*Iter);
-		if (CurrentExp < ExperienceToReachLevel)
-		{
-			NextLevelExp = ExperienceToReachLevel;
-			break;
-		}
-				
-		PrevLevelExp = ExperienceToReachLevel;
-		NewLevel = Iter.GetIndex() + 1;
-	}
+	const FCExperienceLevel ExperienceLevel = AbilitySystemGenerics->GetExperienceLevel(CurrentExp);
+	float NewLevel = ExperienceLevel.Level;
 
 	float CurrentLevel = GetNumericAttributeBase(UCHeroAttributeSet::GetLevelAttribute());
 	float CurrentUpgradePoint = GetNumericAttribute(UCHeroAttributeSet::GetUpgradePointAttribute());
@@ -294,7 +288,23 @@ void UCAbilitySystemComponent::ExperienceUpdated(const FOnAttributeChangeData& C
 	float NewUpgradePoint = CurrentUpgradePoint + LevelUpgraded;
 
 	SetNumericAttributeBase(UCHeroAttributeSet::GetLevelAttribute(), NewLevel);
-	SetNumericAttributeBase(UCHeroAttributeSet::GetPrevLevelExperienceAttribute(), PrevLevelExp);
-	SetNumericAttributeBase(UCHeroAttributeSet::GetNextLevelExperienceAttribute(), NextLevelExp);
+	SetNumericAttributeBase(UCHeroAttributeSet::GetPrevLevelExperienceAttribute(), ExperienceLevel.PrevLevelExperience);
+	SetNumericAttributeBase(UCHeroAttributeSet::GetNextLevelExperienceAttribute(), ExperienceLevel.NextLevelExperience);
 	SetNumericAttributeBase(UCHeroAttributeSet::GetUpgradePointAttribute(), NewUpgradePoint);
 }
+
+void UCAbilitySystemComponent::DurationEffectAdded(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle)
+{
+	if (Spec.Def)
+	{
+		OnDurationEffectChanged.Broadcast(Spec.Def);
+	}
+}
+
+void UCAbilitySystemComponent::DurationEffectRemoved(const FActiveGameplayEffect& Effect)
+{
+	if (Effect.Spec.Def)
+	{
+		OnDurationEffectChanged.Broadcast(Effect.Spec.Def);
+	}
+}
@@ -8,12 +8,17 @@
 #include "GAS/CGameplayAbilityTypes.h"
 #include "CAbilitySystemComponent.generated.h"
 
+/** A duration effect (e.g. a cooldown) of this definition was added or removed */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnDurationEffectChanged, const UGameplayEffect* /*EffectDefinition*/);
+
 /**
  * Crunch-specific Ability System Component (ASC) extension.
  * Responsibilities:
  * - Initialize and grant initial abilities/effects to the avatar.
  * - Expose project-specific ability maps keyed by ECAbilityInputID.
  * - Provide helpers for attribute init and server-authoritative upgrades.
+ * - Report duration effects (cooldowns) coming and going, on the server and the
+ *   owning client alike, so HUD widgets do not poll for them.
  */
 UCLASS()
 class UCAbilitySystemComponent : public UAbilitySystemComponent
@@ -27,6 +32,8 @@ public:
     void ServerSideInit();
     /** Apply an effect that restores stats to full (health/mana, etc.) */
     void ApplyFullStatEffect();
+    /** Server: cancel abilities, remove every effect but the initial ones and restore full stats (pooled actors) */
+    void ResetForReuse();
     //Get the Abilities that is unique for the avatar actor, this do not include Generic/Basic ones
     /** Returns the unique (non-basic) abilities granted to the avatar, keyed by input ID */
     const TMap<ECAbilityInputID, TSubclassOf<UGameplayAbility>>& GetAbilities() const;
@@ -41,6 +48,9 @@ public:
     /** Client RPC: notify when an ability spec level has changed */
     void Client_AbilitySpecLevelUpdated(FGameplayAbilitySpecHandle Handle, int NewLevel);
 
+    /** Fires for predicted and replicated effects; query the active effects for the resulting state */
+    FOnDurationEffectChanged OnDurationEffectChanged;
+
 private:
     /** Apply initial passive/starting effects to the avatar */
     void ApplyInitialEffects();
@@ -52,6 +62,9 @@ private:
     void HealthUpdated(const FOnAttributeChangeData& ChangeData);
     void ManaUpdated(const FOnAttributeChangeData& ChangeData);
     void ExperienceUpdated(const FOnAttributeChangeData& ChangeData);
+    /** Duration effect handlers feeding OnDurationEffectChanged */
+    void DurationEffectAdded(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle);
+    void DurationEffectRemoved(const FActiveGameplayEffect& Effect);
 
     UPROPERTY(EditDefaultsOnly, Category = "Gameplay Ability")
     /** Unique abilities (non-basic), mapped to their input bindings */
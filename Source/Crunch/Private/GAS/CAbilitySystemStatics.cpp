@@ -8,100 +8,101 @@
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
 #include "GameplayCueManager.h"
+#include "GAS/CGameplayTags.h"
 
 FGameplayTag UCAbilitySystemStatics::GetBasicAttackAbilityTag()
 {
-	return FGameplayTag::RequestGameplayTag("ability.basicattack");
+	return CGameplayTags::Ability_BasicAttack;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetBasicAttackInputPressedTag()
 {
-	return FGameplayTag::RequestGameplayTag("ability.basicattack.pressed");
+	return CGameplayTags::Ability_BasicAttack_Pressed;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetBasicAttackInputReleasedTag()
 {
-	return FGameplayTag::RequestGameplayTag("ability.basicattack.released");
+	return CGameplayTags::Ability_BasicAttack_Released;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetDeadStatTag()
 {
-	return FGameplayTag::RequestGameplayTag("stats.dead");
+	return CGameplayTags::Stats_Dead;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetStunStatTag()
 {
-	return FGameplayTag::RequestGameplayTag("stats.stun");
+	return CGameplayTags::Stats_Stun;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetAimStatTag()
 {
-	return FGameplayTag::RequestGameplayTag("stats.aim");
+	return CGameplayTags::Stats_Aim;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetFocusStatTag()
 {
-	return FGameplayTag::RequestGameplayTag("stats.focus");
+	return CGameplayTags::Stats_Focus;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetCameraShakeGameplayCueTag()
 {
-	return FGameplayTag::RequestGameplayTag("GameplayCue.cameraShake");
+	return CGameplayTags::GameplayCue_CameraShake;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetHealthFullStatTag()
 {
-	return FGameplayTag::RequestGameplayTag("stats.health.full");
+	return CGameplayTags::Stats_Health_Full;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetHealthEmptyStatTag()
 {
-	return FGameplayTag::RequestGameplayTag("stats.health.empty");
+	return CGameplayTags::Stats_Health_Empty;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetManaFullStatTag()
 {
-	return FGameplayTag::RequestGameplayTag("stats.mana.full");
+	return CGameplayTags::Stats_Mana_Full;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetManaEmptyStatTag()
 {
-	return FGameplayTag::RequestGameplayTag("stats.mana.empty");
+	return CGameplayTags::Stats_Mana_Empty;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetHeroRoleTag()
 {
-	return FGameplayTag::RequestGameplayTag("role.hero");
+	return CGameplayTags::Role_Hero;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetExperienceAttributeTag()
 {
-	return FGameplayTag::RequestGameplayTag("attr.experience");
+	return CGameplayTags::Attr_Experience;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetGoldAttributeTag()
 {
-	return FGameplayTag::RequestGameplayTag("attr.gold");
+	return CGameplayTags::Attr_Gold;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetCrosshairTag()
 {
-	return FGameplayTag::RequestGameplayTag("stats.crosshair");
+	return CGameplayTags::Stats_Crosshair;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetTargetUpdatedTag()
 {
-	return FGameplayTag::RequestGameplayTag("target.updated");
+	return CGameplayTags::Target_Updated;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetGenericDamagePointTag()
 {
-	return FGameplayTag::RequestGameplayTag("ability.generic.damage");
+	return CGameplayTags::Ability_Generic_Damage;
 }
 
 FGameplayTag UCAbilitySystemStatics::GetGenericTargetPointTag()
 {
-	return FGameplayTag::RequestGameplayTag("ability.generic.target");
+	return CGameplayTags::Ability_Generic_Target;
 }
 
 bool UCAbilitySystemStatics::IsActorDead(const AActor* ActorToCheck)
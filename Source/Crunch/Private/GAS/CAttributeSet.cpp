@@ -2,6 +2,7 @@
 
 
 #include "GAS/CAttributeSet.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Net/UnrealNetwork.h"
 #include "GameplayEffectExtension.h"
 
@@ -96,13 +97,37 @@ void UCAttributeSet::OnRep_MoveAcceleration(const FGameplayAttributeData& OldVal
 void UCAttributeSet::GetLifetimeReplicatedProps(TArray< class FLifetimeProperty >& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCAttributeSet, Health, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCAttributeSet, MaxHealth, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCAttributeSet, Mana, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCAttributeSet, MaxMana, COND_None, REPNOTIFY_Always);
-
-	DOREPLIFETIME_CONDITION_NOTIFY(UCAttributeSet, AttackDamage, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCAttributeSet, Armor, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCAttributeSet, MoveSpeed, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCAttributeSet, MoveAcceleration, COND_None, REPNOTIFY_Always);
+
+	// Push model: a property is only compared when PostAttributeChange marked it dirty
+	FDoRepLifetimeParams PublicParams;
+	PublicParams.Condition = COND_None;
+	PublicParams.RepNotifyCondition = REPNOTIFY_Always;
+	PublicParams.bIsPushBased = true;
+
+	FDoRepLifetimeParams OwnerParams = PublicParams;
+	OwnerParams.Condition = COND_OwnerOnly;
+
+	// Everyone who has the actor: the over head gauges
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCAttributeSet, Health, PublicParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCAttributeSet, MaxHealth, PublicParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCAttributeSet, Mana, PublicParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCAttributeSet, MaxMana, PublicParams);
+
+	// The owning player only: stats panel and movement prediction. Simulated
+	// proxies follow replicated movement and damage is computed on the server.
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCAttributeSet, AttackDamage, OwnerParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCAttributeSet, Armor, OwnerParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCAttributeSet, MoveSpeed, OwnerParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCAttributeSet, MoveAcceleration, OwnerParams);
+}
+
+void UCAttributeSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
+{
+	Super::PostAttributeChange(Attribute, OldValue, NewValue);
+
+	const FProperty* Property = Attribute.GetUProperty();
+	if (Property && Property->HasAnyPropertyFlags(CPF_Net))
+	{
+		MARK_PROPERTY_DIRTY(this, Property);
+	}
 }
@@ -16,6 +16,8 @@
  * Base attribute set for universal combat/resource attributes.
  * Replicates health/mana and combat stats, exposes accessors via macro,
  * and clamps/rescales values in PreAttributeChange/PostGameplayEffectExecute.
+ * Replication is push based and tiered: health/mana go to everyone, the
+ * combat stats to the owning player only.
  */
 UCLASS()
 class UCAttributeSet : public UAttributeSet
@@ -55,6 +57,9 @@ public:
      */
     virtual void PostGameplayEffectExecute(const struct FGameplayEffectModCallbackData& Data) override;
 
+    /** Marks the changed attribute dirty for push-model replication */
+    virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
+
     /** Update cached percent attributes after health changes */
     void RescaleHealth();
     /** Update cached percent attributes after mana changes */
@@ -0,0 +1,237 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GAS/CForceFieldSubsystem.h"
+#include "Engine/World.h"
+#include "Framework/CSpatialIndexSubsystem.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "Net/UnrealNetwork.h"
+
+DECLARE_CYCLE_STAT(TEXT("Force Field Update"), STAT_CForceFieldUpdate, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Force Field Characters"), STAT_CForceFieldCharacters, STATGROUP_Game);
+
+FVector FCForceField::GetCenter() const
+{
+	return IsValid(AttachActor) ? AttachActor->GetActorLocation() : FVector(Origin);
+}
+
+FVector FCForceField::Evaluate(const FVector& Location, float DeltaTime) const
+{
+	if (Type == ECForceFieldType::Directional)
+	{
+		return FVector(Direction.X, Direction.Y, 0.f) * Strength;
+	}
+
+	FVector Offset = Location - GetCenter();
+	Offset.Z = 0.f;
+	const float Distance = Offset.Size();
+	if (Distance <= UE_KINDA_SMALL_NUMBER)
+	{
+		return FVector::ZeroVector;
+	}
+
+	const FVector Outward = Offset / Distance;
+	float RadialSpeed = Strength;
+	if (RadialSpeed < 0.f && DeltaTime > 0.f)
+	{
+		RadialSpeed = FMath::Max(RadialSpeed, -Distance / DeltaTime);
+	}
+
+	FVector Velocity = Outward * RadialSpeed;
+	if (Type == ECForceFieldType::Vortex)
+	{
+		Velocity += FVector(-Outward.Y, Outward.X, 0.f) * SwirlStrength;
+	}
+	return Velocity;
+}
+
+ACForceFieldReplicator::ACForceFieldReplicator()
+{
+	bReplicates = true;
+	bAlwaysRelevant = true;
+}
+
+void ACForceFieldReplicator::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!HasAuthority())
+	{
+		if (UCForceFieldSubsystem* ForceFields = UCForceFieldSubsystem::Get(this))
+		{
+			ForceFields->SetReplicator(this);
+		}
+	}
+}
+
+void ACForceFieldReplicator::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(ACForceFieldReplicator, Fields);
+}
+
+void UCForceFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Standalone games use it as plain storage
+	if (InWorld.GetNetMode() != NM_Client)
+	{
+		Replicator = InWorld.SpawnActor<ACForceFieldReplicator>();
+	}
+}
+
+void UCForceFieldSubsystem::Deinitialize()
+{
+	FieldVelocities.Empty();
+	Replicator = nullptr;
+	Super::Deinitialize();
+}
+
+void UCForceFieldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_CForceFieldUpdate);
+	const double StartTime = FPlatformTime::Seconds();
+
+	FieldVelocities.Reset();
+	if (!Replicator)
+	{
+		LastUpdateSeconds = 0.0;
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	const bool bAuthority = World->GetNetMode() != NM_Client;
+	const float ServerTime = GetServerTime();
+	if (bAuthority)
+	{
+		const int32 NumFields = Replicator->Fields.Num();
+		Replicator->Fields.RemoveAll([this, ServerTime](const FCForceField& Field) { return IsExpired(Field, ServerTime); });
+		if (Replicator->Fields.Num() != NumFields)
+		{
+			Replicator->ForceNetUpdate();
+		}
+	}
+
+	const UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(World);
+	if (!SpatialIndex)
+	{
+		LastUpdateSeconds = FPlatformTime::Seconds() - StartTime;
+		return;
+	}
+
+	for (const FCForceField& Field : Replicator->Fields)
+	{
+		// Clients do not wait for the removal to replicate
+		if (IsExpired(Field, ServerTime))
+		{
+			continue;
+		}
+
+		FCSpatialQueryFilter Filter;
+		Filter.QuerierTeam = Field.TeamId;
+		Filter.IgnoreActor = Field.AttachActor;
+
+		AffectedPawns.Reset();
+		SpatialIndex->QueryRadius(Field.GetCenter(), Field.Radius, Filter, AffectedPawns);
+		for (APawn* Pawn : AffectedPawns)
+		{
+			if (!bAuthority && !Pawn->IsLocallyControlled())
+			{
+				continue;
+			}
+			FieldVelocities.FindOrAdd(Pawn) += Field.Evaluate(Pawn->GetActorLocation(), DeltaTime);
+		}
+	}
+
+	LastUpdateSeconds = FPlatformTime::Seconds() - StartTime;
+	SET_DWORD_STAT(STAT_CForceFieldCharacters, FieldVelocities.Num());
+}
+
+TStatId UCForceFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCForceFieldSubsystem, STATGROUP_Tickables);
+}
+
+uint16 UCForceFieldSubsystem::AddField(const FCForceField& Field)
+{
+	if (!Replicator || GetWorld()->GetNetMode() == NM_Client || Field.Radius <= 0.f)
+	{
+		return 0;
+	}
+
+	FCForceField& NewField = Replicator->Fields.Add_GetRef(Field);
+	NewField.Id = NextId++;
+	if (NextId == 0)
+	{
+		// 0 means "no field"
+		NextId = 1;
+	}
+	NewField.Direction = Field.Direction.GetSafeNormal2D(UE_SMALL_NUMBER, FVector::ForwardVector);
+	NewField.StartTime = GetServerTime();
+	Replicator->ForceNetUpdate();
+	return NewField.Id;
+}
+
+void UCForceFieldSubsystem::RemoveField(uint16 Id)
+{
+	if (Replicator && Id != 0 && Replicator->Fields.RemoveAll([Id](const FCForceField& Field) { return Field.Id == Id; }) > 0)
+	{
+		Replicator->ForceNetUpdate();
+	}
+}
+
+FVector UCForceFieldSubsystem::GetFieldVelocity(const APawn* Pawn) const
+{
+	const FVector* Velocity = Pawn ? FieldVelocities.Find(Pawn) : nullptr;
+	return Velocity ? *Velocity : FVector::ZeroVector;
+}
+
+void UCForceFieldSubsystem::SetReplicator(ACForceFieldReplicator* InReplicator)
+{
+	Replicator = InReplicator;
+}
+
+int32 UCForceFieldSubsystem::GetNumFields() const
+{
+	return Replicator ? Replicator->Fields.Num() : 0;
+}
+
+UCForceFieldSubsystem* UCForceFieldSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCForceFieldSubsystem>() : nullptr;
+}
+
+float UCForceFieldSubsystem::GetServerTime() const
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	return GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+}
+
+bool UCForceFieldSubsystem::IsExpired(const FCForceField& Field, float ServerTime) const
+{
+	return Field.Duration > 0.f && ServerTime >= Field.StartTime + Field.Duration;
+}
+
+static void ForceFieldStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UCForceFieldSubsystem* ForceFields = UCForceFieldSubsystem::Get(World);
+	if (!ForceFields)
+	{
+		Ar.Log(TEXT("Crunch.ForceFields.Stats: no force field subsystem in this world"));
+		return;
+	}
+
+	Ar.Logf(TEXT("Force fields: %d active, %d characters affected last frame"), ForceFields->GetNumFields(), ForceFields->GetLastNumAffected());
+	Ar.Logf(TEXT("  update %.1f us last frame"), ForceFields->GetLastUpdateSeconds() * 1000000.0);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice ForceFieldStatsCommand(
+	TEXT("Crunch.ForceFields.Stats"),
+	TEXT("Crunch.ForceFields.Stats: print active force fields, the characters they moved last frame and the last update cost."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&ForceFieldStats));
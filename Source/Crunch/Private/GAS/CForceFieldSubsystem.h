@@ -0,0 +1,166 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "GameFramework/Info.h"
+#include "GenericTeamAgentInterface.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+// ----------------------------------------------------------------------------
+// File: CForceFieldSubsystem.h
+// Purpose: Pull / push effects of abilities (blackhole, tornado) as force
+//          fields instead of per-actor location writes. Abilities register a
+//          field with a lifetime on the server; only the field descriptors
+//          replicate. Every frame one pass turns the fields into a velocity per
+//          affected character, which the movement components add to their own
+//          moves on the server and on the owning client alike.
+// Key API:
+//  - FCForceField: radial, directional or vortex field around a point or actor.
+//  - UCForceFieldSubsystem::AddField / RemoveField: server only.
+//  - UCForceFieldSubsystem::GetFieldVelocity: read by the movement components.
+// Notes:
+//  - Crunch.ForceFields.Stats prints the active fields, affected characters
+//    and the cost of the last pass.
+// ----------------------------------------------------------------------------
+#include "CForceFieldSubsystem.generated.h"
+
+UENUM()
+enum class ECForceFieldType : uint8
+{
+	/** Away from the center; a negative Strength pulls toward it */
+	Radial,
+	/** Along Direction, everywhere in the radius */
+	Directional,
+	/** Radial plus SwirlStrength counter-clockwise around the center */
+	Vortex
+};
+
+/** Everything needed to evaluate a field on any machine */
+USTRUCT()
+struct FCForceField
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint16 Id = 0;
+
+	UPROPERTY()
+	ECForceFieldType Type = ECForceFieldType::Radial;
+
+	/** Center, unless AttachActor is set */
+	UPROPERTY()
+	FVector_NetQuantize Origin = FVector::ZeroVector;
+
+	/** The field follows this actor while it exists */
+	UPROPERTY()
+	const AActor* AttachActor = nullptr;
+
+	/** Push direction of a directional field */
+	UPROPERTY()
+	FVector_NetQuantizeNormal Direction = FVector::ForwardVector;
+
+	UPROPERTY()
+	float Radius = 0.f;
+
+	/** cm/s */
+	UPROPERTY()
+	float Strength = 0.f;
+
+	/** cm/s, vortex only */
+	UPROPERTY()
+	float SwirlStrength = 0.f;
+
+	/** Characters hostile to this team are affected */
+	UPROPERTY()
+	FGenericTeamId TeamId = FGenericTeamId::NoTeam;
+
+	/** Server world time the field was added */
+	UPROPERTY()
+	float StartTime = 0.f;
+
+	/** Seconds; 0 lasts until RemoveField */
+	UPROPERTY()
+	float Duration = 0.f;
+
+	FVector GetCenter() const;
+
+	/** Velocity this field gives a character at Location. Pulls stop at the center instead of overshooting it within DeltaTime. */
+	FVector Evaluate(const FVector& Location, float DeltaTime) const;
+};
+
+/**
+ * ACForceFieldReplicator is spawned once by the server's UCForceFieldSubsystem
+ * and holds the active fields. A field replicates when it is added or
+ * removed; clients evaluate it themselves every frame.
+ */
+UCLASS(NotPlaceable)
+class ACForceFieldReplicator : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+	ACForceFieldReplicator();
+
+	virtual void BeginPlay() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	UPROPERTY(Replicated)
+	TArray<FCForceField> Fields;
+};
+
+/**
+ * UCForceFieldSubsystem evaluates all fields of the world in Tick. Each field
+ * queries UCSpatialIndexSubsystem for the hostile characters in its radius and
+ * adds its velocity to theirs, so a character inside several fields gets the
+ * sum. The server evaluates every character; a client only its locally
+ * controlled ones, whose moves it predicts. Others follow the server through
+ * their usual movement replication.
+ *
+ * The velocities are read during the next frame's movement: UCMinionMovementComponent
+ * adds them to its batched step, UCCharacterMovementComponent to the velocity of
+ * every (predicted) move.
+ */
+UCLASS()
+class UCForceFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Server only. Returns the field's id for RemoveField, or 0 when it could not be added. */
+	uint16 AddField(const FCForceField& Field);
+	void RemoveField(uint16 Id);
+
+	/** Sum of the field velocities of Pawn from the last pass */
+	FVector GetFieldVelocity(const APawn* Pawn) const;
+
+	/** Client side of ACForceFieldReplicator */
+	void SetReplicator(ACForceFieldReplicator* InReplicator);
+
+	int32 GetNumFields() const;
+	int32 GetLastNumAffected() const { return FieldVelocities.Num(); }
+	double GetLastUpdateSeconds() const { return LastUpdateSeconds; }
+
+	static UCForceFieldSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	float GetServerTime() const;
+	bool IsExpired(const FCForceField& Field, float ServerTime) const;
+
+	UPROPERTY()
+	ACForceFieldReplicator* Replicator = nullptr;
+
+	TMap<TObjectKey<APawn>, FVector> FieldVelocities;
+
+	/** Query scratch */
+	TArray<APawn*> AffectedPawns;
+
+	uint16 NextId = 1;
+	double LastUpdateSeconds = 0.0;
+};
@@ -51,19 +51,54 @@ AActor* UCGameplayAbility::GetAimTarget(float AimDistance, ETeamAttitude::Type T
 		TArray<FHitResult> HitResults;
 		if (GetWorld()->LineTraceMultiByObjectType(HitResults, Location, AimEnd, CollisionObjectQueryParams, CollisionQueryParams))
 		{
-			for (FHitResult& HitResult : HitResults)
-			{
-				if (IsActorTeamAttitudeIs(HitResult.GetActor(), TeamAttitude))
-				{
-					return HitResult.GetActor();
-				}
-			}
+			return PickAimTarget(HitResults, TeamAttitude);
 		}
 	}
 
 	return nullptr;
 }
 
+bool UCGameplayAbility::RequestAimTargetQuery(float AimDistance, FCTargetingQueryDelegate OnResult) const
+{
+	AActor* OwnerAvatarActor = GetAvatarActorFromActorInfo();
+	UCTargetingQuerySubsystem* Targeting = UCTargetingQuerySubsystem::Get(OwnerAvatarActor);
+	if (!OwnerAvatarActor || !Targeting)
+	{
+		return false;
+	}
+
+	FVector Location;
+	FRotator Rotation;
+	OwnerAvatarActor->GetActorEyesViewPoint(Location, Rotation);
+
+	FCTargetingQuery Query;
+	Query.Start = Location;
+	Query.End = Location + Rotation.Vector() * AimDistance;
+	Query.bMulti = true;
+	Query.bByObjectType = true;
+	Query.ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+	Query.Params = FCollisionQueryParams(SCENE_QUERY_STAT(CAimTarget), false, OwnerAvatarActor);
+
+	if (ShouldDrawDebug())
+	{
+		DrawDebugLine(GetWorld(), Query.Start, Query.End, FColor::Red, false, 2.f, 0U, 3.f);
+	}
+
+	return Targeting->RequestQuery(this, Query, MoveTemp(OnResult));
+}
+
+AActor* UCGameplayAbility::PickAimTarget(const TArray<FHitResult>& HitResults, ETeamAttitude::Type TeamAttitude) const
+{
+	for (const FHitResult& HitResult : HitResults)
+	{
+		if (IsActorTeamAttitudeIs(HitResult.GetActor(), TeamAttitude))
+		{
+			return HitResult.GetActor();
+		}
+	}
+	return nullptr;
+}
+
 UAnimInstance* UCGameplayAbility::GetOwnerAnimInstance() const
 {
 	USkeletalMeshComponent* OwnerSkeletalMeshComp = GetOwningComponentFromActorInfo();
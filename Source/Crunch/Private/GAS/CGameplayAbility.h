@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Abilities/GameplayAbility.h"
 #include "GenericTeamAgentInterface.h"
+#include "GAS/CTargetingQuerySubsystem.h"
 #include "CGameplayAbility.generated.h"
 
 /**
@@ -23,6 +24,10 @@ public:
 protected:
     /** Single-line aim to acquire a target within distance with team filter */
     AActor* GetAimTarget(float AimDistance, ETeamAttitude::Type TeamAttitude) const;
+    /** Same aim line as an async query on UCTargetingQuerySubsystem; false when skipped because the view has not moved */
+    bool RequestAimTargetQuery(float AimDistance, FCTargetingQueryDelegate OnResult) const;
+    /** First hit actor with the given attitude, for GetAimTarget and aim query results */
+    AActor* PickAimTarget(const TArray<FHitResult>& HitResults, ETeamAttitude::Type TeamAttitude) const;
     /** Retrieve owning avatar's anim instance */
     class UAnimInstance* GetOwnerAnimInstance() const;
     /** Expand target data to hit results using sweep for proximity-based effects */
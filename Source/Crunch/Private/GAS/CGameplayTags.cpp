@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GAS/CGameplayTags.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+namespace CGameplayTags
+{
+	UE_DEFINE_GAMEPLAY_TAG(Ability_BasicAttack, "ability.basicattack");
+	UE_DEFINE_GAMEPLAY_TAG(Ability_BasicAttack_Pressed, "ability.basicattack.pressed");
+	UE_DEFINE_GAMEPLAY_TAG(Ability_BasicAttack_Released, "ability.basicattack.released");
+	UE_DEFINE_GAMEPLAY_TAG(Ability_Blink_Teleport, "ability.blink.teleport");
+	UE_DEFINE_GAMEPLAY_TAG(Ability_Combo_Change, "ability.combo.change");
+	UE_DEFINE_GAMEPLAY_TAG(Ability_Combo_Change_End, "ability.combo.change.end");
+	UE_DEFINE_GAMEPLAY_TAG(Ability_Combo_Damage, "ability.combo.damage");
+	UE_DEFINE_GAMEPLAY_TAG(Ability_Dash_Start, "ability.dash.start");
+	UE_DEFINE_GAMEPLAY_TAG(Ability_Generic_Damage, "ability.generic.damage");
+	UE_DEFINE_GAMEPLAY_TAG(Ability_Generic_Target, "ability.generic.target");
+	UE_DEFINE_GAMEPLAY_TAG(Ability_Lazer_Shoot, "ability.lazer.shoot");
+	UE_DEFINE_GAMEPLAY_TAG(Ability_Passive_Launch_Activate, "ability.passive.launch.activate");
+	UE_DEFINE_GAMEPLAY_TAG(Ability_Shoot, "ability.shoot");
+	UE_DEFINE_GAMEPLAY_TAG(Ability_UpperCut_Launch, "ability.uppercut.launch");
+
+	UE_DEFINE_GAMEPLAY_TAG(Attr_Experience, "attr.experience");
+	UE_DEFINE_GAMEPLAY_TAG(Attr_Gold, "attr.gold");
+
+	UE_DEFINE_GAMEPLAY_TAG(GameplayCue_CameraShake, "GameplayCue.cameraShake");
+
+	UE_DEFINE_GAMEPLAY_TAG(Role_Hero, "role.hero");
+
+	UE_DEFINE_GAMEPLAY_TAG(Stats_Aim, "stats.aim");
+	UE_DEFINE_GAMEPLAY_TAG(Stats_Crosshair, "stats.crosshair");
+	UE_DEFINE_GAMEPLAY_TAG(Stats_Dead, "stats.dead");
+	UE_DEFINE_GAMEPLAY_TAG(Stats_Focus, "stats.focus");
+	UE_DEFINE_GAMEPLAY_TAG(Stats_Health_Empty, "stats.health.empty");
+	UE_DEFINE_GAMEPLAY_TAG(Stats_Health_Full, "stats.health.full");
+	UE_DEFINE_GAMEPLAY_TAG(Stats_Mana_Empty, "stats.mana.empty");
+	UE_DEFINE_GAMEPLAY_TAG(Stats_Mana_Full, "stats.mana.full");
+	UE_DEFINE_GAMEPLAY_TAG(Stats_Stun, "stats.stun");
+
+	UE_DEFINE_GAMEPLAY_TAG(Target_Updated, "target.updated");
+}
+
+static void TagBenchmark(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000000;
+
+	// The first local player's tags when there is one, as IsActorDead sees them; otherwise a typical state set
+	FGameplayTagContainer OwnedTags;
+	const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	if (const UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(PlayerController ? PlayerController->GetPawn() : nullptr))
+	{
+		ASC->GetOwnedGameplayTags(OwnedTags);
+	}
+	else
+	{
+		OwnedTags.AddTag(CGameplayTags::Role_Hero);
+		OwnedTags.AddTag(CGameplayTags::Stats_Health_Full);
+		OwnedTags.AddTag(CGameplayTags::Stats_Mana_Full);
+	}
+
+	int32 NumMatches = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < Iterations; ++Index)
+	{
+		NumMatches += OwnedTags.HasTag(FGameplayTag::RequestGameplayTag("stats.dead")) ? 1 : 0;
+	}
+	const double RequestSeconds = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < Iterations; ++Index)
+	{
+		NumMatches += OwnedTags.HasTag(CGameplayTags::Stats_Dead) ? 1 : 0;
+	}
+	const double NativeSeconds = FPlatformTime::Seconds() - StartTime;
+
+	Ar.Logf(TEXT("Tag checks against %d owned tags, %d iterations (%d matches)"), OwnedTags.Num(), Iterations, NumMatches);
+	Ar.Logf(TEXT("  RequestGameplayTag: %.2f M checks/s"), Iterations / FMath::Max(RequestSeconds, UE_SMALL_NUMBER) / 1000000.0);
+	Ar.Logf(TEXT("  native tag:         %.2f M checks/s"), Iterations / FMath::Max(NativeSeconds, UE_SMALL_NUMBER) / 1000000.0);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice TagBenchmarkCommand(
+	TEXT("Crunch.Tags.Benchmark"),
+	TEXT("Crunch.Tags.Benchmark [Iterations]: time \"is dead\" tag checks through RequestGameplayTag and through the native tag."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&TagBenchmark));
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NativeGameplayTags.h"
+// ----------------------------------------------------------------------------
+// File: CGameplayTags.h
+// Purpose: Every gameplay tag the C++ code refers to, as native tags. They are
+//          registered with the tag manager when the module loads and resolved
+//          once, so reading one is a plain copy instead of a
+//          RequestGameplayTag name lookup.
+// Key API:
+//  - CGameplayTags::<Category>_<Name>: converts to FGameplayTag.
+// Notes:
+//  - The tags also stay listed in Config/DefaultGameplayTags.ini with their
+//    comments; registering a tag from both places is fine.
+//  - The Get*Tag accessors of UCAbilitySystemStatics and the abilities return
+//    these, so callers did not change.
+//  - Crunch.Tags.Benchmark [Iterations] compares tag checks per second through
+//    RequestGameplayTag and through the native tags.
+// ----------------------------------------------------------------------------
+
+namespace CGameplayTags
+{
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_BasicAttack);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_BasicAttack_Pressed);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_BasicAttack_Released);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Blink_Teleport);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Combo_Change);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Combo_Change_End);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Combo_Damage);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Dash_Start);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Generic_Damage);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Generic_Target);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Lazer_Shoot);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Passive_Launch_Activate);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Shoot);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_UpperCut_Launch);
+
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Attr_Experience);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Attr_Gold);
+
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayCue_CameraShake);
+
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Role_Hero);
+
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Stats_Aim);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Stats_Crosshair);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Stats_Dead);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Stats_Focus);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Stats_Health_Empty);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Stats_Health_Full);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Stats_Mana_Empty);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Stats_Mana_Full);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Stats_Stun);
+
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Target_Updated);
+}
@@ -2,6 +2,7 @@
 
 
 #include "GAS/CHeroAttributeSet.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Net/UnrealNetwork.h"
 #include "GameplayEffectExtension.h"
 
@@ -9,16 +10,40 @@ void UCHeroAttributeSet::GetLifetimeReplicatedProps(TArray<class FLifetimeProper
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION_NOTIFY(UCHeroAttributeSet, Intelligence, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCHeroAttributeSet, Strength, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCHeroAttributeSet, Experience, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCHeroAttributeSet, PrevLevelExperience, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCHeroAttributeSet, NextLevelExperience, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCHeroAttributeSet, Level, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCHeroAttributeSet, UpgradePoint, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCHeroAttributeSet, MaxLevel, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCHeroAttributeSet, MaxLevelExperience, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UCHeroAttributeSet, Gold, COND_None, REPNOTIFY_Always);
+	// Push model: a property is only compared when PostAttributeChange marked it dirty
+	FDoRepLifetimeParams PublicParams;
+	PublicParams.Condition = COND_None;
+	PublicParams.RepNotifyCondition = REPNOTIFY_Always;
+	PublicParams.bIsPushBased = true;
+
+	FDoRepLifetimeParams OwnerParams = PublicParams;
+	OwnerParams.Condition = COND_OwnerOnly;
+
+	// Everyone: a hero's level is public in a match
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCHeroAttributeSet, Level, PublicParams);
+
+	// The owning player only: stats panel, level gauge, upgrades and shop.
+	// The growth rates are server-side inputs and do not replicate at all.
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCHeroAttributeSet, Intelligence, OwnerParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCHeroAttributeSet, Strength, OwnerParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCHeroAttributeSet, Experience, OwnerParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCHeroAttributeSet, PrevLevelExperience, OwnerParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCHeroAttributeSet, NextLevelExperience, OwnerParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCHeroAttributeSet, UpgradePoint, OwnerParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCHeroAttributeSet, MaxLevel, OwnerParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCHeroAttributeSet, MaxLevelExperience, OwnerParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UCHeroAttributeSet, Gold, OwnerParams);
+}
+
+void UCHeroAttributeSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
+{
+	Super::PostAttributeChange(Attribute, OldValue, NewValue);
+
+	const FProperty* Property = Attribute.GetUProperty();
+	if (Property && Property->HasAnyPropertyFlags(CPF_Net))
+	{
+		MARK_PROPERTY_DIRTY(this, Property);
+	}
 }
 
 void UCHeroAttributeSet::OnRep_Intelligence(const FGameplayAttributeData& OldValue)
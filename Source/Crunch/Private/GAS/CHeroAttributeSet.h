@@ -15,7 +15,8 @@
 /**
  * Attribute set for hero-specific progression and economy stats.
  * Includes Intelligence/Strength and growth, XP/Level ladders, gold, and
- * upgrade points. Replicated with OnRep hooks for UI/reactivity.
+ * upgrade points. Replicated with OnRep hooks for UI/reactivity, push based:
+ * the level goes to everyone, everything else to the owning player only.
  */
 UCLASS()
 class UCHeroAttributeSet : public UAttributeSet
@@ -36,6 +37,8 @@ public:
     ATTRIBUTE_ACCESSORS(UCHeroAttributeSet, StrengthGrowthRate)
     ATTRIBUTE_ACCESSORS(UCHeroAttributeSet, IntelligenceGrowthRate)
     virtual void GetLifetimeReplicatedProps( TArray< class FLifetimeProperty > & OutLifetimeProps ) const override;
+    /** Marks the changed attribute dirty for push-model replication */
+    virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
 private:
     /** Core hero stats */
     UPROPERTY(ReplicatedUsing = OnRep_Intelligence)
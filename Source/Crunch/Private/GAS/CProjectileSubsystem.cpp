@@ -0,0 +1,389 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GAS/CProjectileSubsystem.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameplayCueManager.h"
+#include "GAS/ProjectileActor.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Update"), STAT_CProjectileUpdate, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectiles Active"), STAT_CProjectilesActive, STATGROUP_Game);
+
+/** Clients skip at most this much of a projectile's flight to catch up with the server */
+static constexpr float ProjectileMaxFastForward = 0.5f;
+
+ACProjectileReplicator::ACProjectileReplicator()
+{
+	bReplicates = true;
+	bAlwaysRelevant = true;
+}
+
+void ACProjectileReplicator::Multicast_Launch_Implementation(const FCProjectileLaunch& Launch)
+{
+	// The server simulates its own projectiles
+	if (HasAuthority())
+	{
+		return;
+	}
+
+	if (UCProjectileSubsystem* Projectiles = UCProjectileSubsystem::Get(this))
+	{
+		Projectiles->AddRemoteProjectile(Launch);
+	}
+}
+
+void ACProjectileReplicator::Multicast_Impact_Implementation(uint16 Id, AActor* HitActor, FVector_NetQuantize Location)
+{
+	if (HasAuthority())
+	{
+		return;
+	}
+
+	if (UCProjectileSubsystem* Projectiles = UCProjectileSubsystem::Get(this))
+	{
+		Projectiles->RemoteImpact(Id, HitActor, Location);
+	}
+}
+
+void UCProjectileSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const ENetMode NetMode = InWorld.GetNetMode();
+	if (NetMode == NM_ListenServer || NetMode == NM_DedicatedServer)
+	{
+		Replicator = InWorld.SpawnActor<ACProjectileReplicator>();
+	}
+}
+
+void UCProjectileSubsystem::Deinitialize()
+{
+	Projectiles.Empty();
+	FreeVisuals.Empty();
+	Replicator = nullptr;
+	Super::Deinitialize();
+}
+
+void UCProjectileSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_CProjectileUpdate);
+	const double StartTime = FPlatformTime::Seconds();
+
+	const bool bAuthority = GetWorld()->GetNetMode() != NM_Client;
+	for (int32 Index = Projectiles.Num() - 1; Index >= 0; --Index)
+	{
+		FProjectile& Projectile = Projectiles[Index];
+		const FVector Start = Projectile.Location;
+		const float Step = FMath::Min(Projectile.Speed * DeltaTime, Projectile.RemainingDistance);
+		Advance(Projectile, Step);
+
+		if (bAuthority)
+		{
+			FHitResult Hit;
+			if (AActor* HitActor = SweepForHit(Projectile, Start, Hit))
+			{
+				ApplyHit(Projectile, HitActor, Hit.Location);
+				RemoveProjectile(Index);
+				continue;
+			}
+		}
+
+		if (Projectile.RemainingDistance <= 0.f)
+		{
+			RemoveProjectile(Index);
+			continue;
+		}
+
+		if (AProjectileActor* Visual = Projectile.Visual.Get())
+		{
+			Visual->SetActorLocationAndRotation(Projectile.Location, Projectile.Direction.Rotation());
+		}
+	}
+
+	LastUpdateSeconds = FPlatformTime::Seconds() - StartTime;
+	SET_DWORD_STAT(STAT_CProjectilesActive, Projectiles.Num());
+}
+
+TStatId UCProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCProjectileSubsystem, STATGROUP_Tickables);
+}
+
+void UCProjectileSubsystem::LaunchProjectile(TSubclassOf<AProjectileActor> ProjectileClass, AActor* Instigator, const FVector& Origin, const FVector& Direction,
+	float Speed, float MaxDistance, const AActor* Target, FGenericTeamId TeamId, const FGameplayEffectSpecHandle& HitEffect)
+{
+	if (!ProjectileClass || Speed <= 0.f || MaxDistance <= 0.f)
+	{
+		return;
+	}
+
+	FCProjectileLaunch Launch;
+	Launch.Id = NextId++;
+	Launch.ProjectileClass = ProjectileClass;
+	Launch.Origin = Origin;
+	Launch.Direction = Direction.GetSafeNormal();
+	Launch.Speed = FMath::Clamp(FMath::RoundToInt32(Speed), 1, int32(MAX_uint16));
+	Launch.MaxDistance = FMath::Clamp(FMath::RoundToInt32(MaxDistance), 1, int32(MAX_uint16));
+	Launch.Target = Target;
+	if (const AGameStateBase* GameState = GetWorld()->GetGameState())
+	{
+		Launch.LaunchTime = GameState->GetServerWorldTimeSeconds();
+	}
+
+	// Simulate what clients receive, so both sides fly the same path
+	FProjectile& Projectile = Projectiles.AddDefaulted_GetRef();
+	Projectile.Id = Launch.Id;
+	Projectile.Location = Launch.Origin;
+	Projectile.Direction = Launch.Direction;
+	Projectile.Speed = Launch.Speed;
+	Projectile.RemainingDistance = Launch.MaxDistance;
+	Projectile.Radius = ProjectileClass->GetDefaultObject<AProjectileActor>()->GetCollisionRadius();
+	Projectile.TeamId = TeamId;
+	Projectile.Target = Target;
+	Projectile.Instigator = Instigator;
+	Projectile.ProjectileClass = ProjectileClass;
+	Projectile.HitEffect = HitEffect;
+	if (HasVisuals())
+	{
+		Projectile.Visual = AcquireVisual(ProjectileClass, Projectile.Location, Projectile.Direction);
+	}
+	++NumLaunched;
+
+	if (Replicator)
+	{
+		Replicator->Multicast_Launch(Launch);
+	}
+}
+
+void UCProjectileSubsystem::AddRemoteProjectile(const FCProjectileLaunch& Launch)
+{
+	if (!Launch.ProjectileClass)
+	{
+		return;
+	}
+
+	FProjectile& Projectile = Projectiles.AddDefaulted_GetRef();
+	Projectile.Id = Launch.Id;
+	Projectile.Location = Launch.Origin;
+	Projectile.Direction = Launch.Direction;
+	Projectile.Speed = Launch.Speed;
+	Projectile.RemainingDistance = Launch.MaxDistance;
+	Projectile.Target = Launch.Target;
+	Projectile.ProjectileClass = Launch.ProjectileClass;
+
+	// Catch up with the server's copy, which has been flying for the latency
+	if (const AGameStateBase* GameState = GetWorld()->GetGameState())
+	{
+		const float Elapsed = FMath::Clamp(float(GameState->GetServerWorldTimeSeconds() - Launch.LaunchTime), 0.f, ProjectileMaxFastForward);
+		Advance(Projectile, FMath::Min(Projectile.Speed * Elapsed, Projectile.RemainingDistance));
+	}
+
+	Projectile.Visual = AcquireVisual(Projectile.ProjectileClass, Projectile.Location, Projectile.Direction);
+	++NumLaunched;
+}
+
+void UCProjectileSubsystem::RemoteImpact(uint16 Id, AActor* HitActor, const FVector& Location)
+{
+	const int32 Index = Projectiles.IndexOfByPredicate([Id](const FProjectile& Projectile) { return Projectile.Id == Id; });
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (HitActor)
+	{
+		PlayHitCue(Projectiles[Index].ProjectileClass, HitActor, Location, Projectiles[Index].Direction);
+	}
+	RemoveProjectile(Index);
+}
+
+UCProjectileSubsystem* UCProjectileSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCProjectileSubsystem>() : nullptr;
+}
+
+void UCProjectileSubsystem::Advance(FProjectile& Projectile, float Distance)
+{
+	if (const AActor* Target = Projectile.Target.Get())
+	{
+		Projectile.Direction = (Target->GetActorLocation() - Projectile.Location).GetSafeNormal(UE_SMALL_NUMBER, Projectile.Direction);
+	}
+
+	Projectile.Location += Projectile.Direction * Distance;
+	Projectile.RemainingDistance -= Distance;
+}
+
+AActor* UCProjectileSubsystem::SweepForHit(const FProjectile& Projectile, const FVector& Start, FHitResult& OutHit) const
+{
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(CProjectileSweep), false);
+	Params.AddIgnoredActor(Projectile.Instigator.Get());
+
+	TArray<FHitResult> Hits;
+	GetWorld()->SweepMultiByObjectType(Hits, Start, Projectile.Location, FQuat::Identity, FCollisionObjectQueryParams(ECC_Pawn), FCollisionShape::MakeSphere(Projectile.Radius), Params);
+
+	for (const FHitResult& Hit : Hits)
+	{
+		AActor* HitActor = Hit.GetActor();
+		if (!HitActor || FGenericTeamId::GetAttitude(Projectile.TeamId, FGenericTeamId::GetTeamIdentifier(HitActor)) != ETeamAttitude::Hostile)
+		{
+			continue;
+		}
+
+		if (IsValid(UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(HitActor)))
+		{
+			OutHit = Hit;
+			return HitActor;
+		}
+	}
+	return nullptr;
+}
+
+void UCProjectileSubsystem::ApplyHit(const FProjectile& Projectile, AActor* HitActor, const FVector& Location)
+{
+	UAbilitySystemComponent* HitASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(HitActor);
+	if (HitASC && Projectile.HitEffect.IsValid())
+	{
+		HitASC->ApplyGameplayEffectSpecToSelf(*Projectile.HitEffect.Data.Get());
+	}
+
+	PlayHitCue(Projectile.ProjectileClass, HitActor, Location, Projectile.Direction);
+
+	if (Replicator)
+	{
+		Replicator->Multicast_Impact(Projectile.Id, HitActor, Location);
+	}
+}
+
+void UCProjectileSubsystem::PlayHitCue(const TSubclassOf<AProjectileActor>& ProjectileClass, AActor* HitActor, const FVector& Location, const FVector& Normal) const
+{
+	const FGameplayTag& CueTag = ProjectileClass->GetDefaultObject<AProjectileActor>()->GetHitGameplayCueTag();
+	if (!CueTag.IsValid())
+	{
+		return;
+	}
+
+	FGameplayCueParameters CueParams;
+	CueParams.Location = Location;
+	CueParams.Normal = Normal;
+
+	UAbilitySystemGlobals::Get().GetGameplayCueManager()->HandleGameplayCue(HitActor, CueTag, EGameplayCueEvent::Executed, CueParams);
+}
+
+AProjectileActor* UCProjectileSubsystem::AcquireVisual(const TSubclassOf<AProjectileActor>& ProjectileClass, const FVector& Location, const FVector& Direction)
+{
+	AProjectileActor* Visual = nullptr;
+	for (int32 Index = FreeVisuals.Num() - 1; Index >= 0; --Index)
+	{
+		if (!IsValid(FreeVisuals[Index]))
+		{
+			FreeVisuals.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+		else if (FreeVisuals[Index]->GetClass() == ProjectileClass)
+		{
+			Visual = FreeVisuals[Index];
+			FreeVisuals.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			break;
+		}
+	}
+
+	if (!Visual)
+	{
+		// Deferred, so the proxy is set up before it registers: it never replicates, ticks or overlaps, not even on its first frame
+		const FTransform SpawnTransform(Direction.Rotation(), Location);
+		Visual = GetWorld()->SpawnActorDeferred<AProjectileActor>(ProjectileClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (!Visual)
+		{
+			return nullptr;
+		}
+		Visual->InitVisualProxy();
+		Visual->FinishSpawning(SpawnTransform);
+		++NumVisualsSpawned;
+	}
+	else
+	{
+		Visual->SetActorLocationAndRotation(Location, Direction.Rotation(), false, nullptr, ETeleportType::TeleportPhysics);
+	}
+
+	Visual->SetVisualActive(true);
+	return Visual;
+}
+
+void UCProjectileSubsystem::ReleaseVisual(FProjectile& Projectile)
+{
+	if (AProjectileActor* Visual = Projectile.Visual.Get())
+	{
+		Visual->SetVisualActive(false);
+		FreeVisuals.Add(Visual);
+	}
+	Projectile.Visual.Reset();
+}
+
+void UCProjectileSubsystem::RemoveProjectile(int32 Index)
+{
+	ReleaseVisual(Projectiles[Index]);
+	Projectiles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+bool UCProjectileSubsystem::HasVisuals() const
+{
+	return GetWorld()->GetNetMode() != NM_DedicatedServer;
+}
+
+static void ProjectileStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UCProjectileSubsystem* Projectiles = UCProjectileSubsystem::Get(World);
+	if (!Projectiles)
+	{
+		Ar.Log(TEXT("Crunch.Projectiles.Stats: no projectile subsystem in this world"));
+		return;
+	}
+
+	Ar.Logf(TEXT("Projectiles: %d active, %d launched"), Projectiles->GetNumActive(), Projectiles->GetNumLaunched());
+	Ar.Logf(TEXT("  visuals: %d spawned in total, %d free in the pool"), Projectiles->GetNumVisualsSpawned(), Projectiles->GetNumFreeVisuals());
+	Ar.Logf(TEXT("  update %.1f us last frame"), Projectiles->GetLastUpdateSeconds() * 1000000.0);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice ProjectileStatsCommand(
+	TEXT("Crunch.Projectiles.Stats"),
+	TEXT("Crunch.Projectiles.Stats: print active projectiles, how many visual actors were ever spawned and the last update cost."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&ProjectileStats));
+
+static void ProjectileStress(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UCProjectileSubsystem* Projectiles = UCProjectileSubsystem::Get(World);
+	const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+	if (!Projectiles || !Pawn || World->GetNetMode() == NM_Client)
+	{
+		Ar.Log(TEXT("Crunch.Projectiles.Stress: needs a server or standalone world with a local player pawn"));
+		return;
+	}
+
+	const int32 Count = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 500;
+	const FGenericTeamId TeamId = FGenericTeamId::GetTeamIdentifier(Pawn);
+
+	// A ring around the player, without hit effects
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const float Yaw = 360.f * Index / Count;
+		Projectiles->LaunchProjectile(AProjectileActor::StaticClass(), Pawn, Pawn->GetActorLocation(), FRotator(0.f, Yaw, 0.f).Vector(),
+			1000.f, 5000.f, nullptr, TeamId, FGameplayEffectSpecHandle());
+	}
+
+	Ar.Logf(TEXT("Crunch.Projectiles.Stress: launched %d projectiles, %d active"), Count, Projectiles->GetNumActive());
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice ProjectileStressCommand(
+	TEXT("Crunch.Projectiles.Stress"),
+	TEXT("Crunch.Projectiles.Stress [Count]: fire Count projectiles (500 by default) in a ring around the local player. Follow with Crunch.Projectiles.Stats."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&ProjectileStress));
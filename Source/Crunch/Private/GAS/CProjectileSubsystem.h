@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "GameFramework/Info.h"
+#include "GameplayEffectTypes.h"
+#include "GenericTeamAgentInterface.h"
+#include "Subsystems/WorldSubsystem.h"
+// ----------------------------------------------------------------------------
+// File: CProjectileSubsystem.h
+// Purpose: Projectiles without an actor per shot. The server keeps every live
+//          projectile in one flat array, sweeps them all in a single update and
+//          applies hit effects; clients receive a compact launch event and run
+//          the same simulation for visuals, which come from a local pool of
+//          AProjectileActor instances.
+// Key API:
+//  - UCProjectileSubsystem::LaunchProjectile: fire a projectile (server).
+//  - ACProjectileReplicator: one always relevant actor carrying launch/impact RPCs.
+// Notes:
+//  - Crunch.Projectiles.Stats prints the active count, pool size and update cost;
+//    Crunch.Projectiles.Stress fires a ring of projectiles (500 by default).
+// ----------------------------------------------------------------------------
+#include "CProjectileSubsystem.generated.h"
+
+class AProjectileActor;
+
+/** Everything a client needs to simulate a projectile, sent once per shot */
+USTRUCT()
+struct FCProjectileLaunch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint16 Id = 0;
+
+	/** Visual class; its defaults also give the hit cue */
+	UPROPERTY()
+	TSubclassOf<AProjectileActor> ProjectileClass;
+
+	UPROPERTY()
+	FVector_NetQuantize Origin = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector_NetQuantizeNormal Direction = FVector::ForwardVector;
+
+	/** Whole cm/s and cm */
+	UPROPERTY()
+	uint16 Speed = 0;
+
+	UPROPERTY()
+	uint16 MaxDistance = 0;
+
+	/** Homing target, null for a straight shot */
+	UPROPERTY()
+	const AActor* Target = nullptr;
+
+	/** Server world time of the launch; clients fast-forward by the difference */
+	UPROPERTY()
+	float LaunchTime = 0.f;
+};
+
+/**
+ * ACProjectileReplicator is spawned once by the server's UCProjectileSubsystem
+ * in networked games. Launches and impacts are unreliable multicasts: a lost
+ * launch only loses a visual, a lost impact lets the visual fly to its max
+ * distance.
+ */
+UCLASS(NotPlaceable)
+class ACProjectileReplicator : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+	ACProjectileReplicator();
+
+	UFUNCTION(NetMulticast, Unreliable)
+	void Multicast_Launch(const FCProjectileLaunch& Launch);
+
+	UFUNCTION(NetMulticast, Unreliable)
+	void Multicast_Impact(uint16 Id, AActor* HitActor, FVector_NetQuantize Location);
+};
+
+/**
+ * UCProjectileSubsystem advances all projectiles of the world in Tick:
+ *  - Server: steer homing projectiles, sweep a sphere of the class's
+ *    CollisionRadius along the step against pawns, and on the first hostile
+ *    pawn with an ASC apply the hit effect, play the hit cue and multicast the
+ *    impact. Projectiles end at their max distance.
+ *  - Client: move launched projectiles the same way without sweeping; impacts
+ *    come from the server.
+ * Visuals (not on a dedicated server) are AProjectileActor instances of the
+ * launch's class, spawned once and then recycled hidden.
+ */
+UCLASS()
+class UCProjectileSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Server only. Instigator is ignored by the sweep and never hit. */
+	void LaunchProjectile(TSubclassOf<AProjectileActor> ProjectileClass, AActor* Instigator, const FVector& Origin, const FVector& Direction,
+		float Speed, float MaxDistance, const AActor* Target, FGenericTeamId TeamId, const FGameplayEffectSpecHandle& HitEffect);
+
+	/** Client side of ACProjectileReplicator */
+	void AddRemoteProjectile(const FCProjectileLaunch& Launch);
+	void RemoteImpact(uint16 Id, AActor* HitActor, const FVector& Location);
+
+	int32 GetNumActive() const { return Projectiles.Num(); }
+	int32 GetNumVisualsSpawned() const { return NumVisualsSpawned; }
+	int32 GetNumFreeVisuals() const { return FreeVisuals.Num(); }
+	int32 GetNumLaunched() const { return NumLaunched; }
+	double GetLastUpdateSeconds() const { return LastUpdateSeconds; }
+
+	static UCProjectileSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	struct FProjectile
+	{
+		uint16 Id = 0;
+		FVector Location = FVector::ZeroVector;
+		FVector Direction = FVector::ForwardVector;
+		float Speed = 0.f;
+		float RemainingDistance = 0.f;
+		float Radius = 0.f;
+		FGenericTeamId TeamId;
+		TWeakObjectPtr<const AActor> Target;
+		TWeakObjectPtr<AActor> Instigator;
+		TSubclassOf<AProjectileActor> ProjectileClass;
+		TWeakObjectPtr<AProjectileActor> Visual;
+		FGameplayEffectSpecHandle HitEffect;
+	};
+
+	/** Move one projectile by Distance, steering toward its target */
+	static void Advance(FProjectile& Projectile, float Distance);
+
+	/** Server: first hostile pawn with an ASC between Start and the projectile's location, or null */
+	AActor* SweepForHit(const FProjectile& Projectile, const FVector& Start, FHitResult& OutHit) const;
+
+	void ApplyHit(const FProjectile& Projectile, AActor* HitActor, const FVector& Location);
+	void PlayHitCue(const TSubclassOf<AProjectileActor>& ProjectileClass, AActor* HitActor, const FVector& Location, const FVector& Normal) const;
+
+	AProjectileActor* AcquireVisual(const TSubclassOf<AProjectileActor>& ProjectileClass, const FVector& Location, const FVector& Direction);
+	void ReleaseVisual(FProjectile& Projectile);
+	void RemoveProjectile(int32 Index);
+
+	bool HasVisuals() const;
+
+	TArray<FProjectile> Projectiles;
+
+	UPROPERTY()
+	TArray<AProjectileActor*> FreeVisuals;
+
+	UPROPERTY()
+	ACProjectileReplicator* Replicator = nullptr;
+
+	uint16 NextId = 0;
+	int32 NumVisualsSpawned = 0;
+	int32 NumLaunched = 0;
+	double LastUpdateSeconds = 0.0;
+};
@@ -0,0 +1,234 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GAS/CTargetingQuerySubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Targeting Queries Issued"), STAT_CTargetingQueriesIssued, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Targeting Queries Skipped"), STAT_CTargetingQueriesSkipped, STATGROUP_Game);
+
+static TAutoConsoleVariable<bool> CVarTargetingAsync(
+	TEXT("Crunch.Targeting.Async"),
+	true,
+	TEXT("Run targeting queries as async traces answered next frame. 0 runs them synchronously when the batch is issued."));
+
+static TAutoConsoleVariable<float> CVarTargetingMoveThreshold(
+	TEXT("Crunch.Targeting.MoveThreshold"),
+	5.f,
+	TEXT("A targeting query starting closer than this to the requester's last one can be skipped."));
+
+static TAutoConsoleVariable<float> CVarTargetingAngleThreshold(
+	TEXT("Crunch.Targeting.AngleThreshold"),
+	0.5f,
+	TEXT("Degrees a targeting query may turn from the requester's last one and still be skipped."));
+
+static TAutoConsoleVariable<float> CVarTargetingMaxSkipTime(
+	TEXT("Crunch.Targeting.MaxSkipTime"),
+	0.25f,
+	TEXT("Seconds after which a requester's query is issued again even if its view has not moved, so moving targets are picked up."));
+
+void UCTargetingQuerySubsystem::Deinitialize()
+{
+	Queue.Empty();
+	LastViews.Empty();
+	InFlight.Empty();
+	Super::Deinitialize();
+}
+
+void UCTargetingQuerySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Views too old to skip a query are only memory
+	const double Now = GetWorld()->GetTimeSeconds();
+	const float MaxSkipTime = CVarTargetingMaxSkipTime.GetValueOnGameThread();
+	for (TMap<FObjectKey, FLastView>::TIterator It = LastViews.CreateIterator(); It; ++It)
+	{
+		if (Now - It->Value.Time >= MaxSkipTime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (Queue.Num() == 0)
+	{
+		return;
+	}
+
+	// Callbacks may queue again; they land in the next batch
+	TArray<FQueuedQuery> Batch = MoveTemp(Queue);
+	Queue.Reset();
+
+	const bool bAsync = CVarTargetingAsync.GetValueOnGameThread();
+	for (FQueuedQuery& Queued : Batch)
+	{
+		if (bAsync)
+		{
+			Issue(Queued);
+		}
+		else
+		{
+			RunSynchronously(Queued);
+		}
+	}
+
+	NumIssued += Batch.Num();
+	INC_DWORD_STAT_BY(STAT_CTargetingQueriesIssued, Batch.Num());
+}
+
+TStatId UCTargetingQuerySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCTargetingQuerySubsystem, STATGROUP_Tickables);
+}
+
+bool UCTargetingQuerySubsystem::RequestQuery(const UObject* Requester, const FCTargetingQuery& Query, FCTargetingQueryDelegate OnResult, bool bSkipIfUnchanged)
+{
+	++NumRequested;
+
+	const FObjectKey RequesterKey(Requester);
+	if (bSkipIfUnchanged)
+	{
+		const FVector Direction = (Query.End - Query.Start).GetSafeNormal();
+		const double Now = GetWorld()->GetTimeSeconds();
+
+		FLastView& LastView = LastViews.FindOrAdd(RequesterKey);
+		const bool bUnchanged = LastView.Time > 0.0
+			&& Now - LastView.Time < CVarTargetingMaxSkipTime.GetValueOnGameThread()
+			&& FVector::DistSquared(Query.Start, LastView.Start) < FMath::Square(CVarTargetingMoveThreshold.GetValueOnGameThread())
+			&& (Direction | LastView.Direction) > FMath::Cos(FMath::DegreesToRadians(CVarTargetingAngleThreshold.GetValueOnGameThread()));
+		if (bUnchanged)
+		{
+			++NumSkipped;
+			INC_DWORD_STAT(STAT_CTargetingQueriesSkipped);
+			return false;
+		}
+
+		LastView.Start = Query.Start;
+		LastView.Direction = Direction;
+		LastView.Time = Now;
+	}
+
+	if (FQueuedQuery* Existing = Queue.FindByPredicate([&RequesterKey](const FQueuedQuery& Queued) { return Queued.Requester == RequesterKey; }))
+	{
+		Existing->Query = Query;
+		Existing->OnResult = MoveTemp(OnResult);
+		return true;
+	}
+
+	FQueuedQuery& Queued = Queue.AddDefaulted_GetRef();
+	Queued.Requester = RequesterKey;
+	Queued.Query = Query;
+	Queued.OnResult = MoveTemp(OnResult);
+	return true;
+}
+
+void UCTargetingQuerySubsystem::CancelQueries(const UObject* Requester)
+{
+	const FObjectKey RequesterKey(Requester);
+	Queue.RemoveAllSwap([&RequesterKey](const FQueuedQuery& Queued) { return Queued.Requester == RequesterKey; }, EAllowShrinking::No);
+	LastViews.Remove(RequesterKey);
+}
+
+UCTargetingQuerySubsystem* UCTargetingQuerySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCTargetingQuerySubsystem>() : nullptr;
+}
+
+void UCTargetingQuerySubsystem::Issue(FQueuedQuery& Queued)
+{
+	if (!TraceDelegate.IsBound())
+	{
+		TraceDelegate.BindUObject(this, &UCTargetingQuerySubsystem::OnTraceDone);
+	}
+
+	const uint32 UserData = NextUserData++;
+	InFlight.Add(UserData, MoveTemp(Queued.OnResult));
+
+	UWorld* World = GetWorld();
+	const FCTargetingQuery& Query = Queued.Query;
+	const EAsyncTraceType TraceType = Query.bMulti ? EAsyncTraceType::Multi : EAsyncTraceType::Single;
+	if (Query.Radius > 0.f)
+	{
+		const FCollisionShape Sphere = FCollisionShape::MakeSphere(Query.Radius);
+		if (Query.bByObjectType)
+		{
+			World->AsyncSweepByObjectType(TraceType, Query.Start, Query.End, FQuat::Identity, Query.ObjectParams, Sphere, Query.Params, &TraceDelegate, UserData);
+		}
+		else
+		{
+			World->AsyncSweepByChannel(TraceType, Query.Start, Query.End, FQuat::Identity, Query.Channel, Sphere, Query.Params, Query.ResponseParams, &TraceDelegate, UserData);
+		}
+	}
+	else if (Query.bByObjectType)
+	{
+		World->AsyncLineTraceByObjectType(TraceType, Query.Start, Query.End, Query.ObjectParams, Query.Params, &TraceDelegate, UserData);
+	}
+	else
+	{
+		World->AsyncLineTraceByChannel(TraceType, Query.Start, Query.End, Query.Channel, Query.Params, Query.ResponseParams, &TraceDelegate, UserData);
+	}
+}
+
+void UCTargetingQuerySubsystem::RunSynchronously(FQueuedQuery& Queued)
+{
+	UWorld* World = GetWorld();
+	const FCTargetingQuery& Query = Queued.Query;
+	const FCollisionShape Shape = Query.Radius > 0.f ? FCollisionShape::MakeSphere(Query.Radius) : FCollisionShape();
+
+	TArray<FHitResult> Hits;
+	if (Query.bMulti)
+	{
+		if (Query.bByObjectType)
+		{
+			World->SweepMultiByObjectType(Hits, Query.Start, Query.End, FQuat::Identity, Query.ObjectParams, Shape, Query.Params);
+		}
+		else
+		{
+			World->SweepMultiByChannel(Hits, Query.Start, Query.End, FQuat::Identity, Query.Channel, Shape, Query.Params, Query.ResponseParams);
+		}
+	}
+	else
+	{
+		FHitResult Hit;
+		const bool bHit = Query.bByObjectType
+			? World->SweepSingleByObjectType(Hit, Query.Start, Query.End, FQuat::Identity, Query.ObjectParams, Shape, Query.Params)
+			: World->SweepSingleByChannel(Hit, Query.Start, Query.End, FQuat::Identity, Query.Channel, Shape, Query.Params, Query.ResponseParams);
+		if (bHit)
+		{
+			Hits.Add(Hit);
+		}
+	}
+
+	Queued.OnResult.ExecuteIfBound(Hits);
+}
+
+void UCTargetingQuerySubsystem::OnTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	FCTargetingQueryDelegate OnResult;
+	if (InFlight.RemoveAndCopyValue(Datum.UserData, OnResult))
+	{
+		OnResult.ExecuteIfBound(Datum.OutHits);
+	}
+}
+
+static void TargetingStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UCTargetingQuerySubsystem* Targeting = UCTargetingQuerySubsystem::Get(World);
+	if (!Targeting)
+	{
+		Ar.Log(TEXT("Crunch.Targeting.Stats: no targeting query subsystem in this world"));
+		return;
+	}
+
+	const int32 NumRequested = Targeting->GetNumRequested();
+	Ar.Logf(TEXT("Targeting queries: %d requested, %d issued, %d skipped (%.0f%%), %d in flight"),
+		NumRequested, Targeting->GetNumIssued(), Targeting->GetNumSkipped(),
+		NumRequested > 0 ? 100.0 * Targeting->GetNumSkipped() / NumRequested : 0.0, Targeting->GetNumInFlight());
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice TargetingStatsCommand(
+	TEXT("Crunch.Targeting.Stats"),
+	TEXT("Crunch.Targeting.Stats: print how many targeting queries were requested, issued and skipped because the view had not moved."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&TargetingStats));
@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
+// ----------------------------------------------------------------------------
+// File: CTargetingQuerySubsystem.h
+// Purpose: Collision queries for periodic ability targeting (target actors,
+//          aim checks) off the game thread. Requests from every requester are
+//          queued during the frame, issued together as async traces and
+//          answered on the next frame through a callback.
+// Key API:
+//  - FCTargetingQuery: line (Radius 0) or sphere sweep, by channel or object type.
+//  - UCTargetingQuerySubsystem::RequestQuery: queue a query for a requester.
+// Notes:
+//  - A requester whose query starts and points (almost) where its last one did
+//    is skipped and keeps its previous result, up to Crunch.Targeting.MaxSkipTime.
+//  - Crunch.Targeting.Async 0 runs the queries synchronously (for comparisons);
+//    Crunch.Targeting.Stats prints requested / issued / skipped counts.
+// ----------------------------------------------------------------------------
+#include "CTargetingQuerySubsystem.generated.h"
+
+DECLARE_DELEGATE_OneParam(FCTargetingQueryDelegate, const TArray<FHitResult>& /*Hits*/);
+
+/** One targeting trace; mirrors the parameters of the blocking UWorld queries */
+struct FCTargetingQuery
+{
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+
+	/** Sphere sweep radius; 0 traces a line */
+	float Radius = 0.f;
+
+	/** All hits along the query instead of the first blocking one */
+	bool bMulti = false;
+
+	/** Used unless bByObjectType */
+	ECollisionChannel Channel = ECC_Visibility;
+	FCollisionResponseParams ResponseParams;
+
+	FCollisionObjectQueryParams ObjectParams;
+	FCollisionQueryParams Params;
+
+	/** Query by object type (ObjectParams) instead of by channel */
+	bool bByObjectType = false;
+};
+
+/**
+ * UCTargetingQuerySubsystem keeps at most one queued query per requester and
+ * issues the frame's queries from Tick with AsyncLineTrace* / AsyncSweep*.
+ * The physics scene runs them in parallel with the next frame, and the
+ * engine's trace delegate hands the hits back, after which the callback runs
+ * unless it was bound to a requester that is gone.
+ */
+UCLASS()
+class UCTargetingQuerySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Queue Query for Requester, replacing one it queued earlier this frame.
+	 * With bSkipIfUnchanged, returns false and issues nothing when the query
+	 * starts within Crunch.Targeting.MoveThreshold and points within
+	 * Crunch.Targeting.AngleThreshold of the requester's last issued query.
+	 */
+	bool RequestQuery(const UObject* Requester, const FCTargetingQuery& Query, FCTargetingQueryDelegate OnResult, bool bSkipIfUnchanged = true);
+
+	/** Forget a requester's queued query and last view, e.g. when targeting ends */
+	void CancelQueries(const UObject* Requester);
+
+	int32 GetNumRequested() const { return NumRequested; }
+	int32 GetNumIssued() const { return NumIssued; }
+	int32 GetNumSkipped() const { return NumSkipped; }
+	int32 GetNumInFlight() const { return InFlight.Num(); }
+
+	static UCTargetingQuerySubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	struct FQueuedQuery
+	{
+		FObjectKey Requester;
+		FCTargetingQuery Query;
+		FCTargetingQueryDelegate OnResult;
+	};
+
+	struct FLastView
+	{
+		FVector Start = FVector::ZeroVector;
+		FVector Direction = FVector::ForwardVector;
+		double Time = 0.0;
+	};
+
+	void Issue(FQueuedQuery& Queued);
+	void RunSynchronously(FQueuedQuery& Queued);
+	void OnTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	TArray<FQueuedQuery> Queue;
+	TMap<FObjectKey, FLastView> LastViews;
+
+	/** Callbacks of issued async traces, by the trace's user data */
+	TMap<uint32, FCTargetingQueryDelegate> InFlight;
+	uint32 NextUserData = 1;
+
+	FTraceDelegate TraceDelegate;
+
+	int32 NumRequested = 0;
+	int32 NumIssued = 0;
+	int32 NumSkipped = 0;
+};
@@ -7,7 +7,8 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "GAS/CAttributeSet.h"
 #include "GAS/CHeroAttributeSet.h"
-#include "Engine/OverlapResult.h"
+#include "Framework/CSpatialIndexSubsystem.h"
+#include "GameFramework/Pawn.h"
 
 UGAP_Dead::UGAP_Dead()
 {
@@ -87,28 +88,19 @@ TArray<AActor*> UGAP_Dead::GetRewardTargets() const
 		return OutActors.Array();
 	}
 
-	FCollisionObjectQueryParams ObjectQueryParams;
-	ObjectQueryParams.AddObjectTypesToQuery(ECC_Pawn);
-	FCollisionShape CollisionShape;
-	CollisionShape.SetSphere(RewardRange);
+	UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(AvatarActor);
+	if (!SpatialIndex)
+	{
+		return OutActors.Array();
+	}
 
-	TArray<FOverlapResult> OverlapResults;
-	if (GetWorld()->OverlapMultiByObjectType(OverlapResults, AvatarActor->GetActorLocation(), FQuat::Identity, ObjectQueryParams, CollisionShape))
+	TArray<APawn*> Hostiles;
+	SpatialIndex->QueryRadius(AvatarActor->GetActorLocation(), RewardRange, FCSpatialQueryFilter::Hostile(AvatarActor), Hostiles);
+	for (APawn* Hostile : Hostiles)
 	{
-		for (const FOverlapResult& OverlapResult : OverlapResults)
+		if (UCAbilitySystemStatics::IsHero(Hostile))
 		{
-			const IGenericTeamAgentInterface* OtherTeamInterface = Cast<IGenericTeamAgentInterface>(OverlapResult.GetActor());
-			if (!OtherTeamInterface || OtherTeamInterface->GetTeamAttitudeTowards(*AvatarActor) != ETeamAttitude::Hostile)
-			{
-				continue;
-			}
-			
-			if (!UCAbilitySystemStatics::IsHero(OverlapResult.GetActor()))
-			{
-				continue;
-			}
-
-			OutActors.Add(OverlapResult.GetActor());
+			OutActors.Add(Hostile);
 		}
 	}
 
@@ -3,6 +3,7 @@
 
 #include "GAS/GAP_Launched.h"
 #include "GAS/CAbilitySystemStatics.h"
+#include "GAS/CGameplayTags.h"
 
 UGAP_Launched::UGAP_Launched()
 {
@@ -32,5 +33,5 @@ void UGAP_Launched::ActivateAbility(const FGameplayAbilitySpecHandle Handle, con
 
 FGameplayTag UGAP_Launched::GetLauchedAbilityActiationTag()
 {
-	return FGameplayTag::RequestGameplayTag("ability.passive.launch.activate");
+	return CGameplayTags::Ability_Passive_Launch_Activate;
 }
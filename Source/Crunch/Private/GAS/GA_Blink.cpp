@@ -2,6 +2,7 @@
 
 #include "GAS/GA_Blink.h"
 #include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
+#include "GAS/CGameplayTags.h"
 #include "GAS/TargetActor_GroundPick.h"
 #include "GAS/CAbilitySystemStatics.h"
 #include "Abilities/Tasks/AbilityTask_WaitTargetData.h"
@@ -44,7 +45,7 @@ void UGA_Blink::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const F
 
 FGameplayTag UGA_Blink::GetTeleportationTag()
 {
-	return FGameplayTag::RequestGameplayTag("ability.blink.teleport");
+	return CGameplayTags::Ability_Blink_Teleport;
 }
 
 void UGA_Blink::GroundPickTargetReceived(const FGameplayAbilityTargetDataHandle& TargetDataHandle)
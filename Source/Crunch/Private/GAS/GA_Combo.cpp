@@ -8,6 +8,7 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "GameplayTagsManager.h"
 #include "GAS/CAbilitySystemStatics.h"
+#include "GAS/CGameplayTags.h"
 
 UGA_Combo::UGA_Combo()
 {
@@ -51,17 +52,17 @@ void UGA_Combo::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const F
 
 FGameplayTag UGA_Combo::GetComboChangedEventTag()
 {
-	return FGameplayTag::RequestGameplayTag("ability.combo.change");
+	return CGameplayTags::Ability_Combo_Change;
 }
 
 FGameplayTag UGA_Combo::GetComboChangedEventEndTag()
 {
-	return FGameplayTag::RequestGameplayTag("ability.combo.change.end");
+	return CGameplayTags::Ability_Combo_Change_End;
 }
 
 FGameplayTag UGA_Combo::GetComboTargetEventTag()
 {
-	return FGameplayTag::RequestGameplayTag("ability.combo.damage");
+	return CGameplayTags::Ability_Combo_Damage;
 }
 
 void UGA_Combo::SetupWaitComboInputPress()
@@ -7,6 +7,7 @@
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "GAS/CGameplayTags.h"
 #include "GAS/TargetActor_Around.h"
 #include "Abilities/Tasks/AbilityTask_WaitTargetData.h"
 
@@ -51,7 +52,7 @@ void UGA_Dash::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGamepl
 
 FGameplayTag UGA_Dash::GetDashStartTag()
 {
-	return FGameplayTag::RequestGameplayTag("ability.dash.start");
+	return CGameplayTags::Ability_Dash_Start;
 }
 
 void UGA_Dash::PushForward()
@@ -9,6 +9,7 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
 #include "GAS/CAttributeSet.h"
+#include "GAS/CGameplayTags.h"
 #include "GAS/TargetActor_Line.h"
 
 void UGA_Lazer::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
@@ -52,7 +53,7 @@ void UGA_Lazer::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGamep
 
 FGameplayTag UGA_Lazer::GetShootTag()
 {
-	return FGameplayTag::RequestGameplayTag("ability.lazer.shoot");
+	return CGameplayTags::Ability_Lazer_Shoot;
 }
 
 void UGA_Lazer::ShootLazer(FGameplayEventData Payload)
@@ -4,6 +4,8 @@
 #include "GAS/GA_Shoot.h"
 #include "GAS/CAbilitySystemStatics.h"
 #include "GameplayTagsManager.h"
+#include "GAS/CGameplayTags.h"
+#include "GAS/CProjectileSubsystem.h"
 #include "GAS/ProjectileActor.h"
 #include "Abilities/Tasks/AbilityTask_WaitGameplayEvent.h"
 #include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
@@ -55,6 +57,10 @@ void UGA_Shoot::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGamep
 		AimTargetAbilitySystemComponent->RegisterGameplayTagEvent(UCAbilitySystemStatics::GetDeadStatTag()).RemoveAll(this);
 		AimTargetAbilitySystemComponent = nullptr;
 	}
+	if (UCTargetingQuerySubsystem* Targeting = UCTargetingQuerySubsystem::Get(GetAvatarActorFromActorInfo()))
+	{
+		Targeting->CancelQueries(this);
+	}
 	SendLocalGameplayEvent(UCAbilitySystemStatics::GetTargetUpdatedTag(), FGameplayEventData());
 
 	StopShooting(FGameplayEventData());
@@ -63,7 +69,7 @@ void UGA_Shoot::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGamep
 
 FGameplayTag UGA_Shoot::GetShootTag()
 {
-	return FGameplayTag::RequestGameplayTag("ability.shoot");
+	return CGameplayTags::Ability_Shoot;
 }
 
 void UGA_Shoot::StartShooting(FGameplayEventData Payload)
@@ -100,9 +106,6 @@ void UGA_Shoot::ShootProjectile(FGameplayEventData Payload)
 	if (K2_HasAuthority())
 	{
 		AActor* OwnerAvaterActor = GetAvatarActorFromActorInfo();
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.Owner = OwnerAvaterActor;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
 		FVector SocketLocation = GetAvatarActorFromActorInfo()->GetActorLocation();
 		USkeletalMeshComponent* MeshComp = GetOwningComponentFromActorInfo();
@@ -117,10 +120,15 @@ void UGA_Shoot::ShootProjectile(FGameplayEventData Payload)
 			}
 		}
 
-		AProjectileActor* Projectile = GetWorld()->SpawnActor<AProjectileActor>(ProjectileClass, SocketLocation, OwnerAvaterActor->GetActorRotation(), SpawnParams);
-		if (Projectile)
+		// Fly along the owner's view, like AProjectileActor::ShootProjectile
+		FVector OwnerViewLoc;
+		FRotator OwnerViewRot;
+		OwnerAvaterActor->GetActorEyesViewPoint(OwnerViewLoc, OwnerViewRot);
+
+		if (UCProjectileSubsystem* Projectiles = UCProjectileSubsystem::Get(OwnerAvaterActor))
 		{
-			Projectile->ShootProjectile(ShootProjectileSpeed, ShootProjectileRange, GetAimTargetIfValid(), GetOwnerTeamId(), MakeOutgoingGameplayEffectSpec(ProjectileHitEffect, GetAbilityLevel(CurrentSpecHandle, CurrentActorInfo)));
+			Projectiles->LaunchProjectile(ProjectileClass, OwnerAvaterActor, SocketLocation, OwnerViewRot.Vector(), ShootProjectileSpeed, ShootProjectileRange,
+				GetAimTargetIfValid(), GetOwnerTeamId(), MakeOutgoingGameplayEffectSpec(ProjectileHitEffect, GetAbilityLevel(CurrentSpecHandle, CurrentActorInfo)));
 		}
 	}
 }
@@ -138,13 +146,22 @@ void UGA_Shoot::FindAimTarget()
 	if (HasValidTarget())
 		return;
 
+	RequestAimTargetQuery(ShootProjectileRange, FCTargetingQueryDelegate::CreateUObject(this, &UGA_Shoot::AimTargetQueryDone));
+}
+
+void UGA_Shoot::AimTargetQueryDone(const TArray<FHitResult>& HitResults)
+{
+	// Answered a frame later: the ability may have ended or found a target meanwhile
+	if (!IsActive() || HasValidTarget())
+		return;
+
 	if (AimTargetAbilitySystemComponent)
 	{
 		AimTargetAbilitySystemComponent->RegisterGameplayTagEvent(UCAbilitySystemStatics::GetDeadStatTag()).RemoveAll(this);
 		AimTargetAbilitySystemComponent = nullptr;
 	}
 
-	AimTarget = GetAimTarget(ShootProjectileRange, ETeamAttitude::Hostile);
+	AimTarget = PickAimTarget(HitResults, ETeamAttitude::Hostile);
 	if (AimTarget)
 	{
 		AimTargetAbilitySystemComponent = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(AimTarget);
@@ -204,6 +221,11 @@ void UGA_Shoot::TargetDeadTagUpdated(const FGameplayTag Tag, int32 NewCount)
 {
 	if (NewCount > 0)
 	{
+		// The view may not have moved, but the target is gone: query again right away
+		if (UCTargetingQuerySubsystem* Targeting = UCTargetingQuerySubsystem::Get(GetAvatarActorFromActorInfo()))
+		{
+			Targeting->CancelQueries(this);
+		}
 		FindAimTarget();
 	}
 }
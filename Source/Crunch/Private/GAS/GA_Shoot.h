@@ -72,9 +72,11 @@ private:
 
     FTimerHandle AimTargetCheckTimerHandle;
 
-    /** Periodically update aim target during held fire */
+    /** Periodically update aim target during held fire; the trace result arrives in AimTargetQueryDone */
     void FindAimTarget();
 
+    void AimTargetQueryDone(const TArray<FHitResult>& HitResults);
+
     UPROPERTY(EditDefaultsOnly, Category = "Target")
     /** How often to check for a new target while holding fire */
     float AimTargetCheckTimeInterval = 0.1f;
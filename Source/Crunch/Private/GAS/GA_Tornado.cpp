@@ -7,6 +7,7 @@
 #include "Abilities/Tasks/AbilityTask_WaitGameplayEvent.h"
 #include "Abilities/Tasks/AbilityTask_WaitDelay.h"
 #include "GAS/CAbilitySystemStatics.h"
+#include "GAS/CForceFieldSubsystem.h"
 
 void UGA_Tornado::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
@@ -30,6 +31,20 @@ void UGA_Tornado::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const
 			UAbilityTask_WaitGameplayEvent* WaitDamageEvent = UAbilityTask_WaitGameplayEvent::WaitGameplayEvent(this, UCAbilitySystemStatics::GetGenericDamagePointTag(), nullptr, false);
 			WaitDamageEvent->EventReceived.AddDynamic(this, &UGA_Tornado::TornadoDamageEventReceived);
 			WaitDamageEvent->ReadyForActivation();
+
+			if (UCForceFieldSubsystem* ForceFields = UCForceFieldSubsystem::Get(GetAvatarActorFromActorInfo()))
+			{
+				FCForceField TornadoField;
+				TornadoField.Type = ECForceFieldType::Vortex;
+				TornadoField.AttachActor = GetAvatarActorFromActorInfo();
+				TornadoField.Origin = GetAvatarActorFromActorInfo()->GetActorLocation();
+				TornadoField.Radius = TornadoFieldRadius;
+				TornadoField.Strength = TornadoPushSpeed;
+				TornadoField.SwirlStrength = TornadoSwirlSpeed;
+				TornadoField.TeamId = GetOwnerTeamId();
+				TornadoField.Duration = TornadoDuration;
+				TornadoFieldId = ForceFields->AddField(TornadoField);
+			}
 		}
 
 		UAbilityTask_WaitCancel* WaitCancel = UAbilityTask_WaitCancel::WaitCancel(this);
@@ -48,9 +63,22 @@ void UGA_Tornado::TornadoDamageEventReceived(FGameplayEventData Payload)
 	{
 		FGameplayAbilityTargetDataHandle TargetDataHandle = Payload.TargetData;
 		BP_ApplyGameplayEffectToTarget(TargetDataHandle, HitDamageEffect, GetAbilityLevel(CurrentSpecHandle, CurrentActorInfo));
-		PushTargetsFromOwnerLocation(TargetDataHandle, HitPushSpeed);
 	}
 }
 
+void UGA_Tornado::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
+{
+	if (TornadoFieldId != 0)
+	{
+		if (UCForceFieldSubsystem* ForceFields = UCForceFieldSubsystem::Get(GetAvatarActorFromActorInfo()))
+		{
+			ForceFields->RemoveField(TornadoFieldId);
+		}
+		TornadoFieldId = 0;
+	}
+
+	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
+}
+
 
 
@@ -15,13 +15,23 @@ class UGA_Tornado : public UCGameplayAbility
 	GENERATED_BODY()
 public:	
 	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;	
+	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
 	
 private:
 	UPROPERTY(EditDefaultsOnly, Category = "Effect")
 	TSubclassOf<UGameplayEffect> HitDamageEffect;
 
+	/** Vortex force field around the caster while the tornado lasts */
 	UPROPERTY(EditDefaultsOnly, Category = "Effect")
-	float HitPushSpeed = 3000.f;
+	float TornadoFieldRadius = 500.f;
+
+	/** Outward speed of the field; negative pulls enemies in */
+	UPROPERTY(EditDefaultsOnly, Category = "Effect")
+	float TornadoPushSpeed = 600.f;
+
+	/** Speed of the field around the caster */
+	UPROPERTY(EditDefaultsOnly, Category = "Effect")
+	float TornadoSwirlSpeed = 400.f;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Anim")
 	UAnimMontage* TornadoMontage;
@@ -31,5 +41,7 @@ private:
 
 	UFUNCTION()
 	void TornadoDamageEventReceived(FGameplayEventData Payload);
+
+	uint16 TornadoFieldId = 0;
 };
 
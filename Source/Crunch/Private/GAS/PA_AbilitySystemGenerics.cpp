@@ -2,8 +2,146 @@
 
 
 #include "GAS/PA_AbilitySystemGenerics.h"
+#include "Algo/BinarySearch.h"
+#include "Curves/CurveTable.h"
+#include "Engine/DataTable.h"
+#include "GAS/CGameplayAbilityTypes.h"
 
 const FRealCurve* UPA_AbilitySystemGenerics::GetExperienceCurve() const
 {
-	return ExperienceCurveTable->FindCurve(ExperienceRowName, "");
+	return ExperienceCurveTable ? ExperienceCurveTable->FindCurve(ExperienceRowName, "") : nullptr;
+}
+
+const FHeroBaseStats* UPA_AbilitySystemGenerics::FindBaseStats(const UClass* Class) const
+{
+	BakeLookupTables();
+	const FHeroBaseStats* const* BaseStats = Class ? BaseStatsByClass.Find(Class) : nullptr;
+	return BaseStats ? *BaseStats : FallbackBaseStats;
+}
+
+FCExperienceLevel UPA_AbilitySystemGenerics::GetExperienceLevel(float Experience) const
+{
+	BakeLookupTables();
+
+	FCExperienceLevel Result;
+	if (LevelExperience.IsEmpty())
+	{
+		return Result;
+	}
+
+	// Number of levels whose threshold has been reached
+	const int32 NumReached = Algo::UpperBound(LevelExperience, Experience);
+	if (NumReached > 0)
+	{
+		Result.Level = NumReached;
+		Result.PrevLevelExperience = LevelExperience[NumReached - 1];
+	}
+	Result.NextLevelExperience = LevelExperience.IsValidIndex(NumReached) ? LevelExperience[NumReached] : 0.f;
+	return Result;
+}
+
+int32 UPA_AbilitySystemGenerics::GetMaxLevel() const
+{
+	BakeLookupTables();
+	return LevelExperience.Num();
+}
+
+float UPA_AbilitySystemGenerics::GetMaxLevelExperience() const
+{
+	BakeLookupTables();
+	return LevelExperience.IsEmpty() ? 0.f : LevelExperience.Last();
+}
+
+void UPA_AbilitySystemGenerics::PostLoad()
+{
+	Super::PostLoad();
+	MarkLookupTablesDirty();
+#if WITH_EDITOR
+	WatchSourceTables();
+#endif
+}
+
+#if WITH_EDITOR
+void UPA_AbilitySystemGenerics::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	MarkLookupTablesDirty();
+	WatchSourceTables();
+}
+
+void UPA_AbilitySystemGenerics::WatchSourceTables()
+{
+	if (WatchedBaseStatDataTable.Get() != BaseStatDataTable)
+	{
+		if (UDataTable* OldTable = WatchedBaseStatDataTable.Get())
+		{
+			OldTable->OnDataTableChanged().Remove(BaseStatDataTableChangedHandle);
+		}
+		BaseStatDataTableChangedHandle.Reset();
+		WatchedBaseStatDataTable = BaseStatDataTable;
+		if (BaseStatDataTable)
+		{
+			BaseStatDataTableChangedHandle = BaseStatDataTable->OnDataTableChanged().AddUObject(this, &UPA_AbilitySystemGenerics::MarkLookupTablesDirty);
+		}
+	}
+
+	if (WatchedExperienceCurveTable.Get() != ExperienceCurveTable)
+	{
+		if (UCurveTable* OldTable = WatchedExperienceCurveTable.Get())
+		{
+			OldTable->OnCurveTableChanged().Remove(ExperienceCurveTableChangedHandle);
+		}
+		ExperienceCurveTableChangedHandle.Reset();
+		WatchedExperienceCurveTable = ExperienceCurveTable;
+		if (ExperienceCurveTable)
+		{
+			ExperienceCurveTableChangedHandle = ExperienceCurveTable->OnCurveTableChanged().AddUObject(this, &UPA_AbilitySystemGenerics::MarkLookupTablesDirty);
+		}
+	}
+}
+#endif
+
+void UPA_AbilitySystemGenerics::MarkLookupTablesDirty()
+{
+	bLookupTablesBaked = false;
+}
+
+void UPA_AbilitySystemGenerics::BakeLookupTables() const
+{
+	if (bLookupTablesBaked)
+	{
+		return;
+	}
+	bLookupTablesBaked = true;
+
+	BaseStatsByClass.Reset();
+	FallbackBaseStats = nullptr;
+	if (BaseStatDataTable)
+	{
+		for (const TPair<FName, uint8*>& DataPair : BaseStatDataTable->GetRowMap())
+		{
+			const FHeroBaseStats* BaseStats = BaseStatDataTable->FindRow<FHeroBaseStats>(DataPair.Key, "");
+			// The first row of a class wins, as with the old row scan
+			if (BaseStats && BaseStats->Class && !BaseStatsByClass.Contains(BaseStats->Class.Get()))
+			{
+				BaseStatsByClass.Add(BaseStats->Class.Get(), BaseStats);
+			}
+			if (BaseStats)
+			{
+				FallbackBaseStats = BaseStats;
+			}
+		}
+	}
+
+	LevelExperience.Reset();
+	if (const FRealCurve* ExperienceCurve = GetExperienceCurve())
+	{
+		LevelExperience.Reserve(ExperienceCurve->GetNumKeys());
+		for (auto Iter = ExperienceCurve->GetKeyHandleIterator(); Iter; ++Iter)
+		{
+			// Clamped so the binary search stays valid on a badly authored curve
+			const float ExperienceToReachLevel = ExperienceCurve->GetKeyValue(*Iter);
+			LevelExperience.Add(LevelExperience.IsEmpty() ? ExperienceToReachLevel : FMath::Max(LevelExperience.Last(), ExperienceToReachLevel));
+		}
+	}
 }
@@ -4,16 +4,31 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "UObject/ObjectKey.h"
 #include "PA_AbilitySystemGenerics.generated.h"
 
 class UGameplayEffect;
 class UGameplayAbility;
+struct FHeroBaseStats;
+
+/** Level reached with a given amount of experience, and the experience bounds of that level */
+struct FCExperienceLevel
+{
+    int32 Level = 1;
+    float PrevLevelExperience = 0.f;
+    /** 0 at the last level */
+    float NextLevelExperience = 0.f;
+};
+
 /**
  * PrimaryDataAsset holding generic GAS assets used across the project.
  * Responsibilities:
  * - Provide references to common GameplayEffects (full heal, death, initial passives)
  * - Provide passive abilities granted to characters
  * - Provide base stat data table and experience progression curve
+ * - Bake both into lookup tables on first use: base stats by class and the
+ *   experience needed per level, so spawns and experience gains never scan
+ *   the tables (the editor rebakes when either table changes)
  */
 UCLASS()
 class UPA_AbilitySystemGenerics : public UPrimaryDataAsset
@@ -33,7 +48,29 @@ public:
     /** Returns experience curve for progression lookups */
     const FRealCurve* GetExperienceCurve() const;
 
+    /** Base stat row of exactly this class; a class without a row gets the table's last row, as the old row scan did. One map lookup. */
+    const FHeroBaseStats* FindBaseStats(const UClass* Class) const;
+    /** Level for an amount of experience; binary search over the baked thresholds */
+    FCExperienceLevel GetExperienceLevel(float Experience) const;
+    /** Number of levels in the experience curve, 0 when there is none */
+    int32 GetMaxLevel() const;
+    /** Experience needed to reach the last level */
+    float GetMaxLevelExperience() const;
+
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 private:
+    /** Build the lookup tables if they were never built or a source changed */
+    void BakeLookupTables() const;
+    void MarkLookupTablesDirty();
+#if WITH_EDITOR
+    /** Rebake when the referenced tables are edited or reimported */
+    void WatchSourceTables();
+#endif
+
     UPROPERTY(EditDefaultsOnly, Category = "Gameplay Effects")
     /** GameplayEffect that fills all relevant attributes to max */
     TSubclassOf<UGameplayEffect> FullStatEffect;
@@ -61,4 +98,19 @@ private:
     UPROPERTY(EditDefaultsOnly, Category = "Level")
     /** Curve table providing XP required per level */
     UCurveTable* ExperienceCurveTable;
+
+    /** Baked from BaseStatDataTable; points at its rows */
+    mutable TMap<TObjectKey<UClass>, const FHeroBaseStats*> BaseStatsByClass;
+    mutable const FHeroBaseStats* FallbackBaseStats = nullptr;
+    /** Baked from the experience curve: entry i is the experience needed to reach level i + 1, never decreasing */
+    mutable TArray<float> LevelExperience;
+    mutable bool bLookupTablesBaked = false;
+
+#if WITH_EDITORONLY_DATA
+    /** Tables whose change delegates mark the lookups dirty */
+    TWeakObjectPtr<UDataTable> WatchedBaseStatDataTable;
+    TWeakObjectPtr<UCurveTable> WatchedExperienceCurveTable;
+    FDelegateHandle BaseStatDataTableChangedHandle;
+    FDelegateHandle ExperienceCurveTableChangedHandle;
+#endif
 };
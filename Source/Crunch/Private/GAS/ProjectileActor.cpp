@@ -6,6 +6,7 @@
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
 #include "GameplayCueManager.h"
+#include "Particles/ParticleSystemComponent.h"
 #include "Net/UnrealNetwork.h"
 
 // Sets default values
@@ -81,6 +82,32 @@ void AProjectileActor::NotifyActorBeginOverlap(AActor* OtherActor)
 	}
 }
 
+void AProjectileActor::InitVisualProxy()
+{
+	SetReplicates(false);
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	SetActorTickEnabled(false);
+	SetActorEnableCollision(false);
+}
+
+void AProjectileActor::SetVisualActive(bool bActive)
+{
+	SetActorHiddenInGame(!bActive);
+
+	TInlineComponentArray<UFXSystemComponent*> Effects(this);
+	for (UFXSystemComponent* Effect : Effects)
+	{
+		if (bActive)
+		{
+			Effect->Activate(true);
+		}
+		else
+		{
+			Effect->Deactivate();
+		}
+	}
+}
+
 // Called when the game starts or when spawned
 void AProjectileActor::BeginPlay()
 {
@@ -32,7 +32,21 @@ public:
 	virtual FGenericTeamId GetGenericTeamId() const { return TeamId; }
 
 	virtual void NotifyActorBeginOverlap(AActor* OtherActor) override;
+
+	/** Turn a locally spawned instance into a visual for UCProjectileSubsystem: no replication, tick or collision. Call between SpawnActorDeferred and FinishSpawning. */
+	void InitVisualProxy();
+
+	/** Show and restart the effects of a pooled visual, or hide it back into the pool */
+	void SetVisualActive(bool bActive);
+
+	const FGameplayTag& GetHitGameplayCueTag() const { return HitGameplayCueTag; }
+	float GetCollisionRadius() const { return CollisionRadius; }
+
 private:
+	/** Sphere swept by UCProjectileSubsystem every frame */
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile")
+	float CollisionRadius = 30.f;
+
 	UPROPERTY(EditDefaultsOnly, Category = "Gameplay Cue")
 	FGameplayTag HitGameplayCueTag;
 
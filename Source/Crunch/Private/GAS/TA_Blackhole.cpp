@@ -4,6 +4,7 @@
 #include "GAS/TA_Blackhole.h"
 #include "Components/SphereComponent.h"
 #include "Components/SceneComponent.h"
+#include "GAS/CForceFieldSubsystem.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "NiagaraComponent.h"
@@ -60,6 +61,27 @@ void ATA_Blackhole::StartTargeting(UGameplayAbility* Ability)
 	{
 		World->GetTimerManager().SetTimer(BlackholeDurationTimerHandle, this, &ATA_Blackhole::StopBlackhole, BlackholeDuration);
 	}
+
+	// The ability moves this actor onto the target point right after, so the field follows it
+	UCForceFieldSubsystem* ForceFields = UCForceFieldSubsystem::Get(this);
+	if (HasAuthority() && ForceFields)
+	{
+		FCForceField PullField;
+		PullField.Type = ECForceFieldType::Radial;
+		PullField.Origin = GetActorLocation();
+		PullField.AttachActor = this;
+		PullField.Radius = BlackholeRange;
+		PullField.Strength = -PullSpeed;
+		PullField.TeamId = TeamId;
+		PullField.Duration = BlackholeDuration;
+		PullFieldId = ForceFields->AddField(PullField);
+	}
+}
+
+void ATA_Blackhole::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	RemovePullField();
+	Super::EndPlay(EndPlayReason);
 }
 
 void ATA_Blackhole::Tick(float DeltaTime)
@@ -68,12 +90,8 @@ void ATA_Blackhole::Tick(float DeltaTime)
 	{
 		for (TPair<AActor*, UNiagaraComponent*>& TargetPair : ActorsInRangeMap)
 		{
-			AActor* Target = TargetPair.Key;
+			// The pull itself is the force field; only the link VFX follows the blackhole here
 			UNiagaraComponent* NiagaraComponent = TargetPair.Value;
-
-			FVector PullDir = (GetActorLocation() - Target->GetActorLocation()).GetSafeNormal();
-			Target->SetActorLocation(Target->GetActorLocation() + PullDir * PullSpeed * DeltaTime);
-
 			if (NiagaraComponent)
 			{
 				NiagaraComponent->SetVariablePosition(BlackholeVFXOriginVariableName, VFXComponent->GetComponentLocation());
@@ -147,8 +165,24 @@ void ATA_Blackhole::RemoveTarget(AActor* OtherTarget)
 	}
 }
 
+void ATA_Blackhole::RemovePullField()
+{
+	if (PullFieldId == 0)
+	{
+		return;
+	}
+
+	if (UCForceFieldSubsystem* ForceFields = UCForceFieldSubsystem::Get(this))
+	{
+		ForceFields->RemoveField(PullFieldId);
+	}
+	PullFieldId = 0;
+}
+
 void ATA_Blackhole::StopBlackhole()
 {
+	RemovePullField();
+
 	TArray<TWeakObjectPtr<AActor>> FinalTargets;
 	for (TPair<AActor*, UNiagaraComponent*>& TargetPair : ActorsInRangeMap)
 	{
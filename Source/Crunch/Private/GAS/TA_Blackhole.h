@@ -24,6 +24,7 @@ public:
 	virtual FGenericTeamId GetGenericTeamId() const { return TeamId; }
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void StartTargeting(class UGameplayAbility* Ability) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void ConfirmTargetingAndContinue() override;
 	virtual void CancelTargeting() override;
@@ -35,6 +36,10 @@ private:
 	float BlackholeDuration;
 	FTimerHandle BlackholeDurationTimerHandle;
 
+	/** Server: the pull, a UCForceFieldSubsystem field following this actor */
+	uint16 PullFieldId = 0;
+	void RemovePullField();
+
 	UPROPERTY(ReplicatedUsing = OnRep_BlackholeRange)
 	float BlackholeRange;
 
@@ -6,7 +6,9 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "Components/DecalComponent.h"
 #include "Crunch/Crunch.h"
-#include "Engine/OverlapResult.h"
+#include "Framework/CSpatialIndexSubsystem.h"
+#include "GAS/CTargetingQuerySubsystem.h"
+#include "GameFramework/Pawn.h"
 #include "GenericTeamAgentInterface.h"
 
 ATargetActor_GroundPick::ATargetActor_GroundPick()
@@ -28,41 +30,30 @@ void ATargetActor_GroundPick::SetTargetAreaRadius(float NewRadius)
 
 void ATargetActor_GroundPick::ConfirmTargetingAndContinue()
 {
-	TArray<FOverlapResult> OverlapResults;
+	AActor* AvatarActor = OwningAbility ? OwningAbility->GetAvatarActorFromActorInfo() : nullptr;
 
-	FCollisionObjectQueryParams ObjectQueryParams;
-	ObjectQueryParams.AddObjectTypesToQuery(ECC_Pawn);
-
-	FCollisionShape CollisionShape;
-	CollisionShape.SetSphere(TargetAreaRadius);
-
-	GetWorld()->OverlapMultiByObjectType(OverlapResults,
-		GetActorLocation(),
-		FQuat::Identity,
-		ObjectQueryParams,
-		CollisionShape
-	);
-
-	TSet<AActor*> TargetActors;
-
-	IGenericTeamAgentInterface* OwnerTeamInterface = nullptr; 
-	if (OwningAbility)
+	FCSpatialQueryFilter Filter;
+	if (const IGenericTeamAgentInterface* OwnerTeamInterface = Cast<IGenericTeamAgentInterface>(AvatarActor))
 	{
-		OwnerTeamInterface = Cast<IGenericTeamAgentInterface>(OwningAbility->GetAvatarActorFromActorInfo());
+		Filter.QuerierTeam = OwnerTeamInterface->GetGenericTeamId();
+		Filter.bIncludeFriendly = bShouldTargetFriendly;
+		Filter.bIncludeHostile = bShouldTargetEnemy;
 	}
-
-	for (const FOverlapResult& OverlapResult : OverlapResults)
+	else
 	{
-		if (OwnerTeamInterface && OwnerTeamInterface->GetTeamAttitudeTowards(*OverlapResult.GetActor()) == ETeamAttitude::Friendly && !bShouldTargetFriendly)
-			continue;
-
-		if (OwnerTeamInterface && OwnerTeamInterface->GetTeamAttitudeTowards(*OverlapResult.GetActor()) == ETeamAttitude::Hostile && !bShouldTargetEnemy)
-			continue;
+		Filter.bIncludeFriendly = true;
+	}
+	Filter.bIncludeNeutral = true;
 
-		TargetActors.Add(OverlapResult.GetActor());
+	TArray<APawn*> TargetPawns;
+	if (const UCSpatialIndexSubsystem* SpatialIndex = UCSpatialIndexSubsystem::Get(this))
+	{
+		SpatialIndex->QueryRadius(GetActorLocation(), TargetAreaRadius, Filter, TargetPawns);
 	}
 
-	FGameplayAbilityTargetDataHandle TargetData = UAbilitySystemBlueprintLibrary::AbilityTargetDataFromActorArray(TargetActors.Array(), false);
+	TArray<AActor*> TargetActors(TargetPawns);
+
+	FGameplayAbilityTargetDataHandle TargetData = UAbilitySystemBlueprintLibrary::AbilityTargetDataFromActorArray(TargetActors, false);
 
 	FGameplayAbilityTargetData_SingleTargetHit* HitLoc = new FGameplayAbilityTargetData_SingleTargetHit;
 	HitLoc->HitResult.ImpactPoint = GetActorLocation();
@@ -83,40 +74,61 @@ void ATargetActor_GroundPick::Tick(float DeltaTime)
 	Super::Tick(DeltaTime);
 	if (PrimaryPC && PrimaryPC->IsLocalPlayerController())
 	{
-		SetActorLocation(GetTargetPoint());
+		RequestTargetPoint();
 	}
 }
 
-FVector ATargetActor_GroundPick::GetTargetPoint() const
+void ATargetActor_GroundPick::RequestTargetPoint()
 {
-	if (!PrimaryPC || !PrimaryPC->IsLocalPlayerController())
-		return GetActorLocation();
-
-	FHitResult TraceResult;
+	UCTargetingQuerySubsystem* Targeting = UCTargetingQuerySubsystem::Get(this);
+	if (!Targeting)
+		return;
 
 	FVector ViewLoc;
 	FRotator ViewRot;
 
 	PrimaryPC->GetPlayerViewPoint(ViewLoc, ViewRot);
 
-	FVector TraceEnd = ViewLoc + ViewRot.Vector() * TargetTraceRange;
+	FCTargetingQuery Query;
+	Query.Start = ViewLoc;
+	Query.End = ViewLoc + ViewRot.Vector() * TargetTraceRange;
+	Query.Channel = ECC_Target;
 
-	GetWorld()->LineTraceSingleByChannel(TraceResult, ViewLoc, TraceEnd, ECC_Target);
+	// An unchanged view keeps the actor where the last result put it
+	Targeting->RequestQuery(this, Query, FCTargetingQueryDelegate::CreateUObject(this, &ATargetActor_GroundPick::ViewTraceDone, Query.End));
+}
 
-	if (!TraceResult.bBlockingHit)
+void ATargetActor_GroundPick::ViewTraceDone(const TArray<FHitResult>& HitResults, FVector TraceEnd)
+{
+	if (HitResults.Num() != 0 && HitResults[0].bBlockingHit)
 	{
-		GetWorld()->LineTraceSingleByChannel(TraceResult, TraceEnd, TraceEnd + FVector::DownVector * TNumericLimits<float>::Max(), ECC_Target);
+		GroundTraceDone(HitResults);
+		return;
 	}
 
-	if (!TraceResult.bBlockingHit)
-	{
-		return GetActorLocation();
-	}
+	UCTargetingQuerySubsystem* Targeting = UCTargetingQuerySubsystem::Get(this);
+	if (!Targeting)
+		return;
+
+	FCTargetingQuery Query;
+	Query.Start = TraceEnd;
+	Query.End = TraceEnd + FVector::DownVector * TNumericLimits<float>::Max();
+	Query.Channel = ECC_Target;
+
+	// Requested for the decal so the next view query does not replace it
+	Targeting->RequestQuery(DecalComp, Query, FCTargetingQueryDelegate::CreateUObject(this, &ATargetActor_GroundPick::GroundTraceDone), false);
+}
+
+void ATargetActor_GroundPick::GroundTraceDone(const TArray<FHitResult>& HitResults)
+{
+	if (HitResults.Num() == 0 || !HitResults[0].bBlockingHit)
+		return;
 
+	const FHitResult& TraceResult = HitResults[0];
 	if (bShouldDrawDebug)
 	{
 		DrawDebugSphere(GetWorld(), TraceResult.ImpactPoint, TargetAreaRadius, 32, FColor::Red);
 	}
 
-	return TraceResult.ImpactPoint;
+	SetActorLocation(TraceResult.ImpactPoint);
 }
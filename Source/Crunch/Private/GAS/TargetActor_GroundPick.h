@@ -38,8 +38,12 @@ private:
 
     virtual void Tick(float DeltaTime) override;
 
-    /** Trace under cursor/crosshair to find ground point */
-    FVector GetTargetPoint() const;
+    /** Queue the trace under the crosshair to find the ground point; results move the actor */
+    void RequestTargetPoint();
+
+    /** View trace result; a miss falls back to a downward trace from TraceEnd */
+    void ViewTraceDone(const TArray<FHitResult>& HitResults, FVector TraceEnd);
+    void GroundTraceDone(const TArray<FHitResult>& HitResults);
     
     UPROPERTY(EditDefaultsOnly, Category = "Targeting")
     float TargetAreaRadius = 300.f;
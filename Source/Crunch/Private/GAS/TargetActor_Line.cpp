@@ -8,6 +8,7 @@
 #include "NiagaraComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "Abilities/GameplayAbility.h"
+#include "GAS/CTargetingQuerySubsystem.h"
 #include "Kismet/KismetMathLibrary.h"
 
 ATargetActor_Line::ATargetActor_Line()
@@ -78,6 +79,11 @@ void ATargetActor_Line::BeginDestroy()
 		GetWorldTimerManager().ClearTimer(PeoridicalTargetingTimerHandle);
 	}
 
+	if (UCTargetingQuerySubsystem* Targeting = UCTargetingQuerySubsystem::Get(this))
+	{
+		Targeting->CancelQueries(this);
+	}
+
 	Super::BeginDestroy();
 }
 
@@ -122,26 +128,37 @@ void ATargetActor_Line::UpdateTargetTrace()
 
 	FVector SweepEndLocation = GetActorLocation() + LookRotation.Vector() * TargetRange;
 
-	TArray<FHitResult> HitResults;
-
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(AvatarActor);
-	QueryParams.AddIgnoredActor(this);
+	UCTargetingQuerySubsystem* Targeting = UCTargetingQuerySubsystem::Get(this);
+	if (!Targeting)
+		return;
 
-	FCollisionResponseParams CollisionResponseParams(ECR_Overlap);
-	GetWorld()->SweepMultiByChannel(HitResults, GetActorLocation(), SweepEndLocation, FQuat::Identity, ECC_WorldDynamic, FCollisionShape::MakeSphere(DetectionCylinderRadius), QueryParams, CollisionResponseParams);
+	FCTargetingQuery Query;
+	Query.Start = GetActorLocation();
+	Query.End = SweepEndLocation;
+	Query.Radius = DetectionCylinderRadius;
+	Query.bMulti = true;
+	Query.Channel = ECC_WorldDynamic;
+	Query.ResponseParams = FCollisionResponseParams(ECR_Overlap);
+	Query.Params.AddIgnoredActor(AvatarActor);
+	Query.Params.AddIgnoredActor(this);
+
+	// While the beam does not move the end sphere and VFX keep the last result
+	Targeting->RequestQuery(this, Query, FCTargetingQueryDelegate::CreateUObject(this, &ATargetActor_Line::TargetTraceDone, Query.Start, Query.End));
+}
 
-	FVector LineEndLocation = SweepEndLocation;
+void ATargetActor_Line::TargetTraceDone(const TArray<FHitResult>& HitResults, FVector SweepStart, FVector SweepEnd)
+{
+	FVector LineEndLocation = SweepEnd;
 	float LineLength = TargetRange;
 
-	for (FHitResult& HitResult : HitResults)
+	for (const FHitResult& HitResult : HitResults)
 	{
 		if (HitResult.GetActor())
 		{
 			if (GetTeamAttitudeTowards(*HitResult.GetActor()) != ETeamAttitude::Friendly)
 			{
 				LineEndLocation = HitResult.ImpactPoint;
-				LineLength = FVector::Distance(GetActorLocation() , LineEndLocation);
+				LineLength = FVector::Distance(SweepStart, LineEndLocation);
 				break;
 			}
 		}
@@ -77,9 +77,12 @@ private:
     /** Perform trace and send target data to ability system */
     void DoTargetCheckAndReport();
 
-    /** Update VFX and debug line to reflect current trace */
+    /** Queue the forward sweep on UCTargetingQuerySubsystem; the result arrives in TargetTraceDone */
     void UpdateTargetTrace();
 
+    /** Update the end sphere and VFX to reflect the sweep from SweepStart to SweepEnd */
+    void TargetTraceDone(const TArray<FHitResult>& HitResults, FVector SweepStart, FVector SweepEnd);
+
     /** Team and validity filter for candidate target */
     bool ShouldReportActorAsTarget(const AActor* ActorToCheck) const;
 };
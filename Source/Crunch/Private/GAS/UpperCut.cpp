@@ -6,6 +6,7 @@
 #include "Abilities/Tasks/AbilityTask_WaitGameplayEvent.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "GAS/CAbilitySystemStatics.h"
+#include "GAS/CGameplayTags.h"
 #include "GAS/GA_Combo.h"
 #include "GameplayTagsManager.h"
 
@@ -41,7 +42,7 @@ void UUpperCut::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const F
 
 FGameplayTag UUpperCut::GetUpperCutLaunchTag()
 {
-	return FGameplayTag::RequestGameplayTag("ability.uppercut.launch");
+	return CGameplayTags::Ability_UpperCut_Launch;
 }
 
 const FGenericDamgeEffectDef* UUpperCut::GetDamageEffectDefForCurrentCombo() const
@@ -12,7 +12,6 @@ class UPA_ShopItem;
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnItemAddedDelegate, const UInventoryItem* /*NewItem*/);
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnItemRemovedDelegate, const FInventoryItemHandle& /*ItemHandle*/);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnItemStackCountChangeDelegate, const FInventoryItemHandle&, int /*NewCount*/);
-DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnItemAbilityCommitted, const FInventoryItemHandle&, float /*CooldownDuration*/, float /*CooldownTimeRemaining*/);
 
 /**
  * Actor component that manages a player's inventory items, including purchase,
@@ -30,7 +29,6 @@ public:
     FOnItemAddedDelegate OnItemAdded;
     FOnItemRemovedDelegate OnItemRemoved;
     FOnItemStackCountChangeDelegate OnItemStackCountChanged;
-    FOnItemAbilityCommitted OnItemAbilityCommitted;
     void TryActivateItem(const FInventoryItemHandle& ItemHandle);
     void TryPurchase(const UPA_ShopItem* ItemToPurchase);
     void SellItem(const FInventoryItemHandle& ItemHandle);
@@ -62,7 +60,6 @@ private:
 	UPROPERTY()
 	TMap<FInventoryItemHandle, UInventoryItem*> InventoryMap;
 
-	void AbilityCommitted(class UGameplayAbility* CommittedAbility);
 	/*********************************************************/
 	/*                   Server                              */
 	/*********************************************************/
@@ -211,14 +211,6 @@ void UInventoryItem::SetSlot(int NewSlot)
 	Slot = NewSlot;
 }
 
-float UInventoryItem::GetAbilityCooldownTimeRemaining() const
-{
-	if (!IsGrantingAnyAbility())
-		return 0.f;
-
-	return UCAbilitySystemStatics::GetCooldownRemainingFor(GetShopItem()->GetGrantedAbilityCDO(), *OwnerAbilitySystemComponent);
-}
-
 float UInventoryItem::GetAbilityCooldownDuration() const
 {
 	if (!IsGrantingAnyAbility())
@@ -90,7 +90,6 @@ public:
 	void SetSlot(int NewSlot);
 	int GetItemSlot() const { return Slot; }
 
-	float GetAbilityCooldownTimeRemaining() const;
 	float GetAbilityCooldownDuration() const;
 	float GetAbilityManaCost() const;
 	bool CanCastAbility() const;
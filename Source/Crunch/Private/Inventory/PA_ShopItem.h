@@ -47,6 +47,8 @@ public:
     virtual FPrimaryAssetId GetPrimaryAssetId() const override;
     static FPrimaryAssetType GetShopItemAssetType();
     UTexture2D* GetIcon() const;
+    /** Soft reference to the icon, for UCAssetManager::LoadTextureAsync */
+    const TSoftObjectPtr<UTexture2D>& GetIconAsset() const { return Icon; }
     FText GetItemName() const { return ItemName; }
     FText GetItemDescription() const { return ItemDescription; }
     float GetPrice() const { return Price; }
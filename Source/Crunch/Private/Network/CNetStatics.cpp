@@ -2,6 +2,11 @@
 
 
 #include "Network/CNetStatics.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
 
 FOnlineSessionSettings UCNetStatics::GenerateOnlineSesisonSettings(const FName& SessionName, const FString& SessionSearchId, int Port)
 {
@@ -143,3 +148,32 @@ void UCNetStatics::ReplacePort(FString& OutURLStr, int NewPort)
 	URL.Port = NewPort;
 	OutURLStr = URL.ToString();
 }
+
+static void NetStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	if (!NetDriver || !NetDriver->IsServer())
+	{
+		Ar.Log(TEXT("Crunch.Net.Stats: run on the server of a networked game"));
+		return;
+	}
+
+	int64 TotalOutBytesPerSecond = 0;
+	for (const UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (!Connection)
+		{
+			continue;
+		}
+		TotalOutBytesPerSecond += Connection->OutBytesPerSecond;
+		Ar.Logf(TEXT("  %s: out %d B/s, in %d B/s"), Connection->PlayerController ? *Connection->PlayerController->GetName() : *Connection->GetName(), Connection->OutBytesPerSecond, Connection->InBytesPerSecond);
+	}
+
+	const int32 NumClients = NetDriver->ClientConnections.Num();
+	Ar.Logf(TEXT("Clients: %d, out %lld B/s in total, %lld B/s per client"), NumClients, TotalOutBytesPerSecond, NumClients > 0 ? TotalOutBytesPerSecond / NumClients : 0);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice NetStatsCommand(
+	TEXT("Crunch.Net.Stats"),
+	TEXT("Crunch.Net.Stats: print the bytes per second the server sends to and receives from each client."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&NetStats));
@@ -5,6 +5,7 @@
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "Camera/CameraComponent.h"
+#include "Character/CCharacterMovementComponent.h"
 #include "Crunch/Crunch.h"
 #include "EnhancedInputSubsystems.h"
 #include "EnhancedInputComponent.h"
@@ -15,7 +16,8 @@
 #include "GAS/CHeroAttributeSet.h"
 #include "Inventory/InventoryComponent.h"
 
-ACPlayerCharacter::ACPlayerCharacter()
+ACPlayerCharacter::ACPlayerCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UCCharacterMovementComponent>(ACharacter::CharacterMovementComponentName))
 {	
 	CameraBoom = CreateDefaultSubobject<USpringArmComponent>("Camera Boom");
 	CameraBoom->SetupAttachment(GetRootComponent());
@@ -30,6 +32,8 @@ ACPlayerCharacter::ACPlayerCharacter()
 	GetCharacterMovement()->RotationRate = FRotator(0.f, 720.f, 0.f);
 
 	HeroAttributeSet = CreateDefaultSubobject<UCHeroAttributeSet>("Hero Attribute Set");
+	// Full effects to the owning player (cooldowns, prediction), cues and effect-granted tags to everyone else
+	GetAbilitySystemComponent()->SetReplicationMode(EGameplayEffectReplicationMode::Mixed);
 	InventoryComponent = CreateDefaultSubobject<UInventoryComponent>("Inventory Component");
 }
 
@@ -26,7 +26,7 @@ class ACPlayerCharacter : public ACCharacter
 {
     GENERATED_BODY()
 public:
-    ACPlayerCharacter();
+    ACPlayerCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
     virtual void PawnClientRestart() override;
     virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
     virtual void GetActorEyesViewPoint(FVector& OutLocation, FRotator& OutRotation) const  override;
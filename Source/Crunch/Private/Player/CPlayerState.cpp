@@ -12,7 +12,8 @@
 ACPlayerState::ACPlayerState()
 {
 	bReplicates = true;
-	NetUpdateFrequency = 100.f;
+	// The selection rarely changes and forces an update when it does
+	NetUpdateFrequency = 10.f;
 }
 
 void ACPlayerState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -76,6 +77,7 @@ void ACPlayerState::Server_SetSelectedCharacterDefination_Implementation(const U
 
 	PlayerSelection.SetCharacterDefination(NewDefination);
 	CGameState->SetCharacterSelected(this, NewDefination);
+	ForceNetUpdate();
 }
 
 bool ACPlayerState::Server_SetSelectedCharacterDefination_Validate(const UPA_CharacterDefination* NewDefination)
@@ -90,6 +92,10 @@ void ACPlayerState::PlayerSelectionUpdated(const TArray<FPlayerSelection>& NewPl
 		if (NewPlayerSelection.IsForPlayer(this))
 		{
 			PlayerSelection = NewPlayerSelection;
+			if (HasAuthority())
+			{
+				ForceNetUpdate();
+			}
 		}
 	}
 }
@@ -11,8 +11,12 @@
 #include "GAS/CAttributeSet.h"
 #include "Components/Image.h"
 #include "Components/TextBlock.h"
+#include "Engine/Texture2D.h"
+#include "Framework/CAssetManager.h"
+#include "GAS/CAbilitySystemComponent.h"
 
 #include "Widgets/AbilityToolTip.h"
+#include "Widgets/CHUDCooldownSubsystem.h"
 
 void UAbilityGauge::NativeConstruct()
 {
@@ -21,7 +25,6 @@ void UAbilityGauge::NativeConstruct()
 	UAbilitySystemComponent* OwnerASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetOwningPlayerPawn());
 	if (OwnerASC)
 	{
-		OwnerASC->AbilityCommittedCallbacks.AddUObject(this, &UAbilityGauge::AbilityCommitted);
 		OwnerASC->AbilitySpecDirtiedCallbacks.AddUObject(this, &UAbilityGauge::AbilitySpecUpdated);
 		OwnerASC->GetGameplayAttributeValueChangeDelegate(UCHeroAttributeSet::GetUpgradePointAttribute()).AddUObject(this, &UAbilityGauge::UpgradePointUpdated);
 		OwnerASC->GetGameplayAttributeValueChangeDelegate(UCAttributeSet::GetManaAttribute()).AddUObject(this, &UAbilityGauge::ManaUpdated);
@@ -37,8 +40,18 @@ void UAbilityGauge::NativeConstruct()
 
 
 	OwnerAbilitySystemComponent = OwnerASC;
-	WholeNumberFormattionOptions.MaximumFractionalDigits = 0;
-	TwoDigitNumberFormattingOptions.MaximumFractionalDigits = 2;
+
+	// Re-added to a panel after NativeDestruct unregistered it
+	if (AbilityCDO)
+	{
+		RegisterCooldownDisplay();
+	}
+}
+
+void UAbilityGauge::NativeDestruct()
+{
+	UnregisterCooldownDisplay();
+	Super::NativeDestruct();
 }
 
 void UAbilityGauge::NativeOnListItemObjectSet(UObject* ListItemObject)
@@ -52,14 +65,21 @@ void UAbilityGauge::NativeOnListItemObjectSet(UObject* ListItemObject)
 	CooldownDurationText->SetText(FText::AsNumber(CooldownDuration));
 	CostText->SetText(FText::AsNumber(Cost));
 	LevelGauge->GetDynamicMaterial()->SetScalarParameterValue(AbilityLevelParamName, 0);
+	RegisterCooldownDisplay();
 }
 
 void UAbilityGauge::ConfigureWithWidgetData(const FAbilityWidgetData* WidgetData)
 {
 	if (Icon && WidgetData)
 	{
-		Icon->GetDynamicMaterial()->SetTextureParameterValue(IconMaterialParamName, WidgetData->Icon.LoadSynchronous());
+		if (PlaceholderIcon)
+		{
+			Icon->GetDynamicMaterial()->SetTextureParameterValue(IconMaterialParamName, PlaceholderIcon);
+		}
 		CreateToolTipWidget(WidgetData);
+
+		RequestedIcon = WidgetData->Icon;
+		UCAssetManager::Get().LoadTextureAsync(WidgetData->Icon, FOnTextureLoaded::CreateUObject(this, &UAbilityGauge::IconLoaded));
 	}
 }
 
@@ -68,57 +88,56 @@ void UAbilityGauge::CreateToolTipWidget(const FAbilityWidgetData* AbilityWidgetD
 	if (!AbilityWidgetData || !AbilityToolTipClass)
 		return;
 
-	UAbilityToolTip* InstantiatedToolTip = CreateWidget<UAbilityToolTip>(GetOwningPlayer(), AbilityToolTipClass);
-	if (InstantiatedToolTip)
+	AbilityToolTip = CreateWidget<UAbilityToolTip>(GetOwningPlayer(), AbilityToolTipClass);
+	if (AbilityToolTip)
 	{
 		float CooldownDuration = UCAbilitySystemStatics::GetStaticCooldownDurationForAbility(AbilityCDO);
 		float Cost = UCAbilitySystemStatics::GetStaticCostForAbility(AbilityCDO);
-		InstantiatedToolTip->SetAbilityInfo(AbilityWidgetData->AbilityName, AbilityWidgetData->Icon.LoadSynchronous(), AbilityWidgetData->Description, CooldownDuration, Cost);
+		AbilityToolTip->SetAbilityInfo(AbilityWidgetData->AbilityName, PlaceholderIcon, AbilityWidgetData->Description, CooldownDuration, Cost);
 
-		SetToolTip(InstantiatedToolTip);
+		SetToolTip(AbilityToolTip);
 	}
 }
 
-void UAbilityGauge::AbilityCommitted(UGameplayAbility* Ability)
+void UAbilityGauge::IconLoaded(UTexture2D* IconTexture)
 {
-	if (Ability->GetClass()->GetDefaultObject() == AbilityCDO)
-	{
-		float CooldownTimeRemaining = 0.f;
-		float CooldownDuration = 0.f;
-
-		Ability->GetCooldownTimeRemainingAndDuration(Ability->GetCurrentAbilitySpecHandle(), Ability->GetCurrentActorInfo(), CooldownTimeRemaining, CooldownDuration);
+	// A later ConfigureWithWidgetData may have asked for another icon meanwhile
+	if (!IconTexture || RequestedIcon.Get() != IconTexture)
+		return;
 
-		StartCooldown(CooldownTimeRemaining, CooldownDuration);
+	Icon->GetDynamicMaterial()->SetTextureParameterValue(IconMaterialParamName, IconTexture);
+	if (AbilityToolTip)
+	{
+		AbilityToolTip->SetAbilityIcon(IconTexture);
 	}
 }
 
-void UAbilityGauge::StartCooldown(float CooldownTimeRemaining, float CooldownDuration)
+void UAbilityGauge::RegisterCooldownDisplay()
 {
-	CooldownDurationText->SetText(FText::AsNumber(CooldownDuration));
-	CachedCooldownDuration = CooldownDuration;
-	CachedCooldownTimeRemaining = CooldownTimeRemaining;
+	UnregisterCooldownDisplay();
 
-	CooldownCounterText->SetVisibility(ESlateVisibility::Visible);
+	UCHUDCooldownSubsystem* HUDCooldowns = UCHUDCooldownSubsystem::Get(this);
+	UCAbilitySystemComponent* OwnerASC = Cast<UCAbilitySystemComponent>(UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetOwningPlayerPawn()));
+	if (!HUDCooldowns || !AbilityCDO)
+		return;
 
-	GetWorld()->GetTimerManager().SetTimer(CooldownTimerHandle, this, &UAbilityGauge::CooldownFinished, CachedCooldownTimeRemaining);
-	GetWorld()->GetTimerManager().SetTimer(CooldownTimerUpdateHandle, this, &UAbilityGauge::UpdateCooldown, CooldownUpdateInterval, true, 0.f);
+	FCCooldownDisplay Display;
+	Display.Material = Icon->GetDynamicMaterial();
+	Display.PercentParamName = CooldownPercentParamname;
+	Display.CounterText = CooldownCounterText;
+	CooldownDisplayId = HUDCooldowns->Register(OwnerASC, AbilityCDO->GetCooldownGameplayEffect(), Display);
 }
 
-void UAbilityGauge::CooldownFinished()
+void UAbilityGauge::UnregisterCooldownDisplay()
 {
-	CachedCooldownDuration = CachedCooldownTimeRemaining = 0.f;
-	CooldownCounterText->SetVisibility(ESlateVisibility::Hidden);
-	GetWorld()->GetTimerManager().ClearTimer(CooldownTimerUpdateHandle);
-	Icon->GetDynamicMaterial()->SetScalarParameterValue(CooldownPercentParamname, 1.f);
-}
-
-void UAbilityGauge::UpdateCooldown()
-{
-	CachedCooldownTimeRemaining -= CooldownUpdateInterval;
-	FNumberFormattingOptions* FormattingOptions = CachedCooldownTimeRemaining > 1 ? &WholeNumberFormattionOptions : &TwoDigitNumberFormattingOptions;
-	CooldownCounterText->SetText(FText::AsNumber(CachedCooldownTimeRemaining, FormattingOptions));
+	if (CooldownDisplayId == INDEX_NONE)
+		return;
 
-	Icon->GetDynamicMaterial()->SetScalarParameterValue(CooldownPercentParamname, 1.0f - CachedCooldownTimeRemaining / CachedCooldownDuration);
+	if (UCHUDCooldownSubsystem* HUDCooldowns = UCHUDCooldownSubsystem::Get(this))
+	{
+		HUDCooldowns->Unregister(CooldownDisplayId);
+	}
+	CooldownDisplayId = INDEX_NONE;
 }
 
 const FGameplayAbilitySpec* UAbilityGauge::GetAbilitySpec()
@@ -50,6 +50,8 @@ struct FAbilityWidgetData : public FTableRowBase
  * lists (e.g., `UListView`). It receives `FAbilityWidgetData` to configure its
  * visuals and listens to the owner's Ability System Component to reflect
  * cooldowns, mana requirements, learned level, and upgrade availability.
+ * Cooldowns are driven by UCHUDCooldownSubsystem; the icon streams in through
+ * UCAssetManager while PlaceholderIcon is shown.
  */
 UCLASS()
 class UAbilityGauge : public UUserWidget, public IUserObjectListEntry
@@ -61,6 +63,11 @@ public:
      */
     virtual void NativeConstruct() override;
 
+    /**
+     * Native destruct event.
+     */
+    virtual void NativeDestruct() override;
+
     /**
      * Called when the list item object is set.
      */
@@ -72,12 +79,6 @@ public:
     void ConfigureWithWidgetData(const FAbilityWidgetData* WidgetData);
 
 private:
-    /**
-     * Interval to tick cooldown text/material updates.
-     */
-    UPROPERTY(EditDefaultsOnly, Category = "Cooldown")
-    float CooldownUpdateInterval = 0.1f;
-
     /**
      * MID parameter names used by the gauge material.
      */
@@ -96,6 +97,12 @@ private:
     UPROPERTY(EditDefaultsOnly, Category = "Visual")
     FName UpgradePointAvaliableParamName = "UpgradeAvaliable";
 
+    /**
+     * Shown until the ability icon has streamed in. Set in the gauge widget blueprint.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Visual")
+    UTexture2D* PlaceholderIcon;
+
     /**
      * Tooltip class used to show ability description and numbers.
      */
@@ -107,6 +114,22 @@ private:
      */
     void CreateToolTipWidget(const FAbilityWidgetData* AbilityWidgetData);
 
+    /**
+     * Tooltip created for this ability, updated when the icon arrives.
+     */
+    UPROPERTY()
+    class UAbilityToolTip* AbilityToolTip;
+
+    /**
+     * Icon requested from the asset manager.
+     */
+    TSoftObjectPtr<UTexture2D> RequestedIcon;
+
+    /**
+     * Called when the ability icon has been loaded.
+     */
+    void IconLoaded(UTexture2D* IconTexture);
+
     /**
      * Icon image widget.
      */
@@ -144,33 +167,16 @@ private:
     class UGameplayAbility* AbilityCDO;
 
     /**
-     * Called when the ability is committed.
-     */
-    void AbilityCommitted(UGameplayAbility* Ability);
-
-    /**
-     * Starts the cooldown timer.
+     * Hands the ability's cooldown effect to UCHUDCooldownSubsystem.
      */
-    void StartCooldown(float CooldownTimeRemaining, float CooldownDuration);
-
-    float CachedCooldownDuration;
-    float CachedCooldownTimeRemaining;
-
-    FTimerHandle CooldownTimerHandle;
-    FTimerHandle CooldownTimerUpdateHandle;
-
-    FNumberFormattingOptions WholeNumberFormattionOptions;
-    FNumberFormattingOptions TwoDigitNumberFormattingOptions;
+    void RegisterCooldownDisplay();
 
     /**
-     * Called when the cooldown finishes.
+     * Removes this gauge from UCHUDCooldownSubsystem.
      */
-    void CooldownFinished();
+    void UnregisterCooldownDisplay();
 
-    /**
-     * Updates the cooldown progress.
-     */
-    void UpdateCooldown();
+    int32 CooldownDisplayId = INDEX_NONE;
 
     /**
      * Owning Ability System and spec handle for this entry.
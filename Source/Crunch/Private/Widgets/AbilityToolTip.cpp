@@ -18,3 +18,8 @@ void UAbilityToolTip::SetAbilityInfo(const FName& AbilityName, UTexture2D* Abili
 	AbilityCooldownText->SetText(FText::AsNumber(AbilityCooldown, &FormattingOptions));
 	AbilityCostText->SetText(FText::AsNumber(AbilityCost, &FormattingOptions));
 }
+
+void UAbilityToolTip::SetAbilityIcon(UTexture2D* AbilityTexture)
+{
+	AbilityIcon->SetBrushFromTexture(AbilityTexture);
+}
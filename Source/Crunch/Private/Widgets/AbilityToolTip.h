@@ -24,6 +24,9 @@ public:
     /** Sets all tooltip display fields for the given ability */
     void SetAbilityInfo(const FName& AbilityName, UTexture2D* AbilityTexture, const FText& AbilityDescription, float AbilityCooldown, float AbilityCost);
 
+    /** Swap the icon once it has been loaded asynchronously. */
+    void SetAbilityIcon(UTexture2D* AbilityTexture);
+
 private: 
     /** Ability display name */
     UPROPERTY(meta=(BindWidget)) 
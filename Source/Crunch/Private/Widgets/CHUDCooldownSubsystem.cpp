@@ -0,0 +1,236 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Widgets/CHUDCooldownSubsystem.h"
+#include "Components/TextBlock.h"
+#include "Engine/World.h"
+#include "GAS/CAbilitySystemComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+DECLARE_CYCLE_STAT(TEXT("HUD Cooldown Update"), STAT_CHUDCooldownUpdate, STATGROUP_UI);
+
+bool UCHUDCooldownSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Nobody looks at a HUD on a dedicated server
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UCHUDCooldownSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	WholeNumberFormattingOptions.MaximumFractionalDigits = 0;
+	TwoDigitNumberFormattingOptions.MaximumFractionalDigits = 2;
+}
+
+void UCHUDCooldownSubsystem::Deinitialize()
+{
+	for (const TWeakObjectPtr<UCAbilitySystemComponent>& ASC : WatchedAbilitySystems)
+	{
+		if (ASC.IsValid())
+		{
+			ASC->OnDurationEffectChanged.RemoveAll(this);
+		}
+	}
+	WatchedAbilitySystems.Empty();
+	Displays.Empty();
+	NumRunning = 0;
+
+	Super::Deinitialize();
+}
+
+void UCHUDCooldownSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_CHUDCooldownUpdate);
+	const double StartTime = FPlatformTime::Seconds();
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (TPair<int32, FEntry>& Pair : Displays)
+	{
+		FEntry& Entry = Pair.Value;
+		if (!Entry.bRunning)
+		{
+			continue;
+		}
+
+		const float Remaining = float(Entry.EndTime - Now);
+		if (Remaining <= 0.f)
+		{
+			// The removal event re-queries in case another cooldown of the same effect still runs
+			StopEntry(Entry);
+			continue;
+		}
+		UpdateEntry(Entry, Remaining);
+	}
+
+	LastUpdateSeconds = FPlatformTime::Seconds() - StartTime;
+}
+
+bool UCHUDCooldownSubsystem::IsTickable() const
+{
+	return NumRunning > 0;
+}
+
+TStatId UCHUDCooldownSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCHUDCooldownSubsystem, STATGROUP_Tickables);
+}
+
+int32 UCHUDCooldownSubsystem::Register(UCAbilitySystemComponent* ASC, const UGameplayEffect* CooldownEffect, const FCCooldownDisplay& Display)
+{
+	if (!ASC || !CooldownEffect)
+	{
+		return INDEX_NONE;
+	}
+
+	WatchAbilitySystem(ASC);
+
+	const int32 DisplayId = NextDisplayId++;
+	FEntry& Entry = Displays.Add(DisplayId);
+	Entry.ASC = ASC;
+	Entry.CooldownEffect = CooldownEffect;
+	Entry.Display = Display;
+	StopEntry(Entry);
+	RefreshEntry(Entry);
+	return DisplayId;
+}
+
+void UCHUDCooldownSubsystem::Unregister(int32 DisplayId)
+{
+	FEntry Entry;
+	if (Displays.RemoveAndCopyValue(DisplayId, Entry) && Entry.bRunning)
+	{
+		--NumRunning;
+	}
+}
+
+UCHUDCooldownSubsystem* UCHUDCooldownSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCHUDCooldownSubsystem>() : nullptr;
+}
+
+void UCHUDCooldownSubsystem::WatchAbilitySystem(UCAbilitySystemComponent* ASC)
+{
+	WatchedAbilitySystems.RemoveAll([](const TWeakObjectPtr<UCAbilitySystemComponent>& Watched) { return !Watched.IsValid(); });
+	if (WatchedAbilitySystems.Contains(ASC))
+	{
+		return;
+	}
+
+	WatchedAbilitySystems.Add(ASC);
+	ASC->OnDurationEffectChanged.AddUObject(this, &UCHUDCooldownSubsystem::DurationEffectChanged, TWeakObjectPtr<UCAbilitySystemComponent>(ASC));
+}
+
+void UCHUDCooldownSubsystem::DurationEffectChanged(const UGameplayEffect* EffectDefinition, TWeakObjectPtr<UCAbilitySystemComponent> ASC)
+{
+	for (TPair<int32, FEntry>& Pair : Displays)
+	{
+		FEntry& Entry = Pair.Value;
+		if (Entry.ASC == ASC && Entry.CooldownEffect.Get() == EffectDefinition)
+		{
+			RefreshEntry(Entry);
+		}
+	}
+}
+
+void UCHUDCooldownSubsystem::RefreshEntry(FEntry& Entry)
+{
+	const UCAbilitySystemComponent* ASC = Entry.ASC.Get();
+	const UGameplayEffect* CooldownEffect = Entry.CooldownEffect.Get();
+	if (!ASC || !CooldownEffect)
+	{
+		StopEntry(Entry);
+		return;
+	}
+
+	FGameplayEffectQuery CooldownEffectQuery;
+	CooldownEffectQuery.EffectDefinition = CooldownEffect->GetClass();
+
+	float Remaining = 0.f;
+	float Duration = 0.f;
+	for (const TPair<float, float>& RemainingAndDuration : ASC->GetActiveEffectsTimeRemainingAndDuration(CooldownEffectQuery))
+	{
+		if (RemainingAndDuration.Key > Remaining)
+		{
+			Remaining = RemainingAndDuration.Key;
+			Duration = RemainingAndDuration.Value;
+		}
+	}
+
+	if (Remaining <= 0.f)
+	{
+		StopEntry(Entry);
+		return;
+	}
+
+	Entry.EndTime = GetWorld()->GetTimeSeconds() + Remaining;
+	Entry.Duration = Duration;
+	if (!Entry.bRunning)
+	{
+		Entry.bRunning = true;
+		++NumRunning;
+		if (UTextBlock* CounterText = Entry.Display.CounterText.Get())
+		{
+			CounterText->SetVisibility(ESlateVisibility::Visible);
+		}
+	}
+	UpdateEntry(Entry, Remaining);
+}
+
+void UCHUDCooldownSubsystem::UpdateEntry(FEntry& Entry, float Remaining)
+{
+	if (UMaterialInstanceDynamic* Material = Entry.Display.Material.Get())
+	{
+		Material->SetScalarParameterValue(Entry.Display.PercentParamName, Entry.Duration > 0.f ? 1.f - Remaining / Entry.Duration : 1.f);
+	}
+
+	UTextBlock* CounterText = Entry.Display.CounterText.Get();
+	const bool bWholeSeconds = Remaining > 1.f;
+	const int32 Counter = bWholeSeconds ? FMath::RoundToInt32(Remaining) : -FMath::RoundToInt32(Remaining * 100.f);
+	if (CounterText && Counter != Entry.ShownCounter)
+	{
+		CounterText->SetText(FText::AsNumber(Remaining, bWholeSeconds ? &WholeNumberFormattingOptions : &TwoDigitNumberFormattingOptions));
+		Entry.ShownCounter = Counter;
+	}
+}
+
+void UCHUDCooldownSubsystem::StopEntry(FEntry& Entry)
+{
+	if (Entry.bRunning)
+	{
+		Entry.bRunning = false;
+		--NumRunning;
+	}
+	Entry.ShownCounter = INDEX_NONE;
+
+	if (UMaterialInstanceDynamic* Material = Entry.Display.Material.Get())
+	{
+		Material->SetScalarParameterValue(Entry.Display.PercentParamName, 1.f);
+	}
+	if (UTextBlock* CounterText = Entry.Display.CounterText.Get())
+	{
+		CounterText->SetVisibility(ESlateVisibility::Hidden);
+	}
+}
+
+static void HUDCooldownStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UCHUDCooldownSubsystem* HUDCooldowns = UCHUDCooldownSubsystem::Get(World);
+	if (!HUDCooldowns)
+	{
+		Ar.Log(TEXT("Crunch.HUDCooldowns.Stats: no HUD cooldown subsystem in this world"));
+		return;
+	}
+
+	Ar.Logf(TEXT("HUD cooldowns: %d displays, %d running"), HUDCooldowns->GetNumDisplays(), HUDCooldowns->GetNumRunning());
+	Ar.Logf(TEXT("  update %.1f us last frame, no timers"), HUDCooldowns->GetLastUpdateSeconds() * 1000000.0);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice HUDCooldownStatsCommand(
+	TEXT("Crunch.HUDCooldowns.Stats"),
+	TEXT("Crunch.HUDCooldowns.Stats: print the registered HUD cooldown displays, the running ones and the cost of the last update."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&HUDCooldownStats));
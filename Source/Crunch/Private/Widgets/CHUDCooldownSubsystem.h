@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+// ----------------------------------------------------------------------------
+// File: CHUDCooldownSubsystem.h
+// Purpose: One cooldown service for every HUD cooldown display (ability gauges,
+//          inventory slots). Cooldowns are read from the owner's
+//          UCAbilitySystemComponent when a cooldown effect is added or removed,
+//          and all running displays advance together once per frame, instead
+//          of a looping timer and ability system query per widget.
+// Key API:
+//  - Register / Unregister: a widget hands over the material parameter and
+//    counter text it shows one cooldown effect with.
+// Notes:
+//  - Only ticks while a registered cooldown runs; counter texts are only set
+//    when the shown number changes.
+//  - Crunch.HUDCooldowns.Stats prints the displays and the last update cost.
+// ----------------------------------------------------------------------------
+#include "CHUDCooldownSubsystem.generated.h"
+
+class UCAbilitySystemComponent;
+class UGameplayEffect;
+class UMaterialInstanceDynamic;
+class UTextBlock;
+
+/** What a widget shows one cooldown with */
+struct FCCooldownDisplay
+{
+	TWeakObjectPtr<UMaterialInstanceDynamic> Material;
+
+	/** Scalar parameter going from 0 when the cooldown starts to 1 when it is over */
+	FName PercentParamName;
+
+	/** Optional: remaining seconds, visible while the cooldown runs */
+	TWeakObjectPtr<UTextBlock> CounterText;
+};
+
+/**
+ * UCHUDCooldownSubsystem keeps the cooldown displays of the local players'
+ * widgets. A display follows one cooldown effect class on one ability system.
+ * UCAbilitySystemComponent::OnDurationEffectChanged (predicted and replicated
+ * effects alike) makes the subsystem query that effect's remaining time once;
+ * from then on Tick derives the percent and counter from the end time.
+ */
+UCLASS()
+class UCHUDCooldownSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	/** Show the cooldown of CooldownEffect on ASC, starting with a running one. Returns the id for Unregister, INDEX_NONE when nothing to show. */
+	int32 Register(UCAbilitySystemComponent* ASC, const UGameplayEffect* CooldownEffect, const FCCooldownDisplay& Display);
+	void Unregister(int32 DisplayId);
+
+	int32 GetNumDisplays() const { return Displays.Num(); }
+	int32 GetNumRunning() const { return NumRunning; }
+	double GetLastUpdateSeconds() const { return LastUpdateSeconds; }
+
+	static UCHUDCooldownSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UCAbilitySystemComponent> ASC;
+		TWeakObjectPtr<const UGameplayEffect> CooldownEffect;
+		FCCooldownDisplay Display;
+		double EndTime = 0.0;
+		float Duration = 0.f;
+		/** Whole seconds above 1 s, negative hundredths below; INDEX_NONE while hidden */
+		int32 ShownCounter = INDEX_NONE;
+		bool bRunning = false;
+	};
+
+	/** Bind to the ASC's effect events once, however many displays follow it */
+	void WatchAbilitySystem(UCAbilitySystemComponent* ASC);
+	void DurationEffectChanged(const UGameplayEffect* EffectDefinition, TWeakObjectPtr<UCAbilitySystemComponent> ASC);
+
+	/** Query the remaining time of the entry's cooldown and start or stop it */
+	void RefreshEntry(FEntry& Entry);
+	void UpdateEntry(FEntry& Entry, float Remaining);
+	void StopEntry(FEntry& Entry);
+
+	TMap<int32, FEntry> Displays;
+	TArray<TWeakObjectPtr<UCAbilitySystemComponent>> WatchedAbilitySystems;
+
+	FNumberFormattingOptions WholeNumberFormattingOptions;
+	FNumberFormattingOptions TwoDigitNumberFormattingOptions;
+
+	int32 NextDisplayId = 0;
+	int32 NumRunning = 0;
+	double LastUpdateSeconds = 0.0;
+};
@@ -2,11 +2,16 @@
 
 
 #include "Widgets/InventoryItemWidget.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "Abilities/GameplayAbility.h"
+#include "Framework/CAssetManager.h"
+#include "GAS/CAbilitySystemComponent.h"
 #include "Inventory/InventoryItem.h"
 #include "Components/TextBlock.h"
 #include "Components/Image.h"
 #include "Inventory/PA_ShopItem.h"
 #include "Widgets/InventoryItemDragDropOp.h"
+#include "Widgets/CHUDCooldownSubsystem.h"
 #include "Widgets/ItemToolTip.h"
 
 void UInventoryItemWidget::NativeConstruct()
@@ -15,6 +20,13 @@ void UInventoryItemWidget::NativeConstruct()
 	EmptySlot();
 }
 
+void UInventoryItemWidget::NativeDestruct()
+{
+	ClearCooldown();
+	UnBindCanCastAbilityDelegate();
+	Super::NativeDestruct();
+}
+
 bool UInventoryItemWidget::IsEmpty() const
 {
 	return !InventoryItem || !(InventoryItem->IsValid());
@@ -36,12 +48,10 @@ void UInventoryItemWidget::UpdateInventoryItem(const UInventoryItem* Item)
 		return;
 	}
 	
-	SetIcon(Item->GetShopItem()->GetIcon());
-	UItemToolTip* ToolTip = SetToolTipWidget(InventoryItem->GetShopItem());
-	if (ToolTip)
-	{
-		ToolTip->SetPrice(InventoryItem->GetShopItem()->GetSellPrice());
-	}
+	// The tooltip shows the icon too, so it is created once the icon is loaded
+	SetIcon(EmptyTexture);
+	SetToolTip(nullptr);
+	UCAssetManager::Get().LoadTextureAsync(Item->GetShopItem()->GetIconAsset(), FOnTextureLoaded::CreateUObject(this, &UInventoryItemWidget::IconLoaded, TWeakObjectPtr<const UInventoryItem>(Item)));
 
 	if (InventoryItem->GetShopItem()->GetIsStackable())
 	{
@@ -58,13 +68,8 @@ void UInventoryItemWidget::UpdateInventoryItem(const UInventoryItem* Item)
 	if (InventoryItem->IsGrantingAnyAbility())
 	{
 		UpdateCanCastDisplay(InventoryItem->CanCastAbility());
-		float AbilityCooldownRemaining = InventoryItem->GetAbilityCooldownTimeRemaining();
 		float AbilityCooldownDuration = InventoryItem->GetAbilityCooldownDuration();
-
-		if (AbilityCooldownRemaining > 0.f)
-		{
-			StartCooldown(AbilityCooldownDuration, AbilityCooldownRemaining);
-		}
+		RegisterCooldownDisplay();
 
 		float AbilityCost = InventoryItem->GetAbilityManaCost();
 		ManaCostText->SetVisibility(AbilityCost == 0.f ? ESlateVisibility::Hidden : ESlateVisibility::Visible);
@@ -171,16 +176,6 @@ bool UInventoryItemWidget::NativeOnDrop(const FGeometry& InGeometry, const FDrag
 	return Super::NativeOnDrop(InGeometry, InDragDropEvent, InOperation);
 }
 
-void UInventoryItemWidget::StartCooldown(float CooldownDuration, float TimeRemaining)
-{
-	CooldownTimeRemaining = TimeRemaining;
-	CooldownTimeDuration = CooldownDuration;
-	GetWorld()->GetTimerManager().SetTimer(CooldownDurationTimerHandle, this, &UInventoryItemWidget::CooldownFinished, CooldownTimeRemaining);
-	GetWorld()->GetTimerManager().SetTimer(CooldownUpdateTimerHandle, this, &UInventoryItemWidget::UpdateCooldown, CooldownUpdateInterval, true);
-
-	CooldownCountText->SetVisibility(ESlateVisibility::Visible);
-}
-
 void UInventoryItemWidget::BindCanCastAbilityDelegate()
 {
 	if (InventoryItem)
@@ -197,9 +192,32 @@ void UInventoryItemWidget::UnBindCanCastAbilityDelegate()
 	}
 }
 
-void UInventoryItemWidget::CooldownFinished()
+void UInventoryItemWidget::RegisterCooldownDisplay()
 {
-	GetWorld()->GetTimerManager().ClearTimer(CooldownUpdateTimerHandle);
+	UCHUDCooldownSubsystem* HUDCooldowns = UCHUDCooldownSubsystem::Get(this);
+	const UGameplayAbility* GrantedAbility = InventoryItem ? InventoryItem->GetShopItem()->GetGrantedAbilityCDO() : nullptr;
+	if (!HUDCooldowns || !GrantedAbility || !GetItemIcon())
+		return;
+
+	FCCooldownDisplay Display;
+	Display.Material = GetItemIcon()->GetDynamicMaterial();
+	Display.PercentParamName = CooldownAmtDynamicMaterialParamName;
+	Display.CounterText = CooldownCountText;
+	UCAbilitySystemComponent* OwnerASC = Cast<UCAbilitySystemComponent>(UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetOwningPlayerPawn()));
+	CooldownDisplayId = HUDCooldowns->Register(OwnerASC, GrantedAbility->GetCooldownGameplayEffect(), Display);
+}
+
+void UInventoryItemWidget::ClearCooldown()
+{
+	if (CooldownDisplayId != INDEX_NONE)
+	{
+		if (UCHUDCooldownSubsystem* HUDCooldowns = UCHUDCooldownSubsystem::Get(this))
+		{
+			HUDCooldowns->Unregister(CooldownDisplayId);
+		}
+		CooldownDisplayId = INDEX_NONE;
+	}
+
 	CooldownCountText->SetVisibility(ESlateVisibility::Hidden);
 	if (GetItemIcon())
 	{
@@ -207,21 +225,21 @@ void UInventoryItemWidget::CooldownFinished()
 	}
 }
 
-void UInventoryItemWidget::UpdateCooldown()
+void UInventoryItemWidget::IconLoaded(UTexture2D* IconTexture, TWeakObjectPtr<const UInventoryItem> Item)
 {
-	CooldownTimeRemaining -= CooldownUpdateInterval;
-	float CooldownAmt = 1.f - CooldownTimeRemaining / CooldownTimeDuration;
-	CooldownDisplayFormattingOptions.MaximumFractionalDigits = CooldownTimeRemaining > 1.f ? 0 : 2;
-	CooldownCountText->SetText(FText::AsNumber(CooldownTimeRemaining, &CooldownDisplayFormattingOptions));
-	if (GetItemIcon())
+	if (!Item.IsValid() || Item.Get() != InventoryItem)
+		return;
+
+	if (IconTexture)
 	{
-		GetItemIcon()->GetDynamicMaterial()->SetScalarParameterValue(CooldownAmtDynamicMaterialParamName, CooldownAmt);
+		SetIcon(IconTexture);
 	}
-}
 
-void UInventoryItemWidget::ClearCooldown()
-{
-	CooldownFinished();
+	UItemToolTip* ToolTip = SetToolTipWidget(InventoryItem->GetShopItem());
+	if (ToolTip)
+	{
+		ToolTip->SetPrice(InventoryItem->GetShopItem()->GetSellPrice());
+	}
 }
 
 void UInventoryItemWidget::SetIcon(UTexture2D* IconTexture)
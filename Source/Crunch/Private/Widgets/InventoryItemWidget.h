@@ -22,7 +22,9 @@ DECLARE_MULTICAST_DELEGATE_OneParam(FOnButtonClick, const FInventoryItemHandle&
 /**
  * Inventory slot widget that presents an `UInventoryItem` and exposes user
  * interactions via delegates. Handles drag/drop to move/combine items and
- * displays cooldown progression with a material parameter-driven overlay.
+ * displays cooldown progression with a material parameter-driven overlay,
+ * driven by UCHUDCooldownSubsystem. The item icon streams in through
+ * UCAssetManager while EmptyTexture is shown.
  */
 UCLASS()
 class UInventoryItemWidget : public UItemWidget
@@ -50,6 +52,11 @@ public:
      */
     virtual void NativeConstruct() override;
 
+    /**
+     * Native destruct event.
+     */
+    virtual void NativeDestruct() override;
+
     /**
      * Checks if the inventory slot is empty.
      *
@@ -119,7 +126,7 @@ private:
     void UpdateCanCastDisplay(bool bCanCast);
 
     /**
-     * The texture to display when the slot is empty.
+     * The texture to display when the slot is empty, or while the item icon loads.
      */
     UPROPERTY(EditDefaultsOnly, Category = "Visual")
     UTexture2D* EmptyTexture;
@@ -204,22 +211,7 @@ private:
     /*            GAS                         */
     /******************************************/
 
-public:
-    /**
-     * Starts the cooldown overlay tick/update for an ability item.
-     *
-     * @param CooldownDuration The duration of the cooldown.
-     * @param TimeRemaining The remaining time on the cooldown.
-     */
-    void StartCooldown(float CooldownDuration, float TimeRemaining);
-
 private:
-    /**
-     * The interval at which to update the cooldown display.
-     */
-    UPROPERTY(EditDefaultsOnly, Category = "Cooldown")
-    float CooldownUpdateInterval = 0.1f;
-
     /**
      * Binds the can cast ability delegate.
      */
@@ -231,39 +223,19 @@ private:
     void UnBindCanCastAbilityDelegate();
 
     /**
-     * Called when the cooldown finishes.
+     * Hands the granted ability's cooldown effect to UCHUDCooldownSubsystem.
      */
-    void CooldownFinished();
+    void RegisterCooldownDisplay();
 
     /**
-     * Updates the cooldown display.
-     */
-    void UpdateCooldown();
-
-    /**
-     * Clears the cooldown display.
+     * Removes this slot from UCHUDCooldownSubsystem and resets the overlay.
      */
     void ClearCooldown();
 
     /**
-     * The timer handle for the cooldown duration.
-     */
-    FTimerHandle CooldownDurationTimerHandle;
-
-    /**
-     * The timer handle for the cooldown update.
-     */
-    FTimerHandle CooldownUpdateTimerHandle;
-
-    /**
-     * The remaining time on the cooldown.
-     */
-    float CooldownTimeRemaining = 0.f;
-
-    /**
-     * The duration of the cooldown.
+     * The id of this slot's display in UCHUDCooldownSubsystem.
      */
-    float CooldownTimeDuration = 0.f;
+    int32 CooldownDisplayId = INDEX_NONE;
 
     /**
      * The material parameter name for the cooldown amount.
@@ -291,7 +263,10 @@ private:
     virtual void SetIcon(UTexture2D* IconTexture) override;
 
     /**
-     * The formatting options for the cooldown display.
+     * Called when the icon of Item has been loaded; ignored if the slot shows another item by then.
+     *
+     * @param IconTexture The loaded icon texture.
+     * @param Item The item the icon was requested for.
      */
-    FNumberFormattingOptions CooldownDisplayFormattingOptions;
+    void IconLoaded(UTexture2D* IconTexture, TWeakObjectPtr<const UInventoryItem> Item);
 };
@@ -21,7 +21,6 @@ void UInventoryWidget::NativeConstruct()
 			InventoryComponent->OnItemAdded.AddUObject(this, &UInventoryWidget::ItemAdded);
 			InventoryComponent->OnItemRemoved.AddUObject(this, &UInventoryWidget::ItemRemoved);
 			InventoryComponent->OnItemStackCountChanged.AddUObject(this, &UInventoryWidget::ItemStackCountChanged);
-			InventoryComponent->OnItemAbilityCommitted.AddUObject(this, &UInventoryWidget::ItemAbilityCommitted);
 			int Capacity = InventoryComponent->GetCapacity();
 			
 			ItemList->ClearChildren();
@@ -209,12 +208,3 @@ void UInventoryWidget::ItemRemoved(const FInventoryItemHandle& ItemHandle)
 		PopulatedItemEntryWidgets.Remove(ItemHandle);
 	}
 }
-
-void UInventoryWidget::ItemAbilityCommitted(const FInventoryItemHandle& ItemHandle, float CooldownDuration, float CooldownTimeRemaining)
-{
-	UInventoryItemWidget** FoundWidget = PopulatedItemEntryWidgets.Find(ItemHandle);
-	if (FoundWidget && *FoundWidget)
-	{
-		(*FoundWidget)->StartCooldown(CooldownDuration, CooldownTimeRemaining);
-	}
-}
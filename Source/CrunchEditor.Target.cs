@@ -11,5 +11,8 @@ public class CrunchEditorTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_4;
 		ExtraModuleNames.Add("Crunch");
+
+		// Attribute sets replicate push based
+		bWithPushModel = true;
 	}
 }